@@ -0,0 +1,97 @@
+#include <cstddef>
+#include <cstdlib>
+#include <list>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "BuildPKBUtils.h"
+#include "catch.hpp"
+#include "query_processor/commons/query/Query.h"
+#include "query_processor/query_evaluator/ClauseResultCache.h"
+#include "query_processor/query_evaluator/QueryEvaluator.h"
+#include "query_processor/query_parser/QueryParser.h"
+#include "query_processor/query_projector/QueryProjector.h"
+
+using namespace std;
+using namespace query_processor;
+
+// every allocation of this test binary made on the current thread is counted, so that the allocations of a query are
+// the difference in the count across its evaluation
+namespace {
+thread_local size_t allocations = 0;
+}  // namespace
+
+void* operator new(size_t bytes) {
+  allocations++;
+  void* memory = malloc(bytes == 0 ? 1 : bytes);
+  if (memory == nullptr) {
+    throw bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+  free(memory);
+}
+
+namespace {
+
+// the allocations of a query besides its results, e.g. for the columns of its clauses, and of each of its results,
+// i.e. an element of its QueryResult, a string of a tuple and a node of the formatted list
+const size_t kQueryAllocations = 64;
+const size_t kResultAllocations = 3;
+
+// disables the ClauseResultCache while in scope, restoring its default limits even if a test fails
+class ClauseResultCacheDisabled {
+ public:
+  ClauseResultCacheDisabled() {
+    ClauseResultCache::SetLimits(0, 0);
+  }
+
+  ~ClauseResultCacheDisabled() {
+    ClauseResultCache::SetLimits(ClauseResultCache::kDefaultMaxEntries, ClauseResultCache::kDefaultMaxBytes);
+  }
+};
+
+// evaluates a planned query and formats its results, returning how many allocations it took
+size_t CountQueryAllocations(Query& query, PKB& pkb, list<string>& results) {
+  size_t allocations_before = allocations;
+  results = QueryProjector::FormatResult(QueryEvaluator::EvaluatePlannedQuery(query, &pkb, true));
+  return allocations - allocations_before;
+}
+
+}  // namespace
+
+SCENARIO("Test the allocations of a query are a constant plus its results") {
+  GIVEN("PKB built from Sample Program 4 given in SPA requirements") {
+    PKB pkb = BuildPKBSampleProgram();
+    pkb.Freeze();
+    // the results of clauses are not cached, so that each evaluation evaluates every clause
+    ClauseResultCacheDisabled cache_disabled;
+    vector<string> query_strings = {"stmt s; Select s",
+                                    "assign a; Select a",
+                                    "stmt s; Select BOOLEAN such that Follows(s, 5)",
+                                    "assign a; variable v; Select a such that Modifies(a, v)",
+                                    "assign a; while w; Select <a, w> such that Parent*(w, a)"};
+
+    WHEN("Queries are evaluated again against the frozen PKB") {
+      THEN("Each takes as many allocations as before, at most a constant and a few for each result") {
+        for (string& query_string : query_strings) {
+          INFO(query_string);
+          Query query = QueryEvaluator::PlanQuery(QueryParser::ParseQuery(query_string));
+          list<string> results;
+          // the first evaluation reads the design entities of the PKB
+          CountQueryAllocations(query, pkb, results);
+          size_t query_allocations = CountQueryAllocations(query, pkb, results);
+          REQUIRE(CountQueryAllocations(query, pkb, results) == query_allocations);
+          REQUIRE(query_allocations <= kQueryAllocations + kResultAllocations * results.size());
+        }
+      }
+    }
+  }
+}
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "spa.h"
+#include "utils/Cancellation.h"
 
 // implementation code of WrapperFactory - do NOT modify the next 5 lines
 AbstractWrapper* WrapperFactory::wrapper = 0;
@@ -24,6 +25,8 @@ TestWrapper::TestWrapper() {
   // create any objects here as instance variables of this class
   // as well as any initialization required for your spa program
   this->pkb = PKB();
+  // queries still evaluating when the autotester times them out stop at their next cancellation check
+  utils::Cancellation::SetStopFlag(&AbstractWrapper::GlobalStop);
 }
 
 // method for parsing the SIMPLE source
@@ -41,6 +44,7 @@ void TestWrapper::parse(std::string filename) {
               << "Exiting AutoTester without evaluating PQL queries or generating out.xml\n";
     exit(EXIT_FAILURE);
   }
+  SPA::ConfigureQueries();
 }
 
 // method to evaluating a query
@@ -0,0 +1,72 @@
+#include "QueryFile.h"
+
+#include <fstream>
+#include <regex>
+#include <stdexcept>
+
+namespace batch_runner {
+
+namespace {
+
+std::string Trim(const std::string& line) {
+  size_t start = line.find_first_not_of(" \t\r\n");
+  if (start == std::string::npos) {
+    return "";
+  }
+  size_t end = line.find_last_not_of(" \t\r\n");
+  return line.substr(start, end - start + 1);
+}
+
+bool ReadLine(std::ifstream& file, std::string& line) {
+  if (!std::getline(file, line)) {
+    return false;
+  }
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+  return true;
+}
+
+}  // namespace
+
+std::string QueryCase::GetQueryString() const {
+  return declarations + " " + selection;
+}
+
+std::vector<QueryCase> QueryFile::Load(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file) {
+    throw std::runtime_error("QueryFile::Load: unable to open " + filename);
+  }
+
+  static const std::regex header_regex("^\\s*(\\d+)\\s*-\\s*(.*)$");
+  std::vector<QueryCase> cases;
+  std::string line;
+  while (ReadLine(file, line)) {
+    // anything between queries that is not a header, such as trailing blank lines, is skipped
+    std::smatch header_match;
+    if (!std::regex_match(line, header_match, header_regex)) {
+      continue;
+    }
+
+    QueryCase query_case;
+    query_case.id = header_match[1];
+    query_case.comment = Trim(header_match[2]);
+    std::string timeout;
+    if (!ReadLine(file, query_case.declarations) || !ReadLine(file, query_case.selection) ||
+        !ReadLine(file, query_case.expected) || !ReadLine(file, timeout)) {
+      throw std::runtime_error("QueryFile::Load: query " + query_case.id + " in " + filename + " is incomplete");
+    }
+    query_case.expected = Trim(query_case.expected);
+    try {
+      query_case.timeout_ms = std::stoi(timeout);
+    } catch (std::logic_error&) {
+      throw std::runtime_error("QueryFile::Load: query " + query_case.id + " in " + filename + " has no valid timeout");
+    }
+    cases.push_back(query_case);
+  }
+
+  return cases;
+}
+
+}  // namespace batch_runner
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace batch_runner {
+
+// one query of a Tests21 style query file, which lists each query over five lines:
+// "<id> - <comment>", the declarations, the selection, the expected answer and the timeout in ms
+struct QueryCase {
+  std::string id;
+  std::string comment;
+  std::string declarations;
+  std::string selection;
+  std::string expected;
+  int timeout_ms = 0;
+
+  // the query exactly as the autotester hands it to the SPA
+  std::string GetQueryString() const;
+};
+
+class QueryFile {
+ public:
+  static std::vector<QueryCase> Load(const std::string& filename);
+};
+
+}  // namespace batch_runner
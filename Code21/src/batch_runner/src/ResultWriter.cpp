@@ -0,0 +1,132 @@
+#include "ResultWriter.h"
+
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace batch_runner {
+
+namespace {
+
+std::string EscapeAttribute(const std::string& value) {
+  std::string escaped;
+  for (char c : value) {
+    switch (c) {
+      case '&':
+        escaped += "&amp;";
+        break;
+      case '<':
+        escaped += "&lt;";
+        break;
+      case '>':
+        escaped += "&gt;";
+        break;
+      case '"':
+        escaped += "&quot;";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+// "none" is how query files spell an empty answer, otherwise answers are comma separated
+std::set<std::string> SplitExpected(const std::string& expected) {
+  std::set<std::string> answers;
+  if (expected == "none") {
+    return answers;
+  }
+  std::stringstream stream(expected);
+  std::string answer;
+  while (std::getline(stream, answer, ',')) {
+    size_t start = answer.find_first_not_of(" \t");
+    if (start != std::string::npos) {
+      answers.insert(answer.substr(start, answer.find_last_not_of(" \t") - start + 1));
+    }
+  }
+  return answers;
+}
+
+template <typename Container>
+std::string Join(const Container& values) {
+  std::string joined;
+  for (auto& value : values) {
+    if (!joined.empty()) {
+      joined += ",";
+    }
+    joined += value;
+  }
+  return joined;
+}
+
+}  // namespace
+
+int ResultWriter::Write(const std::string& filename, double parsing_time_ms, const std::vector<QueryOutcome>& outcomes) {
+  std::ofstream out(filename);
+  if (!out) {
+    throw std::runtime_error("ResultWriter::Write: unable to open " + filename);
+  }
+
+  out << std::fixed << std::setprecision(6);
+  out << "<?xml-stylesheet type=\"text/xsl\" href=\"analysis.xsl\"?>\n"
+      << "<test_results>\n"
+      << "<info>\n"
+      << "<name>batch_runner</name><parsing_time_taken>" << parsing_time_ms << "</parsing_time_taken>\n"
+      << "</info>\n"
+      << "<queries>\n";
+
+  int num_passed = 0;
+  for (auto& outcome : outcomes) {
+    const QueryCase& query_case = outcome.query_case;
+    std::set<std::string> expected = SplitExpected(query_case.expected);
+    std::set<std::string> actual(outcome.answers.begin(), outcome.answers.end());
+
+    std::vector<std::string> missing;
+    std::vector<std::string> additional;
+    for (auto& answer : expected) {
+      if (actual.find(answer) == actual.end()) {
+        missing.push_back(answer);
+      }
+    }
+    for (auto& answer : actual) {
+      if (expected.find(answer) == expected.end()) {
+        additional.push_back(answer);
+      }
+    }
+
+    out << "<query>\n"
+        << "<id comment=\"" << EscapeAttribute(query_case.comment) << "\">" << query_case.id << "</id>"
+        << "<querystr><![CDATA[" << query_case.GetQueryString() << "]]></querystr>\n"
+        << "<stuans>" << Join(outcome.answers) << "</stuans>\n"
+        << "<correct>" << Join(expected) << "</correct>\n"
+        << "<time_taken>" << outcome.time_taken_ms << "</time_taken>\n";
+
+    if (query_case.timeout_ms > 0 && outcome.time_taken_ms > query_case.timeout_ms) {
+      out << "<timeout/>\n";
+    } else if (missing.empty() && additional.empty()) {
+      out << "<passed/>\n";
+      num_passed++;
+    } else {
+      out << "<failed>\n"
+          << "<missing>" << Join(missing) << "</missing>\n"
+          << "<additional>" << Join(additional) << "</additional>\n"
+          << "<summary>\n"
+          << "<expected>" << expected.size() << "</expected>\n"
+          << "<matched>" << expected.size() - missing.size() << "</matched>\n"
+          << "<missing>" << missing.size() << "</missing>\n"
+          << "<additional>" << additional.size() << "</additional>\n"
+          << "</summary>\n"
+          << "</failed>\n";
+    }
+    out << "</query>\n";
+  }
+
+  out << "</queries>\n"
+      << "</test_results>\n";
+  return num_passed;
+}
+
+}  // namespace batch_runner
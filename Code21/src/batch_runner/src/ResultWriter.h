@@ -0,0 +1,24 @@
+#pragma once
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "QueryFile.h"
+
+namespace batch_runner {
+
+struct QueryOutcome {
+  QueryCase query_case;
+  std::list<std::string> answers;
+  double time_taken_ms = 0;
+};
+
+// writes results in the out.xml format of the autotester, so that its analysis.xsl can render them
+class ResultWriter {
+ public:
+  // returns the number of queries whose answers match their expected answers
+  static int Write(const std::string& filename, double parsing_time_ms, const std::vector<QueryOutcome>& outcomes);
+};
+
+}  // namespace batch_runner
@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "QueryFile.h"
+#include "ResultWriter.h"
+#include "pkb/PKB.h"
+#include "query_processor/QueryProcessor.h"
+#include "query_processor/QueryResultCache.h"
+#include "query_processor/query_evaluator/ClauseResultCache.h"
+#include "query_processor/query_optimizer/QueryPlanCache.h"
+#include "spa.h"
+#include "utils/Arena.h"
+#include "utils/Parallel.h"
+
+namespace {
+
+void PrintUsage() {
+  std::cerr << "Usage: batch_runner [-t <threads>] <source_file> <query_file>... <output_file>\n"
+            << "  Extracts the PKB and evaluates the queries of every query file against it on <threads> worker\n"
+            << "  threads (default: all cores), then writes autotester style results, with per-query timings,\n"
+            << "  to <output_file>\n";
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start_time) {
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  return elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int num_threads = 0;
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-t" && i + 1 < argc) {
+      num_threads = std::atoi(argv[++i]);
+    } else {
+      args.push_back(arg);
+    }
+  }
+  if (args.size() < 3) {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+  // design extraction runs its parallel stages on the same number of threads
+  utils::Parallel::SetDefaultNumThreads(num_threads);
+
+  const std::string& source_file = args.front();
+  const std::string& output_file = args.back();
+  std::vector<batch_runner::QueryOutcome> outcomes;
+  std::vector<std::string> query_strings;
+  std::vector<double> timeouts_ms;
+  try {
+    for (size_t i = 1; i + 1 < args.size(); i++) {
+      for (auto& query_case : batch_runner::QueryFile::Load(args[i])) {
+        batch_runner::QueryOutcome outcome;
+        outcome.query_case = query_case;
+        outcomes.push_back(outcome);
+        query_strings.push_back(query_case.GetQueryString());
+        timeouts_ms.push_back(query_case.timeout_ms);
+      }
+    }
+  } catch (const std::runtime_error& e) {
+    std::cerr << "ERROR! " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream file(source_file);
+  if (!file) {
+    std::cerr << "ERROR! Unable to open SIMPLE source " << source_file << "\n";
+    return EXIT_FAILURE;
+  }
+  std::stringstream sstream;
+  sstream << file.rdbuf();
+
+  PKB pkb;
+  auto parse_start = std::chrono::steady_clock::now();
+  try {
+    SPA::ParseSourceCode(sstream.str(), pkb);
+  } catch (const std::runtime_error& e) {
+    std::cerr << "ERROR! SIMPLE source code is not valid\n"
+              << "       " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  double parsing_time_ms = MillisecondsSince(parse_start);
+  SPA::ConfigureQueries();
+
+  auto evaluation_start = std::chrono::steady_clock::now();
+  std::vector<double> elapsed_ms;
+  query_processor::QueryBatchStatistics batch_statistics;
+  // queries are stopped at their timeout rather than left to run to completion
+  auto results = query_processor::QueryProcessor::ProcessQueries(query_strings, pkb, num_threads, &elapsed_ms,
+                                                                 &batch_statistics, &timeouts_ms);
+  double evaluation_time_ms = MillisecondsSince(evaluation_start);
+
+  for (size_t i = 0; i < outcomes.size(); i++) {
+    outcomes[i].answers = results[i];
+    outcomes[i].time_taken_ms = elapsed_ms[i];
+  }
+
+  int num_passed;
+  try {
+    num_passed = batch_runner::ResultWriter::Write(output_file, parsing_time_ms, outcomes);
+  } catch (const std::runtime_error& e) {
+    std::cerr << "ERROR! " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Evaluated " << outcomes.size() << " queries in " << evaluation_time_ms << " ms ("
+            << (evaluation_time_ms > 0 ? outcomes.size() * 1000.0 / evaluation_time_ms : 0) << " queries/s), "
+            << num_passed << " passed\n";
+  if (batch_statistics.timed_out_queries != 0) {
+    std::cout << batch_statistics.timed_out_queries << " queries timed out\n";
+  }
+  if (batch_statistics.memory_limited_queries != 0) {
+    std::cout << batch_statistics.memory_limited_queries << " queries stopped at the memory limit\n";
+  }
+  std::cout << "Peak intermediate results of a query: " << batch_statistics.peak_query_bytes << " bytes\n";
+  utils::ArenaStatistics arena_statistics = utils::Arena::GetTotalStatistics();
+  std::cout << "Query arenas: " << arena_statistics.allocations << " allocations of " << arena_statistics.bytes
+            << " bytes served from " << arena_statistics.chunk_allocations << " heap allocations over "
+            << arena_statistics.resets << " resets\n";
+  std::cout << "Shared " << batch_statistics.shared_clauses << " clauses between queries, saving "
+            << batch_statistics.clause_evaluations_saved << " clause and " << batch_statistics.query_evaluations_saved
+            << " query evaluations (" << batch_statistics.saved_ms << " ms)\n";
+  query_processor::QueryPlanCacheStatistics plan_cache_statistics = query_processor::QueryPlanCache::GetStatistics();
+  std::cout << "Query plan cache: " << plan_cache_statistics.hits << " hits, " << plan_cache_statistics.misses
+            << " misses, " << plan_cache_statistics.uncacheable << " uncacheable ("
+            << plan_cache_statistics.GetHitRate() * 100 << "% hit rate), " << plan_cache_statistics.size << " plans\n";
+  query_processor::QueryResultCacheStatistics result_cache_statistics = query_processor::QueryResultCache::GetStatistics();
+  std::cout << "Query result cache: " << result_cache_statistics.hits << " hits, " << result_cache_statistics.misses
+            << " misses, " << result_cache_statistics.uncacheable << " uncacheable ("
+            << result_cache_statistics.GetHitRate() * 100 << "% hit rate), " << result_cache_statistics.size
+            << " results in " << result_cache_statistics.bytes << " bytes, " << result_cache_statistics.evictions
+            << " evicted\n";
+  query_processor::ClauseResultCacheStatistics clause_cache_statistics = query_processor::ClauseResultCache::GetStatistics();
+  std::cout << "Clause result cache: " << clause_cache_statistics.hits << " hits, " << clause_cache_statistics.misses
+            << " misses, " << clause_cache_statistics.uncacheable << " uncacheable ("
+            << clause_cache_statistics.GetHitRate() * 100 << "% hit rate), " << clause_cache_statistics.size
+            << " results in " << clause_cache_statistics.bytes << " bytes, " << clause_cache_statistics.evictions
+            << " evicted, " << clause_cache_statistics.saved_ms << " ms saved\n";
+  return EXIT_SUCCESS;
+}
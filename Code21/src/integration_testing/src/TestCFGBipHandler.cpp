@@ -3,7 +3,7 @@
 #include "TestUtils.h"
 #include "catch.hpp"
 #include "design_extractor/DesignExtractor.h"
-#include "design_extractor/handler/StatementHandler.h"
+#include "design_extractor/ExtractionContext.h"
 #include "design_extractor/utils/CFGBipHandler.h"
 #include "design_extractor/utils/CFGHandler.h"
 #include "pkb/PKB.h"
@@ -14,6 +14,9 @@ using namespace design_extractor;
 using namespace source_processor;
 
 SCENARIO("CFGBipHandler can create the proper CFGBip") {
+  ExtractionContext context;
+  context.extension.has_next_bip = true;
+
   GIVEN("A valid source program with a single statement") {
     const auto program =
         "procedure main {\
@@ -24,11 +27,10 @@ SCENARIO("CFGBipHandler can create the proper CFGBip") {
         /* 0 */ {},
         /* 1 */ {}};
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     PKB pkb = PKB();
-    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast);
-    const auto graph = CFGBipHandler::GetCFGBip();
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast, context);
+    const auto& graph = context.cfgbip;
 
     REQUIRE(IsSimilarCFG(graph, correct_graph));
   }
@@ -57,11 +59,10 @@ SCENARIO("CFGBipHandler can create the proper CFGBip") {
         /* 4 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     PKB pkb = PKB();
-    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast);
-    const auto graph = CFGBipHandler::GetCFGBip();
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast, context);
+    const auto& graph = context.cfgbip;
 
     REQUIRE(IsSimilarCFG(graph, correct_graph));
   }
@@ -112,11 +113,10 @@ SCENARIO("CFGBipHandler can create the proper CFGBip") {
         /* 6 */ {},
         /* 7 */ {2, 4, 6}};
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     PKB pkb = PKB();
-    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast);
-    const auto graph = CFGBipHandler::GetCFGBip();
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast, context);
+    const auto& graph = context.cfgbip;
 
     REQUIRE(IsSimilarCFG(graph, correct_graph));
   }
@@ -211,12 +211,59 @@ SCENARIO("CFGBipHandler can create the proper CFGBip") {
         /* 15 */ {4},
         /* 16 */ {4}};
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     PKB pkb = PKB();
-    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast);
-    const auto graph = CFGBipHandler::GetCFGBip();
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast, context);
+    const auto& graph = context.cfgbip;
 
     REQUIRE(IsSimilarCFG(graph, correct_graph));
   }
-}
\ No newline at end of file
+}
+SCENARIO("CFGBipHandler collapses CFGBip into basic blocks that only join at calls and exits") {
+  ExtractionContext context;
+  context.extension.has_next_bip = true;
+
+  GIVEN("A program where a call splits a run of statements") {
+    const auto program =
+        "\
+      procedure A {\
+        x = 1;\
+        call B;\
+        y = x;\
+        print y;\
+      }\
+      procedure B {\
+        z = 2;\
+        print z;\
+      }";
+
+    const auto ast = Parser::Parse(program);
+    PKB pkb = PKB();
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, ast, context);
+    const auto& blocks = context.block_cfgbip;
+    auto to_vector = [](NodeRange range) { return std::vector<int>(range.begin(), range.end()); };
+
+    std::vector<std::vector<int>> correct_stmts = {{0}, {1, 2}, {3, 4}, {5, 6}};
+    CFG correct_successors = {
+        /* 0 */ {},
+        /* 1 */ {3},
+        /* 2 */ {},
+        /* 3 */ {2},
+    };
+
+    REQUIRE(blocks.CountBlocks() == correct_stmts.size());
+    for (int block = 0; block < blocks.CountBlocks(); block++) {
+      REQUIRE(to_vector(blocks.GetStatements(block)) == correct_stmts[block]);
+      REQUIRE(to_vector(blocks.GetSuccessors(block)) == correct_successors[block]);
+    }
+
+    // NextBip* is expanded from blocks back to stmts
+    REQUIRE(pkb.IsNextBipT(1, 6));
+    REQUIRE(pkb.IsNextBipT(2, 4));
+    REQUIRE(pkb.IsNextBipT(5, 3));
+    REQUIRE(pkb.IsNextBipT(6, 4));
+    REQUIRE_FALSE(pkb.IsNextBipT(2, 1));
+    REQUIRE_FALSE(pkb.IsNextBipT(4, 3));
+    REQUIRE_FALSE(pkb.IsNextBipT(3, 5));
+  }
+}
@@ -2,7 +2,7 @@
 
 #include "TestUtils.h"
 #include "catch.hpp"
-#include "design_extractor/handler/StatementHandler.h"
+#include "design_extractor/utils/BlockCFG.h"
 #include "design_extractor/utils/CFGHandler.h"
 #include "pkb/PKB.h"
 #include "source_processor/Parser.h"
@@ -23,7 +23,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 1 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -47,7 +46,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 4 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -85,7 +83,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 9 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -129,7 +126,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 12 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -155,7 +151,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 4 */ {3},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -207,7 +202,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 7 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -285,7 +279,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 15 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -327,7 +320,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 5 */ {4},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -404,7 +396,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 12 */ {1},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -496,7 +487,6 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 17 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
@@ -575,10 +565,57 @@ SCENARIO("CFGHandler can create the proper CFG") {
         /* 13 */ {},
     };
 
-    StatementHandler::ResetMaxStmtNum();
     const auto ast = Parser::Parse(program);
     const auto graph = CFGHandler::ConstructCFG(ast);
 
     REQUIRE(IsSimilarCFG(graph, correct_graph));
   }
-}
\ No newline at end of file
+}
+SCENARIO("CFGHandler collapses straight-line statements into basic blocks") {
+  GIVEN("A valid source program with runs of statements around containers") {
+    const auto program =
+        "procedure main {\
+          read x;\
+          print x;\
+          while (x > 0) {\
+            x = x - 1;\
+            y = x;\
+          }\
+          if (x == 0) then {\
+            z = 1;\
+          } else {\
+            z = 2;\
+            z = 3;\
+          }\
+          print z;\
+          print y;\
+        }";
+
+    const auto ast = Parser::Parse(program);
+    const BlockCFG blocks(CFGHandler::ConstructCFG(ast));
+    auto to_vector = [](NodeRange range) { return std::vector<int>(range.begin(), range.end()); };
+
+    // blocks are numbered by their first stmt#; block 0 only holds node 0
+    std::vector<std::vector<int>> correct_stmts = {{0}, {1, 2}, {3}, {4, 5}, {6}, {7}, {8, 9}, {10, 11}};
+    CFG correct_successors = {
+        /* 0 */ {},
+        /* 1 */ {2},
+        /* 2 */ {4, 3},
+        /* 3 */ {2},
+        /* 4 */ {5, 6},
+        /* 5 */ {7},
+        /* 6 */ {7},
+        /* 7 */ {},
+    };
+
+    REQUIRE(blocks.CountBlocks() == correct_stmts.size());
+    for (int block = 0; block < blocks.CountBlocks(); block++) {
+      REQUIRE(to_vector(blocks.GetStatements(block)) == correct_stmts[block]);
+      REQUIRE(to_vector(blocks.GetSuccessors(block)) == correct_successors[block]);
+      for (int offset = 0; offset < correct_stmts[block].size(); offset++) {
+        REQUIRE(blocks.GetPosition(correct_stmts[block][offset]).block == block);
+        REQUIRE(blocks.GetPosition(correct_stmts[block][offset]).offset == offset);
+      }
+    }
+  }
+}
@@ -0,0 +1,262 @@
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "catch.hpp"
+#include "design_extractor/DesignExtractor.h"
+#include "design_extractor/ExtractionContext.h"
+#include "pkb/PKB.h"
+#include "query_processor/QueryProcessor.h"
+#include "query_processor/QueryResultCache.h"
+#include "query_processor/query_evaluator/ClauseResultCache.h"
+#include "source_processor/Parser.h"
+#include "source_processor/ast/TNode.h"
+#include "utils/Parallel.h"
+
+using namespace std;
+
+namespace {
+
+const string kFirstProgram =
+    "procedure main {"
+    "  read x;"
+    "  while (x > 0) {"
+    "    y = x * 2;"
+    "    call helper;"
+    "    x = x - 1; }"
+    "  print y; }"
+    "procedure helper {"
+    "  if (y > 10) then {"
+    "    z = y; } else {"
+    "    z = 0; }"
+    "  print z; }";
+
+const string kSecondProgram =
+    "procedure alpha {"
+    "  a = 1;"
+    "  b = a + 1;"
+    "  c = b + a;"
+    "  call beta; }"
+    "procedure beta {"
+    "  while (c < 100) {"
+    "    c = c * b; }"
+    "  print c; }";
+
+const vector<string> kQueries = {
+    "stmt s; Select s",
+    "variable v; Select v such that Modifies(\"main\", v)",
+    "stmt s1, s2; Select <s1, s2> such that Next*(s1, s2)",
+    "assign a1, a2; Select <a1, a2> such that Affects*(a1, a2)",
+    "procedure p, q; Select <p, q> such that Calls*(p, q)",
+    "stmt s; Select BOOLEAN such that Parent*(s, _)",
+};
+
+const string kCallChainProgram =
+    "procedure outer {"
+    "  a = 1;"
+    "  call middle;"
+    "  b = a + c;"
+    "  call middle;"
+    "  print b; }"
+    "procedure middle {"
+    "  while (a < 10) {"
+    "    c = a * 2;"
+    "    call inner;"
+    "    a = c + 1; } }"
+    "procedure inner {"
+    "  if (c > 5) then {"
+    "    c = c - a; } else {"
+    "    read a; } }";
+
+// NextBip*, AffectsBip and AffectsBip* of every stmt, extracted on the given number of threads
+vector<unordered_set<int>> ExtractExtensionRelations(const string& source, int num_threads) {
+  design_extractor::ExtractionContext context;
+  context.extension.has_next_bip = true;
+  context.extension.has_affects_bip = true;
+  utils::Parallel::SetDefaultNumThreads(num_threads);
+  PKB pkb;
+  design_extractor::DesignExtractor::ExtractDesigns(pkb, source_processor::Parser::Parse(source), context);
+  utils::Parallel::SetDefaultNumThreads(0);
+
+  vector<unordered_set<int>> relations;
+  for (int stmt = 1; stmt <= pkb.GetAllStmts().size(); stmt++) {
+    relations.push_back(pkb.GetNextBipTStatements(stmt));
+    relations.push_back(pkb.GetAffectedBipStatements(stmt));
+    relations.push_back(pkb.GetAffectedBipTStatements(stmt));
+  }
+  return relations;
+}
+
+vector<list<string>> AnalyseProgram(const string& source) {
+  PKB pkb;
+  design_extractor::DesignExtractor::ExtractDesigns(pkb, source_processor::Parser::Parse(source));
+
+  vector<list<string>> results;
+  for (auto query : kQueries) {
+    auto result = query_processor::QueryProcessor::ProcessQuery(query, pkb);
+    result.sort();
+    results.push_back(result);
+  }
+  return results;
+}
+
+}  // namespace
+
+SCENARIO("Independent programs can be analysed concurrently on separate threads") {
+  GIVEN("Two SIMPLE programs and the results of analysing each on its own") {
+    const vector<string> programs = {kFirstProgram, kSecondProgram};
+    vector<vector<list<string>>> expected;
+    for (auto& program : programs) {
+      expected.push_back(AnalyseProgram(program));
+    }
+    REQUIRE(expected[0] != expected[1]);
+
+    WHEN("Both programs are parsed, extracted and queried by several threads at once") {
+      const int kNumThreads = 8;
+      vector<vector<list<string>>> actual(kNumThreads);
+      vector<thread> workers;
+      for (int i = 0; i < kNumThreads; i++) {
+        workers.emplace_back([&programs, &actual, i]() {
+          for (int round = 0; round < 5; round++) {
+            actual[i] = AnalyseProgram(programs[i % programs.size()]);
+          }
+        });
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+
+      THEN("Every thread sees exactly the results of its own program") {
+        for (int i = 0; i < kNumThreads; i++) {
+          REQUIRE(actual[i] == expected[i % programs.size()]);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A batch of queries is evaluated concurrently against one frozen PKB") {
+  GIVEN("The PKB of a SIMPLE program and the results of evaluating each query on its own") {
+    PKB pkb;
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, source_processor::Parser::Parse(kFirstProgram));
+
+    vector<string> batch;
+    for (int round = 0; round < 10; round++) {
+      batch.insert(batch.end(), kQueries.begin(), kQueries.end());
+    }
+    batch.push_back("stmt s; Select s such that Follows(s, ");
+    batch.push_back("stmt s; Select BOOLEAN such that Follows(s, v)");
+
+    vector<list<string>> expected;
+    for (auto query : kQueries) {
+      expected.push_back(query_processor::QueryProcessor::ProcessQuery(query, pkb));
+    }
+
+    WHEN("The PKB has not been frozen") {
+      THEN("The batch is rejected") {
+        REQUIRE_THROWS_AS(query_processor::QueryProcessor::ProcessQueries(batch, pkb, 4), runtime_error);
+      }
+    }
+
+    WHEN("The frozen PKB is queried by a pool of threads") {
+      pkb.Freeze();
+      auto results = query_processor::QueryProcessor::ProcessQueries(batch, pkb, 4);
+
+      THEN("Every result matches its query, in batch order") {
+        REQUIRE(results.size() == batch.size());
+        for (size_t i = 0; i < kQueries.size() * 10; i++) {
+          REQUIRE(results[i] == expected[i % kQueries.size()]);
+        }
+      }
+
+      THEN("Invalid queries are answered as the autotester expects") {
+        REQUIRE(results[batch.size() - 2].empty());
+        REQUIRE(results[batch.size() - 1] == list<string>{"FALSE"});
+      }
+    }
+  }
+}
+
+SCENARIO("Clauses shared by a batch of queries are evaluated once") {
+  GIVEN("The frozen PKB of a SIMPLE program and queries sharing a clause up to the names of its synonyms") {
+    PKB pkb;
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, source_processor::Parser::Parse(kFirstProgram));
+    vector<string> batch = {"stmt s1, s2; Select s1 such that Next*(s1, s2)",
+                            "stmt s, t; Select t such that Next*(s, t)",
+                            "stmt a, b; variable v; Select v such that Next*(a, b) and Modifies(a, v)",
+                            "assign a; Select a pattern a(\"y\", _)",
+                            "assign a; variable v; Select v pattern a(\"y\", _) such that Uses(a, v)"};
+    vector<list<string>> expected;
+    for (auto query : batch) {
+      expected.push_back(query_processor::QueryProcessor::ProcessQuery(query, pkb));
+    }
+    pkb.Freeze();
+    query_processor::ClauseResultCache::Clear();
+    query_processor::QueryResultCache::Clear();
+
+    WHEN("The batch is evaluated") {
+      query_processor::QueryBatchStatistics statistics;
+      auto results = query_processor::QueryProcessor::ProcessQueries(batch, pkb, 4, nullptr, &statistics);
+
+      THEN("Every query reuses the shared results it is not restricted in, and the results are unchanged") {
+        // Next*(a, b) is evaluated after Modifies(a, v), which restricts it
+        REQUIRE(results == expected);
+        REQUIRE(statistics.shared_clauses == 2);
+        REQUIRE(statistics.clause_evaluations_saved == 2);
+        REQUIRE(statistics.query_evaluations_saved == 0);
+      }
+    }
+    query_processor::ClauseResultCache::Clear();
+    query_processor::QueryResultCache::Clear();
+  }
+}
+
+SCENARIO("Interprocedural extensions are extracted on a pool of threads") {
+  GIVEN("A program whose procedures call each other") {
+    auto expected = ExtractExtensionRelations(kCallChainProgram, 1);
+    REQUIRE(expected[0].size() > 0);
+
+    WHEN("The extensions are extracted on several threads") {
+      auto actual = ExtractExtensionRelations(kCallChainProgram, 4);
+
+      THEN("Every relation is the same as on a single thread") {
+        REQUIRE(actual == expected);
+      }
+    }
+  }
+}
+
+SCENARIO("Programs analysed at the same time may each turn on different extensions") {
+  GIVEN("One program analysed with the NextBip extension and one without") {
+    const string next_bip_query = "stmt s; Select s such that NextBip(2, s)";
+    vector<list<string>> results(2);
+    vector<int> is_rejected(2, false);
+    vector<thread> workers;
+    for (int i = 0; i < 2; i++) {
+      workers.emplace_back([&next_bip_query, &results, &is_rejected, i]() {
+        design_extractor::ExtractionContext context;
+        context.extension.has_next_bip = i == 0;
+        PKB pkb;
+        design_extractor::DesignExtractor::ExtractDesigns(pkb, source_processor::Parser::Parse(kCallChainProgram), context);
+        pkb.Freeze();
+        try {
+          results[i] = query_processor::QueryProcessor::ProcessQuery(next_bip_query, pkb);
+        } catch (std::runtime_error&) {
+          is_rejected[i] = true;
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    THEN("Only the program with the extension answers NextBip") {
+      REQUIRE_FALSE(is_rejected[0]);
+      REQUIRE(results[0] == list<string>{"6"});
+      REQUIRE(is_rejected[1]);
+    }
+  }
+}
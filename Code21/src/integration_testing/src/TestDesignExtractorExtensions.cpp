@@ -3,13 +3,14 @@
 #include "TestUtils.h"
 #include "catch.hpp"
 #include "design_extractor/DesignExtractor.h"
+#include "design_extractor/ExtractionContext.h"
 #include "pkb/PKB.h"
 #include "source_processor/Parser.h"
 #include "source_processor/ast/TNode.h"
-#include "utils/Extension.h"
 
 SCENARIO("Test NextBip / NextBip*") {
-  utils::Extension::HasNextBip = true;
+  design_extractor::ExtractionContext context;
+  context.extension.has_next_bip = true;
 
   GIVEN("A program with a linear call hierarchy") {
     /* NUMBERED PROGRAM STRING
@@ -46,7 +47,7 @@ SCENARIO("Test NextBip / NextBip*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with NextBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetNextBipStatements(1), {2}));
@@ -105,7 +106,7 @@ SCENARIO("Test NextBip / NextBip*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with NextBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetNextBipStatements(1), {7}));
@@ -160,7 +161,7 @@ SCENARIO("Test NextBip / NextBip*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with NextBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetNextBipStatements(1), {4}));
@@ -229,7 +230,7 @@ SCENARIO("Test NextBip / NextBip*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with NextBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetNextBipStatements(1), {2}));
@@ -316,7 +317,7 @@ SCENARIO("Test NextBip / NextBip*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with NextBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetNextBipStatements(1), {7}));
@@ -345,10 +346,54 @@ SCENARIO("Test NextBip / NextBip*") {
       }
     }
   }
+
+  GIVEN("A program where the same procedure is called twice in a row") {
+    /* NUMBERED PROGRAM STRING
+    procedure A {
+      call B;         //1
+      read d;         //2
+      call B;         //3
+      e = b + a;      //4
+    }
+    procedure B {
+      b = b + 2;      //5
+      b = e + 2;      //6
+    }
+    */
+    const std::string test_program =
+        "\
+      procedure A {\
+        call B;\
+        read d;\
+        call B;\
+        e = b + a;\
+      }\
+      procedure B {\
+        b = b + 2;\
+        b = e + 2;\
+      }";
+
+    source_processor::TNode root = source_processor::Parser::Parse(test_program);
+
+    WHEN("Design extractor extracts all designs") {
+      PKB pkb = PKB();
+      pkb.ClearAllTables();
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
+
+      THEN("NextBipT holds along paths longer than the number of statements") {
+        // 1 -> 5 -> 6 -> 2 -> 3 -> 5 -> 6 -> 4 takes 7 hops through 6 statements
+        REQUIRE(ContainsExactly<int>(pkb.GetNextBipTStatements(1), {2, 3, 4, 5, 6}));
+        REQUIRE(ContainsExactly<int>(pkb.GetNextBipTStatements(3), {4, 5, 6}));
+        REQUIRE(ContainsExactly<int>(pkb.GetNextBipTStatements(5), {2, 3, 4, 5, 6}));
+        REQUIRE(ContainsExactly<int>(pkb.GetNextBipTStatements(4), {}));
+      }
+    }
+  }
 }
 
 SCENARIO("Test AffectsBip/*") {
-  utils::Extension::HasAffectsBip = true;
+  design_extractor::ExtractionContext context;
+  context.extension.has_affects_bip = true;
 
   GIVEN("Procedures with single call hierarchy") {
     /* NUMBERED PROGRAM STRING
@@ -399,7 +444,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipStatements(1), {6, 10, 11, 8, 3}));
@@ -419,7 +464,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBipT relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipTStatements(1), {6, 5, 10, 11, 8, 3}));
@@ -508,7 +553,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipStatements(1), {6, 10, 11, 8, 3, 5}));
@@ -528,7 +573,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBipT relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipTStatements(1), {6, 10, 11, 8, 3, 5}));
@@ -579,7 +624,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipStatements(1), {}));
@@ -595,7 +640,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBipT relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipTStatements(1), {}));
@@ -654,7 +699,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipStatements(1), {}));
@@ -672,7 +717,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBipT relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipTStatements(1), {}));
@@ -778,7 +823,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
       THEN("PKB gets populated with AffectsBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipStatements(1), {}));
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipStatements(2), {}));
@@ -809,7 +854,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
       THEN("PKB gets populated with AffectsBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipTStatements(1), {}));
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipTStatements(2), {}));
@@ -930,7 +975,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBip relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipStatements(1), {}));
@@ -955,7 +1000,7 @@ SCENARIO("Test AffectsBip/*") {
     WHEN("Design extractor extracts all designs") {
       PKB pkb = PKB();
       pkb.ClearAllTables();
-      design_extractor::DesignExtractor::ExtractDesigns(pkb, root);
+      design_extractor::DesignExtractor::ExtractDesigns(pkb, root, context);
 
       THEN("PKB gets populated with AffectsBipT relation properly") {
         REQUIRE(ContainsExactly<int>(pkb.GetAffectedBipTStatements(1), {}));
@@ -977,4 +1022,70 @@ SCENARIO("Test AffectsBip/*") {
       }
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("Transitive relations of large programs are answered from reachability indexes") {
+  design_extractor::ExtractionContext context;
+  context.extension.has_next_bip = true;
+
+  GIVEN("A program with a loop that calls a procedure twice") {
+    const std::string test_program =
+        "\
+      procedure outer {\
+        a = 1;\
+        call middle;\
+        b = a + c;\
+        call middle;\
+        print b;\
+      }\
+      procedure middle {\
+        while (a < 10) {\
+          c = a * 2;\
+          call inner;\
+          a = c + 1;\
+        }\
+      }\
+      procedure inner {\
+        if (c > 5) then {\
+          c = c - a;\
+        } else {\
+          read a;\
+        }\
+      }";
+
+    source_processor::TNode root = source_processor::Parser::Parse(test_program);
+
+    WHEN("Design extractor extracts all designs with and without materialising transitive relations") {
+      PKB materialised_pkb = PKB();
+      design_extractor::DesignExtractor::ExtractDesigns(materialised_pkb, root, context);
+      PKB indexed_pkb = PKB();
+      indexed_pkb.SetMaxMaterialisedStatements(0);
+      design_extractor::DesignExtractor::ExtractDesigns(indexed_pkb, root, context);
+
+      THEN("Next*, NextBip* and Affects* are answered from indexes and agree with the materialised relations") {
+        REQUIRE(materialised_pkb.IsNextTMaterialised());
+        REQUIRE(materialised_pkb.IsNextBipTMaterialised());
+        REQUIRE(materialised_pkb.IsAffectsTMaterialised());
+        REQUIRE_FALSE(indexed_pkb.IsNextTMaterialised());
+        REQUIRE_FALSE(indexed_pkb.IsNextBipTMaterialised());
+        REQUIRE_FALSE(indexed_pkb.IsAffectsTMaterialised());
+
+        for (int stmt = 1; stmt <= 13; ++stmt) {
+          REQUIRE(indexed_pkb.GetNextTStatements(stmt) == materialised_pkb.GetNextTStatements(stmt));
+          REQUIRE(indexed_pkb.GetNextBipTStatements(stmt) == materialised_pkb.GetNextBipTStatements(stmt));
+          REQUIRE(indexed_pkb.GetPreviousBipTStatements(stmt) == materialised_pkb.GetPreviousBipTStatements(stmt));
+          REQUIRE(indexed_pkb.GetAffectedTStatements(stmt) == materialised_pkb.GetAffectedTStatements(stmt));
+          REQUIRE(indexed_pkb.GetStatementsThatAffectsT(stmt) == materialised_pkb.GetStatementsThatAffectsT(stmt));
+          for (int other_stmt = 1; other_stmt <= 13; ++other_stmt) {
+            REQUIRE(indexed_pkb.IsNextT(stmt, other_stmt) == materialised_pkb.IsNextT(stmt, other_stmt));
+            REQUIRE(indexed_pkb.IsNextBipT(stmt, other_stmt) == materialised_pkb.IsNextBipT(stmt, other_stmt));
+            REQUIRE(indexed_pkb.IsAffectsT(stmt, other_stmt) == materialised_pkb.IsAffectsT(stmt, other_stmt));
+          }
+        }
+        REQUIRE(indexed_pkb.GetAllNextBipTStatements() == materialised_pkb.GetAllNextBipTStatements());
+        REQUIRE(indexed_pkb.GetAllPreviousBipTStatements() == materialised_pkb.GetAllPreviousBipTStatements());
+        REQUIRE(indexed_pkb.GetAllAffectedTStatements() == materialised_pkb.GetAllAffectedTStatements());
+        REQUIRE(indexed_pkb.GetAllStatementsThatAffectsT() == materialised_pkb.GetAllStatementsThatAffectsT());
+      }
+    }
+  }
+}
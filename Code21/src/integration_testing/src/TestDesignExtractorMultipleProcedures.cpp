@@ -4,6 +4,7 @@
 #include "TestUtils.h"
 #include "catch.hpp"
 #include "design_extractor/DesignExtractor.h"
+#include "design_extractor/handler/NextHandler.h"
 #include "pkb/PKB.h"
 #include "source_processor/Parser.h"
 #include "source_processor/ast/TNode.h"
@@ -698,6 +699,20 @@ SCENARIO("Test population of PKB with code 4 from CS3203 Wiki") {
         REQUIRE(ContainsExactly<int>(pkb.GetNextTStatements(22), {23}));
         REQUIRE(ContainsExactly<int>(pkb.GetNextTStatements(23), {}));
       }
+
+      THEN("NextT derived from the stmt labels agrees with the materialised relations") {
+        PKB labelled_pkb = PKB();
+        design_extractor::NextHandler::ExtractNextTLabels(labelled_pkb, root);
+        for (int stmt = 1; stmt <= 23; ++stmt) {
+          REQUIRE(labelled_pkb.GetNextTStatements(stmt) == pkb.GetNextTStatements(stmt));
+          REQUIRE(labelled_pkb.GetPreviousTStatements(stmt) == pkb.GetPreviousTStatements(stmt));
+          for (int other_stmt = 1; other_stmt <= 23; ++other_stmt) {
+            REQUIRE(labelled_pkb.IsNextT(stmt, other_stmt) == pkb.IsNextT(stmt, other_stmt));
+          }
+        }
+        REQUIRE(labelled_pkb.GetAllNextTStatements() == pkb.GetAllNextTStatements());
+        REQUIRE(labelled_pkb.GetAllPreviousTStatements() == pkb.GetAllPreviousTStatements());
+      }
     }
   }
 }
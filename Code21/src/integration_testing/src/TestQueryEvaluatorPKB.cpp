@@ -6,6 +6,7 @@
 #include "query_processor/commons/query/Query.h"
 #include "query_processor/commons/query/clause/SuchThatClause.h"
 #include "query_processor/commons/query/entities/DesignEntity.h"
+#include "query_processor/query_evaluator/ClauseResultCache.h"
 #include "query_processor/query_evaluator/QueryEvaluator.h"
 #include "source_processor/token/TokenList.h"
 
@@ -999,6 +1000,30 @@ SCENARIO("Test Next/*  and NextBip/* queries") {
         REQUIRE(Contains(test_result.statement_indexes_or_constants, 5));
       }
     }
+
+    WHEN("Next*(DE, DE) is evaluated on a frozen PKB, whose Next* rows are compressed") {
+      PKB frozen_pkb_code_4 = BuildPKBSampleProgram();
+      frozen_pkb_code_4.Freeze();
+      Query valid_query = Query(SelectedEntity(DesignEntity(DesignEntityType::PROG_LINE, "n1")));
+      SuchThatClause next_clause = SuchThatClause(DesignAbstraction::NEXT_T,
+                                                  ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")),
+                                                  ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n1")));
+      SuchThatClause parent_clause = SuchThatClause(DesignAbstraction::PARENT,
+                                                    ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
+                                                    ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")));
+      valid_query.AddClause(next_clause);
+      valid_query.AddClause(parent_clause);
+      QueryResult frozen_result = QueryEvaluator::EvaluateQuery(valid_query, &frozen_pkb_code_4, false);
+      QueryResult test_result = QueryEvaluator::EvaluateQuery(valid_query, &pkb_code_4, false);
+      THEN("Select n1 such that Next*(n, n1) such that Parent(w, n) returns the same result as before freezing") {
+        REQUIRE(frozen_pkb_code_4.GetNextTRow(14) != nullptr);
+        REQUIRE_FALSE(frozen_result.statement_indexes_or_constants.empty());
+        REQUIRE(frozen_result.statement_indexes_or_constants.size() == test_result.statement_indexes_or_constants.size());
+        for (auto stmt : test_result.statement_indexes_or_constants) {
+          REQUIRE(Contains(frozen_result.statement_indexes_or_constants, stmt));
+        }
+      }
+    }
   }
 }
 
@@ -1947,3 +1972,97 @@ SCENARIO("Test select queries without clauses", "[query]") {
     }
   }
 }
+
+SCENARIO("Test such that clauses shared between queries are evaluated once against a frozen PKB") {
+  GIVEN("PKB built from Sample Program 4 given in SPA requirements") {
+    PKB pkb_code_4 = BuildPKBSampleProgram();
+    PKB frozen_pkb_code_4 = BuildPKBSampleProgram();
+    frozen_pkb_code_4.Freeze();
+    ClauseResultCache::Clear();
+    SuchThatClause affects_clause = SuchThatClause(DesignAbstraction::AFFECTS_T,
+                                                   ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a1")),
+                                                   ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a2")));
+    SuchThatClause renamed_affects_clause = SuchThatClause(DesignAbstraction::AFFECTS_T,
+                                                           ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "x")),
+                                                           ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "y")));
+    SuchThatClause same_line_clause = SuchThatClause(DesignAbstraction::NEXT_T,
+                                                     ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")),
+                                                     ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")));
+    SuchThatClause other_lines_clause = SuchThatClause(DesignAbstraction::NEXT_T,
+                                                       ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n1")),
+                                                       ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n2")));
+
+    WHEN("Queries share a clause up to the names of its synonyms") {
+      Query first_query = Query(SelectedEntity(DesignEntity(DesignEntityType::ASSIGN, "a1")));
+      first_query.AddClause(Clause(affects_clause));
+      Query second_query = Query(SelectedEntity(DesignEntity(DesignEntityType::ASSIGN, "y")));
+      second_query.AddClause(Clause(renamed_affects_clause));
+      QueryResult first_result = QueryEvaluator::EvaluateQuery(first_query, &frozen_pkb_code_4, false);
+      QueryResult second_result = QueryEvaluator::EvaluateQuery(second_query, &frozen_pkb_code_4, false);
+      THEN("The second query reuses the pairs of the first, projected onto its own synonyms") {
+        ClauseResultCacheStatistics statistics = ClauseResultCache::GetStatistics();
+        REQUIRE(statistics.hits == 1);
+        REQUIRE(statistics.misses == 1);
+        REQUIRE(statistics.size == 1);
+        REQUIRE(first_result.statement_indexes_or_constants ==
+                QueryEvaluator::EvaluateQuery(first_query, &pkb_code_4, false).statement_indexes_or_constants);
+        REQUIRE(second_result.statement_indexes_or_constants ==
+                QueryEvaluator::EvaluateQuery(second_query, &pkb_code_4, false).statement_indexes_or_constants);
+      }
+    }
+
+    WHEN("Clauses only differ in whether their synonyms are the same") {
+      Query same_line_query = Query(SelectedEntity(DesignEntity(DesignEntityType::PROG_LINE, "n")));
+      same_line_query.AddClause(Clause(same_line_clause));
+      Query other_lines_query = Query(SelectedEntity(DesignEntity(DesignEntityType::PROG_LINE, "n1")));
+      other_lines_query.AddClause(Clause(other_lines_clause));
+      QueryResult same_line_result = QueryEvaluator::EvaluateQuery(same_line_query, &frozen_pkb_code_4, false);
+      QueryResult other_lines_result = QueryEvaluator::EvaluateQuery(other_lines_query, &frozen_pkb_code_4, false);
+      THEN("They are cached apart") {
+        ClauseResultCacheStatistics statistics = ClauseResultCache::GetStatistics();
+        REQUIRE(statistics.hits == 0);
+        REQUIRE(statistics.misses == 2);
+        REQUIRE(same_line_result.statement_indexes_or_constants ==
+                QueryEvaluator::EvaluateQuery(same_line_query, &pkb_code_4, false).statement_indexes_or_constants);
+        REQUIRE(other_lines_result.statement_indexes_or_constants ==
+                QueryEvaluator::EvaluateQuery(other_lines_query, &pkb_code_4, false).statement_indexes_or_constants);
+      }
+    }
+
+    WHEN("A clause is restricted by an earlier clause") {
+      Query restricted_query = Query(SelectedEntity(DesignEntity(DesignEntityType::ASSIGN, "a1")));
+      restricted_query.AddClause(Clause(SuchThatClause(DesignAbstraction::MODIFIES,
+                                                       ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a1")),
+                                                       ClauseParam("count"))));
+      restricted_query.AddClause(Clause(affects_clause));
+      QueryResult restricted_result = QueryEvaluator::EvaluateQuery(restricted_query, &frozen_pkb_code_4, false);
+      THEN("It is evaluated without the cache") {
+        REQUIRE_FALSE(restricted_result.statement_indexes_or_constants.empty());
+        ClauseResultCacheStatistics statistics = ClauseResultCache::GetStatistics();
+        REQUIRE(statistics.misses == 1);
+        REQUIRE(statistics.uncacheable == 1);
+        REQUIRE(restricted_result.statement_indexes_or_constants ==
+                QueryEvaluator::EvaluateQuery(restricted_query, &pkb_code_4, false).statement_indexes_or_constants);
+      }
+    }
+
+    WHEN("The cache is bounded to a single result") {
+      ClauseResultCache::SetLimits(1, ClauseResultCache::kDefaultMaxBytes);
+      Query first_query = Query(SelectedEntity(DesignEntity(DesignEntityType::ASSIGN, "a1")));
+      first_query.AddClause(Clause(affects_clause));
+      Query same_line_query = Query(SelectedEntity(DesignEntity(DesignEntityType::PROG_LINE, "n")));
+      same_line_query.AddClause(Clause(same_line_clause));
+      QueryEvaluator::EvaluateQuery(first_query, &frozen_pkb_code_4, false);
+      QueryEvaluator::EvaluateQuery(first_query, &frozen_pkb_code_4, false);
+      QueryEvaluator::EvaluateQuery(same_line_query, &frozen_pkb_code_4, false);
+      THEN("Results are evicted to stay within it") {
+        ClauseResultCacheStatistics statistics = ClauseResultCache::GetStatistics();
+        REQUIRE(statistics.hits == 1);
+        REQUIRE(statistics.evictions == 1);
+        REQUIRE(statistics.size == 1);
+      }
+      ClauseResultCache::SetLimits(ClauseResultCache::kDefaultMaxEntries, ClauseResultCache::kDefaultMaxBytes);
+    }
+    ClauseResultCache::Clear();
+  }
+}
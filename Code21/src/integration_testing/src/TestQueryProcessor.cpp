@@ -1,9 +1,14 @@
+#include <chrono>
+
 #include "BuildPKBUtils.h"
 #include "TestUtils.h"
 #include "catch.hpp"
 #include "pkb/PKB.h"
 #include "query_processor/QueryProcessor.h"
+#include "query_processor/QueryResultCache.h"
 #include "query_processor/commons/query/Query.h"
+#include "query_processor/query_optimizer/QueryPlanCache.h"
+#include "utils/Cancellation.h"
 
 using namespace std;
 using namespace query_processor;
@@ -239,3 +244,174 @@ SCENARIO("Test one such that and one pattern clauase") {
     }
   }
 }
+
+SCENARIO("Test queries of the same shape with different literals") {
+  GIVEN("PKB built from Sample Code 4 from Basic SPA Requirements") {
+    PKB pkb = BuildPKBSampleProgram();
+    QueryPlanCache::Clear();
+    WHEN("The same query shape is evaluated with other literals and synonym names") {
+      string uses_query = "assign a; stmt s; Select s such that Uses(s, \"cenY\") pattern a(_,_)";
+      string uses_x_query = "assign a2;  stmt s2; Select s2 such that Uses(s2, \"x\") pattern a2(_,_)";
+      string follows_query = "stmt s; Select BOOLEAN such that Follows(1, 2)";
+      string not_follows_query = "stmt s; Select BOOLEAN such that Follows(2, 1)";
+      list<string> uses_result = QueryProcessor::ProcessQuery(uses_query, pkb);
+      list<string> uses_x_result = QueryProcessor::ProcessQuery(uses_x_query, pkb);
+      list<string> follows_result = QueryProcessor::ProcessQuery(follows_query, pkb);
+      list<string> not_follows_result = QueryProcessor::ProcessQuery(not_follows_query, pkb);
+      THEN("The second query of each shape reuses the plan of the first, with its own literals") {
+        QueryPlanCacheStatistics statistics = QueryPlanCache::GetStatistics();
+        REQUIRE(statistics.hits == 2);
+        REQUIRE(statistics.misses == 2);
+        REQUIRE(uses_result.size() == 8);
+        REQUIRE(Contains(uses_result, "23"));
+        REQUIRE(uses_x_result.size() == 3);
+        REQUIRE(Contains(uses_x_result, "2"));
+        REQUIRE(Contains(uses_x_result, "14"));
+        REQUIRE(Contains(uses_x_result, "16"));
+        REQUIRE(follows_result == list<string>{"TRUE"});
+        REQUIRE(not_follows_result == list<string>{"FALSE"});
+      }
+    }
+    QueryPlanCache::Clear();
+  }
+}
+
+SCENARIO("Test results of equivalent queries are cached against a frozen PKB") {
+  GIVEN("PKB built from Sample Code 4 from Basic SPA Requirements") {
+    PKB pkb = BuildPKBSampleProgram();
+    QueryResultCache::Clear();
+    string uses_query = "stmt s; assign a; Select s such that Uses(s, \"x\") pattern a(_,_)";
+    string renamed_query = "assign a1; stmt s1; Select s1 such that Uses(s1, \"x\") pattern a1(_, _)";
+    string repeated_query = "assign a1; stmt s1; Select s1 such that Uses(s1, \"x\") and Uses(s1, \"x\") pattern a1(_, _)";
+    string other_query = "stmt s; assign a; Select s such that Modifies(s, \"x\") pattern a(_,_)";
+    WHEN("The PKB is not frozen") {
+      list<string> uses_result = QueryProcessor::ProcessQuery(uses_query, pkb);
+      list<string> renamed_result = QueryProcessor::ProcessQuery(renamed_query, pkb);
+      THEN("No result is cached") {
+        QueryResultCacheStatistics statistics = QueryResultCache::GetStatistics();
+        REQUIRE(statistics.uncacheable == 2);
+        REQUIRE(statistics.size == 0);
+        REQUIRE(uses_result == renamed_result);
+      }
+    }
+    WHEN("Queries that only differ in synonym names, declaration order and repeated clauses are evaluated") {
+      pkb.Freeze();
+      list<string> uses_result = QueryProcessor::ProcessQuery(uses_query, pkb);
+      list<string> renamed_result = QueryProcessor::ProcessQuery(renamed_query, pkb);
+      list<string> repeated_result = QueryProcessor::ProcessQuery(repeated_query, pkb);
+      list<string> other_result = QueryProcessor::ProcessQuery(other_query, pkb);
+      THEN("Only the first of them is evaluated") {
+        QueryResultCacheStatistics statistics = QueryResultCache::GetStatistics();
+        REQUIRE(statistics.hits == 2);
+        REQUIRE(statistics.misses == 2);
+        REQUIRE(statistics.size == 2);
+        REQUIRE(statistics.bytes > 0);
+        REQUIRE(uses_result.size() == 3);
+        REQUIRE(Contains(uses_result, "14"));
+        REQUIRE(renamed_result == uses_result);
+        REQUIRE(repeated_result == uses_result);
+        REQUIRE(other_result != uses_result);
+      }
+      THEN("The results are not reused once the PKB is frozen again") {
+        pkb = BuildPKBSampleProgram();
+        pkb.Freeze();
+        list<string> refrozen_result = QueryProcessor::ProcessQuery(uses_query, pkb);
+        QueryResultCacheStatistics statistics = QueryResultCache::GetStatistics();
+        REQUIRE(statistics.hits == 2);
+        REQUIRE(statistics.misses == 3);
+        REQUIRE(refrozen_result == uses_result);
+      }
+    }
+    QueryResultCache::Clear();
+  }
+}
+
+SCENARIO("Test EXPLAIN and PROFILE report the plan and evaluation of a query") {
+  GIVEN("PKB built from Sample Code 4 from Basic SPA Requirements") {
+    PKB pkb = BuildPKBSampleProgram();
+    string query = "assign a; variable v; stmt s; Select a such that Parent*(s, a) pattern a(v, _\"x\"_)";
+    list<string> query_result = QueryProcessor::ProcessQuery(query, pkb);
+    WHEN("A query is profiled") {
+      list<string> results;
+      string profile = QueryProcessor::ProfileQuery(query, pkb, ProfileMode::PROFILE, results);
+      THEN("It is evaluated, and every clause and merge is reported with its rows, time and PKB probes") {
+        REQUIRE(results == query_result);
+        REQUIRE(profile.find("{\"mode\":\"PROFILE\",") == 0);
+        REQUIRE(profile.find("\"result_rows\":" + to_string(results.size())) != string::npos);
+        REQUIRE(profile.find("\"peak_bytes\":") != string::npos);
+        REQUIRE(profile.find("\"peak_bytes\":0,") == string::npos);
+        REQUIRE(profile.find("\"clause\":\"Parent*(s, a)\",\"strategy\":\"pairwise check\"") != string::npos);
+        REQUIRE(profile.find("\"clause\":\"pattern a(v, _\\\"x\\\"_)\",\"strategy\":\"pattern scan\"") != string::npos);
+        REQUIRE(profile.find("\"actual_rows\":") != string::npos);
+        REQUIRE(profile.find("\"pkb_probes\":0,") == string::npos);
+        REQUIRE(profile.find("\"groups\":[[0,1]]") != string::npos);
+        REQUIRE(profile.find("\"merges\":[{\"strategy\":\"hash join on a\"") != string::npos);
+      }
+    }
+    WHEN("A query is explained") {
+      list<string> results = {"stale"};
+      string profile = QueryProcessor::ProfileQuery(query, pkb, ProfileMode::EXPLAIN, results);
+      THEN("Its plan is reported without evaluating it") {
+        REQUIRE(results.empty());
+        REQUIRE(profile.find("{\"mode\":\"EXPLAIN\",") == 0);
+        REQUIRE(profile.find("\"estimated_rows\":") != string::npos);
+        REQUIRE(profile.find("\"actual_rows\":") == string::npos);
+        REQUIRE(profile.find("\"merges\":") == string::npos);
+        REQUIRE(profile.find("\"merge_strategy\":\"grouped BFS merge from the smallest table\"") != string::npos);
+      }
+    }
+    WHEN("A query is prefixed by PROFILE or EXPLAIN") {
+      list<string> profiled_result = QueryProcessor::ProcessQuery("PROFILE " + query, pkb);
+      list<string> explained_result = QueryProcessor::ProcessQuery("  EXPLAIN\n" + query, pkb);
+      THEN("Only the profiled query returns its results") {
+        REQUIRE(profiled_result == query_result);
+        REQUIRE(explained_result.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("Test queries are stopped at their timeout") {
+  GIVEN("PKB built from Sample Code 4 from Basic SPA Requirements") {
+    PKB pkb = BuildPKBSampleProgram();
+    pkb.Freeze();
+    QueryResultCache::Clear();
+    string cross_query = "assign a; variable v; stmt s; Select <a, v, s>";
+    string boolean_query = "stmt s1, s2; Select BOOLEAN such that Follows*(s1, s2)";
+    WHEN("A query is evaluated past its deadline") {
+      utils::Cancellation::Scope scope(nullptr, utils::Cancellation::Clock::now() - chrono::milliseconds(1));
+      THEN("It unwinds with a TimeoutError, even when it selects a BOOLEAN") {
+        REQUIRE_THROWS_AS(QueryProcessor::ProcessQuery(cross_query, pkb), utils::TimeoutError);
+        REQUIRE_THROWS_AS(QueryProcessor::ProcessQuery(boolean_query, pkb), utils::TimeoutError);
+      }
+    }
+    WHEN("A batch is evaluated with one query given no time") {
+      vector<string> queries = {cross_query, boolean_query};
+      vector<double> timeouts_ms = {1e-6, 0};
+      QueryBatchStatistics statistics;
+      vector<list<string>> results = QueryProcessor::ProcessQueries(queries, pkb, 2, nullptr, &statistics, &timeouts_ms);
+      THEN("Only that query times out, without results") {
+        REQUIRE(statistics.timed_out_queries == 1);
+        REQUIRE(results[0].empty());
+        REQUIRE(results[1] == list<string>{"TRUE"});
+      }
+      THEN("The query is not cached as having no results") {
+        REQUIRE(QueryProcessor::ProcessQuery(cross_query, pkb).size() > 0);
+      }
+    }
+    WHEN("The batch is cancelled by the token of the calling thread") {
+      utils::CancellationToken token;
+      token.Cancel();
+      utils::Cancellation::Scope scope(&token);
+      QueryBatchStatistics statistics;
+      vector<list<string>> results = QueryProcessor::ProcessQueries({cross_query, boolean_query}, pkb, 2, nullptr,
+                                                                    &statistics);
+      THEN("Every query times out") {
+        REQUIRE(statistics.timed_out_queries == 2);
+        REQUIRE(results[0].empty());
+        REQUIRE(results[1].empty());
+      }
+    }
+    QueryResultCache::Clear();
+  }
+}
@@ -2,7 +2,6 @@
 
 #include <list>
 
-#include "graph_explosion/GEHandler.h"
 #include "handler/AffectsBipHandler.h"
 #include "handler/AffectsHandler.h"
 #include "handler/AssignmentHandler.h"
@@ -28,7 +27,6 @@
 #include "source_processor/utils/TypeUtils.h"
 #include "utils/CFGBipHandler.h"
 #include "utils/CFGHandler.h"
-#include "utils/Extension.h"
 
 namespace design_extractor {
 
@@ -66,32 +64,41 @@ void DesignExtractor::BreadthFirstTraversal(PKB& pkb, const source_processor::TN
 }
 
 // call each individual design abstraction extractor function here
-void DesignExtractor::ExtractDesigns(PKB& pkb, const source_processor::TNode& root) {
-  StatementHandler::ExtractStmtNums(pkb, root);            // all stmt numbers in a program only needs to be extracted once
+void DesignExtractor::ExtractDesigns(PKB& pkb, const source_processor::TNode& root, ExtractionContext& context) {
+  int max_stmt_num = StatementHandler::GetMaxStmtNum(root);
+  StatementHandler::ExtractStmtNums(pkb, max_stmt_num);    // all stmt numbers in a program only needs to be extracted once
+  pkb.ReserveTables(max_stmt_num, VariableHandler::CountDistinctVariables(root));  // must be called after StatementHandler::ExtractStmtNums
+  pkb.SetExtension(context.extension);
   ParentHandler::ExtractParentAndParentTStmts(pkb, root);  // parent handler has to be called BEFORE the BreadthFirstTraversal
   ModifiesHandler::ExtractModifiesSWithoutCallsStmts(pkb, root);
-  CFGHandler::ConstructCFG(root);                // must be called after StatementHandler::ExtractStmtNums
-  NextHandler::ExtractNextRelation(pkb, root);   // must be called after CFGHandler::ConstructCFG
-  NextHandler::ExtractNextTRelation(pkb, root);  // must be called after CFGHandler::ConstructCFG
+  context.cfg = CFGHandler::ConstructCFG(root);
+  context.block_cfg = BlockCFG(context.cfg);
+  NextHandler::ExtractNextRelation(pkb, context);   // must be called after CFGHandler::ConstructCFG
+  NextHandler::ExtractNextTRelation(pkb, context);  // must be called after CFGHandler::ConstructCFG
+  NextHandler::ExtractNextTLabels(pkb, root);
 
   BreadthFirstTraversal(pkb, root);
 
   CallHandler::ExtractCallTRelation(pkb, root);                      // ExtractCallTRelation must be called AFTER the CallHandler::ExtractCallRelation in BreadthFirstTraversal
   UsesHandler::ExtractUsesSCallsAndUsesP(pkb, root);                 // must be called AFTER ExtractCallTRelation() and BreadthFirstTraversal
   ModifiesHandler::ExtractModifiesSForCallsAndModifiesP(pkb, root);  // must be called after ModifiesHandler::ExtractModifiesSWithoutCallsStmts AND CallHandler::ExtractCallTRelation
-  AffectsHandler::ExtractAffects(pkb, root);                         // must be called after UsesHandler::ExtractUsesSCallsAndUsesP, ModifiesHandler::ExtractModifiesSForCallsAndModifiesP and CFGHandler::ConstructCFG
+  AffectsHandler::ExtractAffects(pkb, context);                      // must be called after UsesHandler::ExtractUsesSCallsAndUsesP, ModifiesHandler::ExtractModifiesSForCallsAndModifiesP and CFGHandler::ConstructCFG
   AffectsHandler::ExtractAffectsT(pkb, root);
 
   // Extensions:
-  if (utils::Extension::HasNextBip) {
-    CFGBipHandler::ConstructCFGBip(pkb);                           // must be called after CallHandler, NextHandler, CFGHandler, EntityHandler
-    NextBipHandler::ExtractNextBipAndNextBipTRelation(pkb, root);  // must be called after CFGBipHandler
+  if (context.extension.has_next_bip) {
+    CFGBipHandler::ConstructCFGBip(context, pkb);                     // must be called after CallHandler, NextHandler, CFGHandler, EntityHandler
+    NextBipHandler::ExtractNextBipAndNextBipTRelation(pkb, context);  // must be called after CFGBipHandler
   }
-  if (utils::Extension::HasAffectsBip) {
-    GEHandler::ConstructGraphExplosion(pkb, root);     // must be called after CFGHandler and CallHandler
-    AffectsBipHandler::ExtractAffectsBip(pkb, root);   // must be called after ConstructGraphExplosion
-    AffectsBipHandler::ExtractAffectsBipT(pkb, root);  // must be called after ExtractAffectsBip
+  if (context.extension.has_affects_bip) {
+    AffectsBipHandler::ExtractAffectsBip(pkb, context);   // must be called after CFGHandler, CallHandler, UsesHandler and ModifiesHandler
+    AffectsBipHandler::ExtractAffectsBipT(pkb, context);  // must be called after ExtractAffectsBip
   }
 }
 
+void DesignExtractor::ExtractDesigns(PKB& pkb, const source_processor::TNode& root) {
+  ExtractionContext context;
+  ExtractDesigns(pkb, root, context);
+}
+
 };  // namespace design_extractor
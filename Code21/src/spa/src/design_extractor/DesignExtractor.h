@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ExtractionContext.h"
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
 #include "source_processor/ast/TNodeType.h"
@@ -11,7 +12,10 @@ class DesignExtractor {
   static void BreadthFirstTraversal(PKB& pkb, const source_processor::TNode& root);
 
  public:
-  // design extractor entry point
+  // design extractor entry point; extracts the extensions of the context, and keeps all state of the
+  // extraction in it, so separate programs may be extracted concurrently as long as each has its own context
+  static void ExtractDesigns(PKB& pkb, const source_processor::TNode& root, ExtractionContext& context);
+  // extracts the designs of a program without any extensions
   static void ExtractDesigns(PKB& pkb, const source_processor::TNode& root);
 };
 
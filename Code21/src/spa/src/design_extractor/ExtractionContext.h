@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "design_extractor/handler/AffectsBipHandler.h"
+#include "design_extractor/utils/BlockCFG.h"
+#include "design_extractor/utils/CFGHandler.h"
+#include "utils/Extension.h"
+
+namespace design_extractor {
+
+/*
+  The state of extracting the design abstractions of one program. DesignExtractor passes it to every
+  handler that builds on what an earlier handler constructed, so programs extracted at the same time
+  each use their own context, and the worker threads of one extraction only ever read it.
+*/
+struct ExtractionContext {
+  utils::Extension extension;  // the extensions to extract
+  CFG cfg;
+  BlockCFG block_cfg;  // cfg with straight-line runs collapsed into basic blocks
+  CFG cfgbip;
+  // cfgbip collapsed into basic blocks, where procedure entries start a block and call and exit stmts
+  // end one, so that branch ins and branch backs only join whole blocks
+  BlockCFG block_cfgbip;
+  // procedure -> exit stmt#s of the procedure, which include those of callees that end it
+  std::unordered_map<std::string, std::unordered_set<int>> exit_stmts;
+  BipProgram bip_program;  // the program as indexed for AffectsBip and AffectsBip*
+};
+
+}  // namespace design_extractor
@@ -1,131 +1,269 @@
 #include "AffectsBipHandler.h"
 
-#include <iostream>
-#include <map>
-#include <queue>
 #include <stack>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "EntityHandler.h"
-#include "design_extractor/graph_explosion/GEHandler.h"
+#include "design_extractor/ExtractionContext.h"
+#include "design_extractor/utils/CFGBipHandler.h"
 #include "design_extractor/utils/CFGHandler.h"
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
+#include "utils/Cancellation.h"
+#include "utils/Parallel.h"
 
 namespace design_extractor {
 
-AffectsBipGraph AffectsBipHandler::affects_bip_graph;
+/*
+  AffectsBip is an interprocedural reaching definitions problem: the fact carried along a path is the
+  variable whose definition is still live. Every stmt transfers a fact on to its successors unless it
+  writes the variable (gen/kill), and for AffectsBip* an assign that uses the fact also hands it on to
+  the variable it writes, which chains one AffectsBip hop onto the next.
 
-// DFS outward from src, marking all nodes that can be reached
-void AffectsBipHandler::TraverseExplodedGraphFromSrc(GENode* src, PKB& pkb) {
-  std::unordered_set<GENode*> reachable_nodes;
-  std::stack<GENode*> stack;
+  Instead of inlining a copy of a procedure at every call, each procedure gets a summary per fact,
+  i.e. the facts that are live at its exit when the fact is live at its entry. A call then moves its
+  facts to its Next stmt through the summary of the callee (the matched branch back) while also
+  branching in to find the stmts affected inside the callee. Like NextBip*, a path only depends on
+  whether a branch in is still pending:
+    - layer 0 holds the stmts reached with no call pending, where exit stmts may branch back to any
+      caller of their procedure
+    - layer 1 holds the stmts reached inside a pending call, which is only left through the summary
+  A call stmt that is also an exit stmt returns to the callers of its own procedure, so in layer 0 its
+  summary is followed by the branch backs of that procedure.
+  Memory is bounded by the (stmt, layer, fact) states and summaries actually reached, rather than
+  growing exponentially with the depth of calls as inlined copies would.
+  Traversals from different assign stmts are independent, so they run on a pool of threads that
+  share the indexed program and each keep their own summaries and visited states.
+*/
 
-  int src_stmt_num = src->GetStatementNumber();
-  std::string modified_var = pkb.GetAssignedVariable(src_stmt_num);
+void AffectsBipHandler::IndexProgram(BipProgram& program, const CFG& cfg, PKB& pkb) {
+  program = BipProgram();
+  program.cfg = &cfg;
+  int num_nodes = program.cfg->size();  //node 0 is not a stmt, but keeping it makes node ids equal stmt#s
+  auto& stmts = program.stmts;
+  std::unordered_map<std::string, int> var_ids;
+  auto get_var_id = [&var_ids](const std::string& var) {
+    return var_ids.emplace(var, var_ids.size()).first->second;
+  };
+  std::unordered_map<int, std::vector<int>> call_stmts;  //procedure entry stmt# -> call stmt#s that call it
 
-  stack.push(src);
+  stmts.assign(num_nodes, BipStmt());
+  for (auto proc : pkb.GetAllProcedures()) {
+    auto range = pkb.GetProcRange(proc);
+    for (int sn = range.first; sn <= range.second; ++sn) {
+      stmts[sn].proc_entry = range.first;
+      stmts[sn].proc_last = range.second;
+    }
+  }
 
-  while (!stack.empty()) {
-    auto cur = stack.top();
-    stack.pop();
-    bool path_exists = true;
-    int cur_stmt_num = cur->GetStatementNumber();
-
-    // if stmt is reachable
-    if (reachable_nodes.find(cur) != reachable_nodes.end()) {
-      // only insert if it is assign stmt && stmt uses LHS
-      if (pkb.GetAllAssignStmts().find(cur_stmt_num) != pkb.GetAllAssignStmts().end() && (pkb.IsUses(cur_stmt_num, modified_var))) {
-        // populate affectsbip graph
-        affects_bip_graph[src].insert(cur);
-        pkb.InsertAffectsBip(src_stmt_num, cur_stmt_num);
+  for (int sn = 1; sn < num_nodes; ++sn) {
+    auto& stmt = stmts[sn];
+    auto type = pkb.GetStatementType(sn);
+    if (type == EntityHandler::kassign_string) {
+      stmt.is_assign = true;
+      stmt.modified_var = get_var_id(pkb.GetAssignedVariable(sn));
+      for (auto var : pkb.GetUsedVariables(sn)) {
+        stmt.used_vars.insert(get_var_id(var));
       }
-
-      // if stmt (assign/read) modify LHS
-      std::string stmt_type = pkb.GetStatementType(cur_stmt_num);
-      if (stmt_type == EntityHandler::kassign_string || stmt_type == EntityHandler::kread_string) {
-        if (pkb.IsModifies(cur_stmt_num, modified_var)) {
-          path_exists = false;
-        }
+    } else if (type == EntityHandler::kread_string) {
+      for (auto var : pkb.GetModifiedVariables(sn)) {
+        stmt.modified_var = get_var_id(var);
       }
+    } else if (type == EntityHandler::kcall_string) {
+      stmt.callee_entry = pkb.GetProcRange(pkb.GetCallsProcName(sn)).first;
+      call_stmts[stmt.callee_entry].push_back(sn);
     }
+    stmt.is_exit = CFGBipHandler::IsExitStmt(sn, pkb);
+  }
+  program.num_vars = var_ids.size();
 
-    for (auto e : cur->GetChildren()) {
-      if (reachable_nodes.find(e) == reachable_nodes.end() && path_exists == true) {
-        reachable_nodes.insert(e);
-        stack.push(e);
-      }
+  for (int sn = 1; sn < num_nodes; ++sn) {
+    if (stmts[sn].proc_entry == sn) {
+      IndexReturnStmts(program, sn, call_stmts);
     }
   }
 }
 
-void AffectsBipHandler::ExtractAffectsBipForGraph(GENode* root_node, PKB& pkb) {
-  std::unordered_set<GENode*> reachable_nodes;
-  std::queue<GENode*> q;
+// the Next stmts of every call to the procedure, where a call that is an exit stmt passes on the
+// return stmts of its own procedure
+const std::vector<int>& AffectsBipHandler::IndexReturnStmts(
+    BipProgram& program, int entry_sn, std::unordered_map<int, std::vector<int>>& call_stmts) {
+  auto it = program.return_stmts.find(entry_sn);
+  if (it != program.return_stmts.end()) {
+    return it->second;
+  }
 
-  // BFS traverse exploded graph
-  q.push(root_node);
-  while (!q.empty()) {
-    auto cur = q.front();
-    q.pop();
+  const CFG& cfg = *program.cfg;
+  std::unordered_set<int> returns;
+  for (int call_sn : call_stmts[entry_sn]) {
+    const auto& next_sns = cfg[call_sn].empty()
+                               ? IndexReturnStmts(program, program.stmts[call_sn].proc_entry, call_stmts)
+                               : cfg[call_sn];
+    returns.insert(next_sns.begin(), next_sns.end());
+  }
 
-    // if meet assign stmt, send it to TraverseExplodedGraphFromSrc
-    int cur_stmt_num = cur->GetStatementNumber();
-    if (pkb.GetAllAssignStmts().find(cur_stmt_num) != pkb.GetAllAssignStmts().end()) {
-      TraverseExplodedGraphFromSrc(cur, pkb);
+  return program.return_stmts[entry_sn] = std::vector<int>(returns.begin(), returns.end());
+}
+
+// facts that leave the non-call stmt sn when fact reaches it
+std::vector<int> AffectsBipHandler::Transfer(const BipProgram& program, int sn, int fact, bool hand_on) {
+  const auto& stmt = program.stmts[sn];
+  std::vector<int> facts;
+  if (stmt.modified_var != fact) {
+    facts.push_back(fact);
+  }
+  if (hand_on && stmt.is_assign && stmt.used_vars.find(fact) != stmt.used_vars.end()) {
+    facts.push_back(stmt.modified_var);
+  }
+  return facts;
+}
+
+// facts live at the exit of the procedure starting at entry_sn when fact is live at its entry
+const std::vector<int>& AffectsBipHandler::GetSummary(
+    const BipProgram& program, BipTraversal& traversal, int entry_sn, int fact, bool hand_on) {
+  long long key = (static_cast<long long>(entry_sn) << 32) | (fact << 1) | hand_on;
+  auto it = traversal.summaries.find(key);
+  if (it != traversal.summaries.end()) {
+    return it->second;
+  }
+
+  const CFG& cfg = *program.cfg;
+  int num_vars = program.num_vars;
+  std::unordered_set<int> exit_facts;
+  //states are (stmt, fact) pairs within the procedure
+  std::vector<bool> reached((program.stmts[entry_sn].proc_last - entry_sn + 1) * num_vars, false);
+  std::stack<std::pair<int, int>> stack;
+  auto visit = [&reached, &stack, entry_sn, num_vars](int sn, int fact) {
+    int state = (sn - entry_sn) * num_vars + fact;
+    if (!reached[state]) {
+      reached[state] = true;
+      stack.push({sn, fact});
     }
+  };
 
-    for (auto e : cur->GetChildren()) {
-      if (reachable_nodes.find(e) == reachable_nodes.end()) {
-        reachable_nodes.insert(e);
-        q.push(e);
+  visit(entry_sn, fact);
+  while (!stack.empty()) {
+    utils::Cancellation::Check();
+    auto cur = stack.top();
+    stack.pop();
+    const auto& stmt = program.stmts[cur.first];
+    //callees have no calls back into this procedure, so their summaries are never still being computed
+    auto facts = stmt.callee_entry != 0 ? GetSummary(program, traversal, stmt.callee_entry, cur.second, hand_on)
+                                        : Transfer(program, cur.first, cur.second, hand_on);
+    if (stmt.is_exit) {
+      exit_facts.insert(facts.begin(), facts.end());
+    }
+    for (int next_sn : cfg[cur.first]) {
+      for (int next_fact : facts) {
+        visit(next_sn, next_fact);
       }
     }
   }
+
+  return traversal.summaries[key] = std::vector<int>(exit_facts.begin(), exit_facts.end());
 }
 
-void AffectsBipHandler::ExtractAffectsBip(PKB& pkb, const source_processor::TNode& root) {
-  std::vector<GENode*> exploded_graphs = GEHandler::GetGraphExplosion();
-  affects_bip_graph.clear();
+// stmts that the assign stmt src affects, directly or (if hand_on) transitively
+std::unordered_set<int> AffectsBipHandler::GetAffectedStmts(
+    const BipProgram& program, BipTraversal& traversal, int src, bool hand_on) {
+  const CFG& cfg = *program.cfg;
+  const auto& stmts = program.stmts;
+  int num_nodes = stmts.size();
+  int num_vars = program.num_vars;
+  auto& visited = traversal.visited;
+  std::unordered_set<int> affected;
+  std::vector<size_t> reached;
+  std::stack<size_t> stack;  //states are (sn + layer * num_nodes) * num_vars + fact
+  auto visit = [&visited, &reached, &stack, num_nodes, num_vars](int sn, int layer, int fact) {
+    size_t state = (sn + static_cast<size_t>(layer) * num_nodes) * num_vars + fact;
+    if (!visited[state]) {
+      visited[state] = true;
+      reached.push_back(state);
+      stack.push(state);
+    }
+  };
+
+  auto visit_successors = [&](int sn, int layer, const std::vector<int>& facts) {
+    for (int next_fact : facts) {
+      for (int next_sn : cfg[sn]) {
+        visit(next_sn, layer, next_fact);
+      }
+      if (layer == 0 && stmts[sn].is_exit) {
+        for (int next_sn : program.return_stmts.at(stmts[sn].proc_entry)) {
+          visit(next_sn, 0, next_fact);
+        }
+      }
+    }
+  };
+  //src itself is only the definition, so the traversal starts at its successors
+  visit_successors(src, 0, {stmts[src].modified_var});
+
+  while (!stack.empty()) {
+    utils::Cancellation::Check();
+    auto state = stack.top();
+    stack.pop();
+    int node = state / num_vars;
+    int sn = node % num_nodes;
+    int layer = node / num_nodes;
+    int fact = state % num_vars;
+    const auto& stmt = stmts[sn];
+
+    if (stmt.is_assign && stmt.used_vars.find(fact) != stmt.used_vars.end()) {
+      affected.insert(sn);
+    }
+
+    if (stmt.callee_entry == 0) {
+      visit_successors(sn, layer, Transfer(program, sn, fact, hand_on));
+    } else {
+      visit(stmt.callee_entry, 1, fact);
+      visit_successors(sn, layer, GetSummary(program, traversal, stmt.callee_entry, fact, hand_on));
+    }
+  }
 
-  for (auto graph : exploded_graphs) {
-    // extracts and populates affectsbip graph
-    ExtractAffectsBipForGraph(graph, pkb);
+  for (auto state : reached) {
+    visited[state] = false;
   }
+  return affected;
 }
 
-//BFS outward from src, marking all nodes that can be reached and is affected
-std::unordered_set<GENode*> AffectsBipHandler::GetReachableNodes(GENode* src, PKB& pkb) {
-  std::unordered_set<GENode*> reachable_nodes;
-  std::queue<GENode*> q;
+std::vector<std::pair<int, std::unordered_set<int>>> AffectsBipHandler::GetAllAffectedStmts(
+    const BipProgram& program, bool hand_on) {
+  std::vector<std::pair<int, std::unordered_set<int>>> results;
+  for (size_t sn = 1; sn < program.stmts.size(); ++sn) {
+    if (program.stmts[sn].is_assign) {
+      results.push_back({sn, std::unordered_set<int>()});
+    }
+  }
 
-  q.push(src);
+  int num_threads = utils::Parallel::GetDefaultNumThreads();
+  std::vector<BipTraversal> traversals(num_threads);
+  utils::Parallel::For(results.size(), num_threads, [&](size_t i, int worker) {
+    auto& traversal = traversals[worker];
+    if (traversal.visited.empty()) {
+      traversal.visited.assign(2 * program.stmts.size() * program.num_vars, false);
+    }
+    results[i].second = GetAffectedStmts(program, traversal, results[i].first, hand_on);
+  });
 
-  while (!q.empty()) {
-    auto cur = q.front();
-    q.pop();
-    for (auto e : affects_bip_graph[cur]) {
-      int cur_stmt_num = cur->GetStatementNumber();
-      int child_stmt_num = e->GetStatementNumber();
+  return results;
+}
 
-      if (reachable_nodes.find(e) == reachable_nodes.end() && pkb.IsAffectsBip(cur_stmt_num, child_stmt_num)) {
-        reachable_nodes.insert(e);
-        q.push(e);
-      }
-    }
+void AffectsBipHandler::ExtractAffectsBip(PKB& pkb, ExtractionContext& context) {
+  IndexProgram(context.bip_program, context.cfg, pkb);
+  for (const auto& result : GetAllAffectedStmts(context.bip_program, false)) {
+    pkb.InsertAffectsBip(result.first, result.second);
   }
-  return reachable_nodes;
 }
 
-void AffectsBipHandler::ExtractAffectsBipT(PKB& pkb, const source_processor::TNode& root) {
-  // assumes affectsbip graph has been populated by ExtractAffectsBip
-  for (auto src : affects_bip_graph) {
-    auto reachable_nodes = GetReachableNodes(src.first, pkb);
-    int src_stmt_num = src.first->GetStatementNumber();
-    for (auto dest : reachable_nodes) {
-      pkb.InsertAffectsBipT(src_stmt_num, dest->GetStatementNumber());
-    }
+void AffectsBipHandler::ExtractAffectsBipT(PKB& pkb, const ExtractionContext& context) {
+  // assumes the program has been indexed by ExtractAffectsBip
+  for (const auto& result : GetAllAffectedStmts(context.bip_program, true)) {
+    pkb.InsertAffectsBipT(result.first, result.second);
   }
 }
 
-}  // namespace design_extractor
\ No newline at end of file
+}  // namespace design_extractor
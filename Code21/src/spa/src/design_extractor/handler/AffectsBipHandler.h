@@ -1,27 +1,64 @@
 #pragma once
 
-#include <map>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include "design_extractor/graph_explosion/GENode.h"
 #include "design_extractor/utils/CFGHandler.h"
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
 
 namespace design_extractor {
 
-typedef std::map<GENode*, std::unordered_set<GENode*>> AffectsBipGraph;
+// what the AffectsBip analysis needs to know about a stmt; variables are numbered so facts stay ints
+struct BipStmt {
+  bool is_assign = false;
+  bool is_exit = false;
+  int proc_entry = 0;                  // entry stmt# of the procedure containing the stmt
+  int proc_last = 0;                   // last stmt# of the procedure containing the stmt
+  int callee_entry = 0;                // entry stmt# of the called procedure, 0 if not a call stmt
+  int modified_var = -1;               // variable written by an assign or read stmt, -1 if none
+  std::unordered_set<int> used_vars;  // variables read by an assign stmt
+};
+
+// the program as seen by AffectsBip; it is only read once indexed, so all worker threads share it
+struct BipProgram {
+  const CFG* cfg = nullptr;
+  std::vector<BipStmt> stmts;
+  int num_vars = 0;
+  // procedure entry stmt# -> stmt#s it branches back to when no call is pending
+  std::unordered_map<int, std::vector<int>> return_stmts;
+};
+
+// the state of the traversals run by one worker thread
+struct BipTraversal {
+  // (procedure entry stmt#, fact at the entry, whether facts are handed on) -> facts at the exit
+  std::unordered_map<long long, std::vector<int>> summaries;
+  // (stmt, layer, fact) states reached by the running traversal; cleared again when it returns
+  std::vector<bool> visited;
+};
+
+struct ExtractionContext;
 
 class AffectsBipHandler {
  private:
-  static AffectsBipGraph affects_bip_graph;
-  static void ExtractAffectsBipForGraph(GENode* root_node, PKB& pkb);
-  static void TraverseExplodedGraphFromSrc(GENode* src, PKB& pkb);
-  static std::unordered_set<GENode*> GetReachableNodes(GENode* src, PKB& pkb);
+  static void IndexProgram(BipProgram&, const CFG& cfg, PKB& pkb);
+  static const std::vector<int>& IndexReturnStmts(BipProgram&, int entry_sn,
+                                                  std::unordered_map<int, std::vector<int>>& call_stmts);
+  static std::vector<int> Transfer(const BipProgram&, int sn, int fact, bool hand_on);
+  static const std::vector<int>& GetSummary(const BipProgram&, BipTraversal&, int entry_sn, int fact, bool hand_on);
+  static std::unordered_set<int> GetAffectedStmts(const BipProgram&, BipTraversal&, int src, bool hand_on);
+  // runs GetAffectedStmts from every assign stmt on a pool of threads, keeping the result of each
+  // source apart so that they can be inserted into the PKB in one pass once all are done
+  static std::vector<std::pair<int, std::unordered_set<int>>> GetAllAffectedStmts(const BipProgram&, bool hand_on);
 
  public:
-  static void ExtractAffectsBip(PKB& pkb, const source_processor::TNode& root);
-  static void ExtractAffectsBipT(PKB& pkb, const source_processor::TNode& root);
+  // indexes the program into the context, so must be called after CFGHandler, CallHandler, UsesHandler and
+  // ModifiesHandler
+  static void ExtractAffectsBip(PKB& pkb, ExtractionContext& context);
+  static void ExtractAffectsBipT(PKB& pkb, const ExtractionContext& context);
 };
 
-}  // namespace design_extractor
\ No newline at end of file
+}  // namespace design_extractor
@@ -1,33 +1,36 @@
 #include "AffectsHandler.h"
 
+#include <algorithm>
 #include <iostream>
-#include <queue>
 #include <stack>
+#include <utility>
+#include <vector>
 
 #include "EntityHandler.h"
+#include "design_extractor/ExtractionContext.h"
+#include "design_extractor/utils/BlockCFG.h"
 #include "design_extractor/utils/CFGHandler.h"
+#include "design_extractor/utils/CSRGraph.h"
+#include "design_extractor/utils/MultiSourceBFS.h"
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
+#include "utils/Cancellation.h"
 
 namespace design_extractor {
 
-std::unordered_set<int> AffectsHandler::assign_stmts;
-AffectsGraph AffectsHandler::graph;
-
-//DFS outward from src, marking all nodes that can be reached
-void AffectsHandler::TraverseCFGFromSource(int src, std::string& modified_var, const CFG& cfg, PKB& pkb) {
-  std::unordered_set<int> reachable_nodes;
+//DFS outward from src over the basic blocks of the CFG. A block is scanned from its first stmt
+//(or from the stmt after src in the block of src) until a stmt modifies the LHS of src; only blocks
+//scanned to the end pass the definition on to their successors
+void AffectsHandler::TraverseCFGFromSource(int src, std::string& modified_var, const BlockCFG& blocks,
+                                           const std::unordered_set<int>& assign_stmts, PKB& pkb) {
+  std::vector<bool> reachable_blocks(blocks.CountBlocks(), false);
   std::stack<int> stack;
 
-  stack.push(src);
-
-  while (!stack.empty()) {
-    auto cur = stack.top();
-    stack.pop();
-    bool path_exists = true;
-
-    // if stmt is reachable
-    if (reachable_nodes.find(cur) != reachable_nodes.end()) {
+  // returns whether the definition of src is still live after the last stmt of block
+  auto scan_block = [&](int block, int first_offset) {
+    auto stmts = blocks.GetStatements(block);
+    for (int offset = first_offset; offset < stmts.size(); ++offset) {
+      int cur = stmts[offset];
       // only insert if it is assign stmt && stmt uses LHS
       if (assign_stmts.find(cur) != assign_stmts.end() && (pkb.IsUses(cur, modified_var))) {
         pkb.InsertAffects(src, cur);
@@ -37,68 +40,68 @@ void AffectsHandler::TraverseCFGFromSource(int src, std::string& modified_var, c
       std::string stmt_type = pkb.GetStatementType(cur);
       if (stmt_type == EntityHandler::kassign_string || stmt_type == EntityHandler::kread_string || stmt_type == EntityHandler::kcall_string) {
         if (pkb.IsModifies(cur, modified_var)) {
-          path_exists = false;
+          return false;
         }
       }
     }
+    return true;
+  };
+
+  const auto& src_position = blocks.GetPosition(src);
+  if (scan_block(src_position.block, src_position.offset + 1)) {
+    stack.push(src_position.block);
+  }
+
+  while (!stack.empty()) {
+    utils::Cancellation::Check();
+    auto cur = stack.top();
+    stack.pop();
 
-    for (auto e : cfg[cur]) {
-      if (reachable_nodes.find(e) == reachable_nodes.end() && path_exists == true) {
-        reachable_nodes.insert(e);
-        stack.push(e);
+    for (auto e : blocks.GetSuccessors(cur)) {
+      if (!reachable_blocks[e]) {
+        reachable_blocks[e] = true;
+        if (scan_block(e, 0)) {
+          stack.push(e);
+        }
       }
     }
   }
 }
 
-void AffectsHandler::ExtractAffects(PKB& pkb, const source_processor::TNode& root) {
-  CFG cfg = CFGHandler::GetCFG();
-  assign_stmts = pkb.GetAllAssignStmts();
+void AffectsHandler::ExtractAffects(PKB& pkb, const ExtractionContext& context) {
+  const BlockCFG& blocks = context.block_cfg;
+  std::unordered_set<int> assign_stmts = pkb.GetAllAssignStmts();
 
   for (auto stmt_num : assign_stmts) {
     std::string modified_var = pkb.GetAssignedVariable(stmt_num);
-    TraverseCFGFromSource(stmt_num, modified_var, cfg, pkb);
+    TraverseCFGFromSource(stmt_num, modified_var, blocks, assign_stmts, pkb);
   }
 }
 
-//BFS outward from src, marking all nodes that can be reached
-std::unordered_set<int> AffectsHandler::GetReachableNodes(int src) {
-  std::unordered_set<int> reachable_nodes;
-  std::queue<int> q;
-
-  q.push(src);
-
-  while (!q.empty()) {
-    auto cur = q.front();
-    q.pop();
-    for (auto e : graph[cur]) {
-      if (reachable_nodes.find(e) == reachable_nodes.end()) {
-        reachable_nodes.insert(e);
-        q.push(e);
-      }
-    }
-  }
-  return reachable_nodes;
-}
-
 void AffectsHandler::ExtractAffectsT(PKB& pkb, const source_processor::TNode& root) {
-  assign_stmts = pkb.GetAllAssignStmts();
-  graph.clear();
-
-  // populate affects graph
-  for (int stmt_num : assign_stmts) {
-    std::unordered_set<int> affected_stmts = pkb.GetAffectedStatements(stmt_num);
-    for (auto affected_stmt : affected_stmts) {
-      graph[stmt_num].insert(affected_stmt);
+  // large programs answer AffectsT from an index over the Affects graph instead
+  if (!pkb.ShouldMaterialiseTransitiveRelations()) {
+    pkb.IndexAffectsT();
+    return;
+  }
+  std::unordered_set<int> assign_stmts = pkb.GetAllAssignStmts();
+  std::vector<int> sources(assign_stmts.begin(), assign_stmts.end());
+  std::vector<std::pair<int, int>> edges;
+
+  // populate affects graph, over stmt#s
+  int num_nodes = 1;
+  for (int stmt_num : sources) {
+    num_nodes = std::max(num_nodes, stmt_num + 1);
+    for (auto affected_stmt : pkb.GetAffectedStatements(stmt_num)) {
+      edges.push_back(std::make_pair(stmt_num, affected_stmt));
+      num_nodes = std::max(num_nodes, affected_stmt + 1);
     }
   }
 
-  // get reachable nodes
-  for (int src = 0; src < graph.size(); src++) {
-    auto reachable_nodes = GetReachableNodes(src);
-    for (auto to : reachable_nodes) {
-      pkb.InsertAffectsT(src, to);
-    }
+  // get reachable nodes, searching from every assign stmt at once
+  auto reachable_nodes = MultiSourceBFS::GetReachableNodes(CSRGraph(num_nodes, edges), sources);
+  for (size_t i = 0; i < sources.size(); ++i) {
+    pkb.InsertAffectsT(sources[i], reachable_nodes[i]);
   }
 }
 
@@ -1,24 +1,24 @@
 #pragma once
 
+#include <unordered_map>
 #include <unordered_set>
 
-#include "design_extractor/utils/CFGHandler.h"
+#include "design_extractor/utils/BlockCFG.h"
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
 
 namespace design_extractor {
 
-typedef std::unordered_map<int, std::unordered_set<int>> AffectsGraph;
+struct ExtractionContext;
 
 class AffectsHandler {
  private:
-  static AffectsGraph graph;
-  static std::unordered_set<int> assign_stmts;
-  static std::unordered_set<int> GetReachableNodes(int src);
-  static void TraverseCFGFromSource(int src, std::string& modified_var, const CFG& cfg, PKB& pkb);
+  static void TraverseCFGFromSource(int src, std::string& modified_var, const BlockCFG& blocks,
+                                    const std::unordered_set<int>& assign_stmts, PKB& pkb);
 
  public:
-  static void ExtractAffects(PKB& pkb, const source_processor::TNode& root);
+  // must be called after the CFG of the context is constructed
+  static void ExtractAffects(PKB& pkb, const ExtractionContext& context);
   static void ExtractAffectsT(PKB& pkb, const source_processor::TNode& root);
 };
 
@@ -14,8 +14,6 @@
 
 namespace design_extractor {
 
-std::unordered_map<std::string, std::unordered_set<std::string>> CallHandler::call_graph;
-
 void CallHandler::ExtractCallStmts(PKB& pkb, const source_processor::TNode& node) {
   if (!node.IsType(source_processor::TNodeType::Call)) {
     return;
@@ -26,8 +24,8 @@ void CallHandler::ExtractCallStmts(PKB& pkb, const source_processor::TNode& node
 }
 
 /* Called on procedure TNodes.
-* Will populate call_graph with all the procedures that are called
-* within this procedure node
+* Will insert Calls from this procedure node to all the procedures that are called
+* within it
 */
 void CallHandler::ExtractCallRelation(PKB& pkb, const source_processor::TNode& node) {
   if (!node.IsType(source_processor::TNodeType::Procedure)) {
@@ -46,7 +44,6 @@ void CallHandler::ExtractCallRelation(PKB& pkb, const source_processor::TNode& n
     if (cur.IsType(source_processor::TNodeType::Call)) {
       pkb.InsertCalls(node.GetValue(), cur.GetValue());
       //std::cout << node.GetValue() << " calls " << cur.GetValue() << std::endl;
-      call_graph[node.GetValue()].insert(cur.GetValue());  //node is the parent of cur in the call graph
     }
 
     //assert(cur.GetChildren().size() >= 1);
@@ -56,44 +53,47 @@ void CallHandler::ExtractCallRelation(PKB& pkb, const source_processor::TNode& n
   }
 }
 
-/* Precondition: call_graph must already be populated, 
+/* Precondition: Calls must already be populated,
 * aka ExtractCallRelation() must have been called prior
 */
 void CallHandler::ExtractCallTRelation(PKB& pkb, const source_processor::TNode& node) {
+  //the key is a procedure that calls all the procedures in the value set
+  graph call_graph;
+  for (auto& p : pkb.GetAllProcedures()) {
+    auto callees = pkb.GetProceduresCalled(p);
+    if (!callees.empty()) {
+      call_graph[p] = callees;
+    }
+  }
+
   for (auto& pair : call_graph) {
     assert(!pair.second.empty() && "If call_graph has this entry, it should have non-empty descendants");
 
     //descendants = union of all GetDescendants(children)
     //for every d in descendant, calls*(cur, d) is true
     std::unordered_set<std::string> descendants;
-    GetDescendantsOf(pair.first, descendants);
+    GetDescendantsOf(pair.first, call_graph, descendants);
 
     for (std::string d : descendants) {
       //std::cout << pair.first << " calls* " << d << std::endl;
       pkb.InsertCallsT(pair.first, d);
     }
   }
-
-  //clear the static data structures after every run
-  //ExtractCallTRelation() will be called last among all the call handler functions, and will only
-  //be called once per SIMPLE program
-  call_graph.clear();
 }
 
 // will return direct (children) and indirect descendants (grandchildren onwards) of caller
-void CallHandler::GetDescendantsOf(std::string caller,
+void CallHandler::GetDescendantsOf(std::string caller, const graph& call_graph,
                                    std::unordered_set<std::string>& descendants) {
   //if this caller has no descendants, there is nothing to populate descendants with
-  if (call_graph.find(caller) == call_graph.end()) {
+  auto it = call_graph.find(caller);
+  if (it == call_graph.end()) {
     return;
   }
 
   //descendants of caller is the union of all descendants of caller's children
-  //operator[] creates an empty set for the k-v pair if key doesn't exist
-  //we avoid this by doing existence check before this
-  for (std::string child : call_graph[caller]) {
+  for (std::string child : it->second) {
     std::unordered_set<std::string> childs_descendants;
-    GetDescendantsOf(child, childs_descendants);
+    GetDescendantsOf(child, call_graph, childs_descendants);
     descendants.insert(child);  //insert the
 
     for (std::string cd : childs_descendants) {
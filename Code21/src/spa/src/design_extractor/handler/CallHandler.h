@@ -12,10 +12,9 @@ namespace design_extractor {
 
 class CallHandler {
  private:
-  //the key is a procedure that calls all the procedures in the value vector
-  static std::unordered_map<std::string, std::unordered_set<std::string>> call_graph;
-
-  static void GetDescendantsOf(std::string caller, std::unordered_set<std::string>& descendants);
+  //call_graph maps a procedure to all the procedures it calls
+  static void GetDescendantsOf(std::string caller, const graph& call_graph,
+                               std::unordered_set<std::string>& descendants);
 
  public:
   static void ExtractCallStmts(PKB& pkb, const source_processor::TNode& node);
@@ -12,14 +12,13 @@
 
 namespace design_extractor {
 
-std::unordered_map<int, std::unordered_set<std::string>> ModifiesHandler::vars_modified_by;
-
 //extractModifies is called once on root
 //and will populate `vars_modified_by` with all vars modified by all stmtnos
 
 //wishful thinking: For all stmtnos contained within subtree rooted at node,
 //extractModifies will populate vars_modified_by with all vars modified by those stmtnos
-void ModifiesHandler::ExtractModifiesSWithoutCallsStmtsHelper(const source_processor::TNode& node) {
+void ModifiesHandler::ExtractModifiesSWithoutCallsStmtsHelper(const source_processor::TNode& node,
+                                                              VarsModifiedBy& vars_modified_by) {
   int cur_sn = node.GetStatementNumber();  //cur stmt no
 
   //base cases, can get vars modified by Read and Assignment stmts directly
@@ -53,7 +52,7 @@ void ModifiesHandler::ExtractModifiesSWithoutCallsStmtsHelper(const source_proce
 
   //continue dfs
   for (auto cptr : node.GetChildren()) {
-    ExtractModifiesSWithoutCallsStmtsHelper(*cptr);
+    ExtractModifiesSWithoutCallsStmtsHelper(*cptr, vars_modified_by);
   }
 
   //dfs has been completed on all nodes in the subtree rooted at `node`
@@ -94,7 +93,7 @@ void ModifiesHandler::ExtractModifiesSWithoutCallsStmtsHelper(const source_proce
   }
 }
 
-void ModifiesHandler::PopulateModifiesSWithoutCallsStmts(PKB& pkb) {
+void ModifiesHandler::PopulateModifiesSWithoutCallsStmts(PKB& pkb, const VarsModifiedBy& vars_modified_by) {
   //entry is pair of <stmtno, unordered_set<string> modified by this stmtno>
   for (auto& entry : vars_modified_by) {
     for (auto& var : entry.second) {
@@ -104,9 +103,9 @@ void ModifiesHandler::PopulateModifiesSWithoutCallsStmts(PKB& pkb) {
 }
 
 void ModifiesHandler::ExtractModifiesSWithoutCallsStmts(PKB& pkb, const source_processor::TNode& node) {
-  vars_modified_by.clear();
-  ExtractModifiesSWithoutCallsStmtsHelper(node);
-  PopulateModifiesSWithoutCallsStmts(pkb);
+  VarsModifiedBy vars_modified_by;
+  ExtractModifiesSWithoutCallsStmtsHelper(node, vars_modified_by);
+  PopulateModifiesSWithoutCallsStmts(pkb, vars_modified_by);
 }
 
 /**
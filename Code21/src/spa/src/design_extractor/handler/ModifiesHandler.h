@@ -14,10 +14,11 @@ namespace design_extractor {
 class ModifiesHandler {
  private:
   //stmt no modifies the corresponding set of variables
-  static std::unordered_map<int, std::unordered_set<std::string>> vars_modified_by;
+  typedef std::unordered_map<int, std::unordered_set<std::string>> VarsModifiedBy;
 
-  static void ExtractModifiesSWithoutCallsStmtsHelper(const source_processor::TNode& node);
-  static void PopulateModifiesSWithoutCallsStmts(PKB& pkb);
+  static void ExtractModifiesSWithoutCallsStmtsHelper(const source_processor::TNode& node,
+                                                      VarsModifiedBy& vars_modified_by);
+  static void PopulateModifiesSWithoutCallsStmts(PKB& pkb, const VarsModifiedBy& vars_modified_by);
   static void PopulateModifiesSForCallsAndModifiesP(PKB& pkb, graph call_graph, std::string proc);
 
  public:
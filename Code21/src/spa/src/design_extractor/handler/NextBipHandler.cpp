@@ -1,41 +1,28 @@
 #include "NextBipHandler.h"
 
 #include <cassert>
-#include <iostream>
-#include <queue>
-#include <stack>
-#include <stdexcept>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "CallHandler.h"
 #include "EntityHandler.h"
+#include "design_extractor/ExtractionContext.h"
+#include "design_extractor/utils/BlockCFG.h"
 #include "design_extractor/utils/CFGBipHandler.h"
 #include "design_extractor/utils/CFGHandler.h"
+#include "design_extractor/utils/CSRGraph.h"
+#include "design_extractor/utils/TransitiveClosure.h"
 #include "pkb/PKB.h"
+#include "pkb/utils/StatementReachability.h"
 #include "source_processor/ast/TNode.h"
-
-//Meant to be Process Control Block (PCB) from CS2106, which
-//stores all info needed at each node of the CFGBip to resume execution
-//from that point.
-
-//cur_sn: the stmt# of the current node that is popped off the DFS stack
-//hops_left: for reasons explained in the execution-aware traversal, we will only do traversal of path length
-//n-1. 0 hops_left means we process this current node, but do not continue traversal further
-//return_to: it's the call stack of the current execution. When it's time to return to a caller, if any,
-//the top of the stack will be the stmt# to execute next / return to
-struct PCB {
-  int cur_sn;
-  std::stack<int> return_to;  //stack.top would be the stmt no. a returning process should execute next
-  int hops_left;              //when hops_left == 0, cur_sn is processed, but not any further
-};
+#include "utils/Parallel.h"
 
 namespace design_extractor {
 
-//initializing static member variables
-CFG NextBipHandler::cfgbip;
-
 //NextBip(a, b) is true for all edges from a -> b in cfgbip
-void design_extractor::NextBipHandler::PopulateNextBipRelation(PKB& pkb) {
+void design_extractor::NextBipHandler::PopulateNextBipRelation(PKB& pkb, const ExtractionContext& context) {
+  const CFG& cfgbip = context.cfgbip;
   for (int from = 0; from < cfgbip.size(); ++from) {
     for (auto to : cfgbip[from]) {
       //std::cout << "NextBip(" << from << ", " << to << ")\n";
@@ -45,209 +32,137 @@ void design_extractor::NextBipHandler::PopulateNextBipRelation(PKB& pkb) {
 }
 
 /*
-  Does a execution-aware traversal starting from stmt no. `from`.
-  We cannot maintain a visited state, bc while loops mean that each node migh be visited more than once.
-  i.e. CFGBip is not a DAG. Hence to prevent infinite DFS, it is known that there is a path
-  from each node to all nodes it can reach in at most n-1 hops.
-  Hence this function traverses only paths of length n-1, without maintaining visited nodes, to prevent
-  infinite DFS.
-
-  Tries to populate NextBipT(from, s), for all s.
-  Note that NextBipT(from, from) is not automatically true
-  */
-void design_extractor::NextBipHandler::PopulateNextBipTRelationFromStmt(int from, PKB& pkb, int num_hops) {
-  std::unordered_set<int> reachable;
-  std::stack<PCB> s;
-  std::vector<int> visits_left;
-
-  visits_left.assign(cfgbip.size(), 1);
-  ++visits_left[from];
-
-  //when we start traversal we have an empty call stack
-  //Edge case: `from` itself is not automatically nextbipT itself. so we maintain counter of how
-  //many times it is seen
-  int times_from_seen = 0;
-  s.push(PCB{from, std::stack<int>{}, num_hops});
-
-  while (!s.empty()) {
-    PCB cur = s.top();
-    s.pop();
-
-    auto cur_sn = cur.cur_sn;
-    auto return_to = cur.return_to;  //should be deep copy the stack
-    auto hops_left = cur.hops_left;
-
-    if (visits_left[cur_sn] <= 0) {
+  NextBip* asks for paths over CFGBip whose branch backs match the branch ins taken before them,
+  i.e. CFL-reachability with the call stack as the language. A branch back taken while no call is
+  pending is unmatched and may go to any return point of the procedure, since the traversal started
+  inside it.
+
+  Every SIMPLE procedure can reach one of its exit stmts, so a call that is later returned from
+  behaves exactly like its Next edge (the summary edge of the call). Matched calls therefore never
+  need a stack, and a path only depends on whether a branch in is still pending:
+    - layer 0 holds the nodes reached with no call pending, where exit stmts may take any branch back
+    - layer 1 holds the nodes reached inside a pending call, which is only left again through the
+      summary edge of that call, so branch backs are not followed there
+  A call stmt that is also an exit stmt pushes nothing, so its branch in stays in the same layer.
+  NextBip*(a, b) then holds iff either copy of b is reachable from the layer 0 copy of a, which
+  turns the path enumeration into one reachability closure.
+
+  The nodes of the graph are the basic blocks of CFGBip rather than its stmts. Call and exit stmts
+  end their block and procedure entries start one, so only the last stmt of a block has edges that
+  differ between the layers, and every other stmt just falls through to the next one.
+*/
+CSRGraph NextBipHandler::BuildCallContextGraph(PKB& pkb, const ExtractionContext& context) {
+  const CFG& cfg = context.cfg;
+  const CFG& cfgbip = context.cfgbip;
+  const BlockCFG& blocks = context.block_cfgbip;
+  int num_blocks = blocks.CountBlocks();
+  std::vector<std::pair<int, int>> edges;
+  auto add_edge = [&edges, &blocks, num_blocks](int from_block, int from_layer, int to, int to_layer) {
+    edges.push_back({from_block + from_layer * num_blocks, blocks.GetPosition(to).block + to_layer * num_blocks});
+  };
+
+  for (int block = 0; block < num_blocks; ++block) {
+    int sn = blocks.GetLastStatement(block);
+    if (sn == 0) {
       continue;
     }
-    --visits_left[cur_sn];
-
-    //std::cout << cur_sn << " " << hops_left << "\n";
-
-    //if hops_left == 0, this is the last node in this path we process
-    //then we just push the node with hops_left == -1, and it will terminate in the
-    //next loop here
-    if (hops_left < 0) {
-      continue;
-    }
-    assert(hops_left >= 0);
-    if (cur_sn == from) {
-      ++times_from_seen;
-    }
-    reachable.insert(cur_sn);
-
-    //Traverse branchin edge next?
-    if (pkb.GetStatementType(cur_sn) == EntityHandler::kcall_string) {
-      //call can only have at most 1 branchin edge in cfgbip, which is to the beginning stmt no of the called proc
-      //but call can have no Next stmts
-      if (CFGBipHandler::IsExitStmt(cur_sn, pkb)) {
-        //if this call stmt is also an exit stmt, then it has no next stmt for the callee
-        //to return to. so callee should return to my caller, which is already on the stack
-        //if my current call stack is empty, then callee can return to anywhere it can reach
-        std::stack<int> new_stack = return_to;
-        s.push(PCB{cfgbip[cur_sn][0], new_stack, hops_left - 1});
+    if (pkb.GetStatementType(sn) == EntityHandler::kcall_string) {
+      //a call has exactly one cfgbip edge, its branch in to the entry of the callee
+      assert(cfgbip[sn].size() == 1);
+      int callee_entry = cfgbip[sn][0];
+      if (cfg[sn].empty()) {
+        add_edge(block, 0, callee_entry, 0);
+        add_edge(block, 1, callee_entry, 1);
       } else {
-        //cur_sn must have only 1 next statement and outgoing branchin, which callee must return to
-        auto nexts = pkb.GetNextStatements(cur_sn);
-        assert(nexts.size() == 1);
-        assert(cfgbip[cur_sn].size() == 1);  //this is where dfs can go to next
-        auto return_sn = *nexts.begin();     //this is where callee must return to
-        std::stack<int> new_stack = return_to;
-        new_stack.push(return_sn);
-        s.push(PCB{cfgbip[cur_sn][0], new_stack, hops_left - 1});
+        for (int next_sn : cfg[sn]) {
+          add_edge(block, 0, next_sn, 0);
+          add_edge(block, 1, next_sn, 1);
+        }
+        add_edge(block, 0, callee_entry, 1);
+        add_edge(block, 1, callee_entry, 1);
       }
-      //increment by 1 all stmts in the callee proc
-      auto callee = GetProcStartingWith(cfgbip[cur_sn][0], pkb);
-      auto range = pkb.GetProcRange(callee);
-      for (int i = range.first; i <= range.second; ++i) {
-        ++visits_left[i];
+    } else if (CFGBipHandler::IsExitStmt(sn, pkb)) {
+      //cfgbip edges of an exit stmt are its Next edges plus all its branch backs
+      for (int next_sn : cfgbip[sn]) {
+        add_edge(block, 0, next_sn, 0);
       }
-    }
-    //are we at a non-call exit stmt of a proc
-    //and our only cfgbip edges are branchback edges, if any.
-    //any stmt except if-stmts can be exit statements, but there could be no branchback edges if
-    //no procedure calls this one
-    else if (CFGBipHandler::IsExitStmt(cur_sn, pkb)) {
-      //we are a non-call and exit stmt. The possible types, #Next stmts are, #cfgbip out-edges are:
-      //type, #Next stmts are, #cfgbip out-edges are
-      //read    0     c
-      //print   0     c
-      //assign  0     c
-      //while   1     c+1
-      //where c = #stmts this could possible return to
-      //for the first 3 types, we must return to the caller if possible, or all possible callers
-      //for the while stmt, we both return to the caller if possible, or all possible callers
-      //and also duplicate PCB to continue DFS within our whileStmtList
-      if (pkb.GetStatementType(cur_sn) == EntityHandler::kwhile_string) {  //while
-        if (return_to.empty()) {
-          //since we have no callers on call stack, we can return to anywhere that possibly called us,
-          //or called procedures which had call stmts as exit stmts that called us
-          for (int next_sn : cfgbip[cur_sn]) {
-            std::stack<int> new_stack = return_to;  //just make duplicate of the empty stack
-            s.push(PCB{next_sn, new_stack, hops_left - 1});
-          }
-        } else {
-          //we were called from somewhere, so we can only return to somewhere in the caller
-          //the return point is the top of the `return_to` call stack
-          std::stack<int> new_stack = return_to;
-          int next_sn = new_stack.top();
-          new_stack.pop();
-          s.push(PCB{next_sn, new_stack, hops_left - 1});
-
-          //*also have to continue dfs in our own stmtLst
-          auto nexts = pkb.GetNextStatements(cur_sn);
-          assert(nexts.size() == 1);  //exit while stmt should only be able to enter its stmtlist
-          next_sn = *nexts.begin();   //should be ok to reuse the ident once struct created
-          std::stack<int> dup_stack = return_to;
-          s.push(PCB{next_sn, dup_stack, hops_left - 1});
-        }
-      } else {  //read / print / assign stmts
-        if (return_to.empty()) {
-          //since we have no callers on call stack, we can return to anywhere that possibly called us,
-          //or called procedures which had call stmts as exit stmts that called us
-          for (int next_sn : cfgbip[cur_sn]) {
-            std::stack<int> new_stack = return_to;  //just make duplicate of the empty stack
-            s.push(PCB{next_sn, new_stack, hops_left - 1});
-          }
-        } else {
-          //we were called from somewhere, so we can only return to somewhere in the caller
-          //the return point is the top of the `return_to` call stack
-          std::stack<int> new_stack = return_to;
-          int next_sn = new_stack.top();
-          new_stack.pop();
-          s.push(PCB{next_sn, new_stack, hops_left - 1});
-        }
+      for (int next_sn : cfg[sn]) {
+        add_edge(block, 1, next_sn, 1);
       }
-    }
-    //we are a non-exit and non-call stmt. The possible types and #Next stmts are:
-    //node type, #next stmts:
-    //read    1
-    //print   1
-    //assign  1
-    //if      2
-    //while   2
-    //for the first 3 types, we continue normal DFS
-    //for the branching control flow, we duplicate the PCB
-    else {
-      if (pkb.GetStatementType(cur_sn) == EntityHandler::kread_string ||
-          pkb.GetStatementType(cur_sn) == EntityHandler::kprint_string ||
-          pkb.GetStatementType(cur_sn) == EntityHandler::kassign_string) {
-        assert(cfgbip[cur_sn].size() == 1);
-        std::stack<int> new_stack = return_to;
-        s.push(PCB{cfgbip[cur_sn][0], new_stack, hops_left - 1});
-      } else if (pkb.GetStatementType(cur_sn) == EntityHandler::kif_string ||
-                 pkb.GetStatementType(cur_sn) == EntityHandler::kwhile_string) {
-        //std::cout << "cur sn: " << cur_sn << " " << cfgbip[cur_sn].size() << std::endl;
-        assert(cfgbip[cur_sn].size() == 2);
-        for (int next_sn : cfgbip[cur_sn]) {
-          std::stack<int> new_stack = return_to;
-          s.push(PCB{next_sn, new_stack, hops_left - 1});
-        }
-      } else {
-        //should never reach here if all cases handled properly, and cur_sn is a valid stmt number
-        assert(cur_sn != 0 &&
-               "In NextBipHandler, traversing CFGBip, \
-            encountered unexpected node type or statement number");
+    } else {
+      for (int next_sn : cfg[sn]) {
+        add_edge(block, 0, next_sn, 0);
+        add_edge(block, 1, next_sn, 1);
       }
     }
   }
 
-  if (times_from_seen == 1) {
-    //it was only seen when it started from the source
-    //so it's not reachable from itself
-    reachable.erase(from);
-  }
-  for (auto r : reachable) {
-    pkb.InsertNextBipT(from, r);
-  }
+  return CSRGraph(2 * num_blocks, edges);
 }
 
-std::string NextBipHandler::GetProcStartingWith(int sn, PKB& pkb) {
-  auto procs = pkb.GetAllProcedures();
-  for (auto p : procs) {
-    auto range = pkb.GetProcRange(p);
-    if (range.first == sn) {
-      return p;
+void design_extractor::NextBipHandler::PopulateNextBipTRelation(PKB& pkb, const ExtractionContext& context) {
+  const BlockCFG& blocks = context.block_cfgbip;
+  int num_blocks = blocks.CountBlocks();
+  CSRGraph graph = BuildCallContextGraph(pkb, context);
+
+  //both copies of a block stand for the same block
+  std::vector<int> labels(graph.CountNodes());
+  for (int node = 0; node < graph.CountNodes(); ++node) {
+    labels[node] = node % num_blocks;
+  }
+
+  TransitiveClosure closure(graph, labels, num_blocks);
+
+  //rows are expanded into sets of stmts on a pool of threads, then inserted into the PKB in one pass;
+  //within its block a stmt reaches the stmts after it, as in Next*
+  std::vector<std::unordered_set<int>> reachable(blocks.CountStatements());
+  utils::Parallel::For(num_blocks, utils::Parallel::GetDefaultNumThreads(), [&](size_t block, int) {
+    std::unordered_set<int> reachable_stmts;
+    for (int reachable_block : TransitiveClosure::ToSet(closure.GetRow(block))) {
+      auto stmts = blocks.GetStatements(reachable_block);
+      reachable_stmts.insert(stmts.begin(), stmts.end());
+    }
+
+    auto stmts = blocks.GetStatements(block);
+    for (int offset = stmts.size() - 1; offset >= 0; --offset) {
+      reachable[stmts[offset]] = reachable_stmts;
+      reachable_stmts.insert(stmts[offset]);
     }
+  });
+  for (size_t from = 1; from < reachable.size(); ++from) {
+    pkb.InsertNextBipT(from, reachable[from]);
   }
-  assert(false && "there must exist at least 1 procedure with such a starting stmt#");
 }
 
-void design_extractor::NextBipHandler::PopulateNextBipTRelation(PKB& pkb) {
-  int num_nodes = cfgbip.size();  //has 1 node more than num stmts bc of node 0, but it doesn't affect correctedness
-  for (int from = 1; from < num_nodes; ++from) {
-    //must start from stmt 1, bc 0 is an invalid stmt num
-    //std::cout << "populating nb* for " << from << std::endl;
-    PopulateNextBipTRelationFromStmt(from, pkb, num_nodes - 1);
-    //std::cout << "populated nb* for " << from << std::endl;
+//large programs answer NextBip* from a reachability index over the same graph instead of its closure
+void NextBipHandler::IndexNextBipTRelation(PKB& pkb, const ExtractionContext& context) {
+  const BlockCFG& blocks = context.block_cfgbip;
+  CSRGraph graph = BuildCallContextGraph(pkb, context);
+
+  std::vector<std::vector<int>> block_stmts(blocks.CountBlocks());
+  for (int block = 0; block < blocks.CountBlocks(); ++block) {
+    for (int sn : blocks.GetStatements(block)) {
+      if (sn != 0) {
+        block_stmts[block].push_back(sn);
+      }
+    }
   }
+  std::vector<std::pair<int, int>> edges;
+  for (int node = 0; node < graph.CountNodes(); ++node) {
+    for (int child : graph.GetChildren(node)) {
+      edges.push_back({node, child});
+    }
+  }
+  pkb.InsertNextBipTIndex(StatementReachability(std::move(block_stmts), 2, std::move(edges)));
 }
 
-void NextBipHandler::ExtractNextBipAndNextBipTRelation(PKB& pkb, const source_processor::TNode& node) {
-  cfgbip.clear();
-  cfgbip = CFGBipHandler::GetCFGBip();
-  PopulateNextBipRelation(pkb);
-  PopulateNextBipTRelation(pkb);
+void NextBipHandler::ExtractNextBipAndNextBipTRelation(PKB& pkb, const ExtractionContext& context) {
+  PopulateNextBipRelation(pkb, context);
+  if (pkb.ShouldMaterialiseTransitiveRelations()) {
+    PopulateNextBipTRelation(pkb, context);
+  } else {
+    IndexNextBipTRelation(pkb, context);
+  }
 }
 
-}  // namespace design_extractor
\ No newline at end of file
+}  // namespace design_extractor
@@ -2,25 +2,25 @@
 
 #include <unordered_map>
 
-#include "design_extractor/utils/CFGHandler.h"
+#include "design_extractor/utils/CSRGraph.h"
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
 
 namespace design_extractor {
 
+struct ExtractionContext;
+
 //NextBipHandler must be called after Next, CFGHandler, EntityHandler
 class NextBipHandler {
  private:
-  static CFG cfgbip;
-
-  static void PopulateNextBipRelation(PKB& pkb);
-  static void PopulateNextBipTRelation(PKB& pkb);
-  static void PopulateNextBipTRelationFromStmt(int from, PKB& pkb, int num_hops);
-  static std::string GetProcStartingWith(int sn, PKB& pkb);
+  static void PopulateNextBipRelation(PKB& pkb, const ExtractionContext& context);
+  static void PopulateNextBipTRelation(PKB& pkb, const ExtractionContext& context);
+  static void IndexNextBipTRelation(PKB& pkb, const ExtractionContext& context);
+  static CSRGraph BuildCallContextGraph(PKB& pkb, const ExtractionContext& context);
 
  public:
-  //call after CFGHandler and NextHandler
-  static void ExtractNextBipAndNextBipTRelation(PKB& pkb, const source_processor::TNode& node);
+  //call after CFGBipHandler has constructed the CFGBip of the context
+  static void ExtractNextBipAndNextBipTRelation(PKB& pkb, const ExtractionContext& context);
 };
 
 }  // namespace design_extractor
\ No newline at end of file
@@ -1,20 +1,24 @@
 #include "NextHandler.h"
 
 #include <iostream>
-#include <queue>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "design_extractor/ExtractionContext.h"
+#include "design_extractor/utils/BlockCFG.h"
 #include "design_extractor/utils/CFGHandler.h"
-#include "design_extractor/utils/DeUtils.h"
+#include "design_extractor/utils/TransitiveClosure.h"
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
+#include "source_processor/ast/TNodeType.h"
 
 namespace design_extractor {
 
 // every edge on CFG is a next relation.
 // Next(a, b) is true iff there is an edge from a to b in the CFG
-void NextHandler::ExtractNextRelation(PKB& pkb, const source_processor::TNode& node) {
-  const CFG& cfg = CFGHandler::GetCFG();
+void NextHandler::ExtractNextRelation(PKB& pkb, const ExtractionContext& context) {
+  const CFG& cfg = context.cfg;
   for (int from = 0; from < cfg.size(); ++from) {
     for (auto to : cfg[from]) {
       //std::cout << "next(" << from << ", " << to << ")\n";
@@ -24,14 +28,80 @@ void NextHandler::ExtractNextRelation(PKB& pkb, const source_processor::TNode& n
 }
 
 //for a node A, Next*(A, B) is true for all B where
-//B can be reached from A in the CFG
-void NextHandler::ExtractNextTRelation(PKB& pkb, const source_processor::TNode& node) {
-  const CFG& cfg = CFGHandler::GetCFG();
-  for (int from = 0; from < cfg.size(); ++from) {
-    auto reachable_nodes = DeUtils::GetReachableNodes(from, cfg);
-    for (auto to : reachable_nodes) {
-      //std::cout << "next*(" << from << ", " << to << ")\n";
-      pkb.InsertNextT(from, to);
+//B can be reached from A in the CFG.
+//Within a basic block A reaches exactly the stmts after it, and past the end of its block it reaches
+//the stmts of every block reachable from its own, so reachability is closed over blocks only and
+//expanded to stmts once per block, from its last stmt back to its first
+void NextHandler::ExtractNextTRelation(PKB& pkb, const ExtractionContext& context) {
+  // large programs answer NextT from the labels of ExtractNextTLabels instead
+  if (!pkb.ShouldMaterialiseTransitiveRelations()) {
+    return;
+  }
+  const BlockCFG& blocks = context.block_cfg;
+  int num_blocks = blocks.CountBlocks();
+  std::vector<int> labels(num_blocks);
+  for (int block = 0; block < num_blocks; ++block) {
+    labels[block] = block;
+  }
+  TransitiveClosure closure(blocks.GetBlockGraph(), labels, num_blocks);
+
+  for (int block = 0; block < num_blocks; ++block) {
+    std::unordered_set<int> reachable_nodes;
+    for (int reachable_block : TransitiveClosure::ToSet(closure.GetRow(block))) {
+      auto stmts = blocks.GetStatements(reachable_block);
+      reachable_nodes.insert(stmts.begin(), stmts.end());
+    }
+
+    auto stmts = blocks.GetStatements(block);
+    for (int offset = stmts.size() - 1; offset >= 0; --offset) {
+      pkb.InsertNextT(stmts[offset], reachable_nodes);
+      reachable_nodes.insert(stmts[offset]);
+    }
+  }
+}
+
+// labels the stmts of a stmt list, nested stmts included, and returns the last stmt# nested in it
+int NextHandler::LabelStatementList(const source_processor::TNode& stmt_list, const StatementLabel& container_label,
+                                    std::vector<std::pair<int, StatementLabel>>& labels) {
+  int last = 0;
+  for (auto stmt : stmt_list.GetChildren()) {
+    int stmt_no = stmt->GetStatementNumber();
+    StatementLabel label = container_label;
+    label.last = stmt_no;
+    StatementLabel nested_label = container_label;
+    nested_label.parent = stmt_no;
+
+    // the nested stmts are labelled first, so the label is only added once its range is known
+    if (stmt->IsType(source_processor::TNodeType::While)) {
+      label.is_while = true;
+      label.last = LabelStatementList(stmt->GetWhileStatementListTNode(), nested_label, labels);
+    } else if (stmt->IsType(source_processor::TNodeType::If)) {
+      LabelStatementList(stmt->GetThenStatementListTNode(), nested_label, labels);
+      label.else_first = stmt->GetElseStatementListTNode().GetChildren().front()->GetStatementNumber();
+      label.last = LabelStatementList(stmt->GetElseStatementListTNode(), nested_label, labels);
+    }
+    labels.push_back({stmt_no, label});
+    last = label.last;
+  }
+  return last;
+}
+
+//Within a procedure, NextT follows from where its stmts are nested, so every stmt is labelled with
+//its procedure, its innermost container and its own range for NextT to be answered without a table
+void NextHandler::ExtractNextTLabels(PKB& pkb, const source_processor::TNode& root) {
+  for (auto procedure : root.GetChildren()) {
+    if (!procedure->IsType(source_processor::TNodeType::Procedure)) {
+      continue;
+    }
+    const auto& stmt_list = procedure->GetProcedureStatementListTNode();
+    StatementLabel proc_label;
+    proc_label.proc_first = stmt_list.GetChildren().front()->GetStatementNumber();
+
+    std::vector<std::pair<int, StatementLabel>> labels;
+    int proc_last = LabelStatementList(stmt_list, proc_label, labels);
+    for (auto& label : labels) {
+      label.second.proc_last = proc_last;
+      pkb.InsertNextTLabel(label.first, label.second);
     }
   }
 }
@@ -1,15 +1,25 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
 
 namespace design_extractor {
 
+struct ExtractionContext;
+
 class NextHandler {
  private:
+  static int LabelStatementList(const source_processor::TNode& stmt_list, const StatementLabel& container_label,
+                                std::vector<std::pair<int, StatementLabel>>& labels);
+
  public:
-  static void ExtractNextRelation(PKB& pkb, const source_processor::TNode& node);
-  static void ExtractNextTRelation(PKB& pkb, const source_processor::TNode& node);
+  // must be called after the CFG of the context is constructed
+  static void ExtractNextRelation(PKB& pkb, const ExtractionContext& context);
+  static void ExtractNextTRelation(PKB& pkb, const ExtractionContext& context);
+  static void ExtractNextTLabels(PKB& pkb, const source_processor::TNode& root);
 };
 
 }  // namespace design_extractor
\ No newline at end of file
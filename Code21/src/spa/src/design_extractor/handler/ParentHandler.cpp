@@ -9,10 +9,6 @@
 
 namespace design_extractor {
 
-std::vector<std::pair<int, int>> ParentHandler::parent_entries;   // each entry is a <stmt no, stmt no> pair
-std::vector<std::pair<int, int>> ParentHandler::parentT_entries;  // each entry is a <stmt no, stmt no> pair
-std::vector<int> ancestors;                                       //ancestors[0] is earliest ancestor, and last element is immediate parent
-
 bool IsStmtNode(const source_processor::TNode& node) {
   return node.IsType(source_processor::TNodeType::Read) ||
          node.IsType(source_processor::TNodeType::Print) ||
@@ -27,7 +23,8 @@ bool IsContainerNode(const source_processor::TNode& node) {
          node.IsType(source_processor::TNodeType::If);
 }
 
-void ParentHandler::ExtractParentAndParentTHelper(PKB& pkb, const source_processor::TNode& node) {
+void ParentHandler::ExtractParentAndParentTHelper(const source_processor::TNode& node, std::vector<int>& ancestors,
+                                                  Entries& parent_entries, Entries& parentT_entries) {
   //if is a stmt node, then add all parents / parents* entries
   if (IsStmtNode(node)) {
     if (ancestors.size() >= 1) {
@@ -49,7 +46,7 @@ void ParentHandler::ExtractParentAndParentTHelper(PKB& pkb, const source_process
 
   //continue the dfs regardless of node type
   for (auto cptr : node.GetChildren()) {
-    ExtractParentAndParentTHelper(pkb, *cptr);
+    ExtractParentAndParentTHelper(*cptr, ancestors, parent_entries, parentT_entries);
   }
 
   //backtrack: leaving function to explore other branches where this node will no longer be an ancestor
@@ -60,7 +57,8 @@ void ParentHandler::ExtractParentAndParentTHelper(PKB& pkb, const source_process
   }
 }
 
-void ParentHandler::PopulateParentAndParentT(PKB& pkb) {
+void ParentHandler::PopulateParentAndParentT(PKB& pkb, const Entries& parent_entries,
+                                             const Entries& parentT_entries) {
   for (auto e : parent_entries) {
     pkb.InsertParent(e.first, e.second);
   }
@@ -70,10 +68,10 @@ void ParentHandler::PopulateParentAndParentT(PKB& pkb) {
 }
 
 void ParentHandler::ExtractParentAndParentTStmts(PKB& pkb, const source_processor::TNode& node) {
-  parent_entries.clear();
-  parentT_entries.clear();
-  ancestors.clear();
-  ExtractParentAndParentTHelper(pkb, node);
-  PopulateParentAndParentT(pkb);
+  std::vector<int> ancestors;
+  Entries parent_entries;
+  Entries parentT_entries;
+  ExtractParentAndParentTHelper(node, ancestors, parent_entries, parentT_entries);
+  PopulateParentAndParentT(pkb, parent_entries, parentT_entries);
 }
 }  // namespace design_extractor
\ No newline at end of file
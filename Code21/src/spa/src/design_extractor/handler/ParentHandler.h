@@ -9,10 +9,13 @@ namespace design_extractor {
 
 class ParentHandler {
  private:
-  static std::vector<std::pair<int, int>> parent_entries;   // each entry is a <stmt no, stmt no> pair
-  static std::vector<std::pair<int, int>> parentT_entries;  // each entry is a <stmt no, stmt no> pair
-  static void PopulateParentAndParentT(PKB& pkb);
-  static void ExtractParentAndParentTHelper(PKB& pkb, const source_processor::TNode& node);
+  // each entry is a <stmt no, stmt no> pair
+  typedef std::vector<std::pair<int, int>> Entries;
+
+  static void PopulateParentAndParentT(PKB& pkb, const Entries& parent_entries, const Entries& parentT_entries);
+  //ancestors[0] is earliest ancestor, and last element is immediate parent
+  static void ExtractParentAndParentTHelper(const source_processor::TNode& node, std::vector<int>& ancestors,
+                                            Entries& parent_entries, Entries& parentT_entries);
 
  public:
   static void ExtractParentAndParentTStmts(PKB& pkb, const source_processor::TNode& node);
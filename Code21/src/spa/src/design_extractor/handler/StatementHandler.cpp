@@ -3,31 +3,18 @@
 #include <algorithm>
 #include <climits>
 #include <stack>
-#include <unordered_set>
 
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
 
 namespace design_extractor {
 
-int StatementHandler::max_stmt_num = INT_MIN;
-std::unordered_set<int> StatementHandler::statement_entries;
-
-void StatementHandler::ResetMaxStmtNum() {
-  max_stmt_num = INT_MIN;
-}
-
 int StatementHandler::GetMaxStmtNum(const source_processor::TNode& root) {
-  // return max_stmt_num if it is already computed
-  if (max_stmt_num != INT_MIN) {
-    return max_stmt_num;
-  }
-
   // traverse AST in DFS order to get max_stmt_num
   std::stack<source_processor::TNode> stack;
   stack.push(root);
 
-  max_stmt_num = INT_MIN;
+  int max_stmt_num = INT_MIN;
   while (!stack.empty()) {
     source_processor::TNode cur = stack.top();
     stack.pop();
@@ -46,12 +33,8 @@ int StatementHandler::GetMaxStmtNum(const source_processor::TNode& root) {
   return max_stmt_num;
 }
 
-void StatementHandler::ExtractStmtNums(PKB& pkb, const source_processor::TNode& root) {
-  // reset static var to INT_MIN before calling GetMaxStmtNum
-  ResetMaxStmtNum();
-  GetMaxStmtNum(root);
+void StatementHandler::ExtractStmtNums(PKB& pkb, int max_stmt_num) {
   for (int i = 1; i <= max_stmt_num; ++i) {
-    StatementHandler::statement_entries.insert(i);
     pkb.InsertStatement(i);
   }
 }
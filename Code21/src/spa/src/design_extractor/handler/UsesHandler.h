@@ -1,5 +1,9 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "pkb/PKB.h"
 #include "source_processor/ast/TNode.h"
 
@@ -1,5 +1,6 @@
 #include "VariableHandler.h"
 
+#include <stack>
 #include <string>
 #include <unordered_set>
 
@@ -15,4 +16,24 @@ void VariableHandler::ExtractVariableStmts(PKB& pkb, const source_processor::TNo
   pkb.InsertVariable(root.GetValue());
 }
 
+int VariableHandler::CountDistinctVariables(const source_processor::TNode& root) {
+  std::unordered_set<std::string> variables;
+  std::stack<const source_processor::TNode*> stack;
+  stack.push(&root);
+
+  while (!stack.empty()) {
+    const source_processor::TNode* cur = stack.top();
+    stack.pop();
+
+    if (cur->IsType(source_processor::TNodeType::Variable)) {
+      variables.insert(cur->GetValue());
+    }
+    for (auto c : cur->GetChildren()) {
+      stack.push(c);
+    }
+  }
+
+  return variables.size();
+}
+
 }  // namespace design_extractor
\ No newline at end of file
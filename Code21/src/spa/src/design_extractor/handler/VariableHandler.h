@@ -11,6 +11,7 @@ namespace design_extractor {
 class VariableHandler {
  public:
   static void ExtractVariableStmts(PKB& pkb, const source_processor::TNode& root);
+  static int CountDistinctVariables(const source_processor::TNode& root);  // used to pre-size the PKB tables
 };
 
 }  // namespace design_extractor
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "BlockCFG.h"
+
+#include <utility>
+#include <vector>
+
+namespace design_extractor {
+
+BlockCFG::BlockCFG(const std::vector<std::vector<int>>& cfg, const std::vector<bool>& leaders,
+                   const std::vector<bool>& terminators) {
+  const int num_stmts = cfg.size();
+  std::vector<int> num_predecessors(num_stmts, 0);
+  for (const auto& next_sns : cfg) {
+    for (int next_sn : next_sns) {
+      num_predecessors[next_sn]++;
+    }
+  }
+
+  // the stmt that continues the block of sn, or -1 if sn is the last stmt of its block
+  auto get_continuation = [&](int sn) {
+    if (cfg[sn].size() != 1 || (!terminators.empty() && terminators[sn])) {
+      return -1;
+    }
+    int next_sn = cfg[sn][0];
+    if (next_sn == sn || num_predecessors[next_sn] != 1 || (!leaders.empty() && leaders[next_sn])) {
+      return -1;
+    }
+    return next_sn;
+  };
+
+  std::vector<bool> is_continuation(num_stmts, false);
+  for (int sn = 0; sn < num_stmts; ++sn) {
+    int next_sn = get_continuation(sn);
+    if (next_sn != -1) {
+      is_continuation[next_sn] = true;
+    }
+  }
+
+  positions.assign(num_stmts, BlockPosition());
+  std::vector<bool> placed(num_stmts, false);
+  stmt_offsets.push_back(0);
+  auto add_block = [&](int first_sn) {
+    int block = stmt_offsets.size() - 1;
+    int offset = 0;
+    for (int sn = first_sn; sn != -1 && !placed[sn]; sn = get_continuation(sn)) {
+      placed[sn] = true;
+      positions[sn].block = block;
+      positions[sn].offset = offset++;
+      stmts.push_back(sn);
+    }
+    stmt_offsets.push_back(stmts.size());
+  };
+
+  for (int sn = 0; sn < num_stmts; ++sn) {
+    if (!is_continuation[sn]) {
+      add_block(sn);
+    }
+  }
+  // stmts left over lie on a cycle of straight-line stmts, which has no natural first stmt
+  for (int sn = 0; sn < num_stmts; ++sn) {
+    if (!placed[sn]) {
+      add_block(sn);
+    }
+  }
+
+  std::vector<std::pair<int, int>> edges;
+  for (int block = 0; block < CountBlocks(); ++block) {
+    for (int next_sn : cfg[GetLastStatement(block)]) {
+      edges.push_back({block, positions[next_sn].block});
+    }
+  }
+  successors = CSRGraph(CountBlocks(), edges);
+}
+
+}  // namespace design_extractor
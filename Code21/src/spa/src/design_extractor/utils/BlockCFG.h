@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "CSRGraph.h"
+
+namespace design_extractor {
+
+// where a stmt lies within the basic blocks of a BlockCFG
+struct BlockPosition {
+  int block = 0;
+  int offset = 0;
+};
+
+/*
+  A CFG with every maximal straight-line run of stmts collapsed into one basic block. A stmt joins
+  the block of its predecessor iff it is the only successor of that predecessor, which in turn is its
+  only predecessor, so paths may only enter a block at its first stmt and leave it from its last.
+  Blocks are numbered in the order of their first stmt#, and both the stmts of each block and the
+  successors of each block are stored in compressed sparse row form.
+*/
+class BlockCFG {
+ private:
+  CSRGraph successors;                   // block -> successor blocks
+  std::vector<int> stmt_offsets;         // the stmts of block b are stmts[stmt_offsets[b] .. stmt_offsets[b + 1])
+  std::vector<int> stmts;                // stmt#s, grouped by block in execution order
+  std::vector<BlockPosition> positions;  // stmt# -> (block, offset)
+
+ public:
+  BlockCFG() = default;
+  // Collapses the CFG given as adjacency lists indexed by stmt#. Stmts marked in leaders always start
+  // a block and stmts marked in terminators always end one; either may be left empty.
+  explicit BlockCFG(const std::vector<std::vector<int>>& cfg, const std::vector<bool>& leaders = {},
+                    const std::vector<bool>& terminators = {});
+
+  int CountBlocks() const { return stmt_offsets.empty() ? 0 : stmt_offsets.size() - 1; }
+  // includes node 0, which is not a stmt but keeps stmt#s usable as indices
+  int CountStatements() const { return positions.size(); }
+  const CSRGraph& GetBlockGraph() const { return successors; }
+  NodeRange GetSuccessors(int block) const { return successors.GetChildren(block); }
+  NodeRange GetStatements(int block) const {
+    return {stmts.data() + stmt_offsets[block], stmts.data() + stmt_offsets[block + 1]};
+  }
+  int GetLastStatement(int block) const { return stmts[stmt_offsets[block + 1] - 1]; }
+  const BlockPosition& GetPosition(int sn) const { return positions[sn]; }
+};
+
+}  // namespace design_extractor
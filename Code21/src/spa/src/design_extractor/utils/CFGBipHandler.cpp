@@ -5,23 +5,19 @@
 #include <iostream>
 #include <list>
 #include <queue>
-#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include "CFGHandler.h"
 #include "DeUtils.h"
+#include "design_extractor/ExtractionContext.h"
 #include "design_extractor/handler/CallHandler.h"
 #include "design_extractor/handler/EntityHandler.h"
-#include "design_extractor/handler/StatementHandler.h"
 #include "source_processor/ast/TNode.h"
 #include "source_processor/ast/TNodeType.h"
 
 namespace design_extractor {
 
-CFG CFGBipHandler::cfgbip;
-std::unordered_map<std::string, std::unordered_set<int>> CFGBipHandler::exit_stmts;
-
 int CFGBipHandler::GetProcEntryStmt(std::string proc, PKB& pkb) {
   return pkb.GetProcRange(proc).first;
   ;
@@ -85,7 +81,9 @@ start traversal of cfg from that stmt node:
 
 update exit_stmts for the current proc
 */
-void CFGBipHandler::Operate(std::string proc, PKB& pkb) {
+void CFGBipHandler::Operate(std::string proc, PKB& pkb, ExtractionContext& context) {
+  CFG& cfgbip = context.cfgbip;
+  auto& exit_stmts = context.exit_stmts;
   int entry_sn = GetProcEntryStmt(proc, pkb);
   std::unordered_set<int> exits;
 
@@ -159,33 +157,32 @@ void CFGBipHandler::Operate(std::string proc, PKB& pkb) {
 
 /*
 ALGO for constructing CFGBip: 
-clear cfgbip before population (single use DE)
-clear exit_stmts
-
 cfgbip = cfg (initially)
 get toposort of inverse call graph
 Operate on each proc in topo order.
+collapse cfgbip into basic blocks
 */
-const CFG& CFGBipHandler::ConstructCFGBip(PKB& pkb) {
-  cfgbip.clear();
-  exit_stmts.clear();
+void CFGBipHandler::ConstructCFGBip(ExtractionContext& context, PKB& pkb) {
+  CFG& cfgbip = context.cfgbip;
+  context.exit_stmts.clear();
 
-  cfgbip = CFGHandler::GetCFG();  //should be deep copy. Look here if bugs occur
+  cfgbip = context.cfg;
 
   graph inverse_call_graph = CallHandler::GetInverseCallGraph(pkb);
   auto topo_order = DeUtils::Toposort(inverse_call_graph);
   for (std::string p : topo_order) {
-    Operate(p, pkb);
+    Operate(p, pkb, context);
   }
 
-  return cfgbip;
-}
-
-const CFG& CFGBipHandler::GetCFGBip() {
-  if (cfgbip.empty()) {
-    throw std::runtime_error("CFGBipHandler::GetCFGBip: cfgbip is not yet constructed");
+  std::vector<bool> leaders(cfgbip.size(), false);
+  std::vector<bool> terminators(cfgbip.size(), false);
+  for (auto proc : pkb.GetAllProcedures()) {
+    leaders[GetProcEntryStmt(proc, pkb)] = true;
+  }
+  for (size_t sn = 1; sn < cfgbip.size(); ++sn) {
+    terminators[sn] = pkb.GetStatementType(sn) == EntityHandler::kcall_string || IsExitStmt(sn, pkb);
   }
-  return cfgbip;
+  context.block_cfgbip = BlockCFG(cfgbip, leaders, terminators);
 }
 
 }  // namespace design_extractor
\ No newline at end of file
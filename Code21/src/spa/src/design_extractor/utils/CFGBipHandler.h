@@ -1,29 +1,22 @@
 #pragma once
 
 #include <string>
-#include <vector>
 
-#include "CFGHandler.h"
 #include "pkb/PKB.h"
-#include "source_processor/ast/TNode.h"
 
 namespace design_extractor {
 
+struct ExtractionContext;
+
 class CFGBipHandler {
  private:
-  static CFG cfgbip;
-  //stores all exit stmt#s of each procedure
-  static std::unordered_map<std::string, std::unordered_set<int>> exit_stmts;
-
-  static void Operate(std::string proc, PKB& pkb);
+  static void Operate(std::string proc, PKB& pkb, ExtractionContext& context);
   static int GetProcEntryStmt(std::string proc, PKB& pkb);
 
  public:
-  // called whenever the CFGBip needs to be constructed from the CFG;
+  // constructs the CFGBip from the CFG, with its exit stmts and basic blocks, into the context;
   // must be called after CallHandler, NextHandler, CFGHandler, EntityHandler is called
-  static const CFG& ConstructCFGBip(PKB& pkb);
-  // returns the cached CFGBip; throws error when CFGBip is not yet constructed
-  static const CFG& GetCFGBip();
+  static void ConstructCFGBip(ExtractionContext& context, PKB& pkb);
   static bool IsExitStmt(int sn, PKB& pkb);
 };
 
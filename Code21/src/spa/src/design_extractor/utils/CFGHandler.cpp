@@ -10,8 +10,6 @@
 
 namespace design_extractor {
 
-CFG CFGHandler::graph;
-
 /*
 Algorithm to generate the CFG:
 
@@ -75,12 +73,11 @@ void CFGHandler::ConnectLastStmtsOfIf(CFG& graph, const int exit_stmt_num,
   }
 }
 
-const CFG& CFGHandler::ConstructCFG(const source_processor::TNode& root) {
+CFG CFGHandler::ConstructCFG(const source_processor::TNode& root) {
   // get max statement number
   int max_stmt_num = StatementHandler::GetMaxStmtNum(root);
   // graph is an adjacency list; needs exactly (max_stmt_num + 1) space
-  graph.clear();
-  graph.resize(max_stmt_num + 1);  // note: NOT reserve (will lead to segfault)
+  CFG graph(max_stmt_num + 1);
 
   // traverse AST in BFS order
   std::list<source_processor::TNode> queue;
@@ -138,11 +135,4 @@ const CFG& CFGHandler::ConstructCFG(const source_processor::TNode& root) {
   return graph;
 }
 
-const CFG& CFGHandler::GetCFG() {
-  if (graph.empty()) {
-    throw std::runtime_error("CFGHandler::GetCFG: graph is not yet constructed");
-  }
-  return graph;
-}
-
 }  // namespace design_extractor
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "BlockCFG.h"
 #include "source_processor/ast/TNode.h"
 
 namespace design_extractor {
@@ -10,16 +11,12 @@ typedef std::vector<std::vector<int>> CFG;
 
 class CFGHandler {
  private:
-  static CFG graph;
   static void ConnectLastStmtOfWhile(CFG&, const int, const source_processor::TNode&);
   static void ConnectLastStmtsOfIf(CFG&, const int, const source_processor::TNode&);
 
  public:
-  // called whenever the CFG needs to be constructed from scratch;
-  // must be called after StatementHandler::ExtractStmtNums is called
-  static const CFG& ConstructCFG(const source_processor::TNode&);
-  // returns the cached CFG; throws error when CFG is not yet constructed
-  static const CFG& GetCFG();
+  // constructs the CFG of the program from scratch, as adjacency lists indexed by stmt#
+  static CFG ConstructCFG(const source_processor::TNode&);
 };
 
 }  // namespace design_extractor
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "CSRGraph.h"
+
+#include <utility>
+#include <vector>
+
+namespace design_extractor {
+
+CSRGraph::CSRGraph(int num_nodes, const std::vector<std::pair<int, int>>& edges) {
+  // count the children of every node, then place each edge after those of its node added before it
+  offsets.assign(num_nodes + 1, 0);
+  for (const auto& edge : edges) {
+    offsets[edge.first + 1]++;
+  }
+  for (int node = 0; node < num_nodes; node++) {
+    offsets[node + 1] += offsets[node];
+  }
+
+  targets.resize(edges.size());
+  std::vector<int> next_slot(offsets.begin(), offsets.end() - 1);
+  for (const auto& edge : edges) {
+    targets[next_slot[edge.first]++] = edge.second;
+  }
+}
+
+CSRGraph::CSRGraph(const std::vector<std::vector<int>>& adjacency_list) {
+  offsets.reserve(adjacency_list.size() + 1);
+  offsets.push_back(0);
+  for (const auto& children : adjacency_list) {
+    targets.insert(targets.end(), children.begin(), children.end());
+    offsets.push_back(targets.size());
+  }
+}
+
+}  // namespace design_extractor
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace design_extractor {
+
+// Children of a node, as a range over the edge targets of a graph
+struct NodeRange {
+  const int* first;
+  const int* last;
+
+  const int* begin() const { return first; }
+  const int* end() const { return last; }
+  int size() const { return last - first; }
+  int operator[](int i) const { return first[i]; }
+};
+
+// A directed graph over nodes 0..n-1 in compressed sparse row form: the children of node i
+// are the targets between offsets[i] and offsets[i + 1], in the order their edges were added.
+class CSRGraph {
+ private:
+  std::vector<int> offsets;
+  std::vector<int> targets;
+
+ public:
+  CSRGraph() = default;
+  CSRGraph(int num_nodes, const std::vector<std::pair<int, int>>& edges);
+  explicit CSRGraph(const std::vector<std::vector<int>>& adjacency_list);
+
+  int CountNodes() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+  int CountEdges() const { return targets.size(); }
+  NodeRange GetChildren(int node) const {
+    return {targets.data() + offsets[node], targets.data() + offsets[node + 1]};
+  }
+};
+
+}  // namespace design_extractor
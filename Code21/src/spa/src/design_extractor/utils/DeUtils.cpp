@@ -91,30 +91,6 @@ std::vector<std::string> DeUtils::Toposort(graph& call_graph) {
   }
 }
 
-//BFS outward from src, marking all nodes that can be reached
-std::unordered_set<int> DeUtils::GetReachableNodes(int src, const CFG& cfg) {
-  std::unordered_set<int> reachable_nodes;
-  std::queue<int> q;
-
-  //in normal BFS, src node is marked as visited first
-  //but if src is marked as visited, that means Next*(src, src) is true,
-  //which is not always true
-  //reachable_nodes.insert(src);
-  q.push(src);
-
-  while (!q.empty()) {
-    auto cur = q.front();
-    q.pop();
-    for (auto e : cfg[cur]) {
-      if (reachable_nodes.find(e) == reachable_nodes.end()) {
-        reachable_nodes.insert(e);
-        q.push(e);
-      }
-    }
-  }
-  return reachable_nodes;
-}
-
 void DeUtils::PrintSet(std::string set_name, std::unordered_set<int> set) {
   std::cout << "in " << set_name << " : ";
   for (auto e : set) {
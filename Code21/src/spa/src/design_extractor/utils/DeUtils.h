@@ -30,13 +30,6 @@ class DeUtils {
    */
   static std::vector<std::string> Toposort(graph& call_graph);
 
-  /*
-  BFS outward from src, marking all nodes that can be reached, without marking src as reached initially.
-  In normal BFS, src node is marked as visited first.
-  But if src is marked as visited, that means Relation(src, src) is true, which is not always true
-  */
-  static std::unordered_set<int> GetReachableNodes(int src, const CFG& cfg);
-
   static void PrintSet(std::string set_name, std::unordered_set<int> set);
 };
 
@@ -0,0 +1,111 @@
+#include "MultiSourceBFS.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "utils/Cancellation.h"
+
+namespace design_extractor {
+
+MultiSourceBFS::MultiSourceBFS(const CSRGraph& graph) : graph(graph) {
+  // iterative DFS from every unvisited node, recording nodes as they finish
+  const int num_nodes = graph.CountNodes();
+  std::vector<bool> visited(num_nodes, false);
+  std::vector<std::pair<int, int>> stack;  // <node, next child to explore>
+  order.reserve(num_nodes);
+  for (int root = 0; root < num_nodes; ++root) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    stack.push_back(std::make_pair(root, 0));
+    while (!stack.empty()) {
+      int node = stack.back().first;
+      NodeRange children = graph.GetChildren(node);
+      if (stack.back().second < children.size()) {
+        int child = children[stack.back().second++];
+        if (!visited[child]) {
+          visited[child] = true;
+          stack.push_back(std::make_pair(child, 0));
+        }
+        continue;
+      }
+      stack.pop_back();
+      order.push_back(node);
+    }
+  }
+  std::reverse(order.begin(), order.end());
+
+  rank.resize(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    rank[order[i]] = i;
+  }
+}
+
+void MultiSourceBFS::RunBatch(const std::vector<int>& sources, int first, std::vector<uint64_t>& reached) const {
+  const int num_nodes = graph.CountNodes();
+  const int last = std::min<int>(first + kLanes, sources.size());
+  reached.assign(num_nodes, 0);
+  std::vector<uint64_t> frontier(num_nodes, 0);  // lanes that reached a node but are not yet passed on
+  std::priority_queue<int, std::vector<int>, std::greater<int>> queue;  // ranks of nodes with a frontier
+
+  auto push = [&frontier, &queue, this](int node, uint64_t lanes) {
+    if (frontier[node] == 0) {
+      queue.push(rank[node]);
+    }
+    frontier[node] |= lanes;
+  };
+
+  for (int i = first; i < last; ++i) {
+    push(sources[i], uint64_t(1) << (i - first));
+  }
+
+  while (!queue.empty()) {
+    utils::Cancellation::Check();
+    int node = order[queue.top()];
+    queue.pop();
+    uint64_t lanes = frontier[node];
+    frontier[node] = 0;
+    for (int child : graph.GetChildren(node)) {
+      uint64_t new_lanes = lanes & ~reached[child];
+      if (new_lanes != 0) {
+        reached[child] |= new_lanes;
+        push(child, new_lanes);
+      }
+    }
+  }
+}
+
+std::vector<std::unordered_set<int>> MultiSourceBFS::GetReachableNodes(const CSRGraph& graph,
+                                                                      const std::vector<int>& sources) {
+  MultiSourceBFS bfs(graph);
+  std::vector<std::unordered_set<int>> reachable(sources.size());
+  std::vector<uint64_t> reached;
+  for (size_t first = 0; first < sources.size(); first += kLanes) {
+    bfs.RunBatch(sources, first, reached);
+    // fill one set at a time, each sized up front, rather than spreading every node over the batch
+    int num_lanes = std::min<int>(kLanes, sources.size() - first);
+    for (int lane = 0; lane < num_lanes; ++lane) {
+      uint64_t mask = uint64_t(1) << lane;
+      int count = 0;
+      for (uint64_t lanes : reached) {
+        count += (lanes & mask) != 0;
+      }
+      auto& nodes = reachable[first + lane];
+      nodes.reserve(count);
+      for (size_t node = 0; node < reached.size(); ++node) {
+        if (reached[node] & mask) {
+          nodes.insert(node);
+        }
+      }
+    }
+  }
+  return reachable;
+}
+
+}  // namespace design_extractor
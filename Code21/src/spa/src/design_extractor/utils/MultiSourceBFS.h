@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "CSRGraph.h"
+
+namespace design_extractor {
+
+/*
+  Reachability from many sources at once. Sources are taken kLanes at a time, and every node carries
+  one word with a bit lane per source of the batch, so a single pass over the edges moves the search
+  of every source in the batch forward. Nodes are visited in reverse postorder, so a node has mostly
+  collected the lanes of its predecessors before it passes them on, and it is only visited again when
+  a back edge brings it a lane it did not have. Each batch then costs a few BFS, instead of one BFS
+  per source.
+  A source is not marked as reached initially, so a source only reaches itself when it lies on a cycle.
+  Only Affects* is extracted this way. Next* and NextBip* past the materialisation limit are answered per
+  stmt from the NextT labels and the NextBip* reachability index, so their queries never search the CFG.
+*/
+class MultiSourceBFS {
+ private:
+  const CSRGraph& graph;
+  std::vector<int> order;  // nodes in reverse postorder
+  std::vector<int> rank;   // node -> its index in order
+
+ public:
+  static const int kLanes = 64;
+
+  explicit MultiSourceBFS(const CSRGraph& graph);
+
+  // runs one batch of at most kLanes sources; afterwards bit i of reached[v] is set iff node v is
+  // reachable from sources[first + i]
+  void RunBatch(const std::vector<int>& sources, int first, std::vector<uint64_t>& reached) const;
+
+  // for each source, the nodes reachable from it through at least one edge
+  static std::vector<std::unordered_set<int>> GetReachableNodes(const CSRGraph& graph, const std::vector<int>& sources);
+};
+
+}  // namespace design_extractor
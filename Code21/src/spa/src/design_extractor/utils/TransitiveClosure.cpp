@@ -0,0 +1,137 @@
+#include "TransitiveClosure.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "utils/Cancellation.h"
+
+namespace design_extractor {
+
+namespace {
+
+const int kWordBits = 64;
+
+void SetBit(BitsetRow& row, int label) {
+  row[label / kWordBits] |= uint64_t(1) << (label % kWordBits);
+}
+
+void OrInto(BitsetRow& receive, const BitsetRow& give) {
+  for (size_t i = 0; i < receive.size(); ++i) {
+    receive[i] |= give[i];
+  }
+}
+
+}  // namespace
+
+TransitiveClosure::TransitiveClosure(const CSRGraph& graph, const std::vector<int>& labels, int num_labels) {
+  const int num_nodes = graph.CountNodes();
+  const int num_words = (num_labels + kWordBits - 1) / kWordBits;
+  component_of.assign(num_nodes, -1);
+
+  // iterative Tarjan; components are completed sinks first, which is the order rows must be built in
+  std::vector<int> index(num_nodes, -1);
+  std::vector<int> lowlink(num_nodes, 0);
+  std::vector<bool> on_stack(num_nodes, false);
+  std::vector<int> scc_stack;
+  std::vector<std::pair<int, size_t>> call_stack;  // <node, next edge to explore>
+  std::vector<int> last_merged;                     // last component whose row each component was merged into
+  int next_index = 0;
+
+  for (int root = 0; root < num_nodes; ++root) {
+    if (index[root] != -1) {
+      continue;
+    }
+    call_stack.push_back(std::make_pair(root, 0));
+    index[root] = lowlink[root] = next_index++;
+    scc_stack.push_back(root);
+    on_stack[root] = true;
+
+    while (!call_stack.empty()) {
+      utils::Cancellation::Check();
+      int node = call_stack.back().first;
+      size_t& edge = call_stack.back().second;
+
+      NodeRange children = graph.GetChildren(node);
+      if (edge < static_cast<size_t>(children.size())) {
+        int child = children[edge++];
+        if (index[child] == -1) {
+          index[child] = lowlink[child] = next_index++;
+          scc_stack.push_back(child);
+          on_stack[child] = true;
+          call_stack.push_back(std::make_pair(child, 0));
+        } else if (on_stack[child]) {
+          lowlink[node] = std::min(lowlink[node], index[child]);
+        }
+        continue;
+      }
+
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        int parent = call_stack.back().first;
+        lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
+      }
+      if (lowlink[node] != index[node]) {
+        continue;
+      }
+
+      // node is the root of a completed component: pop its members and build its row
+      int component = rows.size();
+      std::vector<int> members;
+      int member;
+      do {
+        member = scc_stack.back();
+        scc_stack.pop_back();
+        on_stack[member] = false;
+        component_of[member] = component;
+        members.push_back(member);
+      } while (member != node);
+
+      rows.push_back(BitsetRow(num_words, 0));
+      last_merged.push_back(-1);
+      BitsetRow& row = rows.back();
+      bool is_cyclic = members.size() > 1;
+      for (int m : members) {
+        for (int child : graph.GetChildren(m)) {
+          int child_component = component_of[child];
+          if (child_component == component) {
+            is_cyclic = true;
+            continue;
+          }
+          SetBit(row, labels[child]);
+          if (last_merged[child_component] != component) {
+            last_merged[child_component] = component;
+            OrInto(row, rows[child_component]);
+          }
+        }
+      }
+      if (is_cyclic) {
+        for (int m : members) {
+          SetBit(row, labels[m]);
+        }
+      }
+    }
+  }
+}
+
+const BitsetRow& TransitiveClosure::GetRow(int node) const {
+  return rows[component_of[node]];
+}
+
+bool TransitiveClosure::Test(const BitsetRow& row, int label) {
+  return (row[label / kWordBits] >> (label % kWordBits)) & 1;
+}
+
+std::unordered_set<int> TransitiveClosure::ToSet(const BitsetRow& row) {
+  std::unordered_set<int> labels;
+  for (size_t i = 0; i < row.size(); ++i) {
+    uint64_t word = row[i];
+    while (word != 0) {
+      int bit = __builtin_ctzll(word);
+      labels.insert(i * kWordBits + bit);
+      word &= word - 1;
+    }
+  }
+  return labels;
+}
+
+}  // namespace design_extractor
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "CSRGraph.h"
+
+namespace design_extractor {
+
+typedef std::vector<uint64_t> BitsetRow;
+
+/*
+  Reachability closure of a directed graph, stored as one bitset row per strongly connected component.
+  Every node carries a label (e.g. the stmt# it stands for); several nodes may share a label.
+  The row of a node has bit `label[w]` set for every node w reachable from it through at least one edge,
+  so a node only reaches itself when it lies on a cycle.
+  Built in O(V + E * L / 64) for L labels, by propagating rows over the condensation in reverse topological order.
+*/
+class TransitiveClosure {
+ private:
+  std::vector<int> component_of;
+  std::vector<BitsetRow> rows;
+
+ public:
+  TransitiveClosure(const CSRGraph& graph, const std::vector<int>& labels, int num_labels);
+
+  const BitsetRow& GetRow(int node) const;
+
+  static bool Test(const BitsetRow& row, int label);
+  static std::unordered_set<int> ToSet(const BitsetRow& row);
+};
+
+}  // namespace design_extractor
@@ -1,102 +1,144 @@
 #include "PKB.h"
 
+#include <stdexcept>
+#include <utility>
+
+std::atomic<uint64_t> PKB::last_generation_id(0);
+
 bool PKB::InsertVariable(const std::string& variable) {
+  ThrowIfFrozen("PKB::InsertVariable");
   return var_table.Insert(variable);
 }
 
 bool PKB::InsertStatement(int stmt_index) {
+  ThrowIfFrozen("PKB::InsertStatement");
   return stmt_table.Insert(stmt_index);
 }
 
 bool PKB::InsertConstant(int constant) {
+  ThrowIfFrozen("PKB::InsertConstant");
   return const_table.Insert(constant);
 }
 
 bool PKB::InsertIf(int stmt_index, const std::vector<std::string>& variable_list) {
+  ThrowIfFrozen("PKB::InsertIf");
   return container_table.InsertIf(stmt_index, variable_list);
 }
 
 bool PKB::InsertWhile(int stmt_index, const std::vector<std::string>& variable_list) {
+  ThrowIfFrozen("PKB::InsertWhile");
   return container_table.InsertWhile(stmt_index, variable_list);
 }
 
 bool PKB::InsertRead(int stmt_index, const std::string& var_name) {
+  ThrowIfFrozen("PKB::InsertRead");
   return read_table.Insert(stmt_index, var_name);
 }
 
 bool PKB::InsertPrint(int stmt_index, const std::string& var_name) {
+  ThrowIfFrozen("PKB::InsertPrint");
   return print_table.Insert(stmt_index, var_name);
 }
 
 bool PKB::InsertCalls(int stmt_index, const std::string& proc_name) {
+  ThrowIfFrozen("PKB::InsertCalls");
   return calls_table.InsertCalls(stmt_index, proc_name);
 }
 
 bool PKB::InsertCalls(const std::string& caller, const std::string& callee) {
+  ThrowIfFrozen("PKB::InsertCalls");
   return calls_table.InsertCalls(caller, callee);
 }
 
 bool PKB::InsertCallsT(const std::string& caller, const std::string& callee) {
+  ThrowIfFrozen("PKB::InsertCallsT");
   return calls_table.InsertCallsT(caller, callee);
 }
 
 bool PKB::InsertAssignment(int stmt_index, const std::string& assigned_var, const source_processor::TokenList& token_list) {
+  ThrowIfFrozen("PKB::InsertAssignment");
   return assign_table.InsertAssign(stmt_index, assigned_var, token_list);
 }
 
 bool PKB::InsertProcedure(const std::string& proc_name, int start_index, int end_index) {
+  ThrowIfFrozen("PKB::InsertProcedure");
   return proc_table.InsertProc(proc_name, std::pair<int, int>(start_index, end_index));
 }
 
 bool PKB::InsertEntity(int stmt_index, const std::string& entity) {
+  ThrowIfFrozen("PKB::InsertEntity");
   return entity_table.InsertEntity(stmt_index, entity);
 }
 
 bool PKB::InsertFollows(int stmt1, int stmt2) {
+  ThrowIfFrozen("PKB::InsertFollows");
   return follows_table.InsertFollows(stmt1, stmt2);
 }
 
 bool PKB::InsertFollowsT(int stmt1, int stmt2) {
+  ThrowIfFrozen("PKB::InsertFollowsT");
   return follows_T_table.InsertFollowsT(stmt1, stmt2);
 }
 
 bool PKB::InsertParent(int stmt1, int stmt2) {
+  ThrowIfFrozen("PKB::InsertParent");
   return parent_table.InsertParent(stmt1, stmt2);
 }
 
 bool PKB::InsertParentT(int stmt1, int stmt2) {
+  ThrowIfFrozen("PKB::InsertParentT");
   return parent_T_table.InsertParentT(stmt1, stmt2);
 }
 
 bool PKB::InsertModifies(int stmt_index, const std::string& variable) {
+  ThrowIfFrozen("PKB::InsertModifies");
   return modifies_table.InsertStmtModifies(stmt_index, variable);
 }
 
 bool PKB::InsertModifies(const std::string& proc_name, const std::string& variable) {
+  ThrowIfFrozen("PKB::InsertModifies");
   return modifies_table.InsertProcModifies(proc_name, variable);
 }
 
 bool PKB::InsertUses(int stmt_index, const std::string& variable) {
+  ThrowIfFrozen("PKB::InsertUses");
   return uses_table.InsertStmtUses(stmt_index, variable);
 }
 
 bool PKB::InsertUses(const std::string& proc_name, const std::string& variable) {
+  ThrowIfFrozen("PKB::InsertUses");
   return uses_table.InsertProcUses(proc_name, variable);
 }
 
 bool PKB::InsertNext(int prog_line1, int prog_line2) {
+  ThrowIfFrozen("PKB::InsertNext");
   return next_table.InsertNext(prog_line1, prog_line2);
 }
 
 bool PKB::InsertNextT(int prog_line1, int prog_line2) {
+  ThrowIfFrozen("PKB::InsertNextT");
   return next_table.InsertNextT(prog_line1, prog_line2);
 }
 
+bool PKB::InsertNextT(int prog_line1, const std::unordered_set<int>& prog_line2s) {
+  ThrowIfFrozen("PKB::InsertNextT");
+  return next_table.InsertNextT(prog_line1, prog_line2s);
+}
+
+bool PKB::InsertNextTLabel(int prog_line, const StatementLabel& label) {
+  ThrowIfFrozen("PKB::InsertNextTLabel");
+  return next_table.InsertNextTLabel(prog_line, label);
+}
+
 bool PKB::IsNext(int prog_line1, int prog_line2) {
   return next_table.IsNext(prog_line1, prog_line2);
 }
 
 bool PKB::IsNextT(int prog_line1, int prog_line2) {
+  // an unmaterialised NextT is derived from Next edges or stmt labels, neither of which leave a procedure
+  if (!next_table.IsNextTMaterialised() && GetProcRangeOfStmt(prog_line1) != GetProcRangeOfStmt(prog_line2)) {
+    return false;
+  }
   return next_table.IsNextT(prog_line1, prog_line2);
 }
 
@@ -162,6 +204,10 @@ std::pair<int, int> PKB::GetProcRange(const std::string& proc_name) {
   return proc_table.GetProcRange(proc_name);
 }
 
+std::pair<int, int> PKB::GetProcRangeOfStmt(int stmt_index) {
+  return proc_table.GetProcRangeOfStmt(stmt_index);
+}
+
 bool PKB::IsCalls(const std::string& caller, const std::string& callee) {
   return calls_table.IsCalls(caller, callee);
 }
@@ -286,11 +332,11 @@ std::string PKB::GetAssignedVariable(int stmt_index) {
   return assign_table.GetAssignedVariable(stmt_index);
 }
 
-std::unordered_set<int> PKB::GetAllAssignStmtsThatMatches(source_processor::TokenList& rhs_expression) {
+std::unordered_set<int> PKB::GetAllAssignStmtsThatMatches(const source_processor::TokenList& rhs_expression) {
   return assign_table.GetAllAssignStmtsThatMatches(rhs_expression);
 }
 
-std::unordered_set<int> PKB::GetAllAssignStmtsThatContains(source_processor::TokenList& rhs_expression) {
+std::unordered_set<int> PKB::GetAllAssignStmtsThatContains(const source_processor::TokenList& rhs_expression) {
   return assign_table.GetAllAssignStmtsThatContains(rhs_expression);
 }
 
@@ -419,6 +465,7 @@ std::unordered_set<int> PKB::GetPreviousTStatements(int prog_line) {
 }
 
 bool PKB::InsertAffects(int assign_stmt1, int assign_stmt2) {
+  ThrowIfFrozen("PKB::InsertAffects");
   return affects_table.InsertAffects(assign_stmt1, assign_stmt2);
 }
 
@@ -443,10 +490,20 @@ std::unordered_set<int> PKB::GetAllAffectedStatements() {
 }
 
 bool PKB::InsertAffectsT(int assign_stmt1, int assign_stmt2) {
+  ThrowIfFrozen("PKB::InsertAffectsT");
   return affects_table.InsertAffectsT(assign_stmt1, assign_stmt2);
 }
 
+bool PKB::InsertAffectsT(int assign_stmt1, const std::unordered_set<int>& assign_stmt2s) {
+  ThrowIfFrozen("PKB::InsertAffectsT");
+  return affects_table.InsertAffectsT(assign_stmt1, assign_stmt2s);
+}
+
 bool PKB::IsAffectsT(int assign_stmt1, int assign_stmt2) {
+  // an unmaterialised AffectsT is searched over Affects edges, which never leave a procedure
+  if (!affects_table.IsAffectsTMaterialised() && GetProcRangeOfStmt(assign_stmt1) != GetProcRangeOfStmt(assign_stmt2)) {
+    return false;
+  }
   return affects_table.IsAffectsT(assign_stmt1, assign_stmt2);
 }
 
@@ -467,13 +524,20 @@ std::unordered_set<int> PKB::GetAllAffectedTStatements() {
 }
 
 bool PKB::InsertNextBip(int prog_line1, int prog_line2) {
+  ThrowIfFrozen("PKB::InsertNextBip");
   return nextbip_table.InsertNextBip(prog_line1, prog_line2);
 }
 
 bool PKB::InsertNextBipT(int prog_line1, int prog_line2) {
+  ThrowIfFrozen("PKB::InsertNextBipT");
   return nextbip_table.InsertNextBipT(prog_line1, prog_line2);
 }
 
+bool PKB::InsertNextBipT(int prog_line1, const std::unordered_set<int>& prog_line2s) {
+  ThrowIfFrozen("PKB::InsertNextBipT");
+  return nextbip_table.InsertNextBipT(prog_line1, prog_line2s);
+}
+
 bool PKB::IsNextBip(int prog_line1, int prog_line2) {
   return nextbip_table.IsNextBip(prog_line1, prog_line2);
 }
@@ -515,9 +579,15 @@ std::unordered_set<int> PKB::GetPreviousBipTStatements(int prog_line) {
 }
 
 bool PKB::InsertAffectsBip(int assign_stmt1, int assign_stmt2) {
+  ThrowIfFrozen("PKB::InsertAffectsBip");
   return affects_bip_table.InsertAffectsBip(assign_stmt1, assign_stmt2);
 }
 
+bool PKB::InsertAffectsBip(int assign_stmt1, const std::unordered_set<int>& assign_stmts2) {
+  ThrowIfFrozen("PKB::InsertAffectsBip");
+  return affects_bip_table.InsertAffectsBip(assign_stmt1, assign_stmts2);
+}
+
 bool PKB::IsAffectsBip(int assign_stmt1, int assign_stmt2) {
   return affects_bip_table.IsAffectsBip(assign_stmt1, assign_stmt2);
 }
@@ -539,9 +609,15 @@ std::unordered_set<int> PKB::GetAllAffectedBipStatements() {
 }
 
 bool PKB::InsertAffectsBipT(int assign_stmt1, int assign_stmt2) {
+  ThrowIfFrozen("PKB::InsertAffectsBipT");
   return affects_bip_table.InsertAffectsBipT(assign_stmt1, assign_stmt2);
 }
 
+bool PKB::InsertAffectsBipT(int assign_stmt1, const std::unordered_set<int>& assign_stmts2) {
+  ThrowIfFrozen("PKB::InsertAffectsBipT");
+  return affects_bip_table.InsertAffectsBipT(assign_stmt1, assign_stmts2);
+}
+
 bool PKB::IsAffectsBipT(int assign_stmt1, int assign_stmt2) {
   return affects_bip_table.IsAffectsBipT(assign_stmt1, assign_stmt2);
 }
@@ -562,6 +638,85 @@ std::unordered_set<int> PKB::GetAllAffectedBipTStatements() {
   return affects_bip_table.GetAllAffectedBipTStatements();
 }
 
+void PKB::SetExtension(const utils::Extension& new_extension) {
+  extension = new_extension;
+}
+
+const utils::Extension& PKB::GetExtension() const {
+  return extension;
+}
+
+void PKB::SetMaxMaterialisedStatements(int max_stmts) {
+  max_materialised_stmts = max_stmts;
+}
+
+bool PKB::ShouldMaterialiseTransitiveRelations() {
+  return max_materialised_stmts >= 0 && stmt_table.GetAll().size() <= static_cast<size_t>(max_materialised_stmts);
+}
+
+bool PKB::IsNextTMaterialised() {
+  return next_table.IsNextTMaterialised();
+}
+
+bool PKB::IsNextBipTMaterialised() {
+  return nextbip_table.IsNextBipTMaterialised();
+}
+
+bool PKB::IsAffectsTMaterialised() {
+  return affects_table.IsAffectsTMaterialised();
+}
+
+void PKB::InsertNextBipTIndex(StatementReachability index) {
+  ThrowIfFrozen("PKB::InsertNextBipTIndex");
+  nextbip_table.SetNextBipTIndex(std::move(index));
+}
+
+void PKB::IndexAffectsT() {
+  ThrowIfFrozen("PKB::IndexAffectsT");
+  affects_table.IndexAffectsT();
+}
+
+const StatementReachability& PKB::GetNextBipTIndex() {
+  return nextbip_table.GetNextBipTIndex();
+}
+
+const StatementReachability& PKB::GetAffectsTIndex() {
+  return affects_table.GetAffectsTIndex();
+}
+
+const CompressedBitmap* PKB::GetNextTRow(int stmt) {
+  return next_table.GetNextTRow(stmt);
+}
+
+const CompressedBitmap* PKB::GetNextBipTRow(int stmt) {
+  return nextbip_table.GetNextBipTRow(stmt);
+}
+
+const CompressedBitmap* PKB::GetAffectsTRow(int assign_stmt) {
+  return affects_table.GetAffectsTRow(assign_stmt);
+}
+
+const CompressedBitmap* PKB::GetAffectsBipTRow(int assign_stmt) {
+  return affects_bip_table.GetAffectsBipTRow(assign_stmt);
+}
+
+size_t PKB::CountCompressedBytes() {
+  return next_table.CountCompressedNextTBytes() + nextbip_table.CountCompressedNextBipTBytes() +
+         affects_table.CountCompressedAffectsTBytes() + affects_bip_table.CountCompressedAffectsBipTBytes();
+}
+
+void PKB::ReserveTables(int num_stmts, int num_vars) {
+  ThrowIfFrozen("PKB::ReserveTables");
+  stmt_table.Reserve(num_stmts);
+  var_table.Reserve(num_vars);
+  entity_table.ReserveEntityTable(num_stmts);
+  follows_table.ReserveFollowsTable(num_stmts);
+  parent_table.ReserveParentTable(num_stmts);
+  modifies_table.ReserveModifiesTable(num_stmts, num_vars);
+  uses_table.ReserveUsesTable(num_stmts, num_vars);
+  next_table.ReserveNextTable(num_stmts);
+}
+
 void PKB::ClearAllTables() {
   var_table.ClearTable();
   stmt_table.ClearTable();
@@ -583,4 +738,29 @@ void PKB::ClearAllTables() {
   affects_table.ClearAffectsTable();
   nextbip_table.ClearNextBipTable();
   affects_bip_table.ClearAffectsBipTable();
+  is_frozen = false;
+  generation_id = 0;
+}
+
+void PKB::Freeze() {
+  next_table.CompressNextTTables();
+  nextbip_table.CompressNextBipTTables();
+  affects_table.CompressAffectsTTables();
+  affects_bip_table.CompressAffectsBipTTables();
+  is_frozen = true;
+  generation_id = ++last_generation_id;
+}
+
+bool PKB::IsFrozen() const {
+  return is_frozen;
+}
+
+uint64_t PKB::GetGenerationId() const {
+  return generation_id;
+}
+
+void PKB::ThrowIfFrozen(const std::string& api) const {
+  if (is_frozen) {
+    throw std::runtime_error(api + ": PKB is frozen and can no longer be modified");
+  }
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -23,8 +25,11 @@
 #include "pkb/templates/Table.h"
 #include "pkb/templates/TableSingle.h"
 #include "source_processor/token/TokenList.h"
+#include "utils/Extension.h"
 
 class PKB {
+  friend class PKBSnapshot;  // reads and restores the underlying tables directly
+
  private:
   Table<std::string> var_table;
   Table<int> stmt_table;
@@ -46,8 +51,19 @@ class PKB {
   AffectsTable affects_table;
   NextBipTable nextbip_table;
   AffectsBipTable affects_bip_table;
+  int max_materialised_stmts = kDefaultMaxMaterialisedStatements;
+  utils::Extension extension;
+  bool is_frozen = false;
+  uint64_t generation_id = 0;
+
+  static std::atomic<uint64_t> last_generation_id;
+
+  void ThrowIfFrozen(const std::string &) const;
 
  public:
+  // programs with more stmts answer Next*, NextBip* and Affects* from indexes instead of materialising them
+  static const int kDefaultMaxMaterialisedStatements = 2000;
+
   PKB(){};
 
   /* ----------------------------------- All APIs related to Variables ----------------------------------- */
@@ -232,14 +248,14 @@ class PKB {
    * @params TokenList rhs_expression
    * @return unordered_set<int> of stmt_index
    */
-  virtual std::unordered_set<int> GetAllAssignStmtsThatMatches(source_processor::TokenList &);
+  virtual std::unordered_set<int> GetAllAssignStmtsThatMatches(const source_processor::TokenList &);
 
   /**
    * Gets all assign statements whose RHS contains a given rhs_sub_expression
    * @params TokenList rhs_sub_expression
    * @return unordered_set<int> of stmt_index
    */
-  virtual std::unordered_set<int> GetAllAssignStmtsThatContains(source_processor::TokenList &);
+  virtual std::unordered_set<int> GetAllAssignStmtsThatContains(const source_processor::TokenList &);
 
   /* ----------------------------------- All APIs related to Procedure ----------------------------------- */
 
@@ -257,6 +273,13 @@ class PKB {
    */
   std::pair<int, int> GetProcRange(const std::string &);
 
+  /**
+   * Get the start and end statement indexes of the procedure containing a given statement
+   * @params int stmt_index
+   * @return pair(int, int) of start and end indexes, or (0, 0) if no procedure contains it
+   */
+  std::pair<int, int> GetProcRangeOfStmt(int);
+
   /**
    * Gets all procedures stored in proc_table
    * @params
@@ -741,6 +764,20 @@ class PKB {
    */
   bool InsertNextT(int, int);
 
+  /**
+   * Inserts NextT(prog_line1, prog_line2) relationships for every prog_line2 in a set with one lookup of prog_line1
+   * @params int prog_line1, unordered_set<int> prog_line2s
+   * @return bool
+   */
+  bool InsertNextT(int, const std::unordered_set<int> &);
+
+  /**
+   * Inserts the label of a statement into next_table, from which NextT is answered when it is not materialised
+   * @params int prog_line, StatementLabel label
+   * @return bool
+   */
+  bool InsertNextTLabel(int, const StatementLabel &);
+
   /**
    * Check if Next(prog_line1, prog_line2) relationship holds
    * @params int prog_line1, int prog_line2
@@ -862,6 +899,13 @@ class PKB {
    */
   bool InsertAffectsT(int, int);
 
+  /**
+   * Inserts AffectsT(assign_stmt1, assign_stmt2) relationships for every assign_stmt2 in a set
+   * @params int assign_stmt1, unordered_set<int> assign_stmt2s
+   * @return bool
+   */
+  bool InsertAffectsT(int, const std::unordered_set<int> &);
+
   /**
    * Checks if AffectsT(assign_stmt1, assign_stmt2) holds
    * @params int assign_stmt1, int assign_stmt2
@@ -913,6 +957,13 @@ class PKB {
    */
   bool InsertNextBipT(int, int);
 
+  /**
+   * Inserts NextBipT(prog_line1, prog_line2) relationships for every prog_line2 in a set with one lookup of prog_line1
+   * @params int prog_line1, unordered_set<int> prog_line2s
+   * @return bool
+   */
+  bool InsertNextBipT(int, const std::unordered_set<int> &);
+
   /**
    * Check if NextBip(prog_line1, prog_line2) relationship holds
    * @params int prog_line1, int prog_line2
@@ -992,6 +1043,13 @@ class PKB {
    */
   bool InsertAffectsBip(int, int);
 
+  /**
+   * Inserts AffectsBip(assign_stmt1, assign_stmt2) for every assign_stmt2 in a set with one lookup of assign_stmt1
+   * @params int assign_stmt1, unordered_set<int> assign_stmt2s
+   * @return bool
+   */
+  bool InsertAffectsBip(int, const std::unordered_set<int> &);
+
   /**
    * Checks if Affects(assign_stmt1, assign_stmt2) holds
    * @params int assign_stmt1, int assign_stmt2
@@ -1034,6 +1092,13 @@ class PKB {
    */
   bool InsertAffectsBipT(int, int);
 
+  /**
+   * Inserts AffectsBipT(assign_stmt1, assign_stmt2) for every assign_stmt2 in a set with one lookup of assign_stmt1
+   * @params int assign_stmt1, unordered_set<int> assign_stmt2s
+   * @return bool
+   */
+  bool InsertAffectsBipT(int, const std::unordered_set<int> &);
+
   /**
    * Checks if AffectsT(assign_stmt1, assign_stmt2) holds
    * @params int assign_stmt1, int assign_stmt2
@@ -1069,10 +1134,163 @@ class PKB {
    */
   std::unordered_set<int> GetAllAffectedBipTStatements();
 
+  /* ------------------------------------- All APIs related to the extensions ------------------------------------- */
+
+  /**
+   * Sets the extensions extracted into the PKB, which are the only extension clauses queries may use
+   * @params utils::Extension extension
+   * @return
+   */
+  void SetExtension(const utils::Extension&);
+
   /**
-   * Clears all underlying tables of the PKB to size 0
+   * Get the extensions extracted into the PKB
+   * @params
+   * @return utils::Extension
+   */
+  const utils::Extension& GetExtension() const;
+
+  /* ------------------------- All APIs related to the storage of transitive relationships ------------------------- */
+
+  /**
+   * Sets the largest number of statements for which NextT, NextBipT and AffectsT are materialised
+   * @params int max_stmts
+   * @return
+   */
+  void SetMaxMaterialisedStatements(int);
+
+  /**
+   * Checks whether NextT, NextBipT and AffectsT should be materialised for the statements inserted so far,
+   * rather than answered from the NextT labels and the NextBipT and AffectsT indexes
+   * @params
+   * @return bool
+   */
+  bool ShouldMaterialiseTransitiveRelations();
+
+  /**
+   * Checks whether NextT relationships are stored as pairs
+   * @params
+   * @return bool
+   */
+  bool IsNextTMaterialised();
+
+  /**
+   * Checks whether NextBipT relationships are stored as pairs
+   * @params
+   * @return bool
+   */
+  bool IsNextBipTMaterialised();
+
+  /**
+   * Checks whether AffectsT relationships are stored as pairs
+   * @params
+   * @return bool
+   */
+  bool IsAffectsTMaterialised();
+
+  /**
+   * Stores the index that NextBipT relationships are answered from when they are not materialised
+   * @params StatementReachability index
+   * @return
+   */
+  void InsertNextBipTIndex(StatementReachability);
+
+  /**
+   * Builds the index that AffectsT relationships are answered from when they are not materialised,
+   * from the Affects relationships inserted so far
+   * @params
+   * @return
+   */
+  void IndexAffectsT();
+
+  /**
+   * Gets the index of NextBipT relationships, empty if none was inserted
+   * @params
+   * @return StatementReachability
+   */
+  const StatementReachability &GetNextBipTIndex();
+
+  /**
+   * Gets the index of AffectsT relationships, empty if none was built
+   * @params
+   * @return StatementReachability
+   */
+  const StatementReachability &GetAffectsTIndex();
+
+  /**
+   * Gets the statements that a statement reaches by NextT as a compressed row, or nullptr if NextT is not
+   * stored as compressed rows
+   * @params int stmt
+   * @return CompressedBitmap
+   */
+  const CompressedBitmap *GetNextTRow(int);
+
+  /**
+   * Gets the statements that a statement reaches by NextBipT as a compressed row, or nullptr if NextBipT is
+   * not stored as compressed rows
+   * @params int stmt
+   * @return CompressedBitmap
+   */
+  const CompressedBitmap *GetNextBipTRow(int);
+
+  /**
+   * Gets the assignment statements that an assignment statement affects by AffectsT as a compressed row, or
+   * nullptr if AffectsT is not stored as compressed rows
+   * @params int assign_stmt
+   * @return CompressedBitmap
+   */
+  const CompressedBitmap *GetAffectsTRow(int);
+
+  /**
+   * Gets the assignment statements that an assignment statement affects by AffectsBipT as a compressed row,
+   * or nullptr if AffectsBipT is not stored as compressed rows
+   * @params int assign_stmt
+   * @return CompressedBitmap
+   */
+  const CompressedBitmap *GetAffectsBipTRow(int);
+
+  /**
+   * Gets the number of bytes taken by the transitive relationships stored as compressed rows
+   * @params
+   * @return size_t
+   */
+  size_t CountCompressedBytes();
+
+  /**
+   * Pre-sizes the statement and variable keyed tables so that extraction does not rehash as they grow
+   * @params int num_stmts, int num_vars
+   * @return
+   */
+  void ReserveTables(int, int);
+
+  /**
+   * Clears all underlying tables of the PKB to size 0, lifting any freeze
    * @params
    * @return
    */
   void ClearAllTables();
+
+  /**
+   * Marks the PKB as read-only once extraction is complete. Inserting into a frozen PKB throws, and
+   * since no getter inserts, any number of threads may then query the PKB concurrently.
+   * Materialised NextT, NextBipT, AffectsT and AffectsBipT relationships are moved into compressed rows
+   * @params
+   * @return
+   */
+  void Freeze();
+
+  /**
+   * Checks whether the PKB has been frozen
+   * @params
+   * @return bool
+   */
+  bool IsFrozen() const;
+
+  /**
+   * Gets the id of the contents of a frozen PKB. Every call to Freeze gives the PKB an id that no PKB in the
+   * process has had before, so anything cached against one generation is never used for another
+   * @params
+   * @return uint64_t generation id, or 0 if the PKB is not frozen
+   */
+  uint64_t GetGenerationId() const;
 };
\ No newline at end of file
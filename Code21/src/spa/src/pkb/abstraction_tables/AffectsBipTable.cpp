@@ -10,6 +10,20 @@ bool AffectsBipTable::InsertAffectsBip(int assign_stmt1, int assign_stmt2) {
   return affects_bip_table.Insert(assign_stmt1, assign_stmt2) && inverse_affects_bip_table.Insert(assign_stmt2, assign_stmt1);
 }
 
+bool AffectsBipTable::InsertAffectsBip(int assign_stmt1, const std::unordered_set<int>& assign_stmts2) {
+  if (assign_stmt1 <= 0) {
+    return false;
+  }
+  std::unordered_set<int> valid_assign_stmts2;
+  for (int assign_stmt2 : assign_stmts2) {
+    if (assign_stmt2 > 0) {
+      valid_assign_stmts2.insert(assign_stmt2);
+      inverse_affects_bip_table.Insert(assign_stmt2, assign_stmt1);
+    }
+  }
+  return affects_bip_table.InsertBatch(assign_stmt1, valid_assign_stmts2);
+}
+
 bool AffectsBipTable::IsAffectsBip(int assign_stmt1, int assign_stmt2) {
   if (assign_stmt1 <= 0 || assign_stmt2 <= 0) {
     return false;
@@ -18,8 +32,8 @@ bool AffectsBipTable::IsAffectsBip(int assign_stmt1, int assign_stmt2) {
     return false;
   }
 
-  std::unordered_set<int>& assign_stmt1_affects_set = affects_bip_table.Get(assign_stmt1);
-  return std::find(assign_stmt1_affects_set.begin(), assign_stmt1_affects_set.end(), assign_stmt2) != assign_stmt1_affects_set.end();
+  const std::unordered_set<int>& assign_stmt1_affects_set = affects_bip_table.Get(assign_stmt1);
+  return assign_stmt1_affects_set.find(assign_stmt2) != assign_stmt1_affects_set.end();
 }
 
 std::unordered_set<int> AffectsBipTable::GetAffectedBipStatements(int assign_stmt1) {
@@ -60,7 +74,27 @@ bool AffectsBipTable::InsertAffectsBipT(int assign_stmt1, int assign_stmt2) {
   return affects_bip_T_table.Insert(assign_stmt1, assign_stmt2) && inverse_affects_bip_T_table.Insert(assign_stmt2, assign_stmt1);
 }
 
+bool AffectsBipTable::InsertAffectsBipT(int assign_stmt1, const std::unordered_set<int>& assign_stmts2) {
+  if (assign_stmt1 <= 0) {
+    return false;
+  }
+  std::unordered_set<int> valid_assign_stmts2;
+  for (int assign_stmt2 : assign_stmts2) {
+    if (assign_stmt2 > 0) {
+      valid_assign_stmts2.insert(assign_stmt2);
+      inverse_affects_bip_T_table.Insert(assign_stmt2, assign_stmt1);
+    }
+  }
+  return affects_bip_T_table.InsertBatch(assign_stmt1, valid_assign_stmts2);
+}
+
 bool AffectsBipTable::IsAffectsBipT(int assign_stmt1, int assign_stmt2) {
+  if (mapped_affects_bip_T_table.IsAttached()) {
+    return mapped_affects_bip_T_table.Contains(assign_stmt1, assign_stmt2);
+  }
+  if (compressed_affects_bip_T_table.IsAttached()) {
+    return compressed_affects_bip_T_table.Contains(assign_stmt1, assign_stmt2);
+  }
   if (assign_stmt1 <= 0 || assign_stmt2 <= 0) {
     return false;
   }
@@ -68,11 +102,17 @@ bool AffectsBipTable::IsAffectsBipT(int assign_stmt1, int assign_stmt2) {
     return false;
   }
 
-  std::unordered_set<int>& assign_stmt1_affects_set = affects_bip_T_table.Get(assign_stmt1);
-  return std::find(assign_stmt1_affects_set.begin(), assign_stmt1_affects_set.end(), assign_stmt2) != assign_stmt1_affects_set.end();
+  const std::unordered_set<int>& assign_stmt1_affects_set = affects_bip_T_table.Get(assign_stmt1);
+  return assign_stmt1_affects_set.find(assign_stmt2) != assign_stmt1_affects_set.end();
 }
 
 std::unordered_set<int> AffectsBipTable::GetAffectedBipTStatements(int assign_stmt1) {
+  if (mapped_affects_bip_T_table.IsAttached()) {
+    return mapped_affects_bip_T_table.Get(assign_stmt1);
+  }
+  if (compressed_affects_bip_T_table.IsAttached()) {
+    return compressed_affects_bip_T_table.Get(assign_stmt1);
+  }
   if (assign_stmt1 <= 0 || !affects_bip_T_table.Contains(assign_stmt1)) {
     return std::unordered_set<int>();
   }
@@ -80,6 +120,12 @@ std::unordered_set<int> AffectsBipTable::GetAffectedBipTStatements(int assign_st
 }
 
 std::unordered_set<int> AffectsBipTable::GetStatementsThatAffectsBipT(int assign_stmt2) {
+  if (mapped_inverse_affects_bip_T_table.IsAttached()) {
+    return mapped_inverse_affects_bip_T_table.Get(assign_stmt2);
+  }
+  if (compressed_inverse_affects_bip_T_table.IsAttached()) {
+    return compressed_inverse_affects_bip_T_table.Get(assign_stmt2);
+  }
   if (assign_stmt2 <= 0 || !inverse_affects_bip_T_table.Contains(assign_stmt2)) {
     return std::unordered_set<int>();
   }
@@ -87,22 +133,70 @@ std::unordered_set<int> AffectsBipTable::GetStatementsThatAffectsBipT(int assign
 }
 
 std::unordered_set<int> AffectsBipTable::GetAllStatementsThatAffectsBipT() {
+  if (mapped_affects_bip_T_table.IsAttached()) {
+    return mapped_affects_bip_T_table.GetAllKeys();
+  }
+  if (compressed_affects_bip_T_table.IsAttached()) {
+    return compressed_affects_bip_T_table.GetAllKeys();
+  }
   return affects_bip_T_table.GetAllKeys();
 }
 
 std::unordered_set<int> AffectsBipTable::GetAllAffectedBipTStatements() {
+  if (mapped_inverse_affects_bip_T_table.IsAttached()) {
+    return mapped_inverse_affects_bip_T_table.GetAllKeys();
+  }
+  if (compressed_inverse_affects_bip_T_table.IsAttached()) {
+    return compressed_inverse_affects_bip_T_table.GetAllKeys();
+  }
   return inverse_affects_bip_T_table.GetAllKeys();
 }
 
 TableMultiple<int, int> AffectsBipTable::GetAffectsBipTTable() {
+  if (compressed_affects_bip_T_table.IsAttached()) {
+    return compressed_affects_bip_T_table.ToTable();
+  }
   return affects_bip_T_table;
 }
 
 TableMultiple<int, int> AffectsBipTable::GetAffectedBipTTable() {
+  if (compressed_inverse_affects_bip_T_table.IsAttached()) {
+    return compressed_inverse_affects_bip_T_table.ToTable();
+  }
   return inverse_affects_bip_T_table;
 }
 
+// the materialised tables are released, so the PKB must no longer be modified
+void AffectsBipTable::CompressAffectsBipTTables() {
+  if (affects_bip_T_table.IsEmpty()) {
+    return;
+  }
+  compressed_affects_bip_T_table = CompressedRelation(affects_bip_T_table);
+  compressed_inverse_affects_bip_T_table = CompressedRelation(inverse_affects_bip_T_table);
+  affects_bip_T_table = TableMultiple<int, int>();
+  inverse_affects_bip_T_table = TableMultiple<int, int>();
+}
+
+const CompressedBitmap* AffectsBipTable::GetAffectsBipTRow(int stmt) {
+  return compressed_affects_bip_T_table.IsAttached() ? &compressed_affects_bip_T_table.GetRow(stmt) : nullptr;
+}
+
+size_t AffectsBipTable::CountCompressedAffectsBipTBytes() {
+  return compressed_affects_bip_T_table.CountBytes() + compressed_inverse_affects_bip_T_table.CountBytes();
+}
+
+void AffectsBipTable::AttachMappedAffectsBipTTables(const MappedRelation& forward, const MappedRelation& inverse) {
+  affects_bip_T_table.ClearTable();
+  inverse_affects_bip_T_table.ClearTable();
+  mapped_affects_bip_T_table = forward;
+  mapped_inverse_affects_bip_T_table = inverse;
+}
+
 void AffectsBipTable::ClearAffectsBipTable() {
+  mapped_affects_bip_T_table.Reset();
+  mapped_inverse_affects_bip_T_table.Reset();
+  compressed_affects_bip_T_table.Reset();
+  compressed_inverse_affects_bip_T_table.Reset();
   affects_bip_table.ClearTable();
   inverse_affects_bip_table.ClearTable();
   affects_bip_T_table.ClearTable();
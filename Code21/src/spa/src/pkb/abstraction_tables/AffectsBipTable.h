@@ -1,4 +1,6 @@
+#include "pkb/snapshot/MappedRelation.h"
 #include "pkb/templates/TableMultiple.h"
+#include "pkb/utils/CompressedRelation.h"
 
 class AffectsBipTable {
  private:
@@ -6,6 +8,10 @@ class AffectsBipTable {
   TableMultiple<int, int> inverse_affects_bip_table;
   TableMultiple<int, int> affects_bip_T_table;
   TableMultiple<int, int> inverse_affects_bip_T_table;
+  MappedRelation mapped_affects_bip_T_table;  // when attached, AffectsBipT relationships are served from a PKB snapshot
+  MappedRelation mapped_inverse_affects_bip_T_table;
+  CompressedRelation compressed_affects_bip_T_table;  // when attached, AffectsBipT relationships are served from here
+  CompressedRelation compressed_inverse_affects_bip_T_table;
 
  public:
   AffectsBipTable(){};
@@ -14,6 +20,8 @@ class AffectsBipTable {
 
   bool InsertAffectsBip(int, int);
 
+  bool InsertAffectsBip(int, const std::unordered_set<int>&);
+
   bool IsAffectsBip(int, int);
 
   std::unordered_set<int> GetStatementsThatAffectsBip(int);
@@ -32,6 +40,8 @@ class AffectsBipTable {
 
   bool InsertAffectsBipT(int, int);
 
+  bool InsertAffectsBipT(int, const std::unordered_set<int>&);
+
   bool IsAffectsBipT(int, int);
 
   std::unordered_set<int> GetStatementsThatAffectsBipT(int);
@@ -46,5 +56,15 @@ class AffectsBipTable {
 
   TableMultiple<int, int> GetAffectedBipTTable();
 
+  /* moves the AffectsBipT tables into compressed rows once they are no longer modified */
+  void CompressAffectsBipTTables();
+
+  /* the stmts related to stmt by AffectsBipT, or nullptr if AffectsBipT is not stored as compressed rows */
+  const CompressedBitmap* GetAffectsBipTRow(int stmt);
+
+  size_t CountCompressedAffectsBipTBytes();
+
+  void AttachMappedAffectsBipTTables(const MappedRelation&, const MappedRelation&);
+
   void ClearAffectsBipTable();
 };
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "AffectsTable.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pkb/utils/BidirectionalSearch.h"
 
 bool AffectsTable::InsertAffects(int assign_stmt1, int assign_stmt2) {
   if (assign_stmt1 <= 0 || assign_stmt2 <= 0) {
@@ -18,8 +23,8 @@ bool AffectsTable::IsAffects(int assign_stmt1, int assign_stmt2) {
     return false;
   }
 
-  std::unordered_set<int>& assign_stmt1_affects_set = affects_table.Get(assign_stmt1);
-  return std::find(assign_stmt1_affects_set.begin(), assign_stmt1_affects_set.end(), assign_stmt2) != assign_stmt1_affects_set.end();
+  const std::unordered_set<int>& assign_stmt1_affects_set = affects_table.Get(assign_stmt1);
+  return assign_stmt1_affects_set.find(assign_stmt2) != assign_stmt1_affects_set.end();
 }
 
 std::unordered_set<int> AffectsTable::GetAffectedStatements(int assign_stmt1) {
@@ -60,19 +65,84 @@ bool AffectsTable::InsertAffectsT(int assign_stmt1, int assign_stmt2) {
   return affects_T_table.Insert(assign_stmt1, assign_stmt2) && inverse_affects_T_table.Insert(assign_stmt2, assign_stmt1);
 }
 
+bool AffectsTable::InsertAffectsT(int assign_stmt1, const std::unordered_set<int>& assign_stmts2) {
+  if (assign_stmt1 <= 0) {
+    return false;
+  }
+  std::unordered_set<int> valid_assign_stmts2;
+  for (int assign_stmt2 : assign_stmts2) {
+    if (assign_stmt2 > 0) {
+      valid_assign_stmts2.insert(assign_stmt2);
+      inverse_affects_T_table.Insert(assign_stmt2, assign_stmt1);
+    }
+  }
+  return affects_T_table.InsertBatch(assign_stmt1, valid_assign_stmts2);
+}
+
 bool AffectsTable::IsAffectsT(int assign_stmt1, int assign_stmt2) {
+  if (mapped_affects_T_table.IsAttached()) {
+    return mapped_affects_T_table.Contains(assign_stmt1, assign_stmt2);
+  }
+  if (compressed_affects_T_table.IsAttached()) {
+    return compressed_affects_T_table.Contains(assign_stmt1, assign_stmt2);
+  }
   if (assign_stmt1 <= 0 || assign_stmt2 <= 0) {
     return false;
   }
+  if (!IsAffectsTMaterialised() && !affects_T_index.IsEmpty()) {
+    return affects_T_index.IsReachable(assign_stmt1, assign_stmt2);
+  }
+  if (!IsAffectsTMaterialised()) {
+    return BidirectionalSearch::IsReachable(affects_table, inverse_affects_table, assign_stmt1, assign_stmt2);
+  }
   if (!affects_T_table.Contains(assign_stmt1)) {
     return false;
   }
 
-  std::unordered_set<int>& assign_stmt1_affects_set = affects_T_table.Get(assign_stmt1);
-  return std::find(assign_stmt1_affects_set.begin(), assign_stmt1_affects_set.end(), assign_stmt2) != assign_stmt1_affects_set.end();
+  const std::unordered_set<int>& assign_stmt1_affects_set = affects_T_table.Get(assign_stmt1);
+  return assign_stmt1_affects_set.find(assign_stmt2) != assign_stmt1_affects_set.end();
+}
+
+bool AffectsTable::IsAffectsTMaterialised() {
+  return mapped_affects_T_table.IsAttached() || compressed_affects_T_table.IsAttached() || !affects_T_table.IsEmpty();
+}
+
+// every assign stmt is a block of its own, so the index is over the Affects graph itself
+void AffectsTable::IndexAffectsT() {
+  std::vector<std::vector<int>> blocks;
+  std::unordered_map<int, int> stmt_blocks;
+  auto get_block = [&blocks, &stmt_blocks](int stmt) {
+    auto it = stmt_blocks.find(stmt);
+    if (it != stmt_blocks.end()) {
+      return it->second;
+    }
+    blocks.push_back({stmt});
+    return stmt_blocks[stmt] = blocks.size() - 1;
+  };
+
+  std::vector<std::pair<int, int>> edges;
+  for (int assign_stmt1 : affects_table.GetAllKeys()) {
+    for (int assign_stmt2 : affects_table.Get(assign_stmt1)) {
+      edges.push_back({get_block(assign_stmt1), get_block(assign_stmt2)});
+    }
+  }
+  affects_T_index = StatementReachability(std::move(blocks), 1, std::move(edges));
+}
+
+const StatementReachability& AffectsTable::GetAffectsTIndex() {
+  return affects_T_index;
 }
 
 std::unordered_set<int> AffectsTable::GetAffectedTStatements(int assign_stmt1) {
+  if (mapped_affects_T_table.IsAttached()) {
+    return mapped_affects_T_table.Get(assign_stmt1);
+  }
+  if (compressed_affects_T_table.IsAttached()) {
+    return compressed_affects_T_table.Get(assign_stmt1);
+  }
+  if (!IsAffectsTMaterialised()) {
+    return affects_T_index.GetReachableStatements(assign_stmt1);
+  }
   if (assign_stmt1 <= 0 || !affects_T_table.Contains(assign_stmt1)) {
     return std::unordered_set<int>();
   }
@@ -80,6 +150,15 @@ std::unordered_set<int> AffectsTable::GetAffectedTStatements(int assign_stmt1) {
 }
 
 std::unordered_set<int> AffectsTable::GetStatementsThatAffectsT(int assign_stmt2) {
+  if (mapped_inverse_affects_T_table.IsAttached()) {
+    return mapped_inverse_affects_T_table.Get(assign_stmt2);
+  }
+  if (compressed_inverse_affects_T_table.IsAttached()) {
+    return compressed_inverse_affects_T_table.Get(assign_stmt2);
+  }
+  if (!IsAffectsTMaterialised()) {
+    return affects_T_index.GetReachingStatements(assign_stmt2);
+  }
   if (assign_stmt2 <= 0 || !inverse_affects_T_table.Contains(assign_stmt2)) {
     return std::unordered_set<int>();
   }
@@ -87,24 +166,79 @@ std::unordered_set<int> AffectsTable::GetStatementsThatAffectsT(int assign_stmt2
 }
 
 std::unordered_set<int> AffectsTable::GetAllStatementsThatAffectsT() {
+  if (mapped_affects_T_table.IsAttached()) {
+    return mapped_affects_T_table.GetAllKeys();
+  }
+  if (compressed_affects_T_table.IsAttached()) {
+    return compressed_affects_T_table.GetAllKeys();
+  }
+  if (!IsAffectsTMaterialised()) {
+    return affects_T_index.GetAllReachingStatements();
+  }
   return affects_T_table.GetAllKeys();
 }
 
 std::unordered_set<int> AffectsTable::GetAllAffectedTStatements() {
+  if (mapped_inverse_affects_T_table.IsAttached()) {
+    return mapped_inverse_affects_T_table.GetAllKeys();
+  }
+  if (compressed_inverse_affects_T_table.IsAttached()) {
+    return compressed_inverse_affects_T_table.GetAllKeys();
+  }
+  if (!IsAffectsTMaterialised()) {
+    return affects_T_index.GetAllReachableStatements();
+  }
   return inverse_affects_T_table.GetAllKeys();
 }
 
 TableMultiple<int, int> AffectsTable::GetAffectsTTable() {
+  if (compressed_affects_T_table.IsAttached()) {
+    return compressed_affects_T_table.ToTable();
+  }
   return affects_T_table;
 }
 
 TableMultiple<int, int> AffectsTable::GetAffectedTTable() {
+  if (compressed_inverse_affects_T_table.IsAttached()) {
+    return compressed_inverse_affects_T_table.ToTable();
+  }
   return inverse_affects_T_table;
 }
 
+// the materialised tables are released, so the PKB must no longer be modified
+void AffectsTable::CompressAffectsTTables() {
+  if (affects_T_table.IsEmpty()) {
+    return;
+  }
+  compressed_affects_T_table = CompressedRelation(affects_T_table);
+  compressed_inverse_affects_T_table = CompressedRelation(inverse_affects_T_table);
+  affects_T_table = TableMultiple<int, int>();
+  inverse_affects_T_table = TableMultiple<int, int>();
+}
+
+const CompressedBitmap* AffectsTable::GetAffectsTRow(int stmt) {
+  return compressed_affects_T_table.IsAttached() ? &compressed_affects_T_table.GetRow(stmt) : nullptr;
+}
+
+size_t AffectsTable::CountCompressedAffectsTBytes() {
+  return compressed_affects_T_table.CountBytes() + compressed_inverse_affects_T_table.CountBytes();
+}
+
+void AffectsTable::AttachMappedAffectsTTables(const MappedRelation& forward, const MappedRelation& inverse) {
+  affects_T_table.ClearTable();
+  inverse_affects_T_table.ClearTable();
+  mapped_affects_T_table = forward;
+  mapped_inverse_affects_T_table = inverse;
+}
+
 void AffectsTable::ClearAffectsTable() {
+  mapped_affects_T_table.Reset();
+  mapped_inverse_affects_T_table.Reset();
+  compressed_affects_T_table.Reset();
+  compressed_inverse_affects_T_table.Reset();
   affects_table.ClearTable();
   inverse_affects_table.ClearTable();
   affects_T_table.ClearTable();
   inverse_affects_T_table.ClearTable();
+  affects_T_index = StatementReachability();
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
+#include "pkb/snapshot/MappedRelation.h"
 #include "pkb/templates/TableMultiple.h"
+#include "pkb/utils/CompressedRelation.h"
+#include "pkb/utils/StatementReachability.h"
 
 class AffectsTable {
  private:
@@ -6,6 +9,11 @@ class AffectsTable {
   TableMultiple<int, int> inverse_affects_table;
   TableMultiple<int, int> affects_T_table;
   TableMultiple<int, int> inverse_affects_T_table;
+  MappedRelation mapped_affects_T_table;  // when attached, AffectsT relationships are served from a PKB snapshot
+  MappedRelation mapped_inverse_affects_T_table;
+  CompressedRelation compressed_affects_T_table;  // when attached, AffectsT relationships are served from here
+  CompressedRelation compressed_inverse_affects_T_table;
+  StatementReachability affects_T_index;  // when AffectsT is not materialised, AffectsT relationships are served from this
 
  public:
   AffectsTable(){};
@@ -32,8 +40,19 @@ class AffectsTable {
 
   bool InsertAffectsT(int, int);
 
+  bool InsertAffectsT(int, const std::unordered_set<int>&);
+
+  /* when AffectsT is not materialised, answered from its index, or if there is none by a bidirectional
+     search over the Affects tables */
   bool IsAffectsT(int, int);
 
+  bool IsAffectsTMaterialised();
+
+  /* builds the index of AffectsT from the Affects relationships inserted so far */
+  void IndexAffectsT();
+
+  const StatementReachability& GetAffectsTIndex();
+
   std::unordered_set<int> GetStatementsThatAffectsT(int);
 
   std::unordered_set<int> GetAffectedTStatements(int);
@@ -46,5 +65,15 @@ class AffectsTable {
 
   TableMultiple<int, int> GetAffectedTTable();
 
+  /* moves the AffectsT tables into compressed rows once they are no longer modified */
+  void CompressAffectsTTables();
+
+  /* the stmts related to stmt by AffectsT, or nullptr if AffectsT is not stored as compressed rows */
+  const CompressedBitmap* GetAffectsTRow(int stmt);
+
+  size_t CountCompressedAffectsTBytes();
+
+  void AttachMappedAffectsTTables(const MappedRelation&, const MappedRelation&);
+
   void ClearAffectsTable();
 };
\ No newline at end of file
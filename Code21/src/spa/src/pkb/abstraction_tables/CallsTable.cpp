@@ -19,8 +19,8 @@ bool CallsTable::IsCalls(const std::string& caller, const std::string& callee) {
     return false;
   }
 
-  std::unordered_set<std::string>& callee_set = calls_table.Get(caller);
-  return std::find(callee_set.begin(), callee_set.end(), callee) != callee_set.end();
+  const std::unordered_set<std::string>& callee_set = calls_table.Get(caller);
+  return callee_set.find(callee) != callee_set.end();
 }
 
 std::unordered_set<std::string> CallsTable::GetProceduresThatCalls(const std::string& callee) {
@@ -72,8 +72,8 @@ bool CallsTable::IsCallsT(const std::string& caller, const std::string& callee)
     return false;
   }
 
-  std::unordered_set<std::string>& callee_set = calls_T_table.Get(caller);
-  return std::find(callee_set.begin(), callee_set.end(), callee) != callee_set.end();
+  const std::unordered_set<std::string>& callee_set = calls_T_table.Get(caller);
+  return callee_set.find(callee) != callee_set.end();
 }
 
 std::unordered_set<std::string> CallsTable::GetProceduresThatCallsT(const std::string& callee) {
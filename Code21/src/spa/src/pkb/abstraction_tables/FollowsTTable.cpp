@@ -17,8 +17,8 @@ bool FollowsTTable::IsFollowsT(int stmt1, int stmt2) {
     return false;
   }
 
-  std::unordered_set<int>& stmt1_follows_set = follows_T_table.Get(stmt1);
-  return std::find(stmt1_follows_set.begin(), stmt1_follows_set.end(), stmt2) != stmt1_follows_set.end();
+  const std::unordered_set<int>& stmt1_follows_set = follows_T_table.Get(stmt1);
+  return stmt1_follows_set.find(stmt2) != stmt1_follows_set.end();
 }
 
 std::unordered_set<int> FollowsTTable::GetStmtsFollowedTBy(int stmt2) {
@@ -49,6 +49,11 @@ TableSingle<int, int> FollowsTable::GetInverseFollowsTable() {
   return inverse_follows_table;
 }
 
+void FollowsTable::ReserveFollowsTable(int num_stmts) {
+  follows_table.Reserve(num_stmts);
+  inverse_follows_table.Reserve(num_stmts);
+}
+
 void FollowsTable::ClearFollowsTable() {
   follows_table.ClearTable();
   inverse_follows_table.ClearTable();
@@ -24,5 +24,7 @@ class FollowsTable {
 
   TableSingle<int, int> GetInverseFollowsTable();
 
+  void ReserveFollowsTable(int);
+
   void ClearFollowsTable();
 };
\ No newline at end of file
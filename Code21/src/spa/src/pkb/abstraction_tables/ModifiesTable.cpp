@@ -26,8 +26,8 @@ bool ModifiesTable::IsStmtModifies(int stmt_index, const std::string& variable)
     return false;
   }
 
-  std::unordered_set<std::string>& stmt_variable_set = modifies_stmt_table.Get(stmt_index);
-  return std::find(stmt_variable_set.begin(), stmt_variable_set.end(), variable) != stmt_variable_set.end();
+  const std::unordered_set<std::string>& stmt_variable_set = modifies_stmt_table.Get(stmt_index);
+  return stmt_variable_set.find(variable) != stmt_variable_set.end();
 }
 
 bool ModifiesTable::IsProcModifies(const std::string& proc_name, const std::string& variable) {
@@ -38,8 +38,8 @@ bool ModifiesTable::IsProcModifies(const std::string& proc_name, const std::stri
     return false;
   }
 
-  std::unordered_set<std::string>& proc_variable_set = modifies_proc_table.Get(proc_name);
-  return std::find(proc_variable_set.begin(), proc_variable_set.end(), variable) != proc_variable_set.end();
+  const std::unordered_set<std::string>& proc_variable_set = modifies_proc_table.Get(proc_name);
+  return proc_variable_set.find(variable) != proc_variable_set.end();
 }
 
 std::unordered_set<int> ModifiesTable::GetModifiesStatements(const std::string& variable) {
@@ -78,6 +78,12 @@ std::unordered_set<std::string> ModifiesTable::GetAllModifiesProcedures() {
   return modifies_proc_table.GetAllKeys();
 }
 
+void ModifiesTable::ReserveModifiesTable(int num_stmts, int num_vars) {
+  modifies_stmt_table.Reserve(num_stmts);
+  inverse_modifies_stmt_table.Reserve(num_vars);
+  inverse_modifies_proc_table.Reserve(num_vars);
+}
+
 void ModifiesTable::ClearModifiesTable() {
   modifies_stmt_table.ClearTable();
   modifies_proc_table.ClearTable();
@@ -30,6 +30,8 @@ class ModifiesTable {
 
   std::unordered_set<int> GetAllModifiesStatements();
 
+  void ReserveModifiesTable(int, int);
+
   void ClearModifiesTable();
 
   TableMultiple<int, std::string> GetModifiesStmtTable();
@@ -1,6 +1,7 @@
 #include "NextBipTable.h"
 
 #include <algorithm>
+#include <utility>
 
 bool NextBipTable::InsertNextBip(int stmt1, int stmt2) {
   if (stmt1 == stmt2 || stmt1 <= 0 || stmt2 <= 0) {
@@ -17,8 +18,8 @@ bool NextBipTable::IsNextBip(int stmt1, int stmt2) {
     return false;
   }
 
-  std::unordered_set<int>& stmt1_next_set = nextbip_table.Get(stmt1);
-  return std::find(stmt1_next_set.begin(), stmt1_next_set.end(), stmt2) != stmt1_next_set.end();
+  const std::unordered_set<int>& stmt1_next_set = nextbip_table.Get(stmt1);
+  return stmt1_next_set.find(stmt2) != stmt1_next_set.end();
 }
 
 std::unordered_set<int> NextBipTable::GetNextBipStatements(int stmt_index) {
@@ -58,19 +59,63 @@ bool NextBipTable::InsertNextBipT(int stmt1, int stmt2) {
   return nextbip_T_table.Insert(stmt1, stmt2) && inverse_nextbip_T_table.Insert(stmt2, stmt1);
 }
 
+bool NextBipTable::InsertNextBipT(int stmt1, const std::unordered_set<int>& stmts2) {
+  if (stmt1 <= 0) {
+    return false;
+  }
+  std::unordered_set<int> valid_stmts2;
+  for (int stmt2 : stmts2) {
+    if (stmt2 > 0) {
+      valid_stmts2.insert(stmt2);
+      inverse_nextbip_T_table.Insert(stmt2, stmt1);
+    }
+  }
+  return nextbip_T_table.InsertBatch(stmt1, valid_stmts2);
+}
+
 bool NextBipTable::IsNextBipT(int stmt1, int stmt2) {
+  if (mapped_nextbip_T_table.IsAttached()) {
+    return mapped_nextbip_T_table.Contains(stmt1, stmt2);
+  }
+  if (compressed_nextbip_T_table.IsAttached()) {
+    return compressed_nextbip_T_table.Contains(stmt1, stmt2);
+  }
   if (stmt1 <= 0 || stmt2 <= 0) {
     return false;
   }
+  if (!IsNextBipTMaterialised()) {
+    return nextbip_T_index.IsReachable(stmt1, stmt2);
+  }
   if (!nextbip_T_table.Contains(stmt1)) {
     return false;
   }
 
-  std::unordered_set<int>& stmt1_next_T_set = nextbip_T_table.Get(stmt1);
-  return std::find(stmt1_next_T_set.begin(), stmt1_next_T_set.end(), stmt2) != stmt1_next_T_set.end();
+  const std::unordered_set<int>& stmt1_next_T_set = nextbip_T_table.Get(stmt1);
+  return stmt1_next_T_set.find(stmt2) != stmt1_next_T_set.end();
+}
+
+bool NextBipTable::IsNextBipTMaterialised() {
+  return mapped_nextbip_T_table.IsAttached() || compressed_nextbip_T_table.IsAttached() || !nextbip_T_table.IsEmpty();
+}
+
+void NextBipTable::SetNextBipTIndex(StatementReachability index) {
+  nextbip_T_index = std::move(index);
+}
+
+const StatementReachability& NextBipTable::GetNextBipTIndex() {
+  return nextbip_T_index;
 }
 
 std::unordered_set<int> NextBipTable::GetNextBipTStatements(int stmt_index) {
+  if (mapped_nextbip_T_table.IsAttached()) {
+    return mapped_nextbip_T_table.Get(stmt_index);
+  }
+  if (compressed_nextbip_T_table.IsAttached()) {
+    return compressed_nextbip_T_table.Get(stmt_index);
+  }
+  if (!IsNextBipTMaterialised()) {
+    return nextbip_T_index.GetReachableStatements(stmt_index);
+  }
   if (stmt_index <= 0 || !nextbip_T_table.Contains(stmt_index)) {
     return std::unordered_set<int>();
   }
@@ -78,6 +123,15 @@ std::unordered_set<int> NextBipTable::GetNextBipTStatements(int stmt_index) {
 }
 
 std::unordered_set<int> NextBipTable::GetPreviousBipTStatements(int stmt2) {
+  if (mapped_inverse_nextbip_T_table.IsAttached()) {
+    return mapped_inverse_nextbip_T_table.Get(stmt2);
+  }
+  if (compressed_inverse_nextbip_T_table.IsAttached()) {
+    return compressed_inverse_nextbip_T_table.Get(stmt2);
+  }
+  if (!IsNextBipTMaterialised()) {
+    return nextbip_T_index.GetReachingStatements(stmt2);
+  }
   if (stmt2 <= 0 || !inverse_nextbip_T_table.Contains(stmt2)) {
     return std::unordered_set<int>();
   }
@@ -85,24 +139,79 @@ std::unordered_set<int> NextBipTable::GetPreviousBipTStatements(int stmt2) {
 }
 
 std::unordered_set<int> NextBipTable::GetAllNextBipTStatements() {
+  if (mapped_inverse_nextbip_T_table.IsAttached()) {
+    return mapped_inverse_nextbip_T_table.GetAllKeys();
+  }
+  if (compressed_inverse_nextbip_T_table.IsAttached()) {
+    return compressed_inverse_nextbip_T_table.GetAllKeys();
+  }
+  if (!IsNextBipTMaterialised()) {
+    return nextbip_T_index.GetAllReachableStatements();
+  }
   return inverse_nextbip_T_table.GetAllKeys();
 }
 
 std::unordered_set<int> NextBipTable::GetAllPreviousBipTStatements() {
+  if (mapped_nextbip_T_table.IsAttached()) {
+    return mapped_nextbip_T_table.GetAllKeys();
+  }
+  if (compressed_nextbip_T_table.IsAttached()) {
+    return compressed_nextbip_T_table.GetAllKeys();
+  }
+  if (!IsNextBipTMaterialised()) {
+    return nextbip_T_index.GetAllReachingStatements();
+  }
   return nextbip_T_table.GetAllKeys();
 }
 
 TableMultiple<int, int> NextBipTable::GetNextBipTTable() {
+  if (compressed_nextbip_T_table.IsAttached()) {
+    return compressed_nextbip_T_table.ToTable();
+  }
   return nextbip_T_table;
 }
 
 TableMultiple<int, int> NextBipTable::GetInverseNextBipTTable() {
+  if (compressed_inverse_nextbip_T_table.IsAttached()) {
+    return compressed_inverse_nextbip_T_table.ToTable();
+  }
   return inverse_nextbip_T_table;
 }
 
+// the materialised tables are released, so the PKB must no longer be modified
+void NextBipTable::CompressNextBipTTables() {
+  if (nextbip_T_table.IsEmpty()) {
+    return;
+  }
+  compressed_nextbip_T_table = CompressedRelation(nextbip_T_table);
+  compressed_inverse_nextbip_T_table = CompressedRelation(inverse_nextbip_T_table);
+  nextbip_T_table = TableMultiple<int, int>();
+  inverse_nextbip_T_table = TableMultiple<int, int>();
+}
+
+const CompressedBitmap* NextBipTable::GetNextBipTRow(int stmt) {
+  return compressed_nextbip_T_table.IsAttached() ? &compressed_nextbip_T_table.GetRow(stmt) : nullptr;
+}
+
+size_t NextBipTable::CountCompressedNextBipTBytes() {
+  return compressed_nextbip_T_table.CountBytes() + compressed_inverse_nextbip_T_table.CountBytes();
+}
+
+void NextBipTable::AttachMappedNextBipTTables(const MappedRelation& forward, const MappedRelation& inverse) {
+  nextbip_T_table.ClearTable();
+  inverse_nextbip_T_table.ClearTable();
+  mapped_nextbip_T_table = forward;
+  mapped_inverse_nextbip_T_table = inverse;
+}
+
 void NextBipTable::ClearNextBipTable() {
+  mapped_nextbip_T_table.Reset();
+  mapped_inverse_nextbip_T_table.Reset();
+  compressed_nextbip_T_table.Reset();
+  compressed_inverse_nextbip_T_table.Reset();
   nextbip_table.ClearTable();
   inverse_nextbip_table.ClearTable();
   nextbip_T_table.ClearTable();
   inverse_nextbip_T_table.ClearTable();
+  nextbip_T_index = StatementReachability();
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
+#include "pkb/snapshot/MappedRelation.h"
 #include "pkb/templates/TableMultiple.h"
+#include "pkb/utils/CompressedRelation.h"
+#include "pkb/utils/StatementReachability.h"
 
 class NextBipTable {
  private:
@@ -6,6 +9,11 @@ class NextBipTable {
   TableMultiple<int, int> inverse_nextbip_table;
   TableMultiple<int, int> nextbip_T_table;
   TableMultiple<int, int> inverse_nextbip_T_table;
+  MappedRelation mapped_nextbip_T_table;  // when attached, NextBipT relationships are served from a PKB snapshot
+  MappedRelation mapped_inverse_nextbip_T_table;
+  CompressedRelation compressed_nextbip_T_table;  // when attached, NextBipT relationships are served from here
+  CompressedRelation compressed_inverse_nextbip_T_table;
+  StatementReachability nextbip_T_index;  // when NextBipT is not materialised, NextBipT relationships are served from this
 
  public:
   NextBipTable(){};
@@ -32,8 +40,17 @@ class NextBipTable {
 
   bool InsertNextBipT(int, int);
 
+  bool InsertNextBipT(int, const std::unordered_set<int>&);
+
+  /* when NextBipT is not materialised, answered from its index */
   bool IsNextBipT(int, int);
 
+  bool IsNextBipTMaterialised();
+
+  void SetNextBipTIndex(StatementReachability);
+
+  const StatementReachability& GetNextBipTIndex();
+
   std::unordered_set<int> GetNextBipTStatements(int);
 
   std::unordered_set<int> GetPreviousBipTStatements(int);
@@ -46,5 +63,15 @@ class NextBipTable {
 
   TableMultiple<int, int> GetInverseNextBipTTable();
 
+  /* moves the NextBipT tables into compressed rows once they are no longer modified */
+  void CompressNextBipTTables();
+
+  /* the stmts related to stmt by NextBipT, or nullptr if NextBipT is not stored as compressed rows */
+  const CompressedBitmap* GetNextBipTRow(int stmt);
+
+  size_t CountCompressedNextBipTBytes();
+
+  void AttachMappedNextBipTTables(const MappedRelation&, const MappedRelation&);
+
   void ClearNextBipTable();
 };
\ No newline at end of file
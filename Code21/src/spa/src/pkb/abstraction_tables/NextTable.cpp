@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include "pkb/utils/BidirectionalSearch.h"
+
 bool NextTable::InsertNext(int stmt1, int stmt2) {
   if (stmt1 == stmt2 || stmt1 <= 0 || stmt2 <= 0) {
     return false;
@@ -17,8 +19,8 @@ bool NextTable::IsNext(int stmt1, int stmt2) {
     return false;
   }
 
-  std::unordered_set<int>& stmt1_next_set = next_table.Get(stmt1);
-  return std::find(stmt1_next_set.begin(), stmt1_next_set.end(), stmt2) != stmt1_next_set.end();
+  const std::unordered_set<int>& stmt1_next_set = next_table.Get(stmt1);
+  return stmt1_next_set.find(stmt2) != stmt1_next_set.end();
 }
 
 std::unordered_set<int> NextTable::GetNextStatements(int stmt_index) {
@@ -58,19 +60,62 @@ bool NextTable::InsertNextT(int stmt1, int stmt2) {
   return next_T_table.Insert(stmt1, stmt2) && inverse_next_T_table.Insert(stmt2, stmt1);
 }
 
+bool NextTable::InsertNextT(int stmt1, const std::unordered_set<int>& stmts2) {
+  if (stmt1 <= 0) {
+    return false;
+  }
+  std::unordered_set<int> valid_stmts2;
+  for (int stmt2 : stmts2) {
+    if (stmt2 > 0) {
+      valid_stmts2.insert(stmt2);
+      inverse_next_T_table.Insert(stmt2, stmt1);
+    }
+  }
+  return next_T_table.InsertBatch(stmt1, valid_stmts2);
+}
+
+bool NextTable::InsertNextTLabel(int stmt, const StatementLabel& label) {
+  return next_T_labels.InsertLabel(stmt, label);
+}
+
 bool NextTable::IsNextT(int stmt1, int stmt2) {
+  if (mapped_next_T_table.IsAttached()) {
+    return mapped_next_T_table.Contains(stmt1, stmt2);
+  }
+  if (compressed_next_T_table.IsAttached()) {
+    return compressed_next_T_table.Contains(stmt1, stmt2);
+  }
   if (stmt1 <= 0 || stmt2 <= 0) {
     return false;
   }
+  if (!IsNextTMaterialised() && !next_T_labels.IsEmpty()) {
+    return next_T_labels.IsNextT(stmt1, stmt2);
+  }
+  if (!IsNextTMaterialised()) {
+    return BidirectionalSearch::IsReachable(next_table, inverse_next_table, stmt1, stmt2);
+  }
   if (!next_T_table.Contains(stmt1)) {
     return false;
   }
 
-  std::unordered_set<int>& stmt1_next_T_set = next_T_table.Get(stmt1);
-  return std::find(stmt1_next_T_set.begin(), stmt1_next_T_set.end(), stmt2) != stmt1_next_T_set.end();
+  const std::unordered_set<int>& stmt1_next_T_set = next_T_table.Get(stmt1);
+  return stmt1_next_T_set.find(stmt2) != stmt1_next_T_set.end();
+}
+
+bool NextTable::IsNextTMaterialised() {
+  return mapped_next_T_table.IsAttached() || compressed_next_T_table.IsAttached() || !next_T_table.IsEmpty();
 }
 
 std::unordered_set<int> NextTable::GetNextTStatements(int stmt_index) {
+  if (mapped_next_T_table.IsAttached()) {
+    return mapped_next_T_table.Get(stmt_index);
+  }
+  if (compressed_next_T_table.IsAttached()) {
+    return compressed_next_T_table.Get(stmt_index);
+  }
+  if (!IsNextTMaterialised()) {
+    return NextTLabels::ExpandRanges(next_T_labels.GetNextTRanges(stmt_index));
+  }
   if (stmt_index <= 0 || !next_T_table.Contains(stmt_index)) {
     return std::unordered_set<int>();
   }
@@ -78,6 +123,15 @@ std::unordered_set<int> NextTable::GetNextTStatements(int stmt_index) {
 }
 
 std::unordered_set<int> NextTable::GetPreviousTStatements(int stmt2) {
+  if (mapped_inverse_next_T_table.IsAttached()) {
+    return mapped_inverse_next_T_table.Get(stmt2);
+  }
+  if (compressed_inverse_next_T_table.IsAttached()) {
+    return compressed_inverse_next_T_table.Get(stmt2);
+  }
+  if (!IsNextTMaterialised()) {
+    return NextTLabels::ExpandRanges(next_T_labels.GetPreviousTRanges(stmt2));
+  }
   if (stmt2 <= 0 || !inverse_next_T_table.Contains(stmt2)) {
     return std::unordered_set<int>();
   }
@@ -85,24 +139,102 @@ std::unordered_set<int> NextTable::GetPreviousTStatements(int stmt2) {
 }
 
 std::unordered_set<int> NextTable::GetAllNextTStatements() {
+  if (mapped_inverse_next_T_table.IsAttached()) {
+    return mapped_inverse_next_T_table.GetAllKeys();
+  }
+  if (compressed_inverse_next_T_table.IsAttached()) {
+    return compressed_inverse_next_T_table.GetAllKeys();
+  }
+  if (!IsNextTMaterialised()) {
+    std::unordered_set<int> stmts;
+    for (int stmt : next_T_labels.GetLabelledStatements()) {
+      if (!next_T_labels.GetPreviousTRanges(stmt).empty()) {
+        stmts.insert(stmt);
+      }
+    }
+    return stmts;
+  }
   return inverse_next_T_table.GetAllKeys();
 }
 
 std::unordered_set<int> NextTable::GetAllPreviousTStatements() {
+  if (mapped_next_T_table.IsAttached()) {
+    return mapped_next_T_table.GetAllKeys();
+  }
+  if (compressed_next_T_table.IsAttached()) {
+    return compressed_next_T_table.GetAllKeys();
+  }
+  if (!IsNextTMaterialised()) {
+    std::unordered_set<int> stmts;
+    for (int stmt : next_T_labels.GetLabelledStatements()) {
+      if (!next_T_labels.GetNextTRanges(stmt).empty()) {
+        stmts.insert(stmt);
+      }
+    }
+    return stmts;
+  }
   return next_T_table.GetAllKeys();
 }
 
 TableMultiple<int, int> NextTable::GetNextTTable() {
+  if (compressed_next_T_table.IsAttached()) {
+    return compressed_next_T_table.ToTable();
+  }
   return next_T_table;
 }
 
 TableMultiple<int, int> NextTable::GetInverseNextTTable() {
+  if (compressed_inverse_next_T_table.IsAttached()) {
+    return compressed_inverse_next_T_table.ToTable();
+  }
   return inverse_next_T_table;
 }
 
+const NextTLabels& NextTable::GetNextTLabels() {
+  return next_T_labels;
+}
+
+void NextTable::ReserveNextTable(int num_stmts) {
+  next_table.Reserve(num_stmts);
+  inverse_next_table.Reserve(num_stmts);
+  next_T_table.Reserve(num_stmts);
+  inverse_next_T_table.Reserve(num_stmts);
+}
+
+// the materialised tables are released, so the PKB must no longer be modified
+void NextTable::CompressNextTTables() {
+  if (next_T_table.IsEmpty()) {
+    return;
+  }
+  compressed_next_T_table = CompressedRelation(next_T_table);
+  compressed_inverse_next_T_table = CompressedRelation(inverse_next_T_table);
+  next_T_table = TableMultiple<int, int>();
+  inverse_next_T_table = TableMultiple<int, int>();
+}
+
+const CompressedBitmap* NextTable::GetNextTRow(int stmt) {
+  return compressed_next_T_table.IsAttached() ? &compressed_next_T_table.GetRow(stmt) : nullptr;
+}
+
+size_t NextTable::CountCompressedNextTBytes() {
+  return compressed_next_T_table.CountBytes() + compressed_inverse_next_T_table.CountBytes();
+}
+
+void NextTable::AttachMappedNextTTables(const MappedRelation& forward, const MappedRelation& inverse) {
+  next_T_table.ClearTable();
+  inverse_next_T_table.ClearTable();
+  mapped_next_T_table = forward;
+  mapped_inverse_next_T_table = inverse;
+}
+
 void NextTable::ClearNextTable() {
+  mapped_next_T_table.Reset();
+  mapped_inverse_next_T_table.Reset();
+  compressed_next_T_table.Reset();
+  compressed_inverse_next_T_table.Reset();
   next_table.ClearTable();
   inverse_next_table.ClearTable();
   next_T_table.ClearTable();
   inverse_next_T_table.ClearTable();
+  next_T_labels.ClearLabels();
 }
\ No newline at end of file
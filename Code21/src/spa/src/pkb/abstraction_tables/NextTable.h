@@ -1,4 +1,7 @@
+#include "pkb/snapshot/MappedRelation.h"
 #include "pkb/templates/TableMultiple.h"
+#include "pkb/utils/CompressedRelation.h"
+#include "pkb/utils/NextTLabels.h"
 
 class NextTable {
  private:
@@ -6,6 +9,11 @@ class NextTable {
   TableMultiple<int, int> inverse_next_table;
   TableMultiple<int, int> next_T_table;
   TableMultiple<int, int> inverse_next_T_table;
+  MappedRelation mapped_next_T_table;  // when attached, NextT relationships are served from a PKB snapshot
+  MappedRelation mapped_inverse_next_T_table;
+  CompressedRelation compressed_next_T_table;  // when attached, NextT relationships are served from here
+  CompressedRelation compressed_inverse_next_T_table;
+  NextTLabels next_T_labels;  // when NextT is not materialised, NextT relationships are derived from these
 
  public:
   NextTable(){};
@@ -32,8 +40,16 @@ class NextTable {
 
   bool InsertNextT(int, int);
 
+  bool InsertNextT(int, const std::unordered_set<int>&);
+
+  bool InsertNextTLabel(int, const StatementLabel&);
+
+  /* when NextT is not materialised, answered from the stmt labels, or if there are none by a
+     bidirectional search over the Next tables */
   bool IsNextT(int, int);
 
+  bool IsNextTMaterialised();
+
   std::unordered_set<int> GetNextTStatements(int);
 
   std::unordered_set<int> GetPreviousTStatements(int);
@@ -46,5 +62,19 @@ class NextTable {
 
   TableMultiple<int, int> GetInverseNextTTable();
 
+  const NextTLabels& GetNextTLabels();
+
+  void ReserveNextTable(int);
+
+  /* moves the NextT tables into compressed rows once they are no longer modified */
+  void CompressNextTTables();
+
+  /* the stmts related to stmt by NextT, or nullptr if NextT is not stored as compressed rows */
+  const CompressedBitmap* GetNextTRow(int stmt);
+
+  size_t CountCompressedNextTBytes();
+
+  void AttachMappedNextTTables(const MappedRelation&, const MappedRelation&);
+
   void ClearNextTable();
 };
\ No newline at end of file
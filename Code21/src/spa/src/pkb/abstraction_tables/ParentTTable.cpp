@@ -17,8 +17,8 @@ bool ParentTTable::IsParentT(int stmt1, int stmt2) {
     return false;
   }
 
-  std::unordered_set<int>& stmt1_children_set = parent_T_table.Get(stmt1);
-  return std::find(stmt1_children_set.begin(), stmt1_children_set.end(), stmt2) != stmt1_children_set.end();
+  const std::unordered_set<int>& stmt1_children_set = parent_T_table.Get(stmt1);
+  return stmt1_children_set.find(stmt2) != stmt1_children_set.end();
 }
 
 std::unordered_set<int> ParentTTable::GetChildrenTStatements(int stmt1) {
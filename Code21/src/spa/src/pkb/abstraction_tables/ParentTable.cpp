@@ -59,6 +59,11 @@ TableSingle<int, int> ParentTable::GetInverseParentTable() {
   return inverse_parent_table;
 }
 
+void ParentTable::ReserveParentTable(int num_stmts) {
+  parent_table.Reserve(num_stmts);
+  inverse_parent_table.Reserve(num_stmts);
+}
+
 void ParentTable::ClearParentTable() {
   parent_table.ClearTable();
   inverse_parent_table.ClearTable();
@@ -25,5 +25,7 @@ class ParentTable {
 
   TableSingle<int, int> GetInverseParentTable();
 
+  void ReserveParentTable(int);
+
   void ClearParentTable();
 };
\ No newline at end of file
@@ -26,8 +26,8 @@ bool UsesTable::IsStmtUses(int stmt_index, const std::string& variable) {
     return false;
   }
 
-  std::unordered_set<std::string>& stmt_variable_set = uses_stmt_table.Get(stmt_index);
-  return std::find(stmt_variable_set.begin(), stmt_variable_set.end(), variable) != stmt_variable_set.end();
+  const std::unordered_set<std::string>& stmt_variable_set = uses_stmt_table.Get(stmt_index);
+  return stmt_variable_set.find(variable) != stmt_variable_set.end();
 }
 
 bool UsesTable::IsProcUses(const std::string& proc_name, const std::string& variable) {
@@ -38,8 +38,8 @@ bool UsesTable::IsProcUses(const std::string& proc_name, const std::string& vari
     return false;
   }
 
-  std::unordered_set<std::string>& proc_variable_set = uses_proc_table.Get(proc_name);
-  return std::find(proc_variable_set.begin(), proc_variable_set.end(), variable) != proc_variable_set.end();
+  const std::unordered_set<std::string>& proc_variable_set = uses_proc_table.Get(proc_name);
+  return proc_variable_set.find(variable) != proc_variable_set.end();
 }
 
 std::unordered_set<std::string> UsesTable::GetUsedStmtVariables(int stmt_index) {
@@ -78,6 +78,12 @@ std::unordered_set<std::string> UsesTable::GetAllUsesProcedures() {
   return uses_proc_table.GetAllKeys();
 }
 
+void UsesTable::ReserveUsesTable(int num_stmts, int num_vars) {
+  uses_stmt_table.Reserve(num_stmts);
+  inverse_uses_stmt_table.Reserve(num_vars);
+  inverse_uses_proc_table.Reserve(num_vars);
+}
+
 void UsesTable::ClearUsesTable() {
   uses_stmt_table.ClearTable();
   uses_proc_table.ClearTable();
@@ -30,6 +30,8 @@ class UsesTable {
 
   std::unordered_set<std::string> GetAllUsesProcedures();
 
+  void ReserveUsesTable(int, int);
+
   void ClearUsesTable();
 
   TableMultiple<int, std::string> GetUsesStmtTable();
@@ -44,7 +44,7 @@ std::unordered_set<int> AssignTable::GetAllAssignStmtsThatModifies(std::string v
 
 std::unordered_set<int> AssignTable::GetAllAssignStmtsThatMatches(const source_processor::TokenList& token_list) {
   std::unordered_set<int> all_assign_stmts_that_matches;
-  std::unordered_map<int, source_processor::TokenList>& assign_map = assign_table.GetTable();
+  FlatHashMap<int, source_processor::TokenList>& assign_map = assign_table.GetTable();
   for (auto& it : assign_map) {
     if (it.second == token_list) {
       all_assign_stmts_that_matches.insert(it.first);
@@ -55,7 +55,7 @@ std::unordered_set<int> AssignTable::GetAllAssignStmtsThatMatches(const source_p
 
 std::unordered_set<int> AssignTable::GetAllAssignStmtsThatContains(const source_processor::TokenList& token_list) {
   std::unordered_set<int> all_assign_stmts_that_contains;
-  std::unordered_map<int, source_processor::TokenList>& assign_map = assign_table.GetTable();
+  FlatHashMap<int, source_processor::TokenList>& assign_map = assign_table.GetTable();
   for (auto& it : assign_map) {
     if (it.second.HasSublist(token_list)) {
       all_assign_stmts_that_contains.insert(it.first);
@@ -40,6 +40,10 @@ TableMultiple<std::string, int> EntityTable::GetInverseEntityTable() {
   return inverse_entity_table;
 }
 
+void EntityTable::ReserveEntityTable(int num_stmts) {
+  entity_table.Reserve(num_stmts);
+}
+
 void EntityTable::ClearEntityTable() {
   entity_table.ClearTable();
   inverse_entity_table.ClearTable();
@@ -21,5 +21,7 @@ class EntityTable {
 
   TableMultiple<std::string, int> GetInverseEntityTable();
 
+  void ReserveEntityTable(int);
+
   void ClearEntityTable();
 };
@@ -1,7 +1,7 @@
 #include "ProcTable.h"
 
 bool ProcTable::InsertProc(const std::string& proc_name, const std::pair<int, int>& start_to_end_indexes) {  //todo:check overlap interval
-  std::unordered_map<std::string, std::pair<int, int>>& proc_map = proc_table.GetTable();
+  FlatHashMap<std::string, std::pair<int, int>>& proc_map = proc_table.GetTable();
   for (auto& it : proc_map) {
     if (it.first == proc_name) {
       return false;
@@ -13,7 +13,11 @@ bool ProcTable::InsertProc(const std::string& proc_name, const std::pair<int, in
     }
   }
 
-  return proc_table.Insert(proc_name, start_to_end_indexes);
+  if (!proc_table.Insert(proc_name, start_to_end_indexes)) {
+    return false;
+  }
+  proc_ranges[start_to_end_indexes.first] = start_to_end_indexes.second;
+  return true;
 }
 
 std::unordered_set<std::string> ProcTable::GetAllProcedures() {
@@ -24,8 +28,22 @@ std::pair<int, int> ProcTable::GetProcRange(const std::string& proc_name) {
   return proc_table.Get(proc_name);
 }
 
+// returns (0, 0) if no procedure contains the stmt
+std::pair<int, int> ProcTable::GetProcRangeOfStmt(int stmt_index) {
+  auto it = proc_ranges.upper_bound(stmt_index);
+  if (it == proc_ranges.begin()) {
+    return std::pair<int, int>(0, 0);
+  }
+  --it;
+  if (stmt_index > it->second) {
+    return std::pair<int, int>(0, 0);
+  }
+  return *it;
+}
+
 void ProcTable::ClearProcTable() {
   proc_table.ClearTable();
+  proc_ranges.clear();
 }
 
 TableSingle<std::string, std::pair<int, int>> ProcTable::GetProcTable() {
@@ -1,8 +1,11 @@
+#include <map>
+
 #include "pkb/templates/TableSingle.h"
 
 class ProcTable {
  private:
   TableSingle<std::string, std::pair<int, int>> proc_table;  // mapping of proc_name to start - end indexes
+  std::map<int, int> proc_ranges;                            // start index to end index, ordered to look up the procedure of a stmt
 
  public:
   ProcTable(){};
@@ -13,6 +16,8 @@ class ProcTable {
 
   std::pair<int, int> GetProcRange(const std::string&);
 
+  std::pair<int, int> GetProcRangeOfStmt(int);
+
   void ClearProcTable();
 
   TableSingle<std::string, std::pair<int, int>> GetProcTable();
@@ -0,0 +1,51 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_USE_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::string& path) : data(nullptr), size(0), is_mapped(false) {
+#ifdef MAPPED_FILE_USE_MMAP
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("MappedFile: unable to open " + path);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    void* mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      data = static_cast<const char*>(mapping);
+      size = file_stat.st_size;
+      is_mapped = true;
+    }
+  }
+  close(fd);
+  if (is_mapped) {
+    return;
+  }
+#endif
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("MappedFile: unable to open " + path);
+  }
+  buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  data = buffer.data();
+  size = buffer.size();
+}
+
+MappedFile::~MappedFile() {
+#ifdef MAPPED_FILE_USE_MMAP
+  if (is_mapped) {
+    munmap(const_cast<char*>(data), size);
+  }
+#endif
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ * Read-only view of a whole file. On POSIX systems the file is memory-mapped so that pages are only
+ * read from disk when they are touched; elsewhere the file is read into a buffer.
+ */
+class MappedFile {
+ private:
+  const char* data;
+  size_t size;
+  bool is_mapped;
+  std::vector<char> buffer;  // only used when the file could not be memory-mapped
+
+ public:
+  // throws std::runtime_error if the file cannot be opened
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* GetData() const { return data; }
+  size_t GetSize() const { return size; }
+};
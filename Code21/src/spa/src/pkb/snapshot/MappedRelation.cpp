@@ -0,0 +1,51 @@
+#include "MappedRelation.h"
+
+#include <algorithm>
+#include <utility>
+
+MappedRelation::MappedRelation() : keys(nullptr), offsets(nullptr), values(nullptr), num_keys(0) {}
+
+MappedRelation::MappedRelation(std::shared_ptr<const MappedFile> file, const int32_t* keys, const uint32_t* offsets,
+                               const int32_t* values, uint32_t num_keys)
+    : file(std::move(file)), keys(keys), offsets(offsets), values(values), num_keys(num_keys) {}
+
+int64_t MappedRelation::FindKey(int key) const {
+  const int32_t* end = keys + num_keys;
+  const int32_t* it = std::lower_bound(keys, end, key);
+  if (it == end || *it != key) {
+    return -1;
+  }
+  return it - keys;
+}
+
+bool MappedRelation::IsAttached() const {
+  return file != nullptr;
+}
+
+bool MappedRelation::Contains(int key, int value) const {
+  int64_t index = FindKey(key);
+  if (index < 0) {
+    return false;
+  }
+  return std::binary_search(values + offsets[index], values + offsets[index + 1], value);
+}
+
+bool MappedRelation::ContainsKey(int key) const {
+  return FindKey(key) >= 0;
+}
+
+std::unordered_set<int> MappedRelation::Get(int key) const {
+  int64_t index = FindKey(key);
+  if (index < 0) {
+    return std::unordered_set<int>();
+  }
+  return std::unordered_set<int>(values + offsets[index], values + offsets[index + 1]);
+}
+
+std::unordered_set<int> MappedRelation::GetAllKeys() const {
+  return std::unordered_set<int>(keys, keys + num_keys);
+}
+
+void MappedRelation::Reset() {
+  *this = MappedRelation();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+
+#include "MappedFile.h"
+
+/*
+ * A read-only int to int relation stored as sorted arrays inside a MappedFile:
+ *   keys[num_keys]         sorted keys
+ *   offsets[num_keys + 1]  values of keys[i] are values[offsets[i]] to values[offsets[i + 1] - 1]
+ *   values[]               sorted within each key
+ * Lookups binary search the arrays in place, so nothing is copied out of the file until a set is requested.
+ */
+class MappedRelation {
+ private:
+  std::shared_ptr<const MappedFile> file;  // keeps the mapping alive for as long as the relation is in use
+  const int32_t* keys;
+  const uint32_t* offsets;
+  const int32_t* values;
+  uint32_t num_keys;
+
+  // returns the index of key in keys, or -1 if the key is absent
+  int64_t FindKey(int key) const;
+
+ public:
+  MappedRelation();
+  MappedRelation(std::shared_ptr<const MappedFile> file, const int32_t* keys, const uint32_t* offsets,
+                 const int32_t* values, uint32_t num_keys);
+
+  bool IsAttached() const;
+
+  bool Contains(int key, int value) const;
+
+  bool ContainsKey(int key) const;
+
+  std::unordered_set<int> Get(int key) const;
+
+  std::unordered_set<int> GetAllKeys() const;
+
+  // Detaches the relation from its file
+  void Reset();
+};
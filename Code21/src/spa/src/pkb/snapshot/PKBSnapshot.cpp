@@ -0,0 +1,747 @@
+#include "PKBSnapshot.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+#include "MappedRelation.h"
+#include "pkb/PKB.h"
+#include "source_processor/token/Token.h"
+#include "source_processor/token/TokenList.h"
+#include "utils/Extension.h"
+
+const uint32_t PKBSnapshot::kVersion = 3;
+
+namespace {
+
+// writes the file to a new temporary file next to the path, removing it again if the write fails
+bool WriteTempFile(const std::string& path, const std::vector<char>& file, std::string& temp_path) {
+#if defined(__unix__) || defined(__APPLE__)
+  std::vector<char> temp_name(path.begin(), path.end());
+  const std::string suffix = ".XXXXXX";
+  temp_name.insert(temp_name.end(), suffix.begin(), suffix.end());
+  temp_name.push_back('\0');
+  int fd = mkstemp(temp_name.data());
+  if (fd < 0) {
+    return false;
+  }
+  temp_path = temp_name.data();
+  // mkstemp creates the file readable by its owner only, while snapshots are shared like any other file
+  bool is_written = fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0;
+  size_t written = 0;
+  while (is_written && written < file.size()) {
+    ssize_t count = write(fd, file.data() + written, file.size() - written);
+    if (count < 0 && errno != EINTR) {
+      is_written = false;
+    } else if (count > 0) {
+      written += count;
+    }
+  }
+  is_written = close(fd) == 0 && is_written;
+#else
+  temp_path = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) +
+              std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  bool is_written;
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    out.write(file.data(), file.size());
+    is_written = static_cast<bool>(out);
+  }
+#endif
+  if (!is_written) {
+    std::remove(temp_path.c_str());
+  }
+  return is_written;
+}
+
+const char kMagic[8] = {'S', 'P', 'A', 'P', 'K', 'B', '\0', '\0'};
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_sections;
+  uint64_t source_hash;
+  uint64_t payload_size;
+  uint64_t checksum;
+};
+
+struct SectionHeader {
+  uint32_t id;
+  uint32_t num_keys;
+  uint32_t num_values;
+  uint32_t reserved;
+};
+
+// Every PKB table that is written to a snapshot. Values must never be reordered, only appended.
+enum class SectionId : uint32_t {
+  Strings = 1,
+  Variables,
+  Statements,
+  Constants,
+  If,
+  While,
+  Read,
+  Print,
+  Assign,  // values: assigned variable, followed by (token type, token value) pairs of the expression
+  Procedures,  // values: start and end statement
+  Entities,
+  Follows,
+  FollowsT,
+  Parent,
+  ParentT,
+  ModifiesStmt,
+  ModifiesProc,
+  UsesStmt,
+  UsesProc,
+  Calls,
+  CallsT,
+  CallsStmt,
+  Next,
+  NextT,
+  InverseNextT,
+  Affects,
+  AffectsT,
+  InverseAffectsT,
+  NextBip,
+  NextBipT,
+  InverseNextBipT,
+  AffectsBip,
+  AffectsBipT,
+  InverseAffectsBipT,
+  NextTLabels,  // values: procedure first and last statement, parent, last nested statement, else first, is while
+  NextBipTIndexBlocks,  // values: statements of the block, in order
+  NextBipTIndexEdges,   // keys and values: nodes of the indexed graph
+  NextBipTIndexCopies,  // a single key: number of copies of every block
+  Count
+};
+
+typedef std::vector<std::pair<int, std::vector<int>>> Rows;
+
+const uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+const uint64_t kFnvPrime = 1099511628211ull;
+
+// FNV-1a over 8-byte words, so that verifying a large snapshot is bound by memory bandwidth
+uint64_t Checksum(const char* data, size_t size) {
+  uint64_t hash = kFnvOffsetBasis;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(uint64_t));
+    hash = (hash ^ word) * kFnvPrime;
+  }
+  for (; i < size; ++i) {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * kFnvPrime;
+  }
+  return hash;
+}
+
+class SnapshotWriter {
+ private:
+  std::vector<char> sections;
+  uint32_t num_sections;
+  std::unordered_map<std::string, int> string_ids;
+  std::vector<std::string> strings;
+
+  static void Append(std::vector<char>& buffer, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+  }
+
+  static void AppendSection(std::vector<char>& buffer, SectionId id, const std::vector<int32_t>& keys,
+                            const std::vector<uint32_t>& offsets, const std::vector<int32_t>& values) {
+    SectionHeader header = {static_cast<uint32_t>(id), static_cast<uint32_t>(keys.size()),
+                            static_cast<uint32_t>(values.size()), 0};
+    Append(buffer, &header, sizeof(header));
+    Append(buffer, keys.data(), keys.size() * sizeof(int32_t));
+    Append(buffer, offsets.data(), offsets.size() * sizeof(uint32_t));
+    Append(buffer, values.data(), values.size() * sizeof(int32_t));
+  }
+
+ public:
+  SnapshotWriter() : num_sections(0) {}
+
+  int Intern(const std::string& value) {
+    auto it = string_ids.find(value);
+    if (it != string_ids.end()) {
+      return it->second;
+    }
+    int id = strings.size();
+    string_ids[value] = id;
+    strings.push_back(value);
+    return id;
+  }
+
+  std::vector<int> Intern(const std::unordered_set<std::string>& values) {
+    std::vector<int> ids;
+    for (const auto& value : values) {
+      ids.push_back(Intern(value));
+    }
+    return ids;
+  }
+
+  // Sorts the rows by key and the values of every row, unless values_are_ordered is set
+  void AddSection(SectionId id, Rows rows, bool values_are_ordered = false) {
+    std::sort(rows.begin(), rows.end(),
+              [](const std::pair<int, std::vector<int>>& a, const std::pair<int, std::vector<int>>& b) {
+                return a.first < b.first;
+              });
+    std::vector<int32_t> keys;
+    std::vector<uint32_t> offsets = {0};
+    std::vector<int32_t> values;
+    for (auto& row : rows) {
+      if (!values_are_ordered) {
+        std::sort(row.second.begin(), row.second.end());
+      }
+      keys.push_back(row.first);
+      values.insert(values.end(), row.second.begin(), row.second.end());
+      offsets.push_back(values.size());
+    }
+    AppendSection(sections, id, keys, offsets, values);
+    num_sections++;
+  }
+
+  void AddKeys(SectionId id, const std::vector<int>& keys) {
+    Rows rows;
+    for (int key : keys) {
+      rows.emplace_back(key, std::vector<int>());
+    }
+    AddSection(id, rows);
+  }
+
+  void AddRelation(SectionId id, TableMultiple<int, int> table) {
+    Rows rows;
+    for (int key : table.GetAllKeys()) {
+      const auto& values = table.Get(key);
+      rows.emplace_back(key, std::vector<int>(values.begin(), values.end()));
+    }
+    AddSection(id, rows);
+  }
+
+  void AddRelation(SectionId id, TableMultiple<int, std::string> table) {
+    Rows rows;
+    for (int key : table.GetAllKeys()) {
+      rows.emplace_back(key, Intern(table.Get(key)));
+    }
+    AddSection(id, rows);
+  }
+
+  void AddRelation(SectionId id, TableMultiple<std::string, std::string> table) {
+    Rows rows;
+    for (const auto& key : table.GetAllKeys()) {
+      rows.emplace_back(Intern(key), Intern(table.Get(key)));
+    }
+    AddSection(id, rows);
+  }
+
+  void AddRelation(SectionId id, TableSingle<int, int> table) {
+    Rows rows;
+    for (const auto& it : table.GetTable()) {
+      rows.emplace_back(it.first, std::vector<int>{it.second});
+    }
+    AddSection(id, rows);
+  }
+
+  void AddRelation(SectionId id, TableSingle<int, std::string> table) {
+    Rows rows;
+    for (const auto& it : table.GetTable()) {
+      rows.emplace_back(it.first, std::vector<int>{Intern(it.second)});
+    }
+    AddSection(id, rows);
+  }
+
+  std::vector<char> Finish(uint64_t source_hash) {
+    std::vector<char> payload;
+
+    // the string section goes first so that it is already known when the other sections are read
+    std::vector<int32_t> keys;
+    std::vector<uint32_t> offsets = {0};
+    std::vector<char> chars;
+    for (size_t i = 0; i < strings.size(); ++i) {
+      keys.push_back(i);
+      chars.insert(chars.end(), strings[i].begin(), strings[i].end());
+      offsets.push_back(chars.size());
+    }
+    chars.resize((chars.size() + sizeof(int32_t) - 1) / sizeof(int32_t) * sizeof(int32_t), '\0');
+    std::vector<int32_t> words(chars.size() / sizeof(int32_t));
+    std::memcpy(words.data(), chars.data(), chars.size());
+    AppendSection(payload, SectionId::Strings, keys, offsets, words);
+    payload.insert(payload.end(), sections.begin(), sections.end());
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = PKBSnapshot::kVersion;
+    header.num_sections = num_sections + 1;
+    header.source_hash = source_hash;
+    header.payload_size = payload.size();
+    header.checksum = Checksum(payload.data(), payload.size());
+
+    std::vector<char> file;
+    Append(file, &header, sizeof(header));
+    file.insert(file.end(), payload.begin(), payload.end());
+    return file;
+  }
+};
+
+// A section of a mapped snapshot; pointers point into the mapping
+struct SectionView {
+  const int32_t* keys;
+  const uint32_t* offsets;
+  const int32_t* values;
+  uint32_t num_keys;
+  uint32_t num_values;
+
+  int Key(uint32_t i) const { return keys[i]; }
+  const int32_t* ValuesBegin(uint32_t i) const { return values + offsets[i]; }
+  const int32_t* ValuesEnd(uint32_t i) const { return values + offsets[i + 1]; }
+  uint32_t NumValues(uint32_t i) const { return offsets[i + 1] - offsets[i]; }
+};
+
+class SnapshotReader {
+ private:
+  std::shared_ptr<const MappedFile> file;
+  std::vector<SectionView> sections;
+  std::vector<bool> has_section;
+  std::vector<std::string> strings;
+
+ public:
+  explicit SnapshotReader(std::shared_ptr<const MappedFile> file)
+      : file(std::move(file)),
+        sections(static_cast<size_t>(SectionId::Count)),
+        has_section(static_cast<size_t>(SectionId::Count), false) {}
+
+  // Validates the header, checksum and section bounds. Nothing is read from the PKB tables' point of view
+  // until every check has passed.
+  bool Parse(uint64_t source_hash) {
+    const char* data = file->GetData();
+    size_t size = file->GetSize();
+    if (size < sizeof(SnapshotHeader)) {
+      return false;
+    }
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != PKBSnapshot::kVersion ||
+        header.source_hash != source_hash || header.payload_size != size - sizeof(header)) {
+      return false;
+    }
+    const char* payload = data + sizeof(header);
+    if (Checksum(payload, header.payload_size) != header.checksum) {
+      return false;
+    }
+
+    size_t position = 0;
+    for (uint32_t i = 0; i < header.num_sections; ++i) {
+      if (header.payload_size - position < sizeof(SectionHeader)) {
+        return false;
+      }
+      SectionHeader section_header;
+      std::memcpy(&section_header, payload + position, sizeof(section_header));
+      position += sizeof(section_header);
+
+      uint64_t num_words = 2ull * section_header.num_keys + 1 + section_header.num_values;
+      if (section_header.id == 0 || section_header.id >= static_cast<uint32_t>(SectionId::Count) ||
+          (header.payload_size - position) / sizeof(int32_t) < num_words) {
+        return false;
+      }
+      SectionView view;
+      view.num_keys = section_header.num_keys;
+      view.num_values = section_header.num_values;
+      view.keys = reinterpret_cast<const int32_t*>(payload + position);
+      view.offsets = reinterpret_cast<const uint32_t*>(view.keys + view.num_keys);
+      view.values = reinterpret_cast<const int32_t*>(view.offsets + view.num_keys + 1);
+      position += num_words * sizeof(int32_t);
+      // offsets of the string section count characters rather than values, and are checked by ReadStrings
+      if (section_header.id != static_cast<uint32_t>(SectionId::Strings) && !IsValidSection(view)) {
+        return false;
+      }
+      sections[section_header.id] = view;
+      has_section[section_header.id] = true;
+    }
+
+    for (size_t id = 1; id < has_section.size(); ++id) {
+      if (!has_section[id]) {
+        return false;
+      }
+    }
+    return ReadStrings();
+  }
+
+  const SectionView& Get(SectionId id) const { return sections[static_cast<size_t>(id)]; }
+
+  const std::string& String(int id) const { return strings[id]; }
+
+  MappedRelation GetMappedRelation(SectionId id) const {
+    const SectionView& view = Get(id);
+    return MappedRelation(file, view.keys, view.offsets, view.values, view.num_keys);
+  }
+
+  bool IsStringId(int id) const { return id >= 0 && id < static_cast<int>(strings.size()); }
+
+  // Ids are only valid strings if they were checked against the string section
+  bool StringIdsAreValid(SectionId id, bool keys_are_strings, bool values_are_strings) const {
+    const SectionView& view = Get(id);
+    for (uint32_t i = 0; keys_are_strings && i < view.num_keys; ++i) {
+      if (!IsStringId(view.keys[i])) {
+        return false;
+      }
+    }
+    for (uint32_t i = 0; values_are_strings && i < view.num_values; ++i) {
+      if (!IsStringId(view.values[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static bool IsValidSection(const SectionView& view) {
+    if (view.offsets[0] != 0 || view.offsets[view.num_keys] != view.num_values) {
+      return false;
+    }
+    for (uint32_t i = 0; i < view.num_keys; ++i) {
+      if (view.offsets[i] > view.offsets[i + 1] || (i > 0 && view.keys[i - 1] >= view.keys[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ReadStrings() {
+    const SectionView& view = Get(SectionId::Strings);
+    const char* chars = reinterpret_cast<const char*>(view.values);
+    size_t num_chars = static_cast<size_t>(view.num_values) * sizeof(int32_t);
+    strings.clear();
+    strings.reserve(view.num_keys);
+    for (uint32_t i = 0; i < view.num_keys; ++i) {
+      if (view.offsets[i] > view.offsets[i + 1] || view.offsets[i + 1] > num_chars) {
+        return false;
+      }
+      strings.emplace_back(chars + view.offsets[i], chars + view.offsets[i + 1]);
+    }
+    return true;
+  }
+};
+
+}  // namespace
+
+uint64_t PKBSnapshot::HashSource(const std::string& source, const utils::Extension& extension,
+                                 int max_materialised_stmts) {
+  std::string key = source;
+  key += extension.has_next_bip ? "\nNB" : "\n";
+  key += extension.has_affects_bip ? "\nAB" : "\n";
+  key += "\n" + std::to_string(max_materialised_stmts);
+
+  uint64_t hash = kFnvOffsetBasis;
+  for (char c : key) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * kFnvPrime;
+  }
+  return hash;
+}
+
+std::string PKBSnapshot::GetCachePath(uint64_t source_hash) {
+  const char* env_char = std::getenv("SPA_PKB_CACHE");
+  if (env_char == NULL || std::string(env_char).empty()) {
+    return "";
+  }
+
+  char file_name[32];
+  std::snprintf(file_name, sizeof(file_name), "pkb_%016llx.bin", static_cast<unsigned long long>(source_hash));
+  return std::string(env_char) + "/" + file_name;
+}
+
+bool PKBSnapshot::Save(PKB& pkb, const std::string& path, uint64_t source_hash) {
+  SnapshotWriter writer;
+
+  writer.AddKeys(SectionId::Variables, writer.Intern(pkb.GetAllVariables()));
+  std::unordered_set<int> stmts = pkb.GetAllStmts();
+  writer.AddKeys(SectionId::Statements, std::vector<int>(stmts.begin(), stmts.end()));
+  std::unordered_set<int> constants = pkb.GetAllConstants();
+  writer.AddKeys(SectionId::Constants, std::vector<int>(constants.begin(), constants.end()));
+
+  writer.AddRelation(SectionId::If, pkb.container_table.GetIfTable());
+  writer.AddRelation(SectionId::While, pkb.container_table.GetWhileTable());
+  writer.AddRelation(SectionId::Read, pkb.read_table);
+  writer.AddRelation(SectionId::Print, pkb.print_table);
+  writer.AddRelation(SectionId::Entities, pkb.entity_table.GetEntityTable());
+
+  Rows assign_rows;
+  TableSingle<int, std::string> assigned_table = pkb.assign_table.GetAssignedTable();
+  TableSingle<int, source_processor::TokenList> assign_table = pkb.assign_table.GetAssignTable();
+  for (const auto& it : assigned_table.GetTable()) {
+    std::vector<int> values = {writer.Intern(it.second)};
+    for (const auto& token : assign_table.Get(it.first).GetUnderlyingList()) {
+      values.push_back(static_cast<int>(token.GetType()));
+      values.push_back(writer.Intern(token.GetValue()));
+    }
+    assign_rows.emplace_back(it.first, values);
+  }
+  writer.AddSection(SectionId::Assign, assign_rows, true);
+
+  Rows procedure_rows;
+  TableSingle<std::string, std::pair<int, int>> proc_table = pkb.proc_table.GetProcTable();
+  for (const auto& it : proc_table.GetTable()) {
+    procedure_rows.emplace_back(writer.Intern(it.first), std::vector<int>{it.second.first, it.second.second});
+  }
+  writer.AddSection(SectionId::Procedures, procedure_rows, true);
+
+  writer.AddRelation(SectionId::Follows, pkb.follows_table.GetFollowsTable());
+  writer.AddRelation(SectionId::FollowsT, pkb.follows_T_table.GetFollowsTTable());
+  writer.AddRelation(SectionId::Parent, pkb.parent_table.GetParentTable());
+  writer.AddRelation(SectionId::ParentT, pkb.parent_T_table.GetParentTTable());
+
+  writer.AddRelation(SectionId::ModifiesStmt, pkb.modifies_table.GetModifiesStmtTable());
+  Rows modifies_proc_rows;
+  for (const auto& proc_name : pkb.GetAllModifiesProcedures()) {
+    modifies_proc_rows.emplace_back(writer.Intern(proc_name), writer.Intern(pkb.GetModifiedVariables(proc_name)));
+  }
+  writer.AddSection(SectionId::ModifiesProc, modifies_proc_rows);
+  writer.AddRelation(SectionId::UsesStmt, pkb.uses_table.GetUsesStmtTable());
+  writer.AddRelation(SectionId::UsesProc, pkb.uses_table.GetUsesProcTable());
+
+  writer.AddRelation(SectionId::Calls, pkb.calls_table.GetCallsTable());
+  writer.AddRelation(SectionId::CallsT, pkb.calls_table.GetCallsTTable());
+  writer.AddRelation(SectionId::CallsStmt, pkb.calls_table.GetCallsStmtTable());
+
+  writer.AddRelation(SectionId::Next, pkb.next_table.GetNextTable());
+  writer.AddRelation(SectionId::NextT, pkb.next_table.GetNextTTable());
+  writer.AddRelation(SectionId::InverseNextT, pkb.next_table.GetInverseNextTTable());
+  Rows next_T_label_rows;
+  const NextTLabels& next_T_labels = pkb.next_table.GetNextTLabels();
+  for (int stmt : next_T_labels.GetLabelledStatements()) {
+    const StatementLabel& label = next_T_labels.GetLabel(stmt);
+    next_T_label_rows.emplace_back(stmt, std::vector<int>{label.proc_first, label.proc_last, label.parent, label.last,
+                                                          label.else_first, label.is_while});
+  }
+  writer.AddSection(SectionId::NextTLabels, next_T_label_rows, true);
+  writer.AddRelation(SectionId::Affects, pkb.affects_table.GetAffectsTable());
+  writer.AddRelation(SectionId::AffectsT, pkb.affects_table.GetAffectsTTable());
+  writer.AddRelation(SectionId::InverseAffectsT, pkb.affects_table.GetAffectedTTable());
+  writer.AddRelation(SectionId::NextBip, pkb.nextbip_table.GetNextBipTable());
+  writer.AddRelation(SectionId::NextBipT, pkb.nextbip_table.GetNextBipTTable());
+  // the sections of the NextBip* index are empty when NextBip* is materialised
+  const StatementReachability& nextbip_T_index = pkb.nextbip_table.GetNextBipTIndex();
+  Rows block_rows;
+  for (size_t block = 0; block < nextbip_T_index.GetBlocks().size(); ++block) {
+    block_rows.emplace_back(block, nextbip_T_index.GetBlocks()[block]);
+  }
+  writer.AddSection(SectionId::NextBipTIndexBlocks, block_rows, true);
+  std::map<int, std::vector<int>> edge_rows;
+  for (const auto& edge : nextbip_T_index.GetEdges()) {
+    edge_rows[edge.first].push_back(edge.second);
+  }
+  writer.AddSection(SectionId::NextBipTIndexEdges, Rows(edge_rows.begin(), edge_rows.end()));
+  writer.AddKeys(SectionId::NextBipTIndexCopies,
+                 nextbip_T_index.IsEmpty() ? std::vector<int>() : std::vector<int>{nextbip_T_index.CountCopies()});
+  writer.AddRelation(SectionId::InverseNextBipT, pkb.nextbip_table.GetInverseNextBipTTable());
+  writer.AddRelation(SectionId::AffectsBip, pkb.affects_bip_table.GetAffectsBipTable());
+  writer.AddRelation(SectionId::AffectsBipT, pkb.affects_bip_table.GetAffectsBipTTable());
+  writer.AddRelation(SectionId::InverseAffectsBipT, pkb.affects_bip_table.GetAffectedBipTTable());
+
+  std::vector<char> file = writer.Finish(source_hash);
+
+  // write to a temporary file of this writer first so that a concurrent reader never maps a partially written
+  // snapshot and concurrent writers never write to the same file, then rename it over the snapshot at once
+  std::string temp_path;
+  if (!WriteTempFile(path, file, temp_path)) {
+    return false;
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool PKBSnapshot::Load(PKB& pkb, const std::string& path, uint64_t source_hash) {
+  std::shared_ptr<const MappedFile> file;
+  try {
+    file = std::make_shared<const MappedFile>(path);
+  } catch (const std::runtime_error&) {
+    return false;
+  }
+
+  SnapshotReader reader(file);
+  if (!reader.Parse(source_hash)) {
+    return false;
+  }
+  const SectionId string_keyed[] = {SectionId::Variables, SectionId::Procedures, SectionId::ModifiesProc,
+                                    SectionId::UsesProc, SectionId::Calls, SectionId::CallsT};
+  const SectionId string_valued[] = {SectionId::If, SectionId::While, SectionId::Read, SectionId::Print,
+                                     SectionId::Entities, SectionId::ModifiesStmt, SectionId::ModifiesProc,
+                                     SectionId::UsesStmt, SectionId::UsesProc, SectionId::Calls,
+                                     SectionId::CallsT, SectionId::CallsStmt};
+  for (SectionId id : string_keyed) {
+    if (!reader.StringIdsAreValid(id, true, false)) {
+      return false;
+    }
+  }
+  for (SectionId id : string_valued) {
+    if (!reader.StringIdsAreValid(id, false, true)) {
+      return false;
+    }
+  }
+  const SectionView& assign_view = reader.Get(SectionId::Assign);
+  for (uint32_t i = 0; i < assign_view.num_keys; ++i) {
+    // the assigned variable followed by (type, value) pairs
+    const int32_t* value = assign_view.ValuesBegin(i);
+    if (assign_view.NumValues(i) % 2 != 1 || !reader.IsStringId(*value)) {
+      return false;
+    }
+    for (++value; value != assign_view.ValuesEnd(i); value += 2) {
+      if (value[0] < 0 || value[0] > static_cast<int>(source_processor::TokenType::Else) || !reader.IsStringId(value[1])) {
+        return false;
+      }
+    }
+  }
+
+  pkb.ClearAllTables();
+
+  // applies insert(key, value) to every pair of a section
+  auto for_each_pair = [&reader](SectionId id, const std::function<void(int, int)>& insert) {
+    const SectionView& view = reader.Get(id);
+    for (uint32_t i = 0; i < view.num_keys; ++i) {
+      for (const int32_t* value = view.ValuesBegin(i); value != view.ValuesEnd(i); ++value) {
+        insert(view.Key(i), *value);
+      }
+    }
+  };
+  auto for_each_key = [&reader](SectionId id, const std::function<void(int)>& insert) {
+    const SectionView& view = reader.Get(id);
+    for (uint32_t i = 0; i < view.num_keys; ++i) {
+      insert(view.Key(i));
+    }
+  };
+
+  const SectionView& statements = reader.Get(SectionId::Statements);
+  pkb.ReserveTables(statements.num_keys, reader.Get(SectionId::Variables).num_keys);
+
+  for_each_key(SectionId::Variables, [&](int key) { pkb.InsertVariable(reader.String(key)); });
+  for_each_key(SectionId::Statements, [&](int key) { pkb.InsertStatement(key); });
+  for_each_key(SectionId::Constants, [&](int key) { pkb.InsertConstant(key); });
+
+  const SectionId containers[] = {SectionId::If, SectionId::While};
+  for (SectionId id : containers) {
+    const SectionView& view = reader.Get(id);
+    for (uint32_t i = 0; i < view.num_keys; ++i) {
+      std::vector<std::string> variables;
+      for (const int32_t* value = view.ValuesBegin(i); value != view.ValuesEnd(i); ++value) {
+        if (!reader.String(*value).empty()) {  // containers without control variables store ""
+          variables.push_back(reader.String(*value));
+        }
+      }
+      if (id == SectionId::If) {
+        pkb.InsertIf(view.Key(i), variables);
+      } else {
+        pkb.InsertWhile(view.Key(i), variables);
+      }
+    }
+  }
+  for_each_pair(SectionId::Read, [&](int key, int value) { pkb.InsertRead(key, reader.String(value)); });
+  for_each_pair(SectionId::Print, [&](int key, int value) { pkb.InsertPrint(key, reader.String(value)); });
+  for_each_pair(SectionId::Entities, [&](int key, int value) { pkb.InsertEntity(key, reader.String(value)); });
+
+  for (uint32_t i = 0; i < assign_view.num_keys; ++i) {
+    const int32_t* value = assign_view.ValuesBegin(i);
+    const std::string& assigned_variable = reader.String(*value++);
+    source_processor::TokenList expression;
+    for (; value != assign_view.ValuesEnd(i); value += 2) {
+      expression.Push(source_processor::Token(reader.String(value[1]), static_cast<source_processor::TokenType>(value[0])));
+    }
+    pkb.InsertAssignment(assign_view.Key(i), assigned_variable, expression);
+  }
+
+  const SectionView& procedures = reader.Get(SectionId::Procedures);
+  for (uint32_t i = 0; i < procedures.num_keys; ++i) {
+    if (procedures.NumValues(i) == 2) {
+      pkb.InsertProcedure(reader.String(procedures.Key(i)), procedures.ValuesBegin(i)[0], procedures.ValuesBegin(i)[1]);
+    }
+  }
+
+  for_each_pair(SectionId::Follows, [&](int key, int value) { pkb.InsertFollows(key, value); });
+  for_each_pair(SectionId::FollowsT, [&](int key, int value) { pkb.InsertFollowsT(key, value); });
+  for_each_pair(SectionId::Parent, [&](int key, int value) { pkb.InsertParent(key, value); });
+  for_each_pair(SectionId::ParentT, [&](int key, int value) { pkb.InsertParentT(key, value); });
+  for_each_pair(SectionId::ModifiesStmt, [&](int key, int value) { pkb.InsertModifies(key, reader.String(value)); });
+  for_each_pair(SectionId::ModifiesProc,
+                [&](int key, int value) { pkb.InsertModifies(reader.String(key), reader.String(value)); });
+  for_each_pair(SectionId::UsesStmt, [&](int key, int value) { pkb.InsertUses(key, reader.String(value)); });
+  for_each_pair(SectionId::UsesProc,
+                [&](int key, int value) { pkb.InsertUses(reader.String(key), reader.String(value)); });
+  for_each_pair(SectionId::Calls, [&](int key, int value) { pkb.InsertCalls(reader.String(key), reader.String(value)); });
+  for_each_pair(SectionId::CallsT,
+                [&](int key, int value) { pkb.InsertCallsT(reader.String(key), reader.String(value)); });
+  for_each_pair(SectionId::CallsStmt, [&](int key, int value) { pkb.InsertCalls(key, reader.String(value)); });
+  for_each_pair(SectionId::Next, [&](int key, int value) { pkb.InsertNext(key, value); });
+  const SectionView& next_T_labels = reader.Get(SectionId::NextTLabels);
+  for (uint32_t i = 0; i < next_T_labels.num_keys; ++i) {
+    if (next_T_labels.NumValues(i) == 6) {
+      const int32_t* value = next_T_labels.ValuesBegin(i);
+      StatementLabel label;
+      label.proc_first = value[0];
+      label.proc_last = value[1];
+      label.parent = value[2];
+      label.last = value[3];
+      label.else_first = value[4];
+      label.is_while = value[5] != 0;
+      pkb.InsertNextTLabel(next_T_labels.Key(i), label);
+    }
+  }
+  for_each_pair(SectionId::Affects, [&](int key, int value) { pkb.InsertAffects(key, value); });
+  for_each_pair(SectionId::NextBip, [&](int key, int value) { pkb.InsertNextBip(key, value); });
+  for_each_pair(SectionId::AffectsBip, [&](int key, int value) { pkb.InsertAffectsBip(key, value); });
+
+  // an empty transitive relation was either not materialised or holds no pairs, and either way is answered
+  // from its labels or index
+  if (reader.Get(SectionId::NextT).num_keys != 0) {
+    pkb.next_table.AttachMappedNextTTables(reader.GetMappedRelation(SectionId::NextT),
+                                           reader.GetMappedRelation(SectionId::InverseNextT));
+  }
+  if (reader.Get(SectionId::AffectsT).num_keys != 0) {
+    pkb.affects_table.AttachMappedAffectsTTables(reader.GetMappedRelation(SectionId::AffectsT),
+                                                 reader.GetMappedRelation(SectionId::InverseAffectsT));
+  } else {
+    pkb.affects_table.IndexAffectsT();
+  }
+  if (reader.Get(SectionId::NextBipT).num_keys != 0) {
+    pkb.nextbip_table.AttachMappedNextBipTTables(reader.GetMappedRelation(SectionId::NextBipT),
+                                                 reader.GetMappedRelation(SectionId::InverseNextBipT));
+  } else if (reader.Get(SectionId::NextBipTIndexCopies).num_keys == 1) {
+    const SectionView& blocks_view = reader.Get(SectionId::NextBipTIndexBlocks);
+    std::vector<std::vector<int>> blocks(blocks_view.num_keys);
+    for (uint32_t i = 0; i < blocks_view.num_keys; ++i) {
+      blocks[i].assign(blocks_view.ValuesBegin(i), blocks_view.ValuesEnd(i));
+    }
+    int num_copies = reader.Get(SectionId::NextBipTIndexCopies).Key(0);
+    int num_nodes = num_copies * blocks.size();
+    bool is_valid = num_copies > 0;
+    std::vector<std::pair<int, int>> edges;
+    for_each_pair(SectionId::NextBipTIndexEdges, [&](int key, int value) {
+      is_valid = is_valid && key >= 0 && key < num_nodes && value >= 0 && value < num_nodes;
+      edges.push_back({key, value});
+    });
+    if (is_valid) {
+      pkb.nextbip_table.SetNextBipTIndex(StatementReachability(std::move(blocks), num_copies, std::move(edges)));
+    }
+  }
+  pkb.affects_bip_table.AttachMappedAffectsBipTTables(reader.GetMappedRelation(SectionId::AffectsBipT),
+                                                      reader.GetMappedRelation(SectionId::InverseAffectsBipT));
+  return true;
+}
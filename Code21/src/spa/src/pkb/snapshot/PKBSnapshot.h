@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "utils/Extension.h"
+
+class PKB;
+
+/*
+ * Binary snapshot of a fully populated PKB, keyed by a hash of the SIMPLE source it was extracted from.
+ *
+ * File layout (native byte order, every array 4-byte aligned):
+ *   header   magic "SPAPKB", format version, section count, source hash, payload size and payload checksum
+ *   payload  a sequence of sections, each a SectionHeader followed by sorted arrays
+ *            keys[num_keys], offsets[num_keys + 1] and values[num_values]
+ * Strings are interned into a single string section and referred to by index everywhere else.
+ *
+ * On load the file is memory-mapped. The transitive Next*, Affects*, NextBip* and AffectsBip* relations,
+ * which dominate both extraction time and PKB size, are served directly from the mapped arrays. The
+ * remaining tables are linear in the size of the program and are inserted back into the PKB.
+ */
+class PKBSnapshot {
+ public:
+  static const uint32_t kVersion;
+
+  // 64-bit FNV-1a hash of the source, the enabled extensions and the largest program whose transitive relations
+  // are materialised, used as the snapshot key
+  static uint64_t HashSource(const std::string& source, const utils::Extension& extension, int max_materialised_stmts);
+
+  // Returns the snapshot path for a source hash inside the directory named by the SPA_PKB_CACHE
+  // environment variable, or an empty string if snapshots are disabled
+  static std::string GetCachePath(uint64_t source_hash);
+
+  // Writes the PKB to path, returns false if the file could not be written
+  static bool Save(PKB& pkb, const std::string& path, uint64_t source_hash);
+
+  // Replaces the contents of the PKB with the snapshot at path. Returns false, leaving the PKB untouched,
+  // if the file is missing, was written by another format version or source, or fails its checksum.
+  static bool Load(PKB& pkb, const std::string& path, uint64_t source_hash);
+};
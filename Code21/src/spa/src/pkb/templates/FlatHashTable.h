@@ -0,0 +1,521 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_USE_SSE2 1
+#endif
+
+/*
+ * Open-addressing hash containers used as the backing store of Table, TableSingle and TableMultiple.
+ *
+ * Layout follows the "swiss table" scheme: every slot has a one byte control tag which is either
+ * kEmpty, kDeleted, or the low 7 bits (h2) of the hash of the key stored in the slot. Control bytes
+ * are probed 16 at a time (one SSE2 register when available), so a lookup compares the h2 of the
+ * key against a whole group in a single instruction and only touches the slots of matching tags.
+ * Slots are stored inline in one array, so there is no per-element node allocation.
+ *
+ * Unlike std::unordered_map, references and iterators are invalidated by any insertion that grows
+ * the table. The class is header-only since, unlike the Table templates, it is instantiated with
+ * arbitrary value types (sets, pairs, TokenLists).
+ */
+namespace flat_hash {
+
+typedef int8_t ctrl_t;
+
+static const ctrl_t kEmpty = -128;   // 0b10000000
+static const ctrl_t kDeleted = -2;   // 0b11111110
+static const size_t kGroupWidth = 16;
+
+// Bitmask of the positions within a group that matched a probe
+class BitMask {
+ private:
+  uint32_t mask;
+
+ public:
+  explicit BitMask(uint32_t mask) : mask(mask) {}
+  bool HasNext() const { return mask != 0; }
+  int Next() {
+    int index = LowestBit(mask);
+    mask &= (mask - 1);
+    return index;
+  }
+  static int LowestBit(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(value);
+#else
+    int index = 0;
+    while (!(value & 1u)) {
+      value >>= 1;
+      ++index;
+    }
+    return index;
+#endif
+  }
+};
+
+// A view over kGroupWidth consecutive control bytes
+class Group {
+ private:
+#ifdef FLAT_HASH_USE_SSE2
+  __m128i ctrl;
+#else
+  const ctrl_t* ctrl;
+#endif
+
+ public:
+#ifdef FLAT_HASH_USE_SSE2
+  explicit Group(const ctrl_t* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  BitMask Match(ctrl_t h2) const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+  }
+
+  BitMask MatchEmpty() const {
+    return Match(kEmpty);
+  }
+
+  // kEmpty and kDeleted are the only control bytes smaller than -1
+  BitMask MatchEmptyOrDeleted() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl))));
+  }
+#else
+  explicit Group(const ctrl_t* pos) : ctrl(pos) {}
+
+  BitMask Match(ctrl_t h2) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      if (ctrl[i] == h2) {
+        mask |= (1u << i);
+      }
+    }
+    return BitMask(mask);
+  }
+
+  BitMask MatchEmpty() const {
+    return Match(kEmpty);
+  }
+
+  BitMask MatchEmptyOrDeleted() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; ++i) {
+      if (ctrl[i] < -1) {
+        mask |= (1u << i);
+      }
+    }
+    return BitMask(mask);
+  }
+#endif
+};
+
+// std::hash<int> is the identity, so the hash is mixed (fibonacci hashing) before being split into
+// h1, which selects the starting group, and h2, the 7 bit tag stored in the control byte
+inline uint64_t Mix(size_t hash) { return static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull; }
+inline size_t H1(size_t hash) { return static_cast<size_t>(Mix(hash) >> 32); }
+inline ctrl_t H2(size_t hash) { return static_cast<ctrl_t>((Mix(hash) >> 25) & 0x7F); }
+
+// Extracts the key out of a stored slot
+struct MapKeyOf {
+  template <class P>
+  const typename P::first_type& operator()(const P& slot) const { return slot.first; }
+};
+
+struct SetKeyOf {
+  template <class K>
+  const K& operator()(const K& slot) const { return slot; }
+};
+
+/*
+ * The raw table shared by FlatHashMap and FlatHashSet. Slot is the stored type, and KeyOf
+ * extracts the key from a Slot.
+ */
+template <class K, class Slot, class KeyOf, class Hash>
+class RawTable {
+ public:
+  static const size_t npos = static_cast<size_t>(-1);
+
+  RawTable() : ctrl(), slots(nullptr), capacity(0), num_elements(0), num_deleted(0) {}
+
+  RawTable(const RawTable& other) : ctrl(other.ctrl), slots(nullptr), capacity(other.capacity),
+                                    num_elements(0), num_deleted(other.num_deleted) {
+    slots = Allocate(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+      if (IsFull(ctrl[i])) {
+        new (slots + i) Slot(other.slots[i]);
+        ++num_elements;
+      }
+    }
+  }
+
+  RawTable(RawTable&& other) noexcept : ctrl(std::move(other.ctrl)), slots(other.slots), capacity(other.capacity),
+                                        num_elements(other.num_elements), num_deleted(other.num_deleted) {
+    other.ResetToEmpty();
+  }
+
+  RawTable& operator=(const RawTable& other) {
+    if (this != &other) {
+      RawTable copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  RawTable& operator=(RawTable&& other) noexcept {
+    if (this != &other) {
+      DestroyAll();
+      ctrl = std::move(other.ctrl);
+      slots = other.slots;
+      capacity = other.capacity;
+      num_elements = other.num_elements;
+      num_deleted = other.num_deleted;
+      other.ResetToEmpty();
+    }
+    return *this;
+  }
+
+  ~RawTable() { DestroyAll(); }
+
+  size_t Size() const { return num_elements; }
+  size_t Capacity() const { return capacity; }
+  bool IsFullAt(size_t index) const { return IsFull(ctrl[index]); }
+  Slot& SlotAt(size_t index) { return slots[index]; }
+  const Slot& SlotAt(size_t index) const { return slots[index]; }
+
+  // Returns the first full index at or after `index`, or Capacity() if there is none
+  size_t NextFull(size_t index) const {
+    while (index < capacity && !IsFull(ctrl[index])) {
+      ++index;
+    }
+    return index;
+  }
+
+  size_t Find(const K& key) const {
+    if (capacity == 0) {
+      return npos;
+    }
+    size_t hash = Hash()(key);
+    ctrl_t h2 = H2(hash);
+    size_t group_mask = capacity / kGroupWidth - 1;
+    size_t group = H1(hash) & group_mask;
+    for (size_t step = 1;; ++step) {
+      size_t offset = group * kGroupWidth;
+      Group g(&ctrl[offset]);
+      for (BitMask match = g.Match(h2); match.HasNext();) {
+        size_t index = offset + match.Next();
+        if (KeyOf()(slots[index]) == key) {
+          return index;
+        }
+      }
+      if (g.MatchEmpty().HasNext()) {
+        return npos;
+      }
+      // triangular probing visits every group when the number of groups is a power of 2
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Returns the index of `key`, and whether a new slot was constructed from `make_slot`
+  template <class MakeSlot>
+  std::pair<size_t, bool> FindOrInsert(const K& key, const MakeSlot& make_slot) {
+    size_t existing = Find(key);
+    if (existing != npos) {
+      return std::make_pair(existing, false);
+    }
+    if ((num_elements + num_deleted + 1) * 8 > capacity * 7) {
+      Rehash(GrowthCapacity(num_elements + 1));
+    }
+    size_t hash = Hash()(key);
+    size_t index = FindInsertPosition(hash);
+    if (ctrl[index] == kDeleted) {
+      --num_deleted;
+    }
+    make_slot(slots + index);
+    ctrl[index] = H2(hash);
+    ++num_elements;
+    return std::make_pair(index, true);
+  }
+
+  bool Erase(const K& key) {
+    size_t index = Find(key);
+    if (index == npos) {
+      return false;
+    }
+    slots[index].~Slot();
+    ctrl[index] = kDeleted;
+    --num_elements;
+    ++num_deleted;
+    return true;
+  }
+
+  void Reserve(size_t count) {
+    size_t required = GrowthCapacity(count);
+    if (required > capacity) {
+      Rehash(required);
+    }
+  }
+
+  void Clear() {
+    DestroyAll();
+    ResetToEmpty();
+  }
+
+  void Swap(RawTable& other) {
+    ctrl.swap(other.ctrl);
+    std::swap(slots, other.slots);
+    std::swap(capacity, other.capacity);
+    std::swap(num_elements, other.num_elements);
+    std::swap(num_deleted, other.num_deleted);
+  }
+
+ private:
+  std::vector<ctrl_t> ctrl;
+  Slot* slots;
+  size_t capacity;  // always 0 or a power of 2 that is at least kGroupWidth
+  size_t num_elements;
+  size_t num_deleted;
+
+  static bool IsFull(ctrl_t c) { return c >= 0; }
+
+  static Slot* Allocate(size_t count) {
+    if (count == 0) {
+      return nullptr;
+    }
+    return static_cast<Slot*>(::operator new(count * sizeof(Slot)));
+  }
+
+  // Smallest power-of-2 capacity that keeps `count` elements under the 7/8 load factor
+  static size_t GrowthCapacity(size_t count) {
+    size_t required = kGroupWidth;
+    while (required * 7 < count * 8) {
+      required *= 2;
+    }
+    return required;
+  }
+
+  size_t FindInsertPosition(size_t hash) const {
+    size_t group_mask = capacity / kGroupWidth - 1;
+    size_t group = H1(hash) & group_mask;
+    for (size_t step = 1;; ++step) {
+      size_t offset = group * kGroupWidth;
+      BitMask available = Group(&ctrl[offset]).MatchEmptyOrDeleted();
+      if (available.HasNext()) {
+        return offset + available.Next();
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  void Rehash(size_t new_capacity) {
+    std::vector<ctrl_t> old_ctrl(new_capacity, kEmpty);
+    old_ctrl.swap(ctrl);
+    Slot* old_slots = slots;
+    size_t old_capacity = capacity;
+
+    slots = Allocate(new_capacity);
+    capacity = new_capacity;
+    num_deleted = 0;
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (IsFull(old_ctrl[i])) {
+        size_t hash = Hash()(KeyOf()(old_slots[i]));
+        size_t index = FindInsertPosition(hash);
+        new (slots + index) Slot(std::move(old_slots[i]));
+        ctrl[index] = H2(hash);
+        old_slots[i].~Slot();
+      }
+    }
+    ::operator delete(old_slots);
+  }
+
+  void DestroyAll() {
+    for (size_t i = 0; i < capacity; ++i) {
+      if (IsFull(ctrl[i])) {
+        slots[i].~Slot();
+      }
+    }
+    ::operator delete(slots);
+    slots = nullptr;
+  }
+
+  void ResetToEmpty() {
+    ctrl.clear();
+    slots = nullptr;
+    capacity = 0;
+    num_elements = 0;
+    num_deleted = 0;
+  }
+};
+
+// Forward iterator over the full slots of a RawTable
+template <class Table, class Value>
+class Iterator {
+ private:
+  Table* table;
+  size_t index;
+
+ public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef Value value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Value* pointer;
+  typedef Value& reference;
+
+  Iterator() : table(nullptr), index(0) {}
+  Iterator(Table* table, size_t index) : table(table), index(index) {}
+
+  // allows conversion from iterator to const_iterator
+  template <class OtherTable, class OtherValue>
+  Iterator(const Iterator<OtherTable, OtherValue>& other) : table(other.GetTable()), index(other.GetIndex()) {}
+
+  Table* GetTable() const { return table; }
+  size_t GetIndex() const { return index; }
+
+  reference operator*() const { return table->SlotAt(index); }
+  pointer operator->() const { return &table->SlotAt(index); }
+
+  Iterator& operator++() {
+    index = table->NextFull(index + 1);
+    return *this;
+  }
+
+  Iterator operator++(int) {
+    Iterator copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  friend bool operator==(const Iterator& a, const Iterator& b) { return a.index == b.index; }
+  friend bool operator!=(const Iterator& a, const Iterator& b) { return a.index != b.index; }
+};
+
+}  // namespace flat_hash
+
+template <class K, class V, class Hash = std::hash<K>>
+class FlatHashMap {
+ private:
+  typedef std::pair<K, V> Slot;
+  typedef flat_hash::RawTable<K, Slot, flat_hash::MapKeyOf, Hash> Raw;
+  Raw raw;
+
+ public:
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef Slot value_type;
+  typedef flat_hash::Iterator<Raw, Slot> iterator;
+  typedef flat_hash::Iterator<const Raw, const Slot> const_iterator;
+
+  FlatHashMap() {}
+
+  iterator begin() { return iterator(&raw, raw.NextFull(0)); }
+  iterator end() { return iterator(&raw, raw.Capacity()); }
+  const_iterator begin() const { return const_iterator(&raw, raw.NextFull(0)); }
+  const_iterator end() const { return const_iterator(&raw, raw.Capacity()); }
+
+  size_t size() const { return raw.Size(); }
+  bool empty() const { return raw.Size() == 0; }
+  size_t capacity() const { return raw.Capacity(); }
+
+  iterator find(const K& key) {
+    size_t index = raw.Find(key);
+    return index == Raw::npos ? end() : iterator(&raw, index);
+  }
+
+  const_iterator find(const K& key) const {
+    size_t index = raw.Find(key);
+    return index == Raw::npos ? end() : const_iterator(&raw, index);
+  }
+
+  size_t count(const K& key) const { return raw.Find(key) == Raw::npos ? 0 : 1; }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    std::pair<size_t, bool> result = raw.FindOrInsert(value.first, [&value](Slot* slot) { new (slot) Slot(value); });
+    return std::make_pair(iterator(&raw, result.first), result.second);
+  }
+
+  V& operator[](const K& key) {
+    size_t index = raw.FindOrInsert(key, [&key](Slot* slot) { new (slot) Slot(key, V()); }).first;
+    return raw.SlotAt(index).second;
+  }
+
+  size_t erase(const K& key) { return raw.Erase(key) ? 1 : 0; }
+
+  // Pre-sizes the table so that `count` elements can be inserted without rehashing
+  void reserve(size_t count) { raw.Reserve(count); }
+
+  void clear() { raw.Clear(); }
+};
+
+template <class K, class Hash = std::hash<K>>
+class FlatHashSet {
+ private:
+  typedef flat_hash::RawTable<K, K, flat_hash::SetKeyOf, Hash> Raw;
+  Raw raw;
+
+ public:
+  typedef K key_type;
+  typedef K value_type;
+  // keys must never be modified in place, so both iterators are const
+  typedef flat_hash::Iterator<const Raw, const K> iterator;
+  typedef iterator const_iterator;
+
+  FlatHashSet() {}
+
+  template <class InputIt>
+  FlatHashSet(InputIt first, InputIt last) { insert(first, last); }
+
+  const_iterator begin() const { return const_iterator(&raw, raw.NextFull(0)); }
+  const_iterator end() const { return const_iterator(&raw, raw.Capacity()); }
+
+  size_t size() const { return raw.Size(); }
+  bool empty() const { return raw.Size() == 0; }
+  size_t capacity() const { return raw.Capacity(); }
+
+  const_iterator find(const K& key) const {
+    size_t index = raw.Find(key);
+    return index == Raw::npos ? end() : const_iterator(&raw, index);
+  }
+
+  size_t count(const K& key) const { return raw.Find(key) == Raw::npos ? 0 : 1; }
+
+  std::pair<const_iterator, bool> insert(const K& key) {
+    std::pair<size_t, bool> result = raw.FindOrInsert(key, [&key](K* slot) { new (slot) K(key); });
+    return std::make_pair(const_iterator(&raw, result.first), result.second);
+  }
+
+  // Batched insert; reserves once for the whole range when its size is known
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    typedef typename std::iterator_traits<InputIt>::iterator_category category;
+    ReserveForRange(first, last, category());
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  size_t erase(const K& key) { return raw.Erase(key) ? 1 : 0; }
+
+  void reserve(size_t count) { raw.Reserve(count); }
+
+  void clear() { raw.Clear(); }
+
+  std::unordered_set<K, Hash> ToUnorderedSet() const {
+    return std::unordered_set<K, Hash>(begin(), end(), size());
+  }
+
+ private:
+  template <class InputIt>
+  void ReserveForRange(InputIt, InputIt, std::input_iterator_tag) {}
+
+  template <class InputIt>
+  void ReserveForRange(InputIt first, InputIt last, std::forward_iterator_tag) {
+    raw.Reserve(raw.Size() + static_cast<size_t>(std::distance(first, last)));
+  }
+};
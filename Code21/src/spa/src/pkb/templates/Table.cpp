@@ -2,16 +2,19 @@
 
 template <class K>
 bool Table<K>::Insert(const K& value) {
-  if (table.find(value) != table.end()) {
-    return false;
-  }
-  table.insert(value);
-  return true;
+  return table.insert(value).second;
 }
 
 template <class K>
 std::unordered_set<K> Table<K>::GetAll() {
-  return table;
+  return table.ToUnorderedSet();
+}
+
+template <class K>
+void Table<K>::Reserve(int expected_size) {
+  if (expected_size > 0) {
+    table.reserve(expected_size);
+  }
 }
 
 template <class K>
@@ -3,10 +3,12 @@
 #include <string>
 #include <unordered_set>
 
+#include "FlatHashTable.h"
+
 template <class K>
 class Table {
  private:
-  std::unordered_set<K> table;
+  FlatHashSet<K> table;
 
  public:
   Table(){};
@@ -15,5 +17,7 @@ class Table {
 
   std::unordered_set<K> GetAll();
 
+  void Reserve(int);
+
   void ClearTable();
 };
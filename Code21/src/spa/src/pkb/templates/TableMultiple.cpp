@@ -1,21 +1,24 @@
 #include "TableMultiple.h"
 
-#include <algorithm>
-
 template <class K, class V>
 bool TableMultiple<K, V>::Insert(const K& k, const V& v) {
-  if (table.find(k) == table.end()) {
-    std::unordered_set<V> values = {v};
-    table[k] = values;
-    return true;
+  return table[k].insert(v).second;
+}
+
+template <class K, class V>
+bool TableMultiple<K, V>::InsertBatch(const K& k, const std::unordered_set<V>& values) {
+  // an empty batch adds no row, just as no single Insert would have
+  if (values.empty()) {
+    return false;
+  }
+  std::unordered_set<V>& existing_values = table[k];
+  size_t previous_size = existing_values.size();
+  if (previous_size == 0) {
+    existing_values = values;
   } else {
-    std::unordered_set<V>& existing_values = table[k];
-    if (std::find(existing_values.begin(), existing_values.end(), v) != existing_values.end()) {
-      return false;
-    }
-    existing_values.insert(v);
-    return true;
+    existing_values.insert(values.begin(), values.end());
   }
+  return existing_values.size() > previous_size;
 }
 
 template <class K, class V>
@@ -24,18 +27,20 @@ int TableMultiple<K, V>::Size() {
 }
 
 template <class K, class V>
-std::unordered_set<V>& TableMultiple<K, V>::Get(const K& k) {
-  return table[k];
+const std::unordered_set<V>& TableMultiple<K, V>::Get(const K& k) const {
+  static const std::unordered_set<V> empty_values;
+  auto it = table.find(k);
+  return it == table.end() ? empty_values : it->second;
 }
 
 template <class K, class V>
-bool TableMultiple<K, V>::Contains(const K& k) {
+bool TableMultiple<K, V>::Contains(const K& k) const {
   return table.find(k) != table.end();
 }
 
 template <class K, class V>
-std::unordered_set<K> TableMultiple<K, V>::GetAllKeys() {
-  std::unordered_set<K> all_keys;
+std::unordered_set<K> TableMultiple<K, V>::GetAllKeys() const {
+  std::unordered_set<K> all_keys(table.size());
   for (auto& it : table) {
     all_keys.insert(it.first);
   }
@@ -53,6 +58,13 @@ bool TableMultiple<K, V>::IsEmpty() {
   return table.size() == 0;
 }
 
+template <class K, class V>
+void TableMultiple<K, V>::Reserve(int expected_size) {
+  if (expected_size > 0) {
+    table.reserve(expected_size);
+  }
+}
+
 template <class K, class V>
 void TableMultiple<K, V>::ClearTable() {
   table.clear();
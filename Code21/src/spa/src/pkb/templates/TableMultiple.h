@@ -1,33 +1,39 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>  // Hash TableMultiple, O(1) average, O(n) worst case
-//#include <map> // self-balancing BST, O(logn)
 #include <unordered_set>
 
+#include "FlatHashTable.h"  // open-addressing hash map, O(1) average with no per-key node allocation
+
 /* using class template, so TableMultiple class does not exist, only TableMultiple<K, V> exists*/
 template <class K, class V>
 class TableMultiple {
  private:
-  /* using a hashmap of with keys and values of generic types for each TableMultiple */
-  std::unordered_map<K, std::unordered_set<V>> table;
+  /* using a flat hashmap of with keys and values of generic types for each TableMultiple */
+  FlatHashMap<K, std::unordered_set<V>> table;
 
  public:
   TableMultiple(){};
 
   bool Insert(const K&, const V&);
 
-  std::unordered_set<V>& Get(const K&);
+  /* inserts all values for a key with a single lookup, returns true if any value is new. An empty set adds no key */
+  bool InsertBatch(const K&, const std::unordered_set<V>&);
+
+  /* never inserts, so lookups are safe to share between threads; missing keys yield an empty set */
+  const std::unordered_set<V>& Get(const K&) const;
 
-  bool Contains(const K&);
+  bool Contains(const K&) const;
 
   int Size();
 
-  std::unordered_set<K> GetAllKeys();
+  std::unordered_set<K> GetAllKeys() const;
 
   bool TableExists();
 
   bool IsEmpty();
 
+  void Reserve(int);
+
   void ClearTable();
 };
\ No newline at end of file
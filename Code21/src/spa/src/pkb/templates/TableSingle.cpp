@@ -2,21 +2,18 @@
 
 template <class K, class V>
 bool TableSingle<K, V>::Insert(const K& k, const V& v) {
-  if (table.find(k) != table.end()) {
-    return false;
-  } else {
-    table[k] = v;
-    return true;
-  }
+  return table.insert(std::make_pair(k, v)).second;
 }
 
 template <class K, class V>
-V& TableSingle<K, V>::Get(const K& k) {
-  return table[k];
+const V& TableSingle<K, V>::Get(const K& k) const {
+  static const V default_value = V();
+  auto it = table.find(k);
+  return it == table.end() ? default_value : it->second;
 }
 
 template <class K, class V>
-bool TableSingle<K, V>::Contains(const K& k) {
+bool TableSingle<K, V>::Contains(const K& k) const {
   return table.find(k) != table.end();
 }
 
@@ -27,7 +24,7 @@ int TableSingle<K, V>::Size() {
 
 template <class K, class V>
 std::unordered_set<K> TableSingle<K, V>::GetAllKeys() {
-  std::unordered_set<K> all_keys;
+  std::unordered_set<K> all_keys(table.size());
   for (auto& it : table) {
     all_keys.insert(it.first);
   }
@@ -36,7 +33,7 @@ std::unordered_set<K> TableSingle<K, V>::GetAllKeys() {
 }
 
 template <class K, class V>
-std::unordered_map<K, V>& TableSingle<K, V>::GetTable() {
+FlatHashMap<K, V>& TableSingle<K, V>::GetTable() {
   return table;
 }
 
@@ -50,6 +47,13 @@ bool TableSingle<K, V>::IsEmpty() {
   return table.empty();
 }
 
+template <class K, class V>
+void TableSingle<K, V>::Reserve(int expected_size) {
+  if (expected_size > 0) {
+    table.reserve(expected_size);
+  }
+}
+
 template <class K, class V>
 void TableSingle<K, V>::ClearTable() {
   table.clear();
@@ -1,35 +1,38 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
+#include "FlatHashTable.h"
 #include "source_processor/token/TokenList.h"
 
 template <class K, class V>
 class TableSingle {
  private:
-  std::unordered_map<K, V> table;
+  FlatHashMap<K, V> table;
 
  public:
   TableSingle(){};
 
   bool Insert(const K&, const V&);
 
-  V& Get(const K&);
+  /* never inserts, so lookups are safe to share between threads; missing keys yield a default value */
+  const V& Get(const K&) const;
 
-  bool Contains(const K&);
+  bool Contains(const K&) const;
 
   int Size();
 
   std::unordered_set<K> GetAllKeys();
 
-  std::unordered_map<K, V>& GetTable();
+  FlatHashMap<K, V>& GetTable();
 
   bool TableExists();
 
   bool IsEmpty();
 
+  void Reserve(int);
+
   void ClearTable();
 };
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "BidirectionalSearch.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "utils/Cancellation.h"
+
+bool BidirectionalSearch::IsReachable(const TableMultiple<int, int>& forward, const TableMultiple<int, int>& inverse,
+                                      int source, int target) {
+  if (source <= 0 || target <= 0) {
+    return false;
+  }
+
+  // forward_reached holds stmts reachable from source through at least one edge, and
+  // backward_reached holds stmts that reach target through zero or more edges
+  std::unordered_set<int> forward_reached;
+  std::unordered_set<int> backward_reached = {target};
+  std::vector<int> forward_frontier = {source};
+  std::vector<int> backward_frontier = {target};
+  std::vector<int> next_frontier;
+  bool is_first_step = true;
+
+  while (!forward_frontier.empty() && !backward_frontier.empty()) {
+    utils::Cancellation::Check(forward_frontier.size() + backward_frontier.size());
+    // the first step always goes forward, so that source itself is never taken as reached
+    bool expand_forward = is_first_step || forward_frontier.size() <= backward_frontier.size();
+    is_first_step = false;
+    next_frontier.clear();
+
+    if (expand_forward) {
+      for (int stmt : forward_frontier) {
+        for (int next_stmt : forward.Get(stmt)) {
+          if (backward_reached.find(next_stmt) != backward_reached.end()) {
+            return true;
+          }
+          if (forward_reached.insert(next_stmt).second) {
+            next_frontier.push_back(next_stmt);
+          }
+        }
+      }
+      forward_frontier.swap(next_frontier);
+    } else {
+      for (int stmt : backward_frontier) {
+        for (int prev_stmt : inverse.Get(stmt)) {
+          if (prev_stmt == source || forward_reached.find(prev_stmt) != forward_reached.end()) {
+            return true;
+          }
+          if (backward_reached.insert(prev_stmt).second) {
+            next_frontier.push_back(prev_stmt);
+          }
+        }
+      }
+      backward_frontier.swap(next_frontier);
+    }
+  }
+  return false;
+}
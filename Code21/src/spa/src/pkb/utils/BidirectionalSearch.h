@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pkb/templates/TableMultiple.h"
+
+/*
+  Single-pair reachability over a relation stored as a forward and an inverse table, for when its
+  transitive closure has not been materialised. The search grows a frontier from each end, always
+  expanding the smaller one, and stops as soon as the two meet, so it only touches the neighbourhoods
+  of the two stmts instead of everything reachable from the first.
+*/
+class BidirectionalSearch {
+ public:
+  // whether target is reachable from source through at least one edge, so a stmt only reaches
+  // itself when it lies on a cycle
+  static bool IsReachable(const TableMultiple<int, int>& forward, const TableMultiple<int, int>& inverse,
+                          int source, int target);
+};
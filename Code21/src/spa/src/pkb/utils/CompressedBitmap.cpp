@@ -0,0 +1,601 @@
+#include "CompressedBitmap.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COMPRESSED_BITMAP_USE_SSE2 1
+#endif
+
+using compressed_bitmap::Container;
+using compressed_bitmap::ContainerType;
+
+namespace {
+
+const int kChunkBits = 16;
+const int kChunkMask = (1 << kChunkBits) - 1;
+const size_t kWordsPerChunk = (1 << kChunkBits) / 64;
+const size_t kMaxArraySize = 4096;  // an ARRAY of more values takes more space than a BITMAP
+
+int CountBits(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(word);
+#else
+  int count = 0;
+  for (; word != 0; word &= word - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+int LowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(word);
+#else
+  int index = 0;
+  while (!(word & 1ull)) {
+    word >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+// the word loops are the kernels of every BITMAP operation, so they process two words at a time when SSE2 is
+// available
+void AndWords(const uint64_t* a, const uint64_t* b, uint64_t* out) {
+#ifdef COMPRESSED_BITMAP_USE_SSE2
+  for (size_t i = 0; i < kWordsPerChunk; i += 2) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(x, y));
+  }
+#else
+  for (size_t i = 0; i < kWordsPerChunk; ++i) {
+    out[i] = a[i] & b[i];
+  }
+#endif
+}
+
+void OrWords(const uint64_t* a, const uint64_t* b, uint64_t* out) {
+#ifdef COMPRESSED_BITMAP_USE_SSE2
+  for (size_t i = 0; i < kWordsPerChunk; i += 2) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(x, y));
+  }
+#else
+  for (size_t i = 0; i < kWordsPerChunk; ++i) {
+    out[i] = a[i] | b[i];
+  }
+#endif
+}
+
+bool AnyCommonWord(const uint64_t* a, const uint64_t* b) {
+#ifdef COMPRESSED_BITMAP_USE_SSE2
+  for (size_t i = 0; i < kWordsPerChunk; i += 2) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    __m128i both = _mm_and_si128(x, y);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(both, _mm_setzero_si128())) != 0xFFFF) {
+      return true;
+    }
+  }
+  return false;
+#else
+  for (size_t i = 0; i < kWordsPerChunk; ++i) {
+    if ((a[i] & b[i]) != 0) {
+      return true;
+    }
+  }
+  return false;
+#endif
+}
+
+void SetRange(std::vector<uint64_t>& words, int first, int last) {
+  for (int value = first; value <= last;) {
+    int offset = value % 64;
+    int count = std::min(64 - offset, last - value + 1);
+    uint64_t mask = count == 64 ? ~0ull : ((1ull << count) - 1) << offset;
+    words[value / 64] |= mask;
+    value += count;
+  }
+}
+
+int RunStart(const Container& container, size_t run) {
+  return container.values[2 * run];
+}
+
+int RunLast(const Container& container, size_t run) {
+  return container.values[2 * run] + container.values[2 * run + 1];
+}
+
+size_t CountRunsOf(const Container& container) {
+  return container.values.size() / 2;
+}
+
+Container MakeArray(std::vector<uint16_t> values) {
+  Container container;
+  container.type = ContainerType::ARRAY;
+  container.cardinality = values.size();
+  container.values = std::move(values);
+  return container;
+}
+
+Container MakeBitmap(std::vector<uint64_t> words) {
+  Container container;
+  container.type = ContainerType::BITMAP;
+  for (uint64_t word : words) {
+    container.cardinality += CountBits(word);
+  }
+  container.words = std::move(words);
+  return container;
+}
+
+// runs of the sorted values
+Container MakeRuns(const std::vector<uint16_t>& values) {
+  Container container;
+  container.type = ContainerType::RUN;
+  container.cardinality = values.size();
+  for (size_t i = 0; i < values.size();) {
+    size_t last = i;
+    while (last + 1 < values.size() && values[last + 1] == values[last] + 1) {
+      ++last;
+    }
+    container.values.push_back(values[i]);
+    container.values.push_back(static_cast<uint16_t>(last - i));
+    i = last + 1;
+  }
+  return container;
+}
+
+std::vector<uint16_t> ToValues(const Container& container) {
+  switch (container.type) {
+    case ContainerType::ARRAY:
+      return container.values;
+    case ContainerType::BITMAP: {
+      std::vector<uint16_t> values;
+      values.reserve(container.cardinality);
+      for (size_t i = 0; i < kWordsPerChunk; ++i) {
+        for (uint64_t word = container.words[i]; word != 0; word &= word - 1) {
+          values.push_back(static_cast<uint16_t>(i * 64 + LowestBit(word)));
+        }
+      }
+      return values;
+    }
+    default: {
+      std::vector<uint16_t> values;
+      values.reserve(container.cardinality);
+      for (size_t run = 0; run < CountRunsOf(container); ++run) {
+        for (int value = RunStart(container, run); value <= RunLast(container, run); ++value) {
+          values.push_back(static_cast<uint16_t>(value));
+        }
+      }
+      return values;
+    }
+  }
+}
+
+// the words of a BITMAP, or of any other container expanded into the buffer
+const std::vector<uint64_t>& ToWords(const Container& container, std::vector<uint64_t>& buffer) {
+  if (container.type == ContainerType::BITMAP) {
+    return container.words;
+  }
+  buffer.assign(kWordsPerChunk, 0);
+  if (container.type == ContainerType::ARRAY) {
+    for (uint16_t value : container.values) {
+      buffer[value / 64] |= 1ull << (value % 64);
+    }
+  } else {
+    for (size_t run = 0; run < CountRunsOf(container); ++run) {
+      SetRange(buffer, RunStart(container, run), RunLast(container, run));
+    }
+  }
+  return buffer;
+}
+
+Container FromValues(std::vector<uint16_t> values) {
+  if (values.size() <= kMaxArraySize) {
+    return MakeArray(std::move(values));
+  }
+  Container array = MakeArray(std::move(values));
+  std::vector<uint64_t> buffer;
+  ToWords(array, buffer);
+  return MakeBitmap(std::move(buffer));
+}
+
+Container FromWords(std::vector<uint64_t> words) {
+  Container bitmap = MakeBitmap(std::move(words));
+  if (bitmap.cardinality > kMaxArraySize) {
+    return bitmap;
+  }
+  return MakeArray(ToValues(bitmap));
+}
+
+bool ContainsValue(const Container& container, uint16_t value) {
+  switch (container.type) {
+    case ContainerType::ARRAY:
+      return std::binary_search(container.values.begin(), container.values.end(), value);
+    case ContainerType::BITMAP:
+      return (container.words[value / 64] >> (value % 64)) & 1ull;
+    default: {
+      // the last run starting at or before the value
+      size_t low = 0;
+      size_t high = CountRunsOf(container);
+      while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (RunStart(container, middle) <= value) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      return low > 0 && value <= RunLast(container, low - 1);
+    }
+  }
+}
+
+size_t CountRuns(const Container& container) {
+  switch (container.type) {
+    case ContainerType::ARRAY: {
+      size_t num_runs = 0;
+      for (size_t i = 0; i < container.values.size(); ++i) {
+        if (i == 0 || container.values[i] != container.values[i - 1] + 1) {
+          ++num_runs;
+        }
+      }
+      return num_runs;
+    }
+    case ContainerType::BITMAP: {
+      // a run starts at every set bit whose previous bit is clear
+      size_t num_runs = 0;
+      uint64_t carry = 0;
+      for (uint64_t word : container.words) {
+        num_runs += CountBits(word & ~((word << 1) | carry));
+        carry = word >> 63;
+      }
+      return num_runs;
+    }
+    default:
+      return CountRunsOf(container);
+  }
+}
+
+Container OptimiseContainer(const Container& container) {
+  size_t array_bytes = container.cardinality <= kMaxArraySize ? container.cardinality * sizeof(uint16_t) : SIZE_MAX;
+  size_t bitmap_bytes = kWordsPerChunk * sizeof(uint64_t);
+  size_t run_bytes = CountRuns(container) * 2 * sizeof(uint16_t);
+  if (run_bytes < array_bytes && run_bytes < bitmap_bytes) {
+    return container.type == ContainerType::RUN ? container : MakeRuns(ToValues(container));
+  }
+  if (array_bytes <= bitmap_bytes) {
+    return container.type == ContainerType::ARRAY ? container : MakeArray(ToValues(container));
+  }
+  std::vector<uint64_t> buffer;
+  return container.type == ContainerType::BITMAP ? container : MakeBitmap(ToWords(container, buffer));
+}
+
+// merges the sorted arrays, or gallops through the larger one when their sizes differ a lot
+std::vector<uint16_t> IntersectArrays(const std::vector<uint16_t>& a, const std::vector<uint16_t>& b) {
+  const std::vector<uint16_t>& small = a.size() <= b.size() ? a : b;
+  const std::vector<uint16_t>& large = a.size() <= b.size() ? b : a;
+  std::vector<uint16_t> values;
+  if (small.size() * 32 < large.size()) {
+    auto it = large.begin();
+    for (uint16_t value : small) {
+      it = std::lower_bound(it, large.end(), value);
+      if (it == large.end()) {
+        break;
+      }
+      if (*it == value) {
+        values.push_back(value);
+      }
+    }
+    return values;
+  }
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(values));
+  return values;
+}
+
+Container IntersectRuns(const Container& a, const Container& b) {
+  Container container;
+  container.type = ContainerType::RUN;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < CountRunsOf(a) && j < CountRunsOf(b)) {
+    int first = std::max(RunStart(a, i), RunStart(b, j));
+    int last = std::min(RunLast(a, i), RunLast(b, j));
+    if (first <= last) {
+      container.values.push_back(static_cast<uint16_t>(first));
+      container.values.push_back(static_cast<uint16_t>(last - first));
+      container.cardinality += last - first + 1;
+    }
+    if (RunLast(a, i) < RunLast(b, j)) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return container;
+}
+
+Container UnionRuns(const Container& a, const Container& b) {
+  std::vector<std::pair<int, int>> runs;
+  for (size_t run = 0; run < CountRunsOf(a); ++run) {
+    runs.push_back({RunStart(a, run), RunLast(a, run)});
+  }
+  for (size_t run = 0; run < CountRunsOf(b); ++run) {
+    runs.push_back({RunStart(b, run), RunLast(b, run)});
+  }
+  std::sort(runs.begin(), runs.end());
+
+  Container container;
+  container.type = ContainerType::RUN;
+  for (size_t i = 0; i < runs.size();) {
+    int first = runs[i].first;
+    int last = runs[i].second;
+    // merge the runs that overlap or touch this one
+    for (++i; i < runs.size() && runs[i].first <= last + 1; ++i) {
+      last = std::max(last, runs[i].second);
+    }
+    container.values.push_back(static_cast<uint16_t>(first));
+    container.values.push_back(static_cast<uint16_t>(last - first));
+    container.cardinality += last - first + 1;
+  }
+  return container;
+}
+
+Container IntersectContainers(const Container& a, const Container& b) {
+  if (a.type == ContainerType::RUN && b.type == ContainerType::RUN) {
+    return IntersectRuns(a, b);
+  }
+  if (a.type == ContainerType::ARRAY && b.type == ContainerType::ARRAY) {
+    return MakeArray(IntersectArrays(a.values, b.values));
+  }
+  if (a.type == ContainerType::ARRAY || b.type == ContainerType::ARRAY) {
+    const Container& array = a.type == ContainerType::ARRAY ? a : b;
+    const Container& other = a.type == ContainerType::ARRAY ? b : a;
+    std::vector<uint16_t> values;
+    for (uint16_t value : array.values) {
+      if (ContainsValue(other, value)) {
+        values.push_back(value);
+      }
+    }
+    return MakeArray(std::move(values));
+  }
+  std::vector<uint64_t> a_buffer;
+  std::vector<uint64_t> b_buffer;
+  std::vector<uint64_t> words(kWordsPerChunk);
+  AndWords(ToWords(a, a_buffer).data(), ToWords(b, b_buffer).data(), words.data());
+  return FromWords(std::move(words));
+}
+
+Container UnionContainers(const Container& a, const Container& b) {
+  if (a.type == ContainerType::RUN && b.type == ContainerType::RUN) {
+    return UnionRuns(a, b);
+  }
+  if (a.type == ContainerType::ARRAY && b.type == ContainerType::ARRAY) {
+    std::vector<uint16_t> values;
+    std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(values));
+    return FromValues(std::move(values));
+  }
+  std::vector<uint64_t> a_buffer;
+  std::vector<uint64_t> b_buffer;
+  std::vector<uint64_t> words(kWordsPerChunk);
+  OrWords(ToWords(a, a_buffer).data(), ToWords(b, b_buffer).data(), words.data());
+  return FromWords(std::move(words));
+}
+
+bool ContainersIntersect(const Container& a, const Container& b) {
+  if (a.type == ContainerType::ARRAY || b.type == ContainerType::ARRAY) {
+    const Container& array = a.type == ContainerType::ARRAY ? a : b;
+    const Container& other = a.type == ContainerType::ARRAY ? b : a;
+    for (uint16_t value : array.values) {
+      if (ContainsValue(other, value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (a.type == ContainerType::RUN && b.type == ContainerType::RUN) {
+    return IntersectRuns(a, b).cardinality != 0;
+  }
+  std::vector<uint64_t> a_buffer;
+  std::vector<uint64_t> b_buffer;
+  return AnyCommonWord(ToWords(a, a_buffer).data(), ToWords(b, b_buffer).data());
+}
+
+}  // namespace
+
+CompressedBitmap::CompressedBitmap(const std::unordered_set<int>& values)
+    : CompressedBitmap(std::vector<int>(values.begin(), values.end())) {}
+
+CompressedBitmap::CompressedBitmap(std::vector<int> values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  auto it = std::lower_bound(values.begin(), values.end(), 0);
+  while (it != values.end()) {
+    uint16_t key = static_cast<uint16_t>(*it >> kChunkBits);
+    std::vector<uint16_t> chunk_values;
+    for (; it != values.end() && (*it >> kChunkBits) == key; ++it) {
+      chunk_values.push_back(static_cast<uint16_t>(*it & kChunkMask));
+    }
+    keys.push_back(key);
+    containers.push_back(FromValues(std::move(chunk_values)));
+  }
+  Optimise();
+}
+
+int CompressedBitmap::FindChunk(uint16_t key) const {
+  auto it = std::lower_bound(keys.begin(), keys.end(), key);
+  if (it == keys.end() || *it != key) {
+    return -1;
+  }
+  return it - keys.begin();
+}
+
+bool CompressedBitmap::Insert(int value) {
+  if (value < 0) {
+    return false;
+  }
+  uint16_t key = static_cast<uint16_t>(value >> kChunkBits);
+  uint16_t low = static_cast<uint16_t>(value & kChunkMask);
+  auto key_it = std::lower_bound(keys.begin(), keys.end(), key);
+  size_t chunk = key_it - keys.begin();
+  if (key_it == keys.end() || *key_it != key) {
+    keys.insert(key_it, key);
+    containers.insert(containers.begin() + chunk, Container());
+  }
+
+  Container& container = containers[chunk];
+  if (ContainsValue(container, low)) {
+    return false;
+  }
+  switch (container.type) {
+    case ContainerType::ARRAY: {
+      container.values.insert(std::lower_bound(container.values.begin(), container.values.end(), low), low);
+      container = FromValues(std::move(container.values));
+      break;
+    }
+    case ContainerType::BITMAP:
+      container.words[low / 64] |= 1ull << (low % 64);
+      container.cardinality++;
+      break;
+    default: {
+      std::vector<uint16_t> values = ToValues(container);
+      values.insert(std::lower_bound(values.begin(), values.end(), low), low);
+      container = FromValues(std::move(values));
+      break;
+    }
+  }
+  return true;
+}
+
+bool CompressedBitmap::Contains(int value) const {
+  if (value < 0) {
+    return false;
+  }
+  int chunk = FindChunk(static_cast<uint16_t>(value >> kChunkBits));
+  return chunk != -1 && ContainsValue(containers[chunk], static_cast<uint16_t>(value & kChunkMask));
+}
+
+size_t CompressedBitmap::Size() const {
+  size_t size = 0;
+  for (const auto& container : containers) {
+    size += container.cardinality;
+  }
+  return size;
+}
+
+bool CompressedBitmap::IsEmpty() const {
+  return containers.empty();
+}
+
+CompressedBitmap CompressedBitmap::Intersect(const CompressedBitmap& other) const {
+  CompressedBitmap intersection;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < keys.size() && j < other.keys.size()) {
+    if (keys[i] < other.keys[j]) {
+      ++i;
+    } else if (keys[i] > other.keys[j]) {
+      ++j;
+    } else {
+      Container container = IntersectContainers(containers[i], other.containers[j]);
+      if (container.cardinality != 0) {
+        intersection.keys.push_back(keys[i]);
+        intersection.containers.push_back(std::move(container));
+      }
+      ++i;
+      ++j;
+    }
+  }
+  return intersection;
+}
+
+CompressedBitmap CompressedBitmap::Union(const CompressedBitmap& other) const {
+  CompressedBitmap union_bitmap;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < keys.size() || j < other.keys.size()) {
+    if (j == other.keys.size() || (i < keys.size() && keys[i] < other.keys[j])) {
+      union_bitmap.keys.push_back(keys[i]);
+      union_bitmap.containers.push_back(containers[i++]);
+    } else if (i == keys.size() || keys[i] > other.keys[j]) {
+      union_bitmap.keys.push_back(other.keys[j]);
+      union_bitmap.containers.push_back(other.containers[j++]);
+    } else {
+      union_bitmap.keys.push_back(keys[i]);
+      union_bitmap.containers.push_back(UnionContainers(containers[i++], other.containers[j++]));
+    }
+  }
+  return union_bitmap;
+}
+
+bool CompressedBitmap::Intersects(const CompressedBitmap& other) const {
+  size_t i = 0;
+  size_t j = 0;
+  while (i < keys.size() && j < other.keys.size()) {
+    if (keys[i] < other.keys[j]) {
+      ++i;
+    } else if (keys[i] > other.keys[j]) {
+      ++j;
+    } else if (ContainersIntersect(containers[i++], other.containers[j++])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void CompressedBitmap::Optimise() {
+  for (auto& container : containers) {
+    container = OptimiseContainer(container);
+    container.values.shrink_to_fit();
+  }
+  keys.shrink_to_fit();
+  containers.shrink_to_fit();
+}
+
+std::vector<int> CompressedBitmap::ToVector() const {
+  std::vector<int> values;
+  values.reserve(Size());
+  for (size_t chunk = 0; chunk < keys.size(); ++chunk) {
+    int high = static_cast<int>(keys[chunk]) << kChunkBits;
+    for (uint16_t low : ToValues(containers[chunk])) {
+      values.push_back(high | low);
+    }
+  }
+  return values;
+}
+
+std::unordered_set<int> CompressedBitmap::ToSet() const {
+  std::vector<int> values = ToVector();
+  return std::unordered_set<int>(values.begin(), values.end());
+}
+
+std::vector<CompressedBitmap::ContainerType> CompressedBitmap::GetContainerTypes() const {
+  std::vector<ContainerType> types;
+  for (const auto& container : containers) {
+    types.push_back(container.type);
+  }
+  return types;
+}
+
+size_t CompressedBitmap::CountBytes() const {
+  size_t num_bytes = sizeof(*this) + keys.capacity() * sizeof(uint16_t) + containers.capacity() * sizeof(Container);
+  for (const auto& container : containers) {
+    num_bytes += container.values.capacity() * sizeof(uint16_t) + container.words.capacity() * sizeof(uint64_t);
+  }
+  return num_bytes;
+}
+
+bool CompressedBitmap::operator==(const CompressedBitmap& other) const {
+  return keys == other.keys && ToVector() == other.ToVector();
+}
+
+bool CompressedBitmap::operator!=(const CompressedBitmap& other) const {
+  return !(*this == other);
+}
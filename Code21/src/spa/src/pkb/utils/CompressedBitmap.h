@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace compressed_bitmap {
+
+enum class ContainerType : uint8_t { ARRAY, BITMAP, RUN };
+
+// The low 16 bits of the values of one chunk of 2^16 values
+struct Container {
+  ContainerType type = ContainerType::ARRAY;
+  uint32_t cardinality = 0;
+  std::vector<uint16_t> values;  // ARRAY: sorted values, RUN: (start, length - 1) pairs sorted by start
+  std::vector<uint64_t> words;   // BITMAP: one bit per value of the chunk
+};
+
+}  // namespace compressed_bitmap
+
+/*
+  A set of non-negative ints stored as a roaring bitmap (Chambi et al., "Better bitmap performance with
+  Roaring bitmaps"). Values are split into chunks of 2^16 by their high 16 bits, and every chunk keeps the
+  low 16 bits of its values in one of three containers:
+    - ARRAY: the sorted values, for chunks of at most 4096 values,
+    - BITMAP: one bit per value of the chunk, for denser chunks,
+    - RUN: runs of consecutive values, for chunks made up of a few ranges (e.g. the stmts of a procedure).
+  Rows of transitive relations range from nearly empty to nearly full, and take 2 bytes per value or
+  4 bytes per run here, against the ~40 bytes per value of an unordered_set.
+  Set operations work chunk by chunk on the containers directly, without expanding them into values.
+*/
+class CompressedBitmap {
+ public:
+  typedef compressed_bitmap::ContainerType ContainerType;
+
+ private:
+  typedef compressed_bitmap::Container Container;
+
+  std::vector<uint16_t> keys;  // high 16 bits of the chunks, sorted
+  std::vector<Container> containers;
+
+  // index of the chunk with the key in keys, or -1 if there is none
+  int FindChunk(uint16_t key) const;
+
+ public:
+  CompressedBitmap() = default;
+
+  explicit CompressedBitmap(const std::unordered_set<int>&);
+
+  explicit CompressedBitmap(std::vector<int>);
+
+  /* negative values cannot be stored, and are never inserted */
+  bool Insert(int);
+
+  bool Contains(int) const;
+
+  size_t Size() const;
+
+  bool IsEmpty() const;
+
+  CompressedBitmap Intersect(const CompressedBitmap&) const;
+
+  CompressedBitmap Union(const CompressedBitmap&) const;
+
+  /* whether the intersection is non-empty, without building it */
+  bool Intersects(const CompressedBitmap&) const;
+
+  /* converts every container to its smallest type, once no more values are inserted */
+  void Optimise();
+
+  std::vector<int> ToVector() const;
+
+  std::unordered_set<int> ToSet() const;
+
+  std::vector<ContainerType> GetContainerTypes() const;
+
+  size_t CountBytes() const;
+
+  bool operator==(const CompressedBitmap&) const;
+
+  bool operator!=(const CompressedBitmap&) const;
+};
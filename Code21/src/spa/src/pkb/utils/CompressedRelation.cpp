@@ -0,0 +1,60 @@
+#include "CompressedRelation.h"
+
+CompressedRelation::CompressedRelation(const TableMultiple<int, int>& table) : is_attached(true) {
+  std::unordered_set<int> keys = table.GetAllKeys();
+  rows.reserve(keys.size());
+  for (int key : keys) {
+    rows[key] = CompressedBitmap(table.Get(key));
+  }
+}
+
+bool CompressedRelation::IsAttached() const {
+  return is_attached;
+}
+
+bool CompressedRelation::Contains(int key, int value) const {
+  return GetRow(key).Contains(value);
+}
+
+bool CompressedRelation::ContainsKey(int key) const {
+  return rows.count(key) != 0;
+}
+
+std::unordered_set<int> CompressedRelation::Get(int key) const {
+  return GetRow(key).ToSet();
+}
+
+const CompressedBitmap& CompressedRelation::GetRow(int key) const {
+  static const CompressedBitmap empty_row;
+  auto it = rows.find(key);
+  return it == rows.end() ? empty_row : it->second;
+}
+
+std::unordered_set<int> CompressedRelation::GetAllKeys() const {
+  std::unordered_set<int> keys(rows.size());
+  for (const auto& row : rows) {
+    keys.insert(row.first);
+  }
+  return keys;
+}
+
+TableMultiple<int, int> CompressedRelation::ToTable() const {
+  TableMultiple<int, int> table;
+  table.Reserve(rows.size());
+  for (const auto& row : rows) {
+    table.InsertBatch(row.first, row.second.ToSet());
+  }
+  return table;
+}
+
+size_t CompressedRelation::CountBytes() const {
+  size_t num_bytes = rows.capacity() * (sizeof(int) + sizeof(CompressedBitmap));
+  for (const auto& row : rows) {
+    num_bytes += row.second.CountBytes() - sizeof(CompressedBitmap);
+  }
+  return num_bytes;
+}
+
+void CompressedRelation::Reset() {
+  *this = CompressedRelation();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_set>
+
+#include "CompressedBitmap.h"
+#include "pkb/templates/FlatHashTable.h"
+#include "pkb/templates/TableMultiple.h"
+
+/*
+ * A read-only int to int relation with every row stored as a CompressedBitmap, built from a TableMultiple
+ * once the relation is no longer modified. Rows can be intersected with other sets of stmts without being
+ * expanded into sets first.
+ */
+class CompressedRelation {
+ private:
+  FlatHashMap<int, CompressedBitmap> rows;
+  bool is_attached = false;
+
+ public:
+  CompressedRelation() = default;
+
+  explicit CompressedRelation(const TableMultiple<int, int>&);
+
+  bool IsAttached() const;
+
+  bool Contains(int key, int value) const;
+
+  bool ContainsKey(int key) const;
+
+  std::unordered_set<int> Get(int key) const;
+
+  /* missing keys yield an empty row */
+  const CompressedBitmap& GetRow(int key) const;
+
+  std::unordered_set<int> GetAllKeys() const;
+
+  TableMultiple<int, int> ToTable() const;
+
+  size_t CountBytes() const;
+
+  // Detaches the relation from its rows
+  void Reset();
+};
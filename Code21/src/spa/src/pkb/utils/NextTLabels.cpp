@@ -0,0 +1,145 @@
+#include "NextTLabels.h"
+
+#include <algorithm>
+
+bool NextTLabels::IsLabelled(int stmt) const {
+  return stmt > 0 && static_cast<size_t>(stmt) < labels.size() && labels[stmt].proc_first != 0;
+}
+
+int NextTLabels::GetOutermostWhile(int stmt) const {
+  int outermost_while = 0;
+  for (int container = stmt; container != 0; container = labels[container].parent) {
+    if (labels[container].is_while) {
+      outermost_while = container;
+    }
+  }
+  return outermost_while;
+}
+
+bool NextTLabels::InsertLabel(int stmt, const StatementLabel& label) {
+  if (stmt <= 0 || label.proc_first <= 0 || IsLabelled(stmt)) {
+    return false;
+  }
+  if (static_cast<size_t>(stmt) >= labels.size()) {
+    labels.resize(stmt + 1);
+  }
+  labels[stmt] = label;
+  return true;
+}
+
+bool NextTLabels::IsEmpty() const {
+  return labels.empty();
+}
+
+const StatementLabel& NextTLabels::GetLabel(int stmt) const {
+  return labels[stmt];
+}
+
+std::vector<int> NextTLabels::GetLabelledStatements() const {
+  std::vector<int> stmts;
+  for (size_t stmt = 1; stmt < labels.size(); ++stmt) {
+    if (IsLabelled(stmt)) {
+      stmts.push_back(stmt);
+    }
+  }
+  return stmts;
+}
+
+bool NextTLabels::IsNextT(int stmt1, int stmt2) const {
+  if (!IsLabelled(stmt1) || !IsLabelled(stmt2) || labels[stmt1].proc_first != labels[stmt2].proc_first) {
+    return false;
+  }
+
+  int loop = GetOutermostWhile(stmt1);
+  if (loop != 0 && loop <= stmt2 && stmt2 <= labels[loop].last) {
+    return true;
+  }
+  // past its loop, if any, control only flows forward
+  int from = loop != 0 ? loop : stmt1;
+  if (stmt2 <= from) {
+    return false;
+  }
+  for (int container = labels[from].parent; container != 0; container = labels[container].parent) {
+    const StatementLabel& label = labels[container];
+    if (label.else_first != 0 && from < label.else_first && label.else_first <= stmt2 && stmt2 <= label.last) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::pair<int, int>> NextTLabels::GetNextTRanges(int stmt) const {
+  std::vector<std::pair<int, int>> ranges;
+  if (!IsLabelled(stmt)) {
+    return ranges;
+  }
+
+  int loop = GetOutermostWhile(stmt);
+  if (loop != 0) {
+    ranges.push_back({loop, labels[loop].last});
+  }
+  int from = loop != 0 ? loop : stmt;
+  // the else branches skipped from a then branch, innermost first, which is also their order in the program
+  int first = loop != 0 ? labels[loop].last + 1 : stmt + 1;
+  for (int container = labels[from].parent; container != 0; container = labels[container].parent) {
+    const StatementLabel& label = labels[container];
+    if (label.else_first != 0 && from < label.else_first) {
+      if (first < label.else_first) {
+        ranges.push_back({first, label.else_first - 1});
+      }
+      first = label.last + 1;
+    }
+  }
+  if (first <= labels[stmt].proc_last) {
+    ranges.push_back({first, labels[stmt].proc_last});
+  }
+  return ranges;
+}
+
+std::vector<std::pair<int, int>> NextTLabels::GetPreviousTRanges(int stmt) const {
+  std::vector<std::pair<int, int>> ranges;
+  if (!IsLabelled(stmt)) {
+    return ranges;
+  }
+
+  int loop = GetOutermostWhile(stmt);
+  int to = loop != 0 ? loop : stmt;
+  // the then branches that cannot reach an else branch, innermost first, so in reverse program order
+  std::vector<std::pair<int, int>> skipped;
+  for (int container = labels[to].parent; container != 0; container = labels[container].parent) {
+    const StatementLabel& label = labels[container];
+    if (label.else_first != 0 && label.else_first <= to) {
+      skipped.push_back({container + 1, label.else_first - 1});
+    }
+  }
+  std::reverse(skipped.begin(), skipped.end());
+
+  int first = labels[stmt].proc_first;
+  for (const auto& range : skipped) {
+    if (first < range.first) {
+      ranges.push_back({first, range.first - 1});
+    }
+    first = range.second + 1;
+  }
+  if (first < to) {
+    ranges.push_back({first, to - 1});
+  }
+  if (loop != 0) {
+    ranges.push_back({loop, labels[loop].last});
+  }
+  return ranges;
+}
+
+std::unordered_set<int> NextTLabels::ExpandRanges(const std::vector<std::pair<int, int>>& ranges) {
+  std::unordered_set<int> stmts;
+  for (const auto& range : ranges) {
+    for (int stmt = range.first; stmt <= range.second; ++stmt) {
+      stmts.insert(stmt);
+    }
+  }
+  return stmts;
+}
+
+void NextTLabels::ClearLabels() {
+  labels.clear();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// where a stmt sits in the nesting of its procedure; stmts are numbered in program order, so every
+// container and every branch of an if covers a contiguous range of stmt#s
+struct StatementLabel {
+  int proc_first = 0;  // first stmt# of the procedure containing the stmt
+  int proc_last = 0;   // last stmt# of the procedure containing the stmt
+  int parent = 0;      // innermost container stmt containing the stmt, 0 if none
+  int last = 0;        // last stmt# nested in the stmt, the stmt itself if it is not a container
+  int else_first = 0;  // first stmt# of the else branch of an if stmt, 0 otherwise
+  bool is_while = false;
+};
+
+/*
+  Answers NextT within a procedure from the nesting of its stmts instead of a transitive table.
+  Control flows forward through the stmt#s of a procedure except that
+    - a while loops back, so every stmt in the range of a while reaches every other stmt in it
+    - the then branch of an if never reaches its else branch
+  So a stmt reaches every stmt in the outermost while containing it, and every stmt after it (or after
+  that while) in its procedure, less the else branches of the ifs whose then branch it lies in.
+  A query walks the containers of a stmt, so it takes time linear in the nesting depth.
+*/
+class NextTLabels {
+ private:
+  std::vector<StatementLabel> labels;  // indexed by stmt#
+
+  bool IsLabelled(int) const;
+  // the outermost while containing the stmt or the stmt itself if it is a while, 0 if none
+  int GetOutermostWhile(int) const;
+
+ public:
+  NextTLabels(){};
+
+  bool InsertLabel(int, const StatementLabel&);
+
+  bool IsEmpty() const;
+
+  const StatementLabel& GetLabel(int) const;
+
+  std::vector<int> GetLabelledStatements() const;
+
+  bool IsNextT(int, int) const;
+
+  // the stmts NextT to a stmt as sorted, disjoint and inclusive ranges of stmt#s
+  std::vector<std::pair<int, int>> GetNextTRanges(int) const;
+
+  // the stmts a stmt is NextT to as sorted, disjoint and inclusive ranges of stmt#s
+  std::vector<std::pair<int, int>> GetPreviousTRanges(int) const;
+
+  static std::unordered_set<int> ExpandRanges(const std::vector<std::pair<int, int>>&);
+
+  void ClearLabels();
+};
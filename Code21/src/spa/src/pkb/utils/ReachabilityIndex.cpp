@@ -0,0 +1,282 @@
+#include "ReachabilityIndex.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace {
+
+// builds the compressed sparse row form of the edges, with the targets of every node sorted and unique
+void ToCompressedRows(int num_nodes, std::vector<std::pair<int, int>> edges, std::vector<int>& offsets,
+                      std::vector<int>& targets) {
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  offsets.assign(num_nodes + 1, 0);
+  targets.clear();
+  targets.reserve(edges.size());
+  for (const auto& edge : edges) {
+    offsets[edge.first + 1]++;
+    targets.push_back(edge.second);
+  }
+  for (int node = 0; node < num_nodes; ++node) {
+    offsets[node + 1] += offsets[node];
+  }
+}
+
+}  // namespace
+
+ReachabilityIndex::ReachabilityIndex(int num_nodes, const std::vector<std::pair<int, int>>& edges) {
+  CondenseComponents(num_nodes, edges);
+  LabelIntervals();
+}
+
+// Tarjan's algorithm, iterative so that long chains of stmts do not overflow the stack. Components are
+// numbered in the order they are completed, so every edge between components goes to a smaller number.
+void ReachabilityIndex::CondenseComponents(int num_nodes, const std::vector<std::pair<int, int>>& edges) {
+  std::vector<int> offsets;
+  std::vector<int> targets;
+  ToCompressedRows(num_nodes, edges, offsets, targets);
+
+  components.assign(num_nodes, -1);
+  std::vector<int> indexes(num_nodes, -1);
+  std::vector<int> lowlinks(num_nodes, 0);
+  std::vector<bool> on_stack(num_nodes, false);
+  std::vector<int> stack;
+  std::vector<std::pair<int, int>> call_stack;  // (node, offset of the next edge to follow)
+  int next_index = 0;
+  int num_components = 0;
+
+  for (int root = 0; root < num_nodes; ++root) {
+    if (indexes[root] != -1) {
+      continue;
+    }
+    call_stack.push_back({root, offsets[root]});
+    indexes[root] = lowlinks[root] = next_index++;
+    stack.push_back(root);
+    on_stack[root] = true;
+
+    while (!call_stack.empty()) {
+      int node = call_stack.back().first;
+      int& edge = call_stack.back().second;
+      if (edge < offsets[node + 1]) {
+        int child = targets[edge++];
+        if (indexes[child] == -1) {
+          indexes[child] = lowlinks[child] = next_index++;
+          stack.push_back(child);
+          on_stack[child] = true;
+          call_stack.push_back({child, offsets[child]});
+        } else if (on_stack[child]) {
+          lowlinks[node] = std::min(lowlinks[node], indexes[child]);
+        }
+        continue;
+      }
+
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        int parent = call_stack.back().first;
+        lowlinks[parent] = std::min(lowlinks[parent], lowlinks[node]);
+      }
+      if (lowlinks[node] == indexes[node]) {
+        int member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          on_stack[member] = false;
+          components[member] = num_components;
+        } while (member != node);
+        num_components++;
+      }
+    }
+  }
+
+  is_cyclic.assign(num_components, false);
+  std::vector<std::pair<int, int>> dag_edges;
+  std::vector<std::pair<int, int>> inverse_dag_edges;
+  for (const auto& edge : edges) {
+    int from = components[edge.first];
+    int to = components[edge.second];
+    if (from == to) {
+      is_cyclic[from] = true;
+    } else {
+      dag_edges.push_back({from, to});
+      inverse_dag_edges.push_back({to, from});
+    }
+  }
+  ToCompressedRows(num_components, dag_edges, dag_offsets, dag_targets);
+  ToCompressedRows(num_components, inverse_dag_edges, inverse_dag_offsets, inverse_dag_targets);
+
+  std::vector<std::pair<int, int>> members;
+  for (int node = 0; node < num_nodes; ++node) {
+    members.push_back({components[node], node});
+  }
+  ToCompressedRows(num_components, members, component_offsets, component_nodes);
+}
+
+// every traversal visits the roots and children of the DAG in a different order, so that the
+// intervals of different traversals rule out different pairs
+void ReachabilityIndex::LabelIntervals() {
+  int num_components = is_cyclic.size();
+  lows.assign(num_components * kNumTraversals, 0);
+  ranks.assign(num_components * kNumTraversals, 0);
+  std::vector<std::pair<int, int>> call_stack;  // (component, number of children followed)
+
+  for (int traversal = 0; traversal < kNumTraversals; ++traversal) {
+    bool is_reversed = traversal % 2 == 1;
+    std::vector<bool> visited(num_components, false);
+    int next_rank = 0;
+    // every component has a larger number than its children, so roots are found among the largest
+    for (int i = 0; i < num_components; ++i) {
+      int root = is_reversed ? i : num_components - 1 - i;
+      if (visited[root] || inverse_dag_offsets[root] != inverse_dag_offsets[root + 1]) {
+        continue;
+      }
+      visited[root] = true;
+      call_stack.push_back({root, 0});
+
+      while (!call_stack.empty()) {
+        int component = call_stack.back().first;
+        int& followed = call_stack.back().second;
+        int num_children = dag_offsets[component + 1] - dag_offsets[component];
+        if (followed < num_children) {
+          int child = is_reversed ? dag_targets[dag_offsets[component + 1] - 1 - followed]
+                                  : dag_targets[dag_offsets[component] + followed];
+          followed++;
+          if (!visited[child]) {
+            visited[child] = true;
+            call_stack.push_back({child, 0});
+          }
+          continue;
+        }
+
+        call_stack.pop_back();
+        int label = component * kNumTraversals + traversal;
+        ranks[label] = next_rank++;
+        lows[label] = ranks[label];
+        for (int edge = dag_offsets[component]; edge < dag_offsets[component + 1]; ++edge) {
+          lows[label] = std::min(lows[label], lows[dag_targets[edge] * kNumTraversals + traversal]);
+        }
+      }
+    }
+  }
+}
+
+bool ReachabilityIndex::MayReach(int from_component, int to_component) const {
+  if (from_component <= to_component) {
+    return false;
+  }
+  for (int traversal = 0; traversal < kNumTraversals; ++traversal) {
+    int from_label = from_component * kNumTraversals + traversal;
+    int to_label = to_component * kNumTraversals + traversal;
+    if (lows[to_label] < lows[from_label] || ranks[to_label] > ranks[from_label]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReachabilityIndex::IsReachable(int from, int to) const {
+  if (from < 0 || to < 0 || from >= CountNodes() || to >= CountNodes()) {
+    return false;
+  }
+  int from_component = components[from];
+  int to_component = components[to];
+  if (from_component == to_component) {
+    return is_cyclic[from_component];
+  }
+  if (!MayReach(from_component, to_component)) {
+    return false;
+  }
+
+  std::vector<int> stack = {from_component};
+  std::unordered_set<int> visited = {from_component};
+  while (!stack.empty()) {
+    int component = stack.back();
+    stack.pop_back();
+    for (int edge = dag_offsets[component]; edge < dag_offsets[component + 1]; ++edge) {
+      int child = dag_targets[edge];
+      if (child == to_component) {
+        return true;
+      }
+      if (MayReach(child, to_component) && visited.insert(child).second) {
+        stack.push_back(child);
+      }
+    }
+  }
+  return false;
+}
+
+bool ReachabilityIndex::HasSuccessors(int node) const {
+  if (node < 0 || node >= CountNodes()) {
+    return false;
+  }
+  int component = components[node];
+  return is_cyclic[component] || dag_offsets[component] != dag_offsets[component + 1];
+}
+
+std::vector<bool> ReachabilityIndex::SearchComponents(const std::vector<int>& source_components,
+                                                      bool is_inverse) const {
+  const std::vector<int>& offsets = is_inverse ? inverse_dag_offsets : dag_offsets;
+  const std::vector<int>& targets = is_inverse ? inverse_dag_targets : dag_targets;
+  std::vector<bool> reached(is_cyclic.size(), false);
+  std::vector<int> stack;
+  for (int component : source_components) {
+    // a component only reaches itself through one of its own edges
+    if (is_cyclic[component]) {
+      reached[component] = true;
+    }
+    stack.push_back(component);
+  }
+  while (!stack.empty()) {
+    int component = stack.back();
+    stack.pop_back();
+    for (int edge = offsets[component]; edge < offsets[component + 1]; ++edge) {
+      if (!reached[targets[edge]]) {
+        reached[targets[edge]] = true;
+        stack.push_back(targets[edge]);
+      }
+    }
+  }
+  return reached;
+}
+
+std::vector<int> ReachabilityIndex::GetReachableNodes(const std::vector<int>& nodes) const {
+  std::vector<int> source_components;
+  for (int node : nodes) {
+    if (node >= 0 && node < CountNodes()) {
+      source_components.push_back(components[node]);
+    }
+  }
+  std::vector<bool> reached = SearchComponents(source_components, false);
+  std::vector<int> reachable_nodes;
+  for (size_t component = 0; component < reached.size(); ++component) {
+    if (reached[component]) {
+      reachable_nodes.insert(reachable_nodes.end(), component_nodes.begin() + component_offsets[component],
+                             component_nodes.begin() + component_offsets[component + 1]);
+    }
+  }
+  return reachable_nodes;
+}
+
+std::vector<int> ReachabilityIndex::GetReachingNodes(const std::vector<int>& nodes) const {
+  std::vector<int> target_components;
+  for (int node : nodes) {
+    if (node >= 0 && node < CountNodes()) {
+      target_components.push_back(components[node]);
+    }
+  }
+  std::vector<bool> reached = SearchComponents(target_components, true);
+  std::vector<int> reaching_nodes;
+  for (size_t component = 0; component < reached.size(); ++component) {
+    if (reached[component]) {
+      reaching_nodes.insert(reaching_nodes.end(), component_nodes.begin() + component_offsets[component],
+                            component_nodes.begin() + component_offsets[component + 1]);
+    }
+  }
+  return reaching_nodes;
+}
+
+size_t ReachabilityIndex::CountBytes() const {
+  size_t num_ints = components.size() + component_offsets.size() + component_nodes.size() + dag_offsets.size() +
+                    dag_targets.size() + inverse_dag_offsets.size() + inverse_dag_targets.size() + lows.size() +
+                    ranks.size();
+  return num_ints * sizeof(int) + is_cyclic.size() / 8;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+  Reachability between the nodes of a directed graph without materialising its transitive closure,
+  after GRAIL (Yildirim et al., "GRAIL: Scalable Reachability Index for Large Graphs").
+  Every strongly connected component is collapsed into one node of a DAG, and every component is
+  labelled with the interval [low, rank] of a few depth-first traversals of the DAG, where rank is its
+  post-order number and low the smallest rank below it. A component can only reach another if its
+  intervals contain the other's, which answers most negative queries at once; the rest search the
+  DAG, only descending into components whose intervals still contain the target.
+  The index takes space linear in the size of the graph.
+*/
+class ReachabilityIndex {
+ private:
+  static const int kNumTraversals = 2;
+
+  std::vector<int> components;           // node -> strongly connected component
+  std::vector<bool> is_cyclic;           // whether a component has an edge back to itself
+  std::vector<int> component_offsets;    // nodes of component c are component_nodes[offsets[c], offsets[c + 1])
+  std::vector<int> component_nodes;
+  std::vector<int> dag_offsets;          // edges between components, in compressed sparse row form
+  std::vector<int> dag_targets;
+  std::vector<int> inverse_dag_offsets;
+  std::vector<int> inverse_dag_targets;
+  std::vector<int> lows;                 // interval of component c in traversal t at c * kNumTraversals + t
+  std::vector<int> ranks;
+
+  void CondenseComponents(int num_nodes, const std::vector<std::pair<int, int>>& edges);
+  void LabelIntervals();
+  bool MayReach(int from_component, int to_component) const;
+  // components reachable from the sources through at least one edge, in the DAG or its inverse
+  std::vector<bool> SearchComponents(const std::vector<int>& source_components, bool is_inverse) const;
+
+ public:
+  ReachabilityIndex() = default;
+  ReachabilityIndex(int num_nodes, const std::vector<std::pair<int, int>>& edges);
+
+  int CountNodes() const { return components.size(); }
+
+  bool IsEmpty() const { return components.empty(); }
+
+  // whether to is reachable from from through at least one edge
+  bool IsReachable(int from, int to) const;
+
+  bool HasSuccessors(int node) const;
+
+  // the nodes reachable from any of the nodes through at least one edge
+  std::vector<int> GetReachableNodes(const std::vector<int>& nodes) const;
+
+  // the nodes that reach any of the nodes through at least one edge
+  std::vector<int> GetReachingNodes(const std::vector<int>& nodes) const;
+
+  size_t CountBytes() const;
+};
@@ -0,0 +1,118 @@
+#include "StatementReachability.h"
+
+#include <algorithm>
+#include <chrono>
+
+StatementReachability::StatementReachability(std::vector<std::vector<int>> blocks, int num_copies,
+                                             std::vector<std::pair<int, int>> edges)
+    : blocks(std::move(blocks)), num_copies(num_copies), edges(std::move(edges)) {
+  auto start_time = std::chrono::steady_clock::now();
+  for (size_t block = 0; block < this->blocks.size(); ++block) {
+    for (size_t offset = 0; offset < this->blocks[block].size(); ++offset) {
+      int stmt = this->blocks[block][offset];
+      if (static_cast<size_t>(stmt) >= positions.size()) {
+        positions.resize(stmt + 1, {-1, -1});
+      }
+      positions[stmt] = {block, offset};
+    }
+  }
+  index = ReachabilityIndex(this->blocks.size() * num_copies, this->edges);
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  build_time_ms = elapsed.count();
+}
+
+bool StatementReachability::HasPosition(int stmt) const {
+  return stmt > 0 && static_cast<size_t>(stmt) < positions.size() && positions[stmt].first != -1;
+}
+
+std::vector<int> StatementReachability::GetCopies(int block) const {
+  std::vector<int> nodes;
+  for (int copy = 0; copy < num_copies; ++copy) {
+    nodes.push_back(block + copy * blocks.size());
+  }
+  return nodes;
+}
+
+void StatementReachability::InsertBlockStatements(int block, std::unordered_set<int>& stmts) const {
+  stmts.insert(blocks[block].begin(), blocks[block].end());
+}
+
+bool StatementReachability::IsReachable(int stmt1, int stmt2) const {
+  if (!HasPosition(stmt1) || !HasPosition(stmt2)) {
+    return false;
+  }
+  auto position1 = positions[stmt1];
+  auto position2 = positions[stmt2];
+  if (position1.first == position2.first && position1.second < position2.second) {
+    return true;
+  }
+  for (int node : GetCopies(position2.first)) {
+    if (index.IsReachable(position1.first, node)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::unordered_set<int> StatementReachability::GetReachableStatements(int stmt) const {
+  std::unordered_set<int> stmts;
+  if (!HasPosition(stmt)) {
+    return stmts;
+  }
+  auto position = positions[stmt];
+  const auto& block = blocks[position.first];
+  stmts.insert(block.begin() + position.second + 1, block.end());
+  for (int node : index.GetReachableNodes({position.first})) {
+    InsertBlockStatements(node % blocks.size(), stmts);
+  }
+  return stmts;
+}
+
+std::unordered_set<int> StatementReachability::GetReachingStatements(int stmt) const {
+  std::unordered_set<int> stmts;
+  if (!HasPosition(stmt)) {
+    return stmts;
+  }
+  auto position = positions[stmt];
+  const auto& block = blocks[position.first];
+  stmts.insert(block.begin(), block.begin() + position.second);
+  for (int node : index.GetReachingNodes(GetCopies(position.first))) {
+    if (static_cast<size_t>(node) < blocks.size()) {  // paths start from copy 0
+      InsertBlockStatements(node, stmts);
+    }
+  }
+  return stmts;
+}
+
+std::unordered_set<int> StatementReachability::GetAllReachableStatements() const {
+  std::unordered_set<int> stmts;
+  std::vector<int> sources;
+  for (size_t block = 0; block < blocks.size(); ++block) {
+    stmts.insert(blocks[block].begin() + std::min<size_t>(1, blocks[block].size()), blocks[block].end());
+    sources.push_back(block);
+  }
+  for (int node : index.GetReachableNodes(sources)) {
+    InsertBlockStatements(node % blocks.size(), stmts);
+  }
+  return stmts;
+}
+
+std::unordered_set<int> StatementReachability::GetAllReachingStatements() const {
+  std::unordered_set<int> stmts;
+  for (size_t block = 0; block < blocks.size(); ++block) {
+    if (index.HasSuccessors(block)) {
+      InsertBlockStatements(block, stmts);
+    } else if (!blocks[block].empty()) {
+      stmts.insert(blocks[block].begin(), blocks[block].end() - 1);
+    }
+  }
+  return stmts;
+}
+
+size_t StatementReachability::CountBytes() const {
+  size_t num_ints = positions.size() * 2 + edges.size() * 2;
+  for (const auto& block : blocks) {
+    num_ints += block.size();
+  }
+  return num_ints * sizeof(int) + index.CountBytes();
+}
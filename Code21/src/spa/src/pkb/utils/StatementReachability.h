@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ReachabilityIndex.h"
+
+/*
+  A transitive relation between stmts answered from a ReachabilityIndex instead of a table.
+  Stmts are grouped into blocks that are entered at their first stmt and left at their last, so within
+  a block a stmt reaches the stmts after it. Every block may stand for several nodes of the indexed
+  graph, one per copy (e.g. the call context layers of NextBip*): copy c of block b is node
+  b + c * number of blocks. Paths start from copy 0 of the block of a stmt and reach the stmts of every
+  block that any copy of it is reached in.
+*/
+class StatementReachability {
+ private:
+  std::vector<std::vector<int>> blocks;
+  int num_copies = 1;
+  std::vector<std::pair<int, int>> edges;      // kept so that the index can be written to a snapshot
+  std::vector<std::pair<int, int>> positions;  // stmt# -> (block, offset in block), (-1, -1) if in none
+  ReachabilityIndex index;
+  double build_time_ms = 0;
+
+  bool HasPosition(int) const;
+  std::vector<int> GetCopies(int block) const;
+  void InsertBlockStatements(int block, std::unordered_set<int>&) const;
+
+ public:
+  StatementReachability() = default;
+  StatementReachability(std::vector<std::vector<int>> blocks, int num_copies, std::vector<std::pair<int, int>> edges);
+
+  bool IsEmpty() const { return blocks.empty(); }
+
+  bool IsReachable(int, int) const;
+
+  std::unordered_set<int> GetReachableStatements(int) const;
+
+  std::unordered_set<int> GetReachingStatements(int) const;
+
+  std::unordered_set<int> GetAllReachableStatements() const;
+
+  std::unordered_set<int> GetAllReachingStatements() const;
+
+  const std::vector<std::vector<int>>& GetBlocks() const { return blocks; }
+
+  int CountCopies() const { return num_copies; }
+
+  const std::vector<std::pair<int, int>>& GetEdges() const { return edges; }
+
+  double GetBuildTime() const { return build_time_ms; }
+
+  size_t CountBytes() const;
+};
@@ -1,22 +1,306 @@
 #include "QueryProcessor.h"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
+#include "query_processor/QueryResultCache.h"
 #include "query_processor/commons/BooleanSemanticError.h"
 #include "query_processor/commons/query/Query.h"
+#include "query_processor/commons/query/utils/QueryUtils.h"
+#include "query_processor/query_evaluator/ClauseResultCache.h"
+#include "query_processor/query_evaluator/QueryMemory.h"
 #include "query_processor/query_evaluator/QueryEvaluator.h"
-#include "query_processor/query_parser/QueryParser.h"
+#include "query_processor/query_optimizer/QueryPlanCache.h"
 #include "query_processor/query_projector/QueryProjector.h"
+#include "utils/Cancellation.h"
+#include "utils/Parallel.h"
 
 namespace query_processor {
 
+namespace {
+
+const std::string EXPLAIN_PREFIX = "EXPLAIN";
+const std::string PROFILE_PREFIX = "PROFILE";
+
+// strips a leading EXPLAIN or PROFILE keyword off a query. No query starts with either, as it starts with a declaration
+bool StripProfilePrefix(std::string& query_string, ProfileMode& mode) {
+  size_t start = query_string.find_first_not_of(" \t\n\r");
+  if (start == std::string::npos) {
+    return false;
+  }
+  for (const std::string& prefix : {EXPLAIN_PREFIX, PROFILE_PREFIX}) {
+    size_t end = start + prefix.size();
+    if (query_string.compare(start, prefix.size(), prefix) == 0 && end < query_string.size() &&
+        std::isspace(static_cast<unsigned char>(query_string[end]))) {
+      mode = prefix == EXPLAIN_PREFIX ? ProfileMode::EXPLAIN : ProfileMode::PROFILE;
+      query_string.erase(0, end);
+      return true;
+    }
+  }
+  return false;
+}
+
+// the synonyms a clause constrains
+std::vector<std::string> GetSynonyms(Clause& clause) {
+  std::vector<std::string> synonyms;
+  for (DesignEntity& synonym : QueryUtils::GetClauseSynonyms(clause)) {
+    synonyms.push_back(synonym.GetSynonym());
+  }
+  return synonyms;
+}
+
+}  // namespace
+
+std::atomic<double> QueryProcessor::query_timeout_ms(0);
+
 QueryProcessor::QueryProcessor() {}
 
+void QueryProcessor::SetQueryTimeout(double timeout_ms) {
+  query_timeout_ms = timeout_ms;
+}
+
+double QueryProcessor::GetQueryTimeout() {
+  return query_timeout_ms;
+}
+
 std::list<std::string> QueryProcessor::ProcessQuery(std::string query_string, PKB& pkb) {
-  Query query = QueryParser::ParseQuery(query_string);
-  QueryResult query_result = QueryEvaluator::EvaluateQuery(query, &pkb, true);
-  return QueryProjector::FormatResult(query_result);
+  utils::Cancellation::Scope scope(nullptr, utils::Cancellation::GetDeadlineAfter(query_timeout_ms));
+  ProfileMode mode;
+  if (StripProfilePrefix(query_string, mode)) {
+    std::list<std::string> results;
+    std::cerr << ProfileQuery(query_string, pkb, mode, results) << std::endl;
+    return results;
+  }
+
+  // queries of a shape planned before skip both parsing and planning
+  Query query = QueryPlanCache::GetPlannedQuery(query_string, pkb.GetExtension());
+  return ProcessPlannedQuery(query, pkb);
+}
+
+std::list<std::string> QueryProcessor::ProcessPlannedQuery(Query& query, PKB& pkb) {
+  // queries that only differ in synonym names from one evaluated before against the same PKB are not evaluated again
+  std::string result_key = QueryResultCache::GetKey(query, pkb);
+  if (!result_key.empty()) {
+    std::shared_ptr<const std::list<std::string>> cached_results = QueryResultCache::Get(result_key);
+    if (cached_results) {
+      return *cached_results;
+    }
+  }
+
+  QueryResult query_result = QueryEvaluator::EvaluatePlannedQuery(query, &pkb, true);
+  std::list<std::string> results = QueryProjector::FormatResult(query_result);
+  if (!result_key.empty()) {
+    QueryResultCache::Put(result_key, results);
+  }
+  return results;
+}
+
+std::string QueryProcessor::ProfileQuery(std::string query_string, PKB& pkb, ProfileMode mode,
+                                         std::list<std::string>& results) {
+  QueryProfile profile;
+  profile.mode = mode;
+  auto start_time = std::chrono::steady_clock::now();
+  Query query = QueryPlanCache::GetPlannedQuery(query_string, pkb.GetExtension());
+  std::chrono::duration<double, std::milli> plan_time = std::chrono::steady_clock::now() - start_time;
+  profile.plan_ms = plan_time.count();
+  profile.groups = QueryProfiler::GroupClauses(query.GetClauseList());
+
+  results.clear();
+  if (mode == ProfileMode::EXPLAIN) {
+    QueryEvaluator::ExplainPlannedQuery(query, &pkb, true, profile);
+    return profile.ToJson();
+  }
+
+  QueryMemory::Scope memory_scope;
+  QueryProfiler::Start(&profile);
+  try {
+    QueryResult query_result = QueryEvaluator::EvaluatePlannedQuery(query, &pkb, true);
+    QueryProfiler::Stop();
+    results = QueryProjector::FormatResult(query_result);
+  } catch (...) {
+    QueryProfiler::Stop();
+    throw;
+  }
+  profile.peak_bytes = memory_scope.GetPeakBytes();
+  profile.result_rows = results.size();
+  return profile.ToJson();
+}
+
+std::vector<std::list<std::string>> QueryProcessor::ProcessQueries(const std::vector<std::string>& query_strings, PKB& pkb,
+                                                                   int num_threads, std::vector<double>* elapsed_ms,
+                                                                   QueryBatchStatistics* batch_statistics,
+                                                                   const std::vector<double>* timeouts_ms) {
+  if (!pkb.IsFrozen()) {
+    throw std::runtime_error("QueryProcessor::ProcessQueries: PKB must be frozen before concurrent evaluation");
+  }
+
+  if (num_threads <= 0) {
+    num_threads = utils::Parallel::GetDefaultNumThreads();
+  }
+
+  std::vector<std::list<std::string>> results(query_strings.size());
+  std::vector<double> query_ms(query_strings.size(), 0);
+  std::vector<char> is_timed_out(query_strings.size(), false);
+  std::vector<char> is_memory_limited(query_strings.size(), false);
+  std::vector<size_t> peak_bytes(query_strings.size(), 0);
+  std::vector<double> query_timeouts_ms(query_strings.size(), query_timeout_ms);
+  if (timeouts_ms != nullptr) {
+    std::copy_n(timeouts_ms->begin(), std::min(timeouts_ms->size(), query_strings.size()), query_timeouts_ms.begin());
+  }
+  ClauseResultCacheStatistics clause_statistics = ClauseResultCache::GetStatistics();
+  QueryResultCacheStatistics result_statistics = QueryResultCache::GetStatistics();
+
+  // every query is parsed and planned before any is evaluated, so that the clauses they share are known
+  std::vector<Query> queries(query_strings.size());
+  std::vector<char> is_planned(query_strings.size(), false);
+  std::vector<char> is_profiled(query_strings.size(), false);
+  utils::Parallel::For(query_strings.size(), num_threads, [&](size_t i, int) {
+    auto start_time = std::chrono::steady_clock::now();
+    try {
+      std::string query_string = query_strings[i];
+      ProfileMode mode;
+      if (StripProfilePrefix(query_string, mode)) {
+        // profiled queries are evaluated on their own, after the shared clauses
+        is_profiled[i] = true;
+        return;
+      }
+      queries[i] = QueryPlanCache::GetPlannedQuery(query_string, pkb.GetExtension());
+      is_planned[i] = true;
+    } catch (BooleanSemanticError&) {
+      results[i] = std::list<std::string>{"FALSE"};
+    } catch (std::runtime_error&) {
+      results[i].clear();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+    query_ms[i] += elapsed.count();
+  });
+
+  // shared clauses are evaluated once, leaving their results in the ClauseResultCache for every query using them.
+  // A shared clause may take as long as the longest timeout, beyond which no query could use its result
+  std::vector<Clause> shared_clauses = FindSharedClauses(queries, is_planned, pkb);
+  std::vector<double> shared_clause_ms(shared_clauses.size(), 0);
+  double shared_clause_timeout_ms = 0;
+  for (double timeout_ms : query_timeouts_ms) {
+    if (timeout_ms <= 0) {
+      shared_clause_timeout_ms = 0;
+      break;
+    }
+    shared_clause_timeout_ms = std::max(shared_clause_timeout_ms, timeout_ms);
+  }
+  utils::Parallel::For(shared_clauses.size(), num_threads, [&](size_t i, int) {
+    auto start_time = std::chrono::steady_clock::now();
+    try {
+      utils::Cancellation::Scope scope(nullptr, utils::Cancellation::GetDeadlineAfter(shared_clause_timeout_ms));
+      QueryEvaluator::EvaluateSharedClause(shared_clauses[i], &pkb);
+    } catch (std::runtime_error&) {
+      // reported by the queries the clause is in
+    } catch (utils::TimeoutError&) {
+      // left for the queries the clause is in to evaluate within their own timeouts
+    } catch (MemoryLimitError&) {
+      // left for the queries the clause is in, which stop at the limit themselves
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+    shared_clause_ms[i] = elapsed.count();
+  });
+
+  utils::Parallel::For(query_strings.size(), num_threads, [&](size_t i, int) {
+    if (!is_planned[i] && !is_profiled[i]) {
+      return;
+    }
+    auto start_time = std::chrono::steady_clock::now();
+    QueryMemory::Scope memory_scope;
+    try {
+      utils::Cancellation::Scope scope(nullptr, utils::Cancellation::GetDeadlineAfter(query_timeouts_ms[i]));
+      if (is_profiled[i]) {
+        std::string query_string = query_strings[i];
+        ProfileMode mode;
+        StripProfilePrefix(query_string, mode);
+        std::cerr << ProfileQuery(query_string, pkb, mode, results[i]) << std::endl;
+      } else {
+        results[i] = ProcessPlannedQuery(queries[i], pkb);
+      }
+    } catch (BooleanSemanticError&) {
+      results[i] = std::list<std::string>{"FALSE"};
+    } catch (std::runtime_error&) {
+      results[i].clear();
+    } catch (utils::TimeoutError&) {
+      results[i].clear();
+      is_timed_out[i] = true;
+    } catch (MemoryLimitError&) {
+      results[i].clear();
+      is_memory_limited[i] = true;
+    }
+    peak_bytes[i] = memory_scope.GetPeakBytes();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+    query_ms[i] += elapsed.count();
+  });
+
+  if (elapsed_ms != nullptr) {
+    *elapsed_ms = query_ms;
+  }
+  if (batch_statistics != nullptr) {
+    // every shared clause is evaluated once, as it would have been by the first query using it
+    ClauseResultCacheStatistics new_clause_statistics = ClauseResultCache::GetStatistics();
+    size_t clause_hits = new_clause_statistics.hits - clause_statistics.hits;
+    double saved_ms = new_clause_statistics.saved_ms - clause_statistics.saved_ms;
+    for (double clause_ms : shared_clause_ms) {
+      saved_ms -= clause_ms;
+    }
+    batch_statistics->shared_clauses = shared_clauses.size();
+    batch_statistics->clause_evaluations_saved = clause_hits > shared_clauses.size() ? clause_hits - shared_clauses.size() : 0;
+    batch_statistics->query_evaluations_saved = QueryResultCache::GetStatistics().hits - result_statistics.hits;
+    batch_statistics->saved_ms = saved_ms > 0 ? saved_ms : 0;
+    batch_statistics->timed_out_queries = std::count(is_timed_out.begin(), is_timed_out.end(), true);
+    batch_statistics->memory_limited_queries = std::count(is_memory_limited.begin(), is_memory_limited.end(), true);
+    batch_statistics->peak_query_bytes = peak_bytes.empty() ? 0 : *std::max_element(peak_bytes.begin(), peak_bytes.end());
+  }
+  return results;
+}
+
+/*
+ * Finds the such that and pattern clauses that more than one clause of the queries can take the cached result
+ * of, i.e. clauses of the same key that no earlier clause of their query shares a synonym with.
+ */
+std::vector<Clause> QueryProcessor::FindSharedClauses(std::vector<Query>& queries, const std::vector<char>& is_planned,
+                                                      const PKB& pkb) {
+  std::unordered_map<std::string, size_t> clause_counts;
+  std::vector<std::pair<std::string, Clause>> clauses;
+  for (size_t i = 0; i < queries.size(); i++) {
+    if (!is_planned[i]) {
+      continue;
+    }
+    std::unordered_set<std::string> earlier_synonyms;
+    for (Clause& clause : queries[i].GetClauseList()) {
+      std::vector<std::string> synonyms = GetSynonyms(clause);
+      bool is_restricted = false;
+      for (const std::string& synonym : synonyms) {
+        is_restricted = is_restricted || earlier_synonyms.count(synonym) != 0;
+      }
+      earlier_synonyms.insert(synonyms.begin(), synonyms.end());
+      std::string clause_key = is_restricted ? "" : ClauseResultCache::CreateKey(clause, pkb);
+      if (clause_key.empty()) {
+        continue;
+      }
+      if (clause_counts[clause_key]++ == 0) {
+        clauses.push_back({clause_key, clause});
+      }
+    }
+  }
+
+  std::vector<Clause> shared_clauses;
+  for (auto& clause : clauses) {
+    if (clause_counts[clause.first] > 1) {
+      shared_clauses.push_back(clause.second);
+    }
+  }
+  return shared_clauses;
 }
 
 }  // namespace query_processor
\ No newline at end of file
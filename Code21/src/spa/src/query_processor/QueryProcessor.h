@@ -1,16 +1,60 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "pkb/PKB.h"
+#include "query_processor/commons/query/Query.h"
+#include "query_processor/query_evaluator/QueryProfiler.h"
 
 namespace query_processor {
 
+// the work saved by evaluating a batch of queries together rather than one by one
+struct QueryBatchStatistics {
+  size_t shared_clauses = 0;            // clauses of more than one query, evaluated once before the queries
+  size_t clause_evaluations_saved = 0;  // clauses answered from the results of another query
+  size_t query_evaluations_saved = 0;   // queries answered from the results of an equivalent query
+  double saved_ms = 0;                  // the evaluation time of the clauses answered from other queries
+  size_t timed_out_queries = 0;         // queries stopped at their timeout, which yield no results
+  size_t memory_limited_queries = 0;    // queries stopped at the memory limit of QueryMemory, which yield no results
+  size_t peak_query_bytes = 0;          // the most bytes of intermediate results any query held at once
+};
+
 class QueryProcessor {
  public:
   QueryProcessor();
+
+  // the time a query may take to evaluate before it is stopped with a utils::TimeoutError, or none if not positive
+  static void SetQueryTimeout(double timeout_ms);
+  static double GetQueryTimeout();
+
+  // a query prefixed by EXPLAIN or PROFILE also writes its QueryProfile as JSON to std::cerr
   static std::list<std::string> ProcessQuery(std::string, PKB&);
+
+  // plans, and for PROFILE evaluates, a query without the QueryResultCache, returning its QueryProfile as JSON.
+  // results receives the results of a profiled query, and none for EXPLAIN
+  static std::string ProfileQuery(std::string, PKB&, ProfileMode, std::list<std::string>& results);
+
+  // evaluates every query against a frozen PKB on a pool of worker threads, returning the
+  // results in query order. Invalid queries yield the same results as SPA::HandleQueries would.
+  // All queries are parsed and planned first, and every clause shared by several of them is
+  // evaluated once before any query, so that each query reuses its result.
+  // If elapsed_ms is given, it receives the wall time each query took in milliseconds, and if
+  // batch_statistics is given, it receives the work the batch saved. If timeouts_ms is given, it
+  // holds the timeout of each query in place of the query timeout; a query that times out yields no results
+  static std::vector<std::list<std::string>> ProcessQueries(const std::vector<std::string>&, PKB&, int num_threads = 0,
+                                                            std::vector<double>* elapsed_ms = nullptr,
+                                                            QueryBatchStatistics* batch_statistics = nullptr,
+                                                            const std::vector<double>* timeouts_ms = nullptr);
+
+ private:
+  static std::list<std::string> ProcessPlannedQuery(Query&, PKB&);
+  static std::atomic<double> query_timeout_ms;
+
+  static std::vector<Clause> FindSharedClauses(std::vector<Query>&, const std::vector<char>&, const PKB&);
 };
 
-}  // namespace query_processor
\ No newline at end of file
+}  // namespace query_processor
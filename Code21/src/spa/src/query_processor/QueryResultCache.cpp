@@ -0,0 +1,144 @@
+#include "QueryResultCache.h"
+
+#include <utility>
+
+#include "query_processor/commons/query/clause/Clause.h"
+
+namespace query_processor {
+
+std::mutex QueryResultCache::cache_mutex;
+utils::LruCache<std::list<std::string>> QueryResultCache::results(kDefaultMaxEntries, kDefaultMaxBytes);
+QueryResultCacheStatistics QueryResultCache::statistics;
+
+std::string QueryResultCache::GetKey(Query& query, const PKB& pkb) {
+  bool is_enabled;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    is_enabled = results.IsEnabled();
+  }
+  std::string key;
+  if (!is_enabled || !CacheKey::AppendGeneration(pkb, key)) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    statistics.uncacheable++;
+    return "";
+  }
+
+  std::vector<std::string> synonyms;  // the synonyms renamed in the key, by index
+
+  for (SelectedEntity& selected_entity : query.GetSelectedEntities()) {
+    CacheKey::AppendEnum(selected_entity.entity_type, key);
+    if (selected_entity.entity_type == SelectedEntityType::DESIGN_ENTITY) {
+      AppendDesignEntity(selected_entity.design_entity, synonyms, key);
+    } else if (selected_entity.entity_type == SelectedEntityType::ATTRIBUTE) {
+      AppendDesignEntity(selected_entity.attribute.first, synonyms, key);
+      CacheKey::AppendEnum(selected_entity.attribute.second, key);
+    }
+  }
+
+  for (Clause& clause : query.GetClauseList()) {
+    CacheKey::AppendEnum(clause.GetClauseType(), key);
+    if (clause.GetClauseType() == ClauseType::SUCHTHAT) {
+      SuchThatClause& such_that_clause = clause.GetSuchThatClause();
+      CacheKey::AppendEnum(such_that_clause.GetDesignAbstraction(), key);
+      AppendClauseParam(such_that_clause.GetLHSParam(), synonyms, key);
+      AppendClauseParam(such_that_clause.GetRHSParam(), synonyms, key);
+    } else if (clause.GetClauseType() == ClauseType::PATTERN) {
+      PatternClause& pattern_clause = clause.GetPatternClause();
+      AppendDesignEntity(pattern_clause.GetDesignEntity(), synonyms, key);
+      AppendClauseParam(pattern_clause.GetLHSParam(), synonyms, key);
+      AppendClauseParam(pattern_clause.GetRHSParam(), synonyms, key);
+    } else if (clause.GetClauseType() == ClauseType::WITH) {
+      WithClause& with_clause = clause.GetWithClause();
+      AppendClauseParam(with_clause.GetLHSParam(), synonyms, key);
+      CacheKey::AppendEnum(with_clause.GetLHSAttributeType(), key);
+      AppendClauseParam(with_clause.GetRHSParam(), synonyms, key);
+      CacheKey::AppendEnum(with_clause.GetRHSAttributeType(), key);
+    }
+  }
+  return key;
+}
+
+std::shared_ptr<const std::list<std::string>> QueryResultCache::Get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::shared_ptr<const std::list<std::string>> cached_results = results.Get(key);
+  if (cached_results) {
+    statistics.hits++;
+  } else {
+    statistics.misses++;
+  }
+  return cached_results;
+}
+
+void QueryResultCache::Put(const std::string& key, const std::list<std::string>& query_results) {
+  size_t bytes = CountBytes(key, query_results);
+  std::shared_ptr<const std::list<std::string>> cached_results = std::make_shared<const std::list<std::string>>(query_results);
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  results.Put(key, cached_results, bytes);
+  statistics.evictions = results.GetEvictions();
+  statistics.size = results.GetSize();
+  statistics.bytes = results.GetBytes();
+}
+
+QueryResultCacheStatistics QueryResultCache::GetStatistics() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  return statistics;
+}
+
+void QueryResultCache::SetLimits(size_t max_entries, size_t max_bytes) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  results.SetLimits(max_entries, max_bytes);
+  statistics.evictions = results.GetEvictions();
+  statistics.size = results.GetSize();
+  statistics.bytes = results.GetBytes();
+}
+
+void QueryResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  results.Clear();
+  statistics = QueryResultCacheStatistics();
+}
+
+void QueryResultCache::AppendDesignEntity(DesignEntity design_entity, std::vector<std::string>& synonyms, std::string& key) {
+  CacheKey::AppendEnum(design_entity.GetDesignEntityType(), key);
+  std::string synonym = design_entity.GetSynonym();
+  size_t synonym_index = 0;
+  while (synonym_index < synonyms.size() && synonyms[synonym_index] != synonym) {
+    synonym_index++;
+  }
+  if (synonym_index == synonyms.size()) {
+    synonyms.push_back(synonym);
+  }
+  CacheKey::AppendNumber(synonym_index, key);
+}
+
+void QueryResultCache::AppendClauseParam(const ClauseParam& clause_param, std::vector<std::string>& synonyms, std::string& key) {
+  CacheKey::AppendEnum(clause_param.param_type, key);
+  switch (clause_param.param_type) {
+    case ClauseParamType::DESIGN_ENTITY:
+      AppendDesignEntity(clause_param.design_entity, synonyms, key);
+      break;
+    case ClauseParamType::NAME:
+      CacheKey::AppendName(clause_param.var_proc_name, key);
+      break;
+    case ClauseParamType::INDEX:
+      CacheKey::AppendNumber(clause_param.statement_index, key);
+      break;
+    case ClauseParamType::EXPR:
+      CacheKey::AppendExpression(clause_param.pattern_expr, key);
+      break;
+    case ClauseParamType::WILDCARD:
+      break;
+  }
+}
+
+// an estimate of the memory taken by the cached results, including the list nodes and the key
+size_t QueryResultCache::CountBytes(const std::string& key, const std::list<std::string>& query_results) {
+  size_t bytes = 2 * key.size() + sizeof(std::list<std::string>);
+  for (const std::string& result : query_results) {
+    bytes += sizeof(std::string) + 2 * sizeof(void*) + result.capacity();
+  }
+  return bytes;
+}
+
+}  // namespace query_processor
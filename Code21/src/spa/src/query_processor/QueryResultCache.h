@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "pkb/PKB.h"
+#include "query_processor/commons/CacheKey.h"
+#include "query_processor/commons/query/Query.h"
+#include "query_processor/commons/query/clause/ClauseParam.h"
+#include "query_processor/commons/query/entities/DesignEntity.h"
+#include "utils/LruCache.h"
+
+namespace query_processor {
+
+typedef CacheStatistics QueryResultCacheStatistics;
+
+/*
+  Caches the formatted results of the queries evaluated against a frozen PKB, so that a query that only
+  differs from an earlier one in whitespace, in the names or declaration order of its synonyms, or in
+  repeats of its clauses is answered without evaluating it again.
+
+  The key is the canonical form of the planned Query: its synonyms are renamed in the order they first
+  occur in the selected entities and then in the clauses, which the QueryOptimizer has already sorted and
+  rid of repeats. Declarations only enter the key through the types of the synonyms that are used, so their
+  order does not matter. Every key is tagged with the generation id of the PKB, which changes whenever the PKB
+  is frozen again, so results are never reused across PKBs.
+
+  The cache is shared by all threads and bounded in both entries and bytes, evicting the least recently used
+  results once either bound is exceeded.
+*/
+class QueryResultCache {
+ public:
+  static const size_t kDefaultMaxEntries = 4096;
+  static const size_t kDefaultMaxBytes = 64 << 20;
+
+  // the key of a planned query against the PKB, or the empty string if its results can not be cached
+  static std::string GetKey(Query&, const PKB&);
+
+  // the results cached under a key from GetKey, or nullptr if there are none
+  static std::shared_ptr<const std::list<std::string>> Get(const std::string&);
+
+  static void Put(const std::string&, const std::list<std::string>&);
+
+  static QueryResultCacheStatistics GetStatistics();
+
+  // a limit of 0 entries or bytes disables the cache
+  static void SetLimits(size_t max_entries, size_t max_bytes);
+
+  // removes every result and resets the statistics
+  static void Clear();
+
+ private:
+  static std::mutex cache_mutex;
+  static utils::LruCache<std::list<std::string>> results;
+  static QueryResultCacheStatistics statistics;
+
+  static void AppendDesignEntity(DesignEntity, std::vector<std::string>&, std::string&);
+  static void AppendClauseParam(const ClauseParam&, std::vector<std::string>&, std::string&);
+  static size_t CountBytes(const std::string&, const std::list<std::string>&);
+};
+
+}  // namespace query_processor
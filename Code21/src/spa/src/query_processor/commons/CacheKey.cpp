@@ -0,0 +1,38 @@
+#include "CacheKey.h"
+
+namespace query_processor {
+
+double CacheStatistics::GetHitRate() const {
+  size_t total = hits + misses + uncacheable;
+  return total == 0 ? 0 : static_cast<double>(hits) / total;
+}
+
+bool CacheKey::AppendGeneration(const PKB& pkb, std::string& key) {
+  if (pkb.GetGenerationId() == 0) {
+    return false;
+  }
+  AppendNumber(pkb.GetGenerationId(), key);
+  return true;
+}
+
+void CacheKey::AppendNumber(size_t number, std::string& key) {
+  key += std::to_string(number);
+  key += kSeparator;
+}
+
+void CacheKey::AppendName(const std::string& name, std::string& key) {
+  AppendNumber(name.size(), key);
+  key += name;
+  key += kSeparator;
+}
+
+void CacheKey::AppendExpression(const PatternExpression& pattern_expr, std::string& key) {
+  AppendNumber(pattern_expr.is_wild_card, key);
+  AppendNumber(pattern_expr.token_list.GetSize(), key);
+  for (const source_processor::Token& token : pattern_expr.token_list.GetUnderlyingList()) {
+    AppendEnum(token.GetType(), key);
+    AppendName(token.GetValue(), key);
+  }
+}
+
+}  // namespace query_processor
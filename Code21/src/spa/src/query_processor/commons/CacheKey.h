@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "pkb/PKB.h"
+#include "query_processor/commons/query/clause/ClauseParam.h"
+
+namespace query_processor {
+
+struct CacheStatistics {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t uncacheable = 0;  // lookups made without the cache, e.g. against a PKB that is not frozen
+  size_t evictions = 0;
+  size_t size = 0;
+  size_t bytes = 0;
+
+  double GetHitRate() const;
+};
+
+/*
+  Builds the keys of the caches of query and clause results. Every field of a key is followed by a separator,
+  and names are prefixed by their length, so that no two different fields share a key.
+*/
+class CacheKey {
+ public:
+  // starts a key with the generation id of the PKB, so that results are never reused across PKBs. Returns false
+  // if the PKB is not frozen, as it may still change under the results
+  static bool AppendGeneration(const PKB&, std::string&);
+
+  static void AppendNumber(size_t, std::string&);
+
+  template <typename Enum>
+  static void AppendEnum(Enum value, std::string& key) {
+    AppendNumber(static_cast<size_t>(value), key);
+  }
+
+  static void AppendName(const std::string&, std::string&);
+
+  static void AppendExpression(const PatternExpression&, std::string&);
+
+ private:
+  static const char kSeparator = ' ';
+};
+
+}  // namespace query_processor
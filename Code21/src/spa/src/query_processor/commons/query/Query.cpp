@@ -1,16 +1,17 @@
 #include "Query.h"
 
 #include <stdexcept>
+#include <utility>
 
 namespace query_processor {
 
 Query::Query() {}
 Query::Query(SelectedEntity entity) {
-  this->selected_entities.push_back(entity);
+  this->selected_entities.push_back(std::move(entity));
 }
 
 Query::Query(std::vector<SelectedEntity> entities) {
-  this->selected_entities = entities;
+  this->selected_entities = std::move(entities);
 }
 
 SelectedEntity& Query::GetSelectedEntity() {
@@ -25,7 +26,7 @@ std::vector<SelectedEntity>& Query::GetSelectedEntities() {
 }
 
 bool Query::SetClauseList(std::vector<Clause> clause_list) {
-  this->clause_list = clause_list;
+  this->clause_list = std::move(clause_list);
   return true;
 }
 
@@ -34,7 +35,7 @@ std::vector<Clause>& Query::GetClauseList() {
 }
 
 bool Query::AddClause(Clause new_clause) {
-  this->clause_list.push_back(new_clause);
+  this->clause_list.push_back(std::move(new_clause));
   return true;
 }
 }  // namespace query_processor
\ No newline at end of file
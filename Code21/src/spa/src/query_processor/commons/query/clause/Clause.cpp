@@ -1,23 +1,24 @@
 #include "Clause.h"
 
 #include <stdexcept>
+#include <utility>
 
 #include "../utils/QueryUtils.h"
 
 namespace query_processor {
 
 Clause::Clause(SuchThatClause such_that_clause) {
-  this->such_that_clause = such_that_clause;
+  this->such_that_clause = std::move(such_that_clause);
   this->type = ClauseType::SUCHTHAT;
 }
 
 Clause::Clause(PatternClause pattern_clause) {
-  this->pattern_clause = pattern_clause;
+  this->pattern_clause = std::move(pattern_clause);
   this->type = ClauseType::PATTERN;
 }
 
 Clause::Clause(WithClause with_clause) {
-  this->with_clause = with_clause;
+  this->with_clause = std::move(with_clause);
   this->type = ClauseType::WITH;
 }
 
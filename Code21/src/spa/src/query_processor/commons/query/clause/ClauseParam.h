@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <utility>
+
 #include <source_processor/token/TokenList.h>
 
 #include "query_processor/commons/query/entities/DesignEntity.h"
@@ -20,12 +23,12 @@ struct PatternExpression {
   PatternExpression() {}
 
   PatternExpression(source_processor::TokenList token_list) {
-    this->token_list = token_list;
+    this->token_list = std::move(token_list);
     this->is_wild_card = false;
   }
 
   PatternExpression(source_processor::TokenList token_list, bool is_wild_card) {
-    this->token_list = token_list;
+    this->token_list = std::move(token_list);
     this->is_wild_card = is_wild_card;
   }
 
@@ -44,8 +47,8 @@ struct ClauseParam {
   ClauseParam() {}
 
   ClauseParam(DesignEntity design_entity) {
-    this->design_entity = design_entity;
-    if (design_entity.GetDesignEntityType() == DesignEntityType::WILDCARD) {
+    this->design_entity = std::move(design_entity);
+    if (this->design_entity.GetDesignEntityType() == DesignEntityType::WILDCARD) {
       this->param_type = ClauseParamType::WILDCARD;
     } else {
       this->param_type = ClauseParamType::DESIGN_ENTITY;
@@ -53,7 +56,7 @@ struct ClauseParam {
   }
 
   ClauseParam(std::string var_proc_name) {
-    this->var_proc_name = var_proc_name;
+    this->var_proc_name = std::move(var_proc_name);
     this->param_type = ClauseParamType::NAME;
   }
 
@@ -63,7 +66,7 @@ struct ClauseParam {
   }
 
   ClauseParam(PatternExpression pattern_expr) {
-    this->pattern_expr = pattern_expr;
+    this->pattern_expr = std::move(pattern_expr);
     this->param_type = ClauseParamType::EXPR;
   }
 
@@ -1,6 +1,7 @@
 #include "PatternClause.h"
 
 #include <stdexcept>
+#include <utility>
 
 #include "query_processor/commons/query/entities/DesignEntityType.h"
 #include "query_processor/commons/query/utils/QueryUtils.h"
@@ -8,9 +9,9 @@
 namespace query_processor {
 
 PatternClause::PatternClause(DesignEntity design_entity, ClauseParam lhs_param, ClauseParam rhs_param) {
-  this->design_entity = design_entity;
-  this->lhs_param = lhs_param;
-  this->rhs_param = rhs_param;
+  this->design_entity = std::move(design_entity);
+  this->lhs_param = std::move(lhs_param);
+  this->rhs_param = std::move(rhs_param);
 }
 
 const DesignEntity& PatternClause::GetDesignEntity() {
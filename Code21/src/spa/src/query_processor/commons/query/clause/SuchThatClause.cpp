@@ -2,6 +2,7 @@
 #include "SuchThatClause.h"
 
 #include <stdexcept>
+#include <utility>
 
 #include "query_processor/commons/query/entities/DesignEntityType.h"
 #include "query_processor/commons/query/utils/QueryUtils.h"
@@ -10,8 +11,8 @@ namespace query_processor {
 
 SuchThatClause::SuchThatClause(DesignAbstraction design_abstraction, ClauseParam lhs_param, ClauseParam rhs_param) {
   this->design_abstraction = design_abstraction;
-  this->lhs_param = lhs_param;
-  this->rhs_param = rhs_param;
+  this->lhs_param = std::move(lhs_param);
+  this->rhs_param = std::move(rhs_param);
 }
 
 const DesignAbstraction SuchThatClause::GetDesignAbstraction() const {
@@ -2,14 +2,15 @@
 #include "WithClause.h"
 
 #include <stdexcept>
+#include <utility>
 
 #include "query_processor/commons/query/utils/QueryUtils.h"
 
 namespace query_processor {
 
 WithClause::WithClause(std::pair<ClauseParam, AttributeType> lhs, std::pair<ClauseParam, AttributeType> rhs) {
-  this->lhs_pair = lhs;
-  this->rhs_pair = rhs;
+  this->lhs_pair = std::move(lhs);
+  this->rhs_pair = std::move(rhs);
 }
 
 const ClauseParam& WithClause::GetLHSParam() const {
@@ -4,6 +4,7 @@
 #include "DesignEntity.h"
 
 #include <stdexcept>
+#include <utility>
 
 #include "query_processor/commons/query/utils/QueryUtils.h"
 
@@ -15,14 +16,14 @@ DesignEntity::DesignEntity(DesignEntityType design_entity, std::string synonym_s
   if (synonym_string.empty()) {
     throw std::runtime_error("Design entity synonym cannot be empty");
   }
-  this->synonym = synonym_string;
+  this->synonym = std::move(synonym_string);
 }
 
-DesignEntityType &DesignEntity::GetDesignEntityType() {
+DesignEntityType DesignEntity::GetDesignEntityType() const {
   return this->design_entity_type;
 }
 
-std::string DesignEntity::GetSynonym() {
+const std::string &DesignEntity::GetSynonym() const {
   return this->synonym;
 }
 
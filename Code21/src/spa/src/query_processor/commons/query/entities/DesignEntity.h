@@ -12,9 +12,9 @@ class DesignEntity {
 
   DesignEntity(DesignEntityType, std::string);
 
-  DesignEntityType &GetDesignEntityType();
+  DesignEntityType GetDesignEntityType() const;
 
-  std::string GetSynonym();
+  const std::string &GetSynonym() const;
 
   friend bool operator==(const DesignEntity &de1, const DesignEntity &de2);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <utility>
 
 #include "DesignEntity.h"
 #include "query_processor/commons/query/utils/QueryUtils.h"
@@ -17,7 +18,7 @@ struct SelectedEntity {
   SelectedEntity() = default;
 
   SelectedEntity(DesignEntity de) {
-    this->design_entity = de;
+    this->design_entity = std::move(de);
     this->entity_type = SelectedEntityType::DESIGN_ENTITY;
   }
 
@@ -33,7 +34,7 @@ struct SelectedEntity {
     if (!QueryUtils::IsValidAttributeType(attribute.first, attribute.second)) {
       throw std::runtime_error("Invalid attribute type for the given design entity");
     }
-    this->attribute = attribute;
+    this->attribute = std::move(attribute);
     this->entity_type = SelectedEntityType::ATTRIBUTE;
   }
 };
@@ -1,34 +1,57 @@
 #include "QueryUtils.h"
-#include "utils/Extension.h"
+#include <map>
 #include <string>
 
 namespace query_processor {
 
+namespace {
+
+// the mappings are shared by every thread evaluating queries, so lookups must never insert
+template <typename K, typename V>
+V FindOrDefault(const std::map<K, V>& mappings, const K& key) {
+  auto it = mappings.find(key);
+  return it == mappings.end() ? V() : it->second;
+}
+
+// reverse lookups are only used to describe queries, so a linear scan suffices
+template <typename V>
+std::string FindKeyOrDefault(const std::map<std::string, V>& mappings, const V& value) {
+  for (const auto& mapping : mappings) {
+    if (mapping.second == value) {
+      return mapping.first;
+    }
+  }
+  return "";
+}
+
+}  // namespace
+
 DesignEntityType QueryUtils::ConvertStringToDesignEntityType(std::string input_string) {
-  return string_to_design_entity_type_mappings[input_string];
+  return FindOrDefault(string_to_design_entity_type_mappings, input_string);
 }
 
 std::string QueryUtils::ConvertDesignEntityTypeToString(DesignEntityType input_type) {
-  return design_entity_type_to_string_mappings[input_type];
+  return FindOrDefault(design_entity_type_to_string_mappings, input_type);
 }
 
 DesignAbstraction QueryUtils::ConvertStringToDesignAbstraction(std::string input_string) {
-  DesignAbstraction da = design_abstraction_mappings[input_string];
-  if (!utils::Extension::HasNextBip && (da == DesignAbstraction::NEXTBIP || da == DesignAbstraction::NEXTBIP_T)) {
-    throw std::runtime_error("NextBip/* has not been turned on as an extension");
-  }
-  if (!utils::Extension::HasAffectsBip && (da == DesignAbstraction::AFFECTSBIP || da == DesignAbstraction::AFFECTSBIP_T)) {
-    throw std::runtime_error("AffectsBip/* has not been turned on as an extension");
-  }
-  return da;
+  return FindOrDefault(design_abstraction_mappings, input_string);
+}
+
+std::string QueryUtils::ConvertDesignAbstractionToString(DesignAbstraction input_type) {
+  return FindKeyOrDefault(design_abstraction_mappings, input_type);
 }
 
 std::string QueryUtils::ConvertClauseTypeToString(ClauseType input_type) {
-  return clause_type_to_string_mappings[input_type];
+  return FindOrDefault(clause_type_to_string_mappings, input_type);
 }
 
 AttributeType QueryUtils::ConvertStringToAttributeType(std::string attribute) {
-  return synonym_attribute_type_mappings[attribute];
+  return FindOrDefault(synonym_attribute_type_mappings, attribute);
+}
+
+std::string QueryUtils::ConvertAttributeTypeToString(AttributeType attribute) {
+  return FindKeyOrDefault(synonym_attribute_type_mappings, attribute);
 }
 
 bool QueryUtils::IsStatementEntity(ClauseParam &param, bool is_wildcard_allowed = false) {
@@ -147,7 +170,7 @@ bool QueryUtils::IsValidAttributeType(DesignEntity &de, AttributeType attr_type)
 }
 
 int QueryUtils::RankDesignAbstraction(DesignAbstraction da) {
-  return design_abstraction_rank[da];
+  return FindOrDefault(design_abstraction_rank, da);
 }
 
 std::map<DesignAbstraction, int> QueryUtils::design_abstraction_rank = {
@@ -168,6 +191,26 @@ std::map<DesignAbstraction, int> QueryUtils::design_abstraction_rank = {
     {DesignAbstraction::NEXT_T, 15},
     {DesignAbstraction::NEXTBIP_T, 16}};
 
+// the distinct synonyms a clause constrains, in the order of its params
+std::vector<DesignEntity> QueryUtils::GetClauseSynonyms(Clause& clause) {
+  std::vector<ClauseParam> params;
+  if (clause.GetClauseType() == ClauseType::SUCHTHAT) {
+    params = {clause.GetSuchThatClause().GetLHSParam(), clause.GetSuchThatClause().GetRHSParam()};
+  } else if (clause.GetClauseType() == ClauseType::PATTERN) {
+    params = {ClauseParam(clause.GetPatternClause().GetDesignEntity()), clause.GetPatternClause().GetLHSParam()};
+  } else if (clause.GetClauseType() == ClauseType::WITH) {
+    params = {clause.GetWithClause().GetLHSParam(), clause.GetWithClause().GetRHSParam()};
+  }
+  std::vector<DesignEntity> synonyms;
+  for (ClauseParam& param : params) {
+    if (param.param_type == ClauseParamType::DESIGN_ENTITY &&
+        (synonyms.empty() || synonyms.front().GetSynonym() != param.design_entity.GetSynonym())) {
+      synonyms.push_back(param.design_entity);
+    }
+  }
+  return synonyms;
+}
+
 std::map<std::string, DesignEntityType> QueryUtils::string_to_design_entity_type_mappings = {
     {"stmt", DesignEntityType::STMT},
     {"read", DesignEntityType::READ},
@@ -3,8 +3,10 @@
 #include <map>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include "query_processor/commons/query/clause/AttributeType.h"
+#include "query_processor/commons/query/clause/Clause.h"
 #include "query_processor/commons/query/clause/ClauseParam.h"
 #include "query_processor/commons/query/clause/ClauseType.h"
 #include "query_processor/commons/query/clause/DesignAbstraction.h"
@@ -17,7 +19,9 @@ class QueryUtils {
   static DesignEntityType ConvertStringToDesignEntityType(std::string);
   static std::string ConvertDesignEntityTypeToString(DesignEntityType);
   static DesignAbstraction ConvertStringToDesignAbstraction(std::string);
+  static std::string ConvertDesignAbstractionToString(DesignAbstraction);
   static AttributeType ConvertStringToAttributeType(std::string);
+  static std::string ConvertAttributeTypeToString(AttributeType);
   static std::string ConvertClauseTypeToString(ClauseType);
   static bool IsStatementEntity(ClauseParam&, bool);
   static bool IsAssignEntity(ClauseParam&, bool);
@@ -26,6 +30,7 @@ class QueryUtils {
   static bool IsVariableEntity(ClauseParam&, bool);
   static bool IsValidAttributeType(DesignEntity&, AttributeType);
   static int RankDesignAbstraction(DesignAbstraction);
+  static std::vector<DesignEntity> GetClauseSynonyms(Clause&);
 
  private:
   static std::map<std::string, DesignEntityType> string_to_design_entity_type_mappings;
@@ -1,14 +1,16 @@
 
 #include "QueryResult.h"
 
+#include <utility>
+
 namespace query_processor {
 QueryResult::QueryResult(std::unordered_set<int> s_idx) {
-  this->statement_indexes_or_constants = s_idx;
+  this->statement_indexes_or_constants = std::move(s_idx);
   this->result_type = QueryResultType::STMTS;
 }
 
 QueryResult::QueryResult(std::unordered_set<std::string> v_p_b) {
-  this->var_proc_names = v_p_b;
+  this->var_proc_names = std::move(v_p_b);
   this->result_type = QueryResultType::NAMES;
 }
 
@@ -18,7 +20,7 @@ QueryResult::QueryResult(bool boolean) {
 }
 
 QueryResult::QueryResult(std::vector<std::vector<std::string>> tuple_result) {
-  this->tuple_result = tuple_result;
+  this->tuple_result = std::move(tuple_result);
   this->result_type = QueryResultType::TUPLE;
 }
 
@@ -0,0 +1,188 @@
+#include "ClauseResultCache.h"
+
+#include <string>
+
+#include "query_processor/commons/query/clause/ClauseType.h"
+#include "query_processor/commons/query/entities/DesignEntity.h"
+
+namespace query_processor {
+
+namespace {
+
+size_t CountColumnBytes(const Column& column) {
+  size_t bytes = column.capacity() * sizeof(TableElement);
+  for (const TableElement& element : column) {
+    bytes += element.name.capacity();
+  }
+  return bytes;
+}
+
+}  // namespace
+
+std::mutex ClauseResultCache::cache_mutex;
+std::unordered_map<std::string, ClauseResultCache::Entry> ClauseResultCache::entries;
+ClauseResultCache::SavingIndex ClauseResultCache::entries_by_saving;
+size_t ClauseResultCache::max_entries = kDefaultMaxEntries;
+size_t ClauseResultCache::max_bytes = kDefaultMaxBytes;
+ClauseResultCacheStatistics ClauseResultCache::statistics;
+
+std::string ClauseResultCache::GetKey(SuchThatClause& clause, const PKB& pkb, std::vector<ResultTable>& database) {
+  if (IsRestricted(clause.GetLHSParam(), clause.GetRHSParam(), database)) {
+    return CountKey("");
+  }
+  Clause such_that_clause(clause);
+  return CountKey(CreateKey(such_that_clause, pkb));
+}
+
+std::string ClauseResultCache::GetKey(PatternClause& clause, const PKB& pkb, std::vector<ResultTable>& database) {
+  if (IsRestricted(ClauseParam(clause.GetDesignEntity()), clause.GetLHSParam(), database)) {
+    return CountKey("");
+  }
+  Clause pattern_clause(clause);
+  return CountKey(CreateKey(pattern_clause, pkb));
+}
+
+std::string ClauseResultCache::CreateKey(Clause& clause, const PKB& pkb) {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (max_entries == 0 || max_bytes == 0) {
+      return "";
+    }
+  }
+
+  std::string key;
+  if (!CacheKey::AppendGeneration(pkb, key)) {
+    return "";
+  }
+  CacheKey::AppendEnum(clause.GetClauseType(), key);
+  ClauseParam lhs_param;
+  ClauseParam rhs_param;
+  if (clause.GetClauseType() == ClauseType::SUCHTHAT) {
+    SuchThatClause& such_that_clause = clause.GetSuchThatClause();
+    CacheKey::AppendEnum(such_that_clause.GetDesignAbstraction(), key);
+    lhs_param = such_that_clause.GetLHSParam();
+    rhs_param = such_that_clause.GetRHSParam();
+  } else if (clause.GetClauseType() == ClauseType::PATTERN) {
+    PatternClause& pattern_clause = clause.GetPatternClause();
+    DesignEntity design_entity = pattern_clause.GetDesignEntity();
+    CacheKey::AppendEnum(design_entity.GetDesignEntityType(), key);
+    lhs_param = pattern_clause.GetLHSParam();
+    rhs_param = pattern_clause.GetRHSParam();
+  } else {
+    return "";
+  }
+  AppendClauseParam(lhs_param, key);
+  AppendClauseParam(rhs_param, key);
+  CacheKey::AppendNumber(lhs_param.param_type == ClauseParamType::DESIGN_ENTITY && lhs_param == rhs_param, key);
+  return key;
+}
+
+std::shared_ptr<const ClauseResult> ClauseResultCache::Get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto entry_it = entries.find(key);
+  if (entry_it == entries.end()) {
+    statistics.misses++;
+    return nullptr;
+  }
+  Entry& entry = entry_it->second;
+  entry.hits++;
+  entries_by_saving.erase(entry.saving_it);
+  entry.saving_it = entries_by_saving.emplace(GetSaving(entry), &entry_it->first);
+  statistics.hits++;
+  statistics.saved_ms += entry.cost_ms;
+  return entry.result;
+}
+
+void ClauseResultCache::Put(const std::string& key, const ClauseResult& result, double cost_ms) {
+  size_t bytes = CountBytes(key, result);
+  std::shared_ptr<const ClauseResult> cached_result = std::make_shared<const ClauseResult>(result);
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  if (bytes > max_bytes || entries.find(key) != entries.end()) {
+    return;
+  }
+  auto entry_it = entries.emplace(key, Entry{cached_result, bytes, cost_ms, 0, SavingIndex::iterator()}).first;
+  entry_it->second.saving_it = entries_by_saving.emplace(GetSaving(entry_it->second), &entry_it->first);
+  statistics.bytes += bytes;
+  EvictToLimits();
+}
+
+ClauseResultCacheStatistics ClauseResultCache::GetStatistics() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  return statistics;
+}
+
+void ClauseResultCache::SetLimits(size_t new_max_entries, size_t new_max_bytes) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  max_entries = new_max_entries;
+  max_bytes = new_max_bytes;
+  EvictToLimits();
+}
+
+void ClauseResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  entries.clear();
+  entries_by_saving.clear();
+  statistics = ClauseResultCacheStatistics();
+}
+
+// whether a synonym of the clause is in an earlier result table, which restricts the pairs of the clause
+bool ClauseResultCache::IsRestricted(ClauseParam lhs_param, ClauseParam rhs_param, std::vector<ResultTable>& database) {
+  for (ResultTable& table : database) {
+    if (table.Contains(lhs_param) || table.Contains(rhs_param)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string ClauseResultCache::CountKey(const std::string& key) {
+  if (key.empty()) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    statistics.uncacheable++;
+  }
+  return key;
+}
+
+void ClauseResultCache::AppendClauseParam(const ClauseParam& clause_param, std::string& key) {
+  CacheKey::AppendEnum(clause_param.param_type, key);
+  if (clause_param.param_type == ClauseParamType::DESIGN_ENTITY) {
+    DesignEntity design_entity = clause_param.design_entity;
+    CacheKey::AppendEnum(design_entity.GetDesignEntityType(), key);
+  } else if (clause_param.param_type == ClauseParamType::INDEX) {
+    CacheKey::AppendNumber(clause_param.statement_index, key);
+  } else if (clause_param.param_type == ClauseParamType::NAME) {
+    CacheKey::AppendName(clause_param.var_proc_name, key);
+  } else if (clause_param.param_type == ClauseParamType::EXPR) {
+    CacheKey::AppendExpression(clause_param.pattern_expr, key);
+  }
+}
+
+// an estimate of the memory taken by a cached result, including its key
+size_t ClauseResultCache::CountBytes(const std::string& key, const ClauseResult& result) {
+  return key.size() + sizeof(Entry) + sizeof(ClauseResult) + CountColumnBytes(result.lhs_column) +
+         CountColumnBytes(result.rhs_column);
+}
+
+/*
+ * The evaluation time a result saves per byte. Every hit of a result saves its evaluation time again, so a result's
+ * saving is its cost for each of its hits, plus one for the hit it may have next.
+ */
+double ClauseResultCache::GetSaving(const Entry& entry) {
+  return entry.cost_ms * (entry.hits + 1) / entry.bytes;
+}
+
+// evicts the results with the least evaluation time saved per byte until the cache is within its limits
+void ClauseResultCache::EvictToLimits() {
+  while (!entries.empty() && (entries.size() > max_entries || statistics.bytes > max_bytes)) {
+    SavingIndex::iterator cheapest_it = entries_by_saving.begin();
+    auto evicted_it = entries.find(*cheapest_it->second);
+    statistics.bytes -= evicted_it->second.bytes;
+    statistics.evictions++;
+    entries_by_saving.erase(cheapest_it);
+    entries.erase(evicted_it);
+  }
+  statistics.size = entries.size();
+}
+
+}  // namespace query_processor
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ResultTable.h"
+#include "pkb/PKB.h"
+#include "query_processor/commons/CacheKey.h"
+#include "query_processor/commons/query/clause/Clause.h"
+#include "query_processor/commons/query/clause/ClauseParam.h"
+#include "query_processor/commons/query/clause/PatternClause.h"
+#include "query_processor/commons/query/clause/SuchThatClause.h"
+
+namespace query_processor {
+
+// the pairs of a such that clause, or only whether it holds if both of its params are wildcards. The pairs of a
+// pattern clause are its design entity and its lhs param
+struct ClauseResult {
+  bool is_true = false;
+  Column lhs_column;
+  Column rhs_column;
+};
+
+// clauses restricted by an earlier clause are also counted as uncacheable
+struct ClauseResultCacheStatistics : CacheStatistics {
+  double saved_ms = 0;  // the evaluation time of every clause answered from the cache
+};
+
+/*
+  Memoises the results of such that and pattern clauses across the queries evaluated against a frozen PKB, so
+  that an expensive clause such as Affects*(a1, a2) or Next*(n, n) is only evaluated by the first query
+  containing it.
+
+  A clause is cached under its design abstraction, or the design entity type of a pattern clause, the shape of
+  its params, i.e. their types and the design entity types of their synonyms, and their literals and
+  expressions, but never the names of its synonyms. Whether its two synonyms are the same is part of the shape.
+  Only clauses whose synonyms are in no earlier result table are cached, as the pairs of any other clause depend
+  on the clauses evaluated before it. Every key is tagged with the generation id of the PKB, so results are
+  never reused across PKBs.
+
+  The cache is shared by all threads and bounded in both entries and bytes. Once either bound is exceeded it
+  evicts the results that save the least evaluation time per byte, counting every hit they have had.
+*/
+class ClauseResultCache {
+ public:
+  static const size_t kDefaultMaxEntries = 4096;
+  static const size_t kDefaultMaxBytes = 64 << 20;
+
+  // the key of the clause evaluated after the tables in the database, or the empty string if its result can
+  // not be cached
+  static std::string GetKey(SuchThatClause&, const PKB&, std::vector<ResultTable>&);
+  static std::string GetKey(PatternClause&, const PKB&, std::vector<ResultTable>&);
+
+  // the key of the clause evaluated before any other clause, or the empty string if its result can not be
+  // cached. Unlike GetKey, it is not counted in the statistics
+  static std::string CreateKey(Clause&, const PKB&);
+
+  // the result cached under a key from GetKey, or nullptr if there is none
+  static std::shared_ptr<const ClauseResult> Get(const std::string&);
+
+  // caches a result that took cost_ms to evaluate
+  static void Put(const std::string&, const ClauseResult&, double cost_ms);
+
+  static ClauseResultCacheStatistics GetStatistics();
+
+  // a limit of 0 entries or bytes disables the cache
+  static void SetLimits(size_t max_entries, size_t max_bytes);
+
+  // removes every result and resets the statistics
+  static void Clear();
+
+ private:
+  // the keys of the cached results, ordered by the evaluation time they save per byte
+  typedef std::multimap<double, const std::string*> SavingIndex;
+
+  struct Entry {
+    std::shared_ptr<const ClauseResult> result;
+    size_t bytes;
+    double cost_ms;
+    size_t hits;
+    SavingIndex::iterator saving_it;
+  };
+
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, Entry> entries;
+  static SavingIndex entries_by_saving;
+  static size_t max_entries;
+  static size_t max_bytes;
+  static ClauseResultCacheStatistics statistics;
+
+  static bool IsRestricted(ClauseParam, ClauseParam, std::vector<ResultTable>&);
+  static std::string CountKey(const std::string&);
+  static void AppendClauseParam(const ClauseParam&, std::string&);
+  static size_t CountBytes(const std::string&, const ClauseResult&);
+  static double GetSaving(const Entry&);
+  static void EvictToLimits();
+};
+
+}  // namespace query_processor
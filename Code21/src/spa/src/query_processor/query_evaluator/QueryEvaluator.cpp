@@ -1,25 +1,51 @@
 
 #include "QueryEvaluator.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "pkb/utils/CompressedBitmap.h"
 #include "query_processor/commons/BooleanSemanticError.h"
 #include "query_processor/commons/query/clause/SuchThatClause.h"
 #include "query_processor/commons/query/entities/DesignEntityType.h"
 #include "query_processor/commons/query/entities/SelectedEntity.h"
 #include "query_processor/commons/query/utils/QueryUtils.h"
+#include "query_processor/query_evaluator/ClauseResultCache.h"
+#include "query_processor/query_evaluator/QueryMemory.h"
+#include "query_processor/query_evaluator/QueryProfiler.h"
 #include "query_processor/query_evaluator/utils/QueryEvaluatorUtils.h"
 #include "query_processor/query_optimizer/QueryOptimizer.h"
+#include "utils/Arena.h"
+#include "utils/Cancellation.h"
 
 namespace query_processor {
 
-PKB empty_pkb = PKB();
-PKB* QueryEvaluator::pkb = &empty_pkb;
+const size_t QueryEvaluator::kMaxFrozenDesignEntityTables;
+std::mutex QueryEvaluator::frozen_design_entity_tables_mutex;
+std::map<uint64_t, std::shared_ptr<QueryEvaluator::DesignEntityTables>> QueryEvaluator::frozen_design_entity_tables;
 
 const std::string LEFT_KEY = "LEFT";
 const std::string RIGHT_KEY = "RIGHT";
 
+// the strategies a clause may be evaluated with, as reported by EXPLAIN and PROFILE
+const std::string RESULT_CACHE_STRATEGY = "result cache";
+const std::string WILDCARD_SCAN_STRATEGY = "wildcard scan";
+const std::string RELATION_ROW_STRATEGY = "relation row intersection";
+const std::string PAIRWISE_CHECK_STRATEGY = "pairwise check";
+const std::string ENTITY_SCAN_STRATEGY = "entity scan";
+const std::string PATTERN_SCAN_STRATEGY = "pattern scan";
+const std::string CONDITIONAL_PATTERN_STRATEGY = "conditional pattern scan";
+const std::string ATTRIBUTE_COMPARISON_STRATEGY = "attribute comparison";
+const std::string NESTED_LOOP_STRATEGY = "nested loop over the cross product";
+
 /* Query Optimizer Flags
  * Note: If the optimize_query flag is set to false when calling EvaluateQuery, all optimizations will be disabled. */
 
@@ -31,9 +57,25 @@ const bool SORT_TABLES_BEFORE_BFS = true;     // Sorts result tables based on ta
 // default: false for this optimisation
 const bool SORT_TABLES_BEFORE_MERGE = false;  // During BFS, sort each node's neighbours based on table size. Merging will start from the smallest table.
 
-void QueryEvaluator::SetPKB(PKB* input_pkb) {
-  pkb = input_pkb;
+QueryEvaluator::QueryEvaluator(PKB* input_pkb) : pkb(input_pkb) {
+  // the columns of an unfrozen PKB are only kept by this evaluator, as the PKB may change once it is done
+  uint64_t generation_id = pkb->GetGenerationId();
+  if (generation_id == 0) {
+    design_entity_tables = std::make_shared<DesignEntityTables>();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(frozen_design_entity_tables_mutex);
+  auto iter = frozen_design_entity_tables.find(generation_id);
+  if (iter == frozen_design_entity_tables.end()) {
+    // generations are numbered in the order they are frozen, so the oldest ones are the first to go
+    if (frozen_design_entity_tables.size() >= kMaxFrozenDesignEntityTables) {
+      frozen_design_entity_tables.erase(frozen_design_entity_tables.begin());
+    }
+    iter = frozen_design_entity_tables.emplace(generation_id, std::make_shared<DesignEntityTables>()).first;
+  }
+  design_entity_tables = iter->second;
 }
+
 /**
  * Evaluates a Query object based on the input PKB. The EvaluateQuery function first evaluates each clause independently.
  * A ResultTable containing data for any design entity evaluated is created for each clause and stored in
@@ -42,42 +84,66 @@ void QueryEvaluator::SetPKB(PKB* input_pkb) {
  * Optimizer and any selected design entity, attribute or tuple will either be retrieved from the table or from the PKB
  * (if it was never evaluated).
  * @param query A Query object should minimally house at least one Selected Entity in a list of Selected Entities,
- * as well as an optional list of Clauses
+ * as well as an optional list of Clauses. It is left as it is, the clauses being planned in a copy of it.
  * @param input_pkb The current state of the PKB populated with the Design Abstractions from the SIMPLE source code.
  * @param optimize_query Set flag to true if the query should be optimized
  * @return QueryResult object, which either stores an unordered set of string or integers, or a boolean.
  */
-QueryResult QueryEvaluator::EvaluateQuery(Query query, PKB* input_pkb, bool optimize_query) {
+QueryResult QueryEvaluator::EvaluateQuery(Query& query, PKB* input_pkb, bool optimize_query) {
   if (optimize_query) {
-    query = QueryOptimizer::OptimizeQuery(query, REMOVE_DUPLICATE_CLAUSE, SORT_CLAUSES);
+    Query planned_query = PlanQuery(query);
+    return EvaluatePlannedQuery(planned_query, input_pkb, optimize_query);
   }
-  SetPKB(input_pkb);
+  return EvaluatePlannedQuery(query, input_pkb, optimize_query);
+}
+
+/**
+ * Applies the clause level optimizations of the Query Optimizer, i.e. removing repeated clauses and ordering the
+ * clauses for evaluation. The order only depends on the types of the clauses and their params, never on the literal
+ * values in them, so a planned Query may be reused for any query of the same shape.
+ * @param query A Query object as generated by the QueryParser
+ * @return The Query with its clauses in the order they should be evaluated in
+ */
+Query QueryEvaluator::PlanQuery(Query query) {
+  return QueryOptimizer::OptimizeQuery(std::move(query), REMOVE_DUPLICATE_CLAUSE, SORT_CLAUSES);
+}
+
+/**
+ * Evaluates a Query whose clauses are already in the order they should be evaluated in, as returned by PlanQuery,
+ * so that a cached plan does not need to be optimized again.
+ * @param query A Query object whose clauses have been planned, or are to be evaluated as they are
+ * @param input_pkb The current state of the PKB populated with the Design Abstractions from the SIMPLE source code.
+ * @param optimize_merging Set flag to true if the result tables should be merged by the Query Optimizer
+ * @return QueryResult object, which either stores an unordered set of string or integers, or a boolean.
+ */
+QueryResult QueryEvaluator::EvaluatePlannedQuery(Query& query, PKB* input_pkb, bool optimize_merging) {
+  // the rows and indexes built while evaluating the query are freed at once when it returns
+  utils::Arena::Scope arena_scope(utils::Arena::GetThreadArena());
+  QueryEvaluator evaluator(input_pkb);
+  return evaluator.EvaluatePlannedQuery(query, optimize_merging);
+}
+
+QueryResult QueryEvaluator::EvaluatePlannedQuery(Query& query, bool optimize_merging) {
   Database database;
-  std::vector<SelectedEntity> selected_entities = query.GetSelectedEntities();
+  std::vector<SelectedEntity>& selected_entities = query.GetSelectedEntities();
   bool is_tuple = selected_entities.size() > 1;
   bool is_boolean_result = selected_entities.size() == 1 && query.GetSelectedEntity().entity_type == SelectedEntityType::BOOLEAN;
 
-  std::vector<Clause> clause_list = query.GetClauseList();
   Column result;
+  // the tables of the database are held until the query is evaluated
+  QueryMemory::Reservation database_reservation;
 
   try {
     // Evaluation of clauses here. If any of the clauses are false, return empty QueryResult or false.
-    for (Clause clause : clause_list) {
-      ClauseType clause_type = clause.GetClauseType();
-      bool is_clause_true;
-      switch (clause_type) {
-        case ClauseType::SUCHTHAT:
-          is_clause_true = EvaluateSuchThatClause(clause.GetSuchThatClause(), database);
-          break;
-        case ClauseType::PATTERN:
-          is_clause_true = EvaluatePatternClause(clause.GetPatternClause(), database);
-          break;
-        case ClauseType::WITH:
-          is_clause_true = EvaluateWithClause(clause.GetWithClause(), database);
-          break;
-        default:
-          throw std::runtime_error("Invalid clause type");
+    for (Clause& clause : query.GetClauseList()) {
+      utils::Cancellation::CheckNow();
+      bool is_clause_true = QueryProfiler::IsActive() ? EvaluateProfiledClause(clause, database)
+                                                      : EvaluateClause(clause, database);
+      size_t database_bytes = 0;
+      for (ResultTable& table : database) {
+        database_bytes += table.CountBytes();
       }
+      database_reservation.Resize(database_bytes);
       if (!is_clause_true) {
         if (is_boolean_result) {
           return QueryResult(false);
@@ -96,15 +162,16 @@ QueryResult QueryEvaluator::EvaluateQuery(Query query, PKB* input_pkb, bool opti
   }
 
   std::vector<ResultTable> result_tables;
-  if (optimize_query && GROUP_BEFORE_MERGE) {
+  QueryProfiler::SetMergeStrategy(GetMergeStrategy(optimize_merging));
+  if (optimize_merging && GROUP_BEFORE_MERGE) {
     result_tables = QueryOptimizer::OptimizeMerging(database, SORT_TABLES_BEFORE_BFS, SORT_TABLES_BEFORE_MERGE);
   } else {
     // Inner join all tables on their intersecting headers trivially
     ResultTable final_table = ResultTable();
-    for (ResultTable table : database) {
+    for (ResultTable& table : database) {
       final_table = table.MergeTable(final_table);
     }
-    result_tables.push_back(final_table);
+    result_tables.push_back(std::move(final_table));
   }
 
   // Evaluation of selection
@@ -118,16 +185,15 @@ QueryResult QueryEvaluator::EvaluateQuery(Query query, PKB* input_pkb, bool opti
     return SelectTuple(selected_entities, result_tables);
   }
 
-  SelectedEntity selected_entity = query.GetSelectedEntity();
+  SelectedEntity& selected_entity = query.GetSelectedEntity();
   switch (selected_entity.entity_type) {
     case SelectedEntityType::BOOLEAN:
       return QueryResult(all_clauses_return_true);
 
     case SelectedEntityType::DESIGN_ENTITY:
       if (all_clauses_return_true) {
-        DesignEntity design_entity = selected_entity.design_entity;
-        result = GetSmallestDesignEntitySet(design_entity, result_tables);
-        return QueryEvaluatorUtils::ConvertColumnToQueryResult(result);
+        return QueryEvaluatorUtils::ConvertColumnToQueryResult(
+            GetSmallestDesignEntitySet(selected_entity.design_entity, result_tables));
       } else {
         // Design entities were evaluated in the process but the resulting columns are all empty.
         return QueryResult();
@@ -135,9 +201,11 @@ QueryResult QueryEvaluator::EvaluateQuery(Query query, PKB* input_pkb, bool opti
 
     case SelectedEntityType::ATTRIBUTE:
       if (all_clauses_return_true) {
-        DesignEntity design_entity = selected_entity.attribute.first;
-        Column design_entity_column = GetSmallestDesignEntitySet(design_entity, result_tables);
-        for (auto elem : design_entity_column) {
+        const DesignEntity& design_entity = selected_entity.attribute.first;
+        const Column& design_entity_column = GetSmallestDesignEntitySet(design_entity, result_tables);
+        result.reserve(design_entity_column.size());
+        for (const TableElement& elem : design_entity_column) {
+          utils::Cancellation::Check();
           result.push_back(ConvertToAttribute(elem, design_entity.GetDesignEntityType(),
                                               selected_entity.attribute.second));
         }
@@ -148,6 +216,147 @@ QueryResult QueryEvaluator::EvaluateQuery(Query query, PKB* input_pkb, bool opti
   }
 }
 
+/**
+ * Evaluates a single clause on its own, as the first clause of a query would be. Such that and pattern clauses
+ * evaluated against a frozen PKB leave their results in the ClauseResultCache, so evaluating a clause shared by
+ * several queries before them lets every one of them reuse its result.
+ * @param clause A clause of a planned Query
+ * @param input_pkb The current state of the PKB populated with the Design Abstractions from the SIMPLE source code.
+ * @return true if the clause holds, false otherwise. Semantic errors in the clause throw a runtime_error.
+ */
+bool QueryEvaluator::EvaluateSharedClause(Clause& clause, PKB* input_pkb) {
+  utils::Arena::Scope arena_scope(utils::Arena::GetThreadArena());
+  QueryEvaluator evaluator(input_pkb);
+  Database database;
+  return evaluator.EvaluateClause(clause, database);
+}
+
+/**
+ * Plans the evaluation of a Query whose clauses are already in the order they should be evaluated in, without
+ * evaluating any of them. The rows of each clause are estimated from the sizes of the design entities of its synonyms
+ * in the PKB, and its strategy is the one it would be evaluated with if no result of it were cached.
+ * @param query A Query object whose clauses have been planned, or are to be evaluated as they are
+ * @param input_pkb The current state of the PKB populated with the Design Abstractions from the SIMPLE source code.
+ * @param optimize_merging Set flag to true if the result tables would be merged by the Query Optimizer
+ * @param profile The QueryProfile receiving the plan of each clause and the merge strategy
+ */
+void QueryEvaluator::ExplainPlannedQuery(Query& query, PKB* input_pkb, bool optimize_merging, QueryProfile& profile) {
+  utils::Arena::Scope arena_scope(utils::Arena::GetThreadArena());
+  QueryEvaluator evaluator(input_pkb);
+  evaluator.ExplainPlannedQuery(query, optimize_merging, profile);
+}
+
+void QueryEvaluator::ExplainPlannedQuery(Query& query, bool optimize_merging, QueryProfile& profile) {
+  Database database;
+  std::vector<std::vector<DesignEntity>> earlier_synonyms;
+  for (Clause& clause : query.GetClauseList()) {
+    ClauseProfile clause_profile;
+    clause_profile.clause = QueryProfiler::DescribeClause(clause);
+    clause_profile.strategy = PredictClauseStrategy(clause, earlier_synonyms);
+    clause_profile.estimated_rows = EstimateClauseRows(clause, database);
+    profile.clauses.push_back(std::move(clause_profile));
+    earlier_synonyms.push_back(QueryUtils::GetClauseSynonyms(clause));
+  }
+  profile.merge_strategy = GetMergeStrategy(optimize_merging);
+}
+
+bool QueryEvaluator::EvaluateClause(Clause& clause, Database& database) {
+  switch (clause.GetClauseType()) {
+    case ClauseType::SUCHTHAT:
+      return EvaluateSuchThatClause(clause.GetSuchThatClause(), database);
+    case ClauseType::PATTERN:
+      return EvaluatePatternClause(clause.GetPatternClause(), database);
+    case ClauseType::WITH:
+      return EvaluateWithClause(clause.GetWithClause(), database);
+    default:
+      throw std::runtime_error("Invalid clause type");
+  }
+}
+
+bool QueryEvaluator::EvaluateProfiledClause(Clause& clause, Database& database) {
+  // the estimate is taken before the clause is timed, as it reads the columns of its synonyms
+  QueryProfiler::BeginClause(clause, EstimateClauseRows(clause, database));
+  bool is_clause_true = EvaluateClause(clause, database);
+  QueryProfiler::EndClause(is_clause_true);
+  return is_clause_true;
+}
+
+/*
+ * Estimates the rows of a clause as the product of the columns its synonyms may take, i.e. the rows of the cross
+ * product it would check pairwise. A with clause comparing two synonyms can match at most the smaller of them.
+ */
+size_t QueryEvaluator::EstimateClauseRows(Clause& clause, Database& database) {
+  std::vector<DesignEntity> synonyms = QueryUtils::GetClauseSynonyms(clause);
+  size_t estimated_rows = 1;
+  size_t smallest_rows = SIZE_MAX;
+  for (DesignEntity& synonym : synonyms) {
+    size_t synonym_rows = QueryEvaluatorUtils::RemoveDuplicateTableElements(
+        GetSmallestDesignEntitySet(synonym, database)).size();
+    estimated_rows *= synonym_rows;
+    smallest_rows = std::min(smallest_rows, synonym_rows);
+  }
+  if (clause.GetClauseType() == ClauseType::WITH && synonyms.size() > 1) {
+    return smallest_rows;
+  }
+  return estimated_rows;
+}
+
+/*
+ * The strategy a clause is evaluated with, given the synonyms of each clause evaluated before it. Like evaluation, it
+ * assumes relations stored as compressed rows have them for every stmt.
+ */
+std::string QueryEvaluator::PredictClauseStrategy(Clause& clause, std::vector<std::vector<DesignEntity>>& earlier_synonyms) {
+  switch (clause.GetClauseType()) {
+    case ClauseType::SUCHTHAT: {
+      SuchThatClause& such_that_clause = clause.GetSuchThatClause();
+      const ClauseParam& lhs_param = such_that_clause.GetLHSParam();
+      const ClauseParam& rhs_param = such_that_clause.GetRHSParam();
+      if (IsWildcardParams(lhs_param, rhs_param)) {
+        return WILDCARD_SCAN_STRATEGY;
+      }
+      if (!QueryEvaluatorUtils::HasRelationRows(such_that_clause.GetDesignAbstraction()) ||
+          IsSimilarParams(lhs_param, rhs_param)) {
+        return PAIRWISE_CHECK_STRATEGY;
+      }
+      // the pairs of a table holding both synonyms are checked instead
+      std::vector<DesignEntity> synonyms = QueryUtils::GetClauseSynonyms(clause);
+      for (std::vector<DesignEntity>& clause_synonyms : earlier_synonyms) {
+        size_t shared_synonyms = 0;
+        for (DesignEntity& synonym : synonyms) {
+          for (DesignEntity& clause_synonym : clause_synonyms) {
+            shared_synonyms += synonym.GetSynonym() == clause_synonym.GetSynonym();
+          }
+        }
+        if (synonyms.size() == 2 && shared_synonyms == 2) {
+          return PAIRWISE_CHECK_STRATEGY;
+        }
+      }
+      return RELATION_ROW_STRATEGY;
+    }
+    case ClauseType::PATTERN: {
+      PatternClause& pattern_clause = clause.GetPatternClause();
+      const DesignEntity& de = pattern_clause.GetDesignEntity();
+      const ClauseParam& lhs_param = pattern_clause.GetLHSParam();
+      const ClauseParam& rhs_param = pattern_clause.GetRHSParam();
+      if (de.GetDesignEntityType() != DesignEntityType::ASSIGN) {
+        return CONDITIONAL_PATTERN_STRATEGY;
+      }
+      return IsWildcardParams(lhs_param, rhs_param) ? ENTITY_SCAN_STRATEGY : PATTERN_SCAN_STRATEGY;
+    }
+    case ClauseType::WITH:
+      return ATTRIBUTE_COMPARISON_STRATEGY;
+    default:
+      throw std::runtime_error("Invalid clause type");
+  }
+}
+
+std::string QueryEvaluator::GetMergeStrategy(bool optimize_merging) {
+  if (optimize_merging && GROUP_BEFORE_MERGE) {
+    return SORT_TABLES_BEFORE_BFS ? "grouped BFS merge from the smallest table" : "grouped BFS merge";
+  }
+  return "sequential merge";
+}
+
 QueryResult QueryEvaluator::SelectTuple(std::vector<SelectedEntity>& selected_entities, Database& result_tables) {
   ResultTable tuple_table;
   for (auto& table : result_tables) {
@@ -158,12 +367,8 @@ QueryResult QueryEvaluator::SelectTuple(std::vector<SelectedEntity>& selected_en
       }
 
       // Obtain the relevant design entity for the synonym or the attribute
-      DesignEntity de;
-      if (entity.entity_type == SelectedEntityType::DESIGN_ENTITY) {
-        de = entity.design_entity;
-      } else {
-        de = entity.attribute.first;
-      }
+      const DesignEntity& de =
+          entity.entity_type == SelectedEntityType::DESIGN_ENTITY ? entity.design_entity : entity.attribute.first;
 
       // If the design entity is not in this result table, look in the next one.
       if (!table.Contains(de.GetSynonym())) {
@@ -184,13 +389,15 @@ QueryResult QueryEvaluator::SelectTuple(std::vector<SelectedEntity>& selected_en
       }
 
       // Add the column to the temporary table without cross product since all columns came from the same table.
-      Column de_col = table.GetColumn(de.GetSynonym());
+      const Column& de_col = table.GetColumn(de.GetSynonym());
       if (entity.entity_type == SelectedEntityType::ATTRIBUTE) {
         Column attribute_col;
-        for (auto elem : de_col) {
+        attribute_col.reserve(de_col.size());
+        for (const TableElement& elem : de_col) {
+          utils::Cancellation::Check();
           attribute_col.push_back(ConvertToAttribute(elem, de.GetDesignEntityType(), entity.attribute.second));
         }
-        temp_table.AddColumn(key, attribute_col);
+        temp_table.AddColumn(key, std::move(attribute_col));
       } else {
         temp_table.AddColumn(key, de_col);
       }
@@ -203,12 +410,8 @@ QueryResult QueryEvaluator::SelectTuple(std::vector<SelectedEntity>& selected_en
       throw std::runtime_error("Incorrect entity type within a tuple.");
     }
 
-    DesignEntity de;
-    if (entity.entity_type == SelectedEntityType::DESIGN_ENTITY) {
-      de = entity.design_entity;
-    } else {
-      de = entity.attribute.first;
-    }
+    const DesignEntity& de =
+        entity.entity_type == SelectedEntityType::DESIGN_ENTITY ? entity.design_entity : entity.attribute.first;
 
     std::string key;
     if (entity.entity_type == SelectedEntityType::ATTRIBUTE) {
@@ -219,28 +422,32 @@ QueryResult QueryEvaluator::SelectTuple(std::vector<SelectedEntity>& selected_en
 
     // Selected Entity was not in any table
     if (!tuple_table.Contains(key)) {
-      Column selected_col = GetDesignEntityTable(de.GetDesignEntityType());
+      const Column& entity_col = GetDesignEntityTable(de.GetDesignEntityType());
+      Column selected_col;
       if (entity.entity_type == SelectedEntityType::ATTRIBUTE) {
-        Column attribute_col;
-        for (auto elem : selected_col) {
-          attribute_col.push_back(
+        selected_col.reserve(entity_col.size());
+        for (const TableElement& elem : entity_col) {
+          utils::Cancellation::Check();
+          selected_col.push_back(
               ConvertToAttribute(elem, de.GetDesignEntityType(), entity.attribute.second));
         }
-        selected_col = attribute_col;
+      } else {
+        selected_col = entity_col;
       }
       if (tuple_table.Contains(de.GetSynonym()) ||
           tuple_table.Contains(QueryEvaluatorUtils::GetAttributeKey(AttributeType::INTEGER, de)) ||
           tuple_table.Contains(QueryEvaluatorUtils::GetAttributeKey(AttributeType::NAME, de))) {
-        tuple_table.AddColumn(key, selected_col);
+        tuple_table.AddColumn(key, std::move(selected_col));
       } else {
-        tuple_table = tuple_table.MergeColumn(key, selected_col);
+        tuple_table = tuple_table.MergeColumn(key, std::move(selected_col));
       }
     }
   }
   return QueryEvaluatorUtils::ConvertResultTableToTupleResult(tuple_table, selected_entities);
 }
 
-bool QueryEvaluator::ApplyPKBFunction(TableElement& lhs, TableElement& rhs, DesignAbstraction da) {
+bool QueryEvaluator::ApplyPKBFunction(const TableElement& lhs, const TableElement& rhs, DesignAbstraction da) {
+  QueryProfiler::CountPkbProbes(1);
   switch (da) {
     case DesignAbstraction::FOLLOWS:
       return pkb->IsFollows(lhs.stmt, rhs.stmt);
@@ -287,12 +494,70 @@ bool QueryEvaluator::ApplyPKBFunction(TableElement& lhs, TableElement& rhs, Desi
   }
 }
 
+const CompressedBitmap* QueryEvaluator::GetRelationRow(const TableElement& lhs, DesignAbstraction da) {
+  QueryProfiler::CountPkbProbes(1);
+  switch (da) {
+    case DesignAbstraction::NEXT_T:
+      return pkb->GetNextTRow(lhs.stmt);
+    case DesignAbstraction::NEXTBIP_T:
+      return pkb->GetNextBipTRow(lhs.stmt);
+    case DesignAbstraction::AFFECTS_T:
+      return pkb->GetAffectsTRow(lhs.stmt);
+    case DesignAbstraction::AFFECTSBIP_T:
+      return pkb->GetAffectsBipTRow(lhs.stmt);
+    default:
+      return nullptr;
+  }
+}
+
+/*
+ * Relations stored as compressed rows are evaluated by intersecting the row of every lhs stmt with the rhs stmts,
+ * rather than by checking every pair of the cross product of the two columns. Returns false, leaving the valid
+ * columns untouched, if the clause cannot be evaluated this way.
+ */
+bool QueryEvaluator::IntersectRelationRows(const ClauseParam& lhs_param, const ClauseParam& rhs_param, DesignAbstraction da,
+                                           Database& database, Column& lhs_valid, Column& rhs_valid) {
+  if (IsSimilarParams(lhs_param, rhs_param)) {
+    return false;
+  }
+  for (auto& table : database) {
+    if (table.Contains(lhs_param) && table.Contains(rhs_param)) {
+      // only the pairs of the existing table need to be checked
+      return false;
+    }
+  }
+
+  DesignEntityType wildcard_type = QueryEvaluatorUtils::ConvertAbstractionToWildcardType(da);
+  Column lhs_col = QueryEvaluatorUtils::RemoveDuplicateTableElements(
+      ConvertClauseParamToColumn(lhs_param, wildcard_type, database));
+  if (lhs_col.empty() || GetRelationRow(lhs_col.front(), da) == nullptr) {
+    return false;
+  }
+  Column rhs_col = ConvertClauseParamToColumn(rhs_param, wildcard_type, database);
+  std::vector<int> rhs_stmts;
+  rhs_stmts.reserve(rhs_col.size());
+  for (const TableElement& rhs_elem : rhs_col) {
+    rhs_stmts.push_back(rhs_elem.stmt);
+  }
+  CompressedBitmap rhs_bitmap(rhs_stmts);
+
+  for (auto& lhs_elem : lhs_col) {
+    utils::Cancellation::Check();
+    for (int rhs_stmt : GetRelationRow(lhs_elem, da)->Intersect(rhs_bitmap).ToVector()) {
+      lhs_valid.push_back(lhs_elem);
+      rhs_valid.push_back(TableElement(rhs_stmt));
+    }
+  }
+  return true;
+}
+
 bool QueryEvaluator::EvaluateSuchThatWildcardClause(SuchThatClause& clause) {
   DesignAbstraction design_abstraction = clause.GetDesignAbstraction();
   DesignEntityType de_type = QueryEvaluatorUtils::ConvertAbstractionToWildcardType(design_abstraction);
-  Column de_col = GetDesignEntityTable(de_type);
-  for (auto lhs_elem : de_col) {
-    for (auto rhs_elem : de_col) {
+  const Column& de_col = GetDesignEntityTable(de_type);
+  for (const TableElement& lhs_elem : de_col) {
+    utils::Cancellation::Check(de_col.size());
+    for (const TableElement& rhs_elem : de_col) {
       if (ApplyPKBFunction(lhs_elem, rhs_elem, design_abstraction)) {
         return true;
       }
@@ -301,13 +566,32 @@ bool QueryEvaluator::EvaluateSuchThatWildcardClause(SuchThatClause& clause) {
   return false;
 }
 
+/*
+ * Finds every pair of the clause's params for which the relationship holds, within the columns of the params in
+ * the database if there are any.
+ */
+void QueryEvaluator::EvaluateSuchThatPairs(const ClauseParam& lhs_param, const ClauseParam& rhs_param, DesignAbstraction design_abstraction,
+                                           Database& database, Column& lhs_valid, Column& rhs_valid) {
+  if (IntersectRelationRows(lhs_param, rhs_param, design_abstraction, database, lhs_valid, rhs_valid)) {
+    QueryProfiler::SetClauseStrategy(RELATION_ROW_STRATEGY);
+    return;
+  }
+  QueryProfiler::SetClauseStrategy(PAIRWISE_CHECK_STRATEGY);
+  FilterClauseParamPairs(lhs_param, rhs_param, QueryEvaluatorUtils::ConvertAbstractionToWildcardType(design_abstraction),
+                         database,
+                         [&](const TableElement& lhs_elem, const TableElement& rhs_elem) {
+                           return ApplyPKBFunction(lhs_elem, rhs_elem, design_abstraction);
+                         },
+                         lhs_valid, rhs_valid);
+}
+
 bool QueryEvaluator::EvaluateSuchThatClause(SuchThatClause& clause, Database& database) {
   if (!clause.IsValidClause()) {
     return false;
   }
   DesignAbstraction design_abstraction = clause.GetDesignAbstraction();
-  ClauseParam lhs_param = clause.GetLHSParam();
-  ClauseParam rhs_param = clause.GetRHSParam();
+  const ClauseParam& lhs_param = clause.GetLHSParam();
+  const ClauseParam& rhs_param = clause.GetRHSParam();
 
   if (QueryEvaluatorUtils::IsDesignAbstractionWithNoSimilarParams(design_abstraction)) {
     // The above design abstractions can evaluate to true for some clauses with similar parameters
@@ -316,62 +600,80 @@ bool QueryEvaluator::EvaluateSuchThatClause(SuchThatClause& clause, Database& da
     }
   }
 
-  if (IsWildcardParams(lhs_param, rhs_param)) {
-    return EvaluateSuchThatWildcardClause(clause);
-  }
-
-  ResultTable clause_param_table = ConvertClauseToResultTable(lhs_param, rhs_param,
-                                                              QueryEvaluatorUtils::ConvertAbstractionToWildcardType(design_abstraction),
-                                                              database);
-  int table_height = clause_param_table.GetHeight();
-  Column& lhs_col = clause_param_table.GetColumn(LEFT_KEY);
-  Column& rhs_col = clause_param_table.GetColumn(RIGHT_KEY);
+  // clauses not restricted by earlier clauses may have been evaluated by an earlier query
+  bool is_wildcard_clause = IsWildcardParams(lhs_param, rhs_param);
+  bool is_clause_true = false;
   Column lhs_valid;
   Column rhs_valid;
-  for (int i = 0; i < table_height; i++) {
-    if (ApplyPKBFunction(lhs_col.at(i), rhs_col.at(i), design_abstraction)) {
-      lhs_valid.push_back(lhs_col.at(i));
-      rhs_valid.push_back(rhs_col.at(i));
+  std::string result_key = ClauseResultCache::GetKey(clause, *pkb, database);
+  std::shared_ptr<const ClauseResult> cached_result;
+  if (!result_key.empty()) {
+    cached_result = ClauseResultCache::Get(result_key);
+  }
+
+  if (cached_result) {
+    QueryProfiler::SetClauseStrategy(RESULT_CACHE_STRATEGY);
+    is_clause_true = cached_result->is_true;
+    lhs_valid = cached_result->lhs_column;
+    rhs_valid = cached_result->rhs_column;
+  } else {
+    auto start_time = std::chrono::steady_clock::now();
+    if (is_wildcard_clause) {
+      QueryProfiler::SetClauseStrategy(WILDCARD_SCAN_STRATEGY);
+      is_clause_true = EvaluateSuchThatWildcardClause(clause);
+    } else {
+      EvaluateSuchThatPairs(lhs_param, rhs_param, design_abstraction, database, lhs_valid, rhs_valid);
+    }
+    if (!result_key.empty()) {
+      std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start_time;
+      ClauseResult result;
+      result.is_true = is_clause_true;
+      result.lhs_column = lhs_valid;
+      result.rhs_column = rhs_valid;
+      ClauseResultCache::Put(result_key, result, cost.count());
     }
   }
 
+  if (is_wildcard_clause) {
+    return is_clause_true;
+  }
   ResultTable result_table = GenerateTable(lhs_param, rhs_param, lhs_valid, rhs_valid);
   if (result_table.IsEmpty()) {
     // No design entities were involved in the process
     return !lhs_valid.empty() || !rhs_valid.empty();
   } else {
-    database.push_back(result_table);
-    return result_table.GetHeight() != 0;
+    int height = result_table.GetHeight();
+    QueryProfiler::SetClauseRows(height);
+    database.push_back(std::move(result_table));
+    return height != 0;
   }
 }
 
 bool QueryEvaluator::EvaluateConditionalPatternClause(PatternClause& clause, Database& database) {
-  DesignEntity de = clause.GetDesignEntity();
+  const DesignEntity& de = clause.GetDesignEntity();
   ClauseParam pattern_param = ClauseParam(de);
-  ClauseParam lhs_param = clause.GetLHSParam();
-  ResultTable clause_param_table = ConvertClauseToResultTable(pattern_param, lhs_param,
-                                                              QueryEvaluatorUtils::ConvertAbstractionToWildcardType(DesignAbstraction::MODIFIES),
-                                                              database);
-  int table_height = clause_param_table.GetHeight();
-  Column& lhs_col = clause_param_table.GetColumn(LEFT_KEY);
-  Column& rhs_col = clause_param_table.GetColumn(RIGHT_KEY);
+  const ClauseParam& lhs_param = clause.GetLHSParam();
   Column pattern_valid;
   Column var_valid;
-  for (int i = 0; i < table_height; i++) {
-    std::unordered_set<std::string> vars_used_by_conditional;
-    if (de.GetDesignEntityType() == DesignEntityType::WHILE) {
-      vars_used_by_conditional = pkb->GetVariablesUsedByWhileStmt(lhs_col.at(i).stmt);
-    } else {
-      vars_used_by_conditional = pkb->GetVariablesUsedByIfStmt(lhs_col.at(i).stmt);
-    }
-    if (vars_used_by_conditional.find(rhs_col.at(i).name) != vars_used_by_conditional.end()) {
-      pattern_valid.push_back(lhs_col.at(i));
-      var_valid.push_back(rhs_col.at(i));
-    }
-  }
+  QueryProfiler::SetClauseStrategy(CONDITIONAL_PATTERN_STRATEGY);
+  FilterClauseParamPairs(pattern_param, lhs_param,
+                         QueryEvaluatorUtils::ConvertAbstractionToWildcardType(DesignAbstraction::MODIFIES), database,
+                         [&](const TableElement& pattern_elem, const TableElement& var_elem) {
+                           QueryProfiler::CountPkbProbes(1);
+                           std::unordered_set<std::string> vars_used_by_conditional;
+                           if (de.GetDesignEntityType() == DesignEntityType::WHILE) {
+                             vars_used_by_conditional = pkb->GetVariablesUsedByWhileStmt(pattern_elem.stmt);
+                           } else {
+                             vars_used_by_conditional = pkb->GetVariablesUsedByIfStmt(pattern_elem.stmt);
+                           }
+                           return vars_used_by_conditional.find(var_elem.name) != vars_used_by_conditional.end();
+                         },
+                         pattern_valid, var_valid);
   ResultTable result_table = GenerateTable(pattern_param, lhs_param, pattern_valid, var_valid);
-  database.push_back(result_table);
-  return result_table.GetHeight() != 0;
+  int height = result_table.GetHeight();
+  QueryProfiler::SetClauseRows(height);
+  database.push_back(std::move(result_table));
+  return height != 0;
 }
 
 bool QueryEvaluator::EvaluatePatternClause(PatternClause& clause, Database& database) {
@@ -379,62 +681,110 @@ bool QueryEvaluator::EvaluatePatternClause(PatternClause& clause, Database& data
     return false;
   }
 
-  DesignEntity de = clause.GetDesignEntity();
+  // pattern clauses not restricted by earlier clauses may have been evaluated by an earlier query
+  std::string result_key = ClauseResultCache::GetKey(clause, *pkb, database);
+  if (result_key.empty()) {
+    return EvaluateUncachedPatternClause(clause, database);
+  }
+  const DesignEntity& de = clause.GetDesignEntity();
+  ClauseParam pattern_param = ClauseParam(de);
+  const ClauseParam& lhs_param = clause.GetLHSParam();
+  const ClauseParam& rhs_param = clause.GetRHSParam();
+  bool has_table = de.GetDesignEntityType() != DesignEntityType::ASSIGN || !IsWildcardParams(lhs_param, rhs_param);
+
+  std::shared_ptr<const ClauseResult> cached_result = ClauseResultCache::Get(result_key);
+  if (!cached_result) {
+    auto start_time = std::chrono::steady_clock::now();
+    // the clause does not depend on the tables evaluated before it, so it is evaluated on its own
+    Database clause_database;
+    ClauseResult result;
+    result.is_true = EvaluateUncachedPatternClause(clause, clause_database);
+    for (ResultTable& table : clause_database) {
+      result.lhs_column = table.GetColumn(pattern_param);
+      if (table.Contains(lhs_param)) {
+        result.rhs_column = table.GetColumn(lhs_param);
+      }
+      database.push_back(std::move(table));
+    }
+    std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start_time;
+    ClauseResultCache::Put(result_key, result, cost.count());
+    return result.is_true;
+  }
+
+  QueryProfiler::SetClauseStrategy(RESULT_CACHE_STRATEGY);
+  if (has_table) {
+    ResultTable result_table;
+    result_table.AddColumn(de.GetSynonym(), cached_result->lhs_column);
+    if (lhs_param.param_type == ClauseParamType::DESIGN_ENTITY) {
+      result_table.AddColumn(lhs_param.design_entity.GetSynonym(), cached_result->rhs_column);
+    }
+    QueryProfiler::SetClauseRows(result_table.GetHeight());
+    database.push_back(std::move(result_table));
+  }
+  return cached_result->is_true;
+}
+
+bool QueryEvaluator::EvaluateUncachedPatternClause(PatternClause& clause, Database& database) {
+  const DesignEntity& de = clause.GetDesignEntity();
   ClauseParam pattern_param = ClauseParam(de);
-  ClauseParam lhs_param = clause.GetLHSParam();
-  ClauseParam rhs_param = clause.GetRHSParam();
+  const ClauseParam& lhs_param = clause.GetLHSParam();
+  const ClauseParam& rhs_param = clause.GetRHSParam();
 
   if (de.GetDesignEntityType() != DesignEntityType::ASSIGN) {
     return EvaluateConditionalPatternClause(clause, database);
   }
 
   if (IsWildcardParams(lhs_param, rhs_param)) {
+    QueryProfiler::SetClauseStrategy(ENTITY_SCAN_STRATEGY);
     Column de_col = ConvertClauseParamToColumn(pattern_param, de.GetDesignEntityType(), database);
     return !de_col.empty();
   }
 
+  QueryProfiler::SetClauseStrategy(PATTERN_SCAN_STRATEGY);
   // Evaluate Modifies(pattern_param, lhs_param)
-  ResultTable clause_param_table = ConvertClauseToResultTable(pattern_param, lhs_param,
-                                                              QueryEvaluatorUtils::ConvertAbstractionToWildcardType(DesignAbstraction::MODIFIES),
-                                                              database);
-  int table_height = clause_param_table.GetHeight();
-  Column& lhs_col = clause_param_table.GetColumn(LEFT_KEY);
-  Column& rhs_col = clause_param_table.GetColumn(RIGHT_KEY);
   Column pattern_valid;
   Column var_valid;
-  for (int i = 0; i < table_height; i++) {
-    if (ApplyPKBFunction(lhs_col.at(i), rhs_col.at(i), DesignAbstraction::MODIFIES)) {
-      pattern_valid.push_back(lhs_col.at(i));
-      var_valid.push_back(rhs_col.at(i));
-    }
-  }
+  FilterClauseParamPairs(pattern_param, lhs_param,
+                         QueryEvaluatorUtils::ConvertAbstractionToWildcardType(DesignAbstraction::MODIFIES), database,
+                         [&](const TableElement& pattern_elem, const TableElement& var_elem) {
+                           return ApplyPKBFunction(pattern_elem, var_elem, DesignAbstraction::MODIFIES);
+                         },
+                         pattern_valid, var_valid);
 
   // Generate ResultTable based on previous evaluation
   ResultTable result_table = GenerateTable(pattern_param, lhs_param, pattern_valid, var_valid);
   if (rhs_param.param_type == ClauseParamType::WILDCARD) {
-    database.push_back(result_table);
-    return result_table.GetHeight() != 0;
+    int height = result_table.GetHeight();
+    QueryProfiler::SetClauseRows(height);
+    database.push_back(std::move(result_table));
+    return height != 0;
   }
 
   ResultTable updated_table = ResultTable(result_table.GetHeaders());
   if (rhs_param.param_type == ClauseParamType::EXPR) {
     std::unordered_set<int> assign_stmts_match_expr;
+    QueryProfiler::CountPkbProbes(1);
     if (rhs_param.pattern_expr.is_wild_card) {
       assign_stmts_match_expr = pkb->GetAllAssignStmtsThatContains(rhs_param.pattern_expr.token_list);
     } else {
       assign_stmts_match_expr = pkb->GetAllAssignStmtsThatMatches(rhs_param.pattern_expr.token_list);
     }
+    // the pattern column was moved into the table
+    const Column& pattern_column = result_table.GetColumn(pattern_param);
     for (int i = 0; i < result_table.GetHeight(); i++) {
+      utils::Cancellation::Check();
       // if the assignment statement in the current ResultTable fulfills the expression
-      if (assign_stmts_match_expr.find(pattern_valid.at(i).stmt) != assign_stmts_match_expr.end()) {
+      if (assign_stmts_match_expr.find(pattern_column.at(i).stmt) != assign_stmts_match_expr.end()) {
         updated_table.AddRow(result_table.GetRowAt(i));
       }
     }
   } else {
     throw std::runtime_error("RHS param in pattern clause cannot be handled");
   }
-  database.push_back(updated_table);
-  return updated_table.GetHeight() != 0;
+  int height = updated_table.GetHeight();
+  QueryProfiler::SetClauseRows(height);
+  database.push_back(std::move(updated_table));
+  return height != 0;
 }
 
 bool QueryEvaluator::EvaluateWithClause(WithClause& clause, Database& database) {
@@ -442,43 +792,38 @@ bool QueryEvaluator::EvaluateWithClause(WithClause& clause, Database& database)
     return false;
   }
 
-  ClauseParam lhs_param = clause.GetLHSParam();
-  ClauseParam rhs_param = clause.GetRHSParam();
+  const ClauseParam& lhs_param = clause.GetLHSParam();
+  const ClauseParam& rhs_param = clause.GetRHSParam();
   AttributeType lhs_attr_type = clause.GetLHSAttributeType();
   AttributeType rhs_attr_type = clause.GetRHSAttributeType();
+  QueryProfiler::SetClauseStrategy(ATTRIBUTE_COMPARISON_STRATEGY);
   if (IsSimilarParams(lhs_param, rhs_param)) {
     Column param_col = ConvertClauseParamToColumn(lhs_param, DesignEntityType::WILDCARD, database);
     return !param_col.empty();
   }
 
-  // A wildcard design entity type is used as a placeholder here since there aren't actually wildcards in with clauses.
-  ResultTable clause_param_table = ConvertClauseToResultTable(lhs_param, rhs_param, DesignEntityType::WILDCARD,
-                                                              database);
-  int table_height = clause_param_table.GetHeight();
-  Column& lhs_col = clause_param_table.GetColumn(LEFT_KEY);
-  Column& rhs_col = clause_param_table.GetColumn(RIGHT_KEY);
   Column lhs_valid;
   Column rhs_valid;
-
-  for (int i = 0; i < table_height; i++) {
-    TableElement lhs_attr = ConvertToAttribute(lhs_col.at(i), lhs_param, lhs_attr_type);
-    TableElement rhs_attr = ConvertToAttribute(rhs_col.at(i), rhs_param, rhs_attr_type);
-    if (lhs_attr == rhs_attr) {
-      lhs_valid.push_back(lhs_col.at(i));
-      rhs_valid.push_back(rhs_col.at(i));
-    }
-  }
+  // A wildcard design entity type is used as a placeholder here since there aren't actually wildcards in with clauses.
+  FilterClauseParamPairs(lhs_param, rhs_param, DesignEntityType::WILDCARD, database,
+                         [&](const TableElement& lhs_elem, const TableElement& rhs_elem) {
+                           return ConvertToAttribute(lhs_elem, lhs_param, lhs_attr_type) ==
+                                  ConvertToAttribute(rhs_elem, rhs_param, rhs_attr_type);
+                         },
+                         lhs_valid, rhs_valid);
 
   ResultTable result_table = GenerateTable(lhs_param, rhs_param, lhs_valid, rhs_valid);
   if (result_table.IsEmpty()) {
     // No design entities were involved in the process
     return !lhs_valid.empty() || !rhs_valid.empty();
   } else {
-    database.push_back(result_table);
-    return result_table.GetHeight() != 0;
+    int height = result_table.GetHeight();
+    QueryProfiler::SetClauseRows(height);
+    database.push_back(std::move(result_table));
+    return height != 0;
   }
 }
-bool QueryEvaluator::IsSimilarParams(ClauseParam& lhs_param, ClauseParam& rhs_param) {
+bool QueryEvaluator::IsSimilarParams(const ClauseParam& lhs_param, const ClauseParam& rhs_param) {
   if (lhs_param == rhs_param) {
     if (lhs_param.param_type != ClauseParamType::WILDCARD) {
       return true;
@@ -487,7 +832,7 @@ bool QueryEvaluator::IsSimilarParams(ClauseParam& lhs_param, ClauseParam& rhs_pa
   return false;
 }
 
-bool QueryEvaluator::IsWildcardParams(ClauseParam& lhs_param, ClauseParam& rhs_param) {
+bool QueryEvaluator::IsWildcardParams(const ClauseParam& lhs_param, const ClauseParam& rhs_param) {
   if (lhs_param.param_type == ClauseParamType::WILDCARD && rhs_param.param_type == ClauseParamType::WILDCARD) {
     return true;
   }
@@ -496,27 +841,29 @@ bool QueryEvaluator::IsWildcardParams(ClauseParam& lhs_param, ClauseParam& rhs_p
 
 /*
  * Generates a Table based on their params and their respective columns. The columns are only added to the table if
- * their corresponding parameter is a DesignEntity with a synonym.
+ * their corresponding parameter is a DesignEntity with a synonym, and are moved into it.
  */
-ResultTable QueryEvaluator::GenerateTable(ClauseParam& lhs_param, ClauseParam& rhs_param, Column& lhs_column, Column& rhs_column) {
+ResultTable QueryEvaluator::GenerateTable(const ClauseParam& lhs_param, const ClauseParam& rhs_param, Column& lhs_column, Column& rhs_column) {
   ClauseParamType lhs_type = lhs_param.param_type;
   ClauseParamType rhs_type = rhs_param.param_type;
   ResultTable new_table;
   if (lhs_type == ClauseParamType::DESIGN_ENTITY && rhs_type == ClauseParamType::DESIGN_ENTITY) {
-    new_table.AddColumn(lhs_param.design_entity.GetSynonym(), lhs_column);
-    new_table.AddColumn(rhs_param.design_entity.GetSynonym(), rhs_column);
+    new_table.AddColumn(lhs_param.design_entity.GetSynonym(), std::move(lhs_column));
+    new_table.AddColumn(rhs_param.design_entity.GetSynonym(), std::move(rhs_column));
   } else if (lhs_type == ClauseParamType::DESIGN_ENTITY) {
-    lhs_column = QueryEvaluatorUtils::RemoveDuplicateTableElements(lhs_column);
-    new_table.AddColumn(lhs_param.design_entity.GetSynonym(), lhs_column);
+    new_table.AddColumn(lhs_param.design_entity.GetSynonym(), QueryEvaluatorUtils::RemoveDuplicateTableElements(lhs_column));
   } else if (rhs_type == ClauseParamType::DESIGN_ENTITY) {
-    rhs_column = QueryEvaluatorUtils::RemoveDuplicateTableElements(rhs_column);
-    new_table.AddColumn(rhs_param.design_entity.GetSynonym(), rhs_column);
+    new_table.AddColumn(rhs_param.design_entity.GetSynonym(), QueryEvaluatorUtils::RemoveDuplicateTableElements(rhs_column));
   }
   return new_table;
 }
 
-Column QueryEvaluator::GetSmallestDesignEntitySet(DesignEntity& de, ResultTable& result_table) {
-  std::string synonym = de.GetSynonym();
+/*
+ * The column of a design entity in a result table, or its column in the PKB if it is in none. Either outlives the
+ * query, as long as the table is not changed.
+ */
+const Column& QueryEvaluator::GetSmallestDesignEntitySet(const DesignEntity& de, ResultTable& result_table) {
+  const std::string& synonym = de.GetSynonym();
   if (result_table.Contains(synonym)) {
     return result_table.GetColumn(synonym);
   } else {
@@ -524,8 +871,8 @@ Column QueryEvaluator::GetSmallestDesignEntitySet(DesignEntity& de, ResultTable&
   }
 }
 
-Column QueryEvaluator::GetSmallestDesignEntitySet(DesignEntity& de, Database& database) {
-  std::string synonym = de.GetSynonym();
+const Column& QueryEvaluator::GetSmallestDesignEntitySet(const DesignEntity& de, Database& database) {
+  const std::string& synonym = de.GetSynonym();
   for (auto iter = database.rbegin(); iter != database.rend(); ++iter) {
     // Iterate through database from the back to search for ResultTables with the synonym.
     ResultTable& table = *iter;
@@ -537,7 +884,7 @@ Column QueryEvaluator::GetSmallestDesignEntitySet(DesignEntity& de, Database& da
   return GetDesignEntityTable(de.GetDesignEntityType());
 }
 
-TableElement QueryEvaluator::ConvertToAttribute(TableElement& elem, ClauseParam& param, AttributeType attr) {
+TableElement QueryEvaluator::ConvertToAttribute(const TableElement& elem, const ClauseParam& param, AttributeType attr) {
   if (param.param_type != ClauseParamType::DESIGN_ENTITY) {
     // Integers and names should remain as it is.
     return elem;
@@ -547,7 +894,7 @@ TableElement QueryEvaluator::ConvertToAttribute(TableElement& elem, ClauseParam&
   return ConvertToAttribute(elem, de_type, attr);
 }
 
-TableElement QueryEvaluator::ConvertToAttribute(TableElement& elem, DesignEntityType de_type, AttributeType attr) {
+TableElement QueryEvaluator::ConvertToAttribute(const TableElement& elem, DesignEntityType de_type, AttributeType attr) {
   if (attr == AttributeType::STMT_NO || attr == AttributeType::VALUE ||
       attr == AttributeType::INTEGER || attr == AttributeType::NAME ||
       attr == AttributeType::NONE) {
@@ -559,17 +906,20 @@ TableElement QueryEvaluator::ConvertToAttribute(TableElement& elem, DesignEntity
     case DesignEntityType::VARIABLE:
       return elem;
     case DesignEntityType::CALL:
+      QueryProfiler::CountPkbProbes(1);
       return TableElement(pkb->GetCallsProcName(elem.stmt));
     case DesignEntityType::PRINT:
+      QueryProfiler::CountPkbProbes(1);
       return TableElement(pkb->GetPrintVarName(elem.stmt));
     case DesignEntityType::READ:
+      QueryProfiler::CountPkbProbes(1);
       return TableElement(pkb->GetReadVarName(elem.stmt));
     default:
       throw std::runtime_error("There should not be other design entity types with AttributeType NAME");
   }
 }
 
-Column QueryEvaluator::ConvertClauseParamToColumn(ClauseParam& clause_param, DesignEntityType wildcard_type, Database& database) {
+Column QueryEvaluator::ConvertClauseParamToColumn(const ClauseParam& clause_param, DesignEntityType wildcard_type, Database& database) {
   switch (clause_param.param_type) {
     case ClauseParamType::DESIGN_ENTITY: {
       return GetSmallestDesignEntitySet(clause_param.design_entity, database);
@@ -584,7 +934,7 @@ Column QueryEvaluator::ConvertClauseParamToColumn(ClauseParam& clause_param, Des
     }
     case ClauseParamType::NAME: {
       Column name_result;
-      name_result.push_back(TableElement({clause_param.var_proc_name}));
+      name_result.push_back(TableElement(clause_param.var_proc_name));
       return name_result;
     }
     case ClauseParamType::EXPR: {
@@ -596,50 +946,93 @@ Column QueryEvaluator::ConvertClauseParamToColumn(ClauseParam& clause_param, Des
 }
 
 /*
- * If there already exists a table with both params inside, we return the two columns.
- * If not, we will retrieve each column individually (either from table or PKB) and cross product the two columns.
+ * Finds the pairs of the params for which the predicate holds. If there already exists a table with both params
+ * inside, its pairs are checked and the table is taken out of the database. If not, we will retrieve each column
+ * individually (either from table or PKB) and check their cross product, which is materialised only if it has no
+ * more rows than the streaming threshold of QueryMemory, and is otherwise checked in a nested loop over the columns.
  */
-ResultTable QueryEvaluator::ConvertClauseToResultTable(ClauseParam& lhs_param, ClauseParam& rhs_param, DesignEntityType wildcard_type, Database& database) {
+void QueryEvaluator::FilterClauseParamPairs(const ClauseParam& lhs_param, const ClauseParam& rhs_param, DesignEntityType wildcard_type,
+                                            Database& database,
+                                            const std::function<bool(const TableElement&, const TableElement&)>& predicate,
+                                            Column& lhs_valid, Column& rhs_valid) {
   Column lhs_col;
   Column rhs_col;
   ResultTable final_table;
+  bool has_table = false;
   for (int i = 0; i < database.size(); i++) {
     ResultTable& table = database.at(i);
     if (table.Contains(lhs_param) && table.Contains(rhs_param)) {
-      lhs_col = table.GetColumn(lhs_param);
-      rhs_col = table.GetColumn(rhs_param);
-      final_table.AddColumn(LEFT_KEY, lhs_col);
-      final_table.AddColumn(RIGHT_KEY, rhs_col);
+      // the table is taken out of the database, so its columns are moved out of it, unless both params share one
+      rhs_col = IsSimilarParams(lhs_param, rhs_param) ? table.GetColumn(rhs_param)
+                                                      : std::move(table.GetColumn(rhs_param));
+      lhs_col = std::move(table.GetColumn(lhs_param));
       database.erase(database.begin() + i);
-      return final_table;
+      has_table = true;
+      break;
     }
   }
 
-  lhs_col = ConvertClauseParamToColumn(lhs_param, wildcard_type, database);
-  rhs_col = ConvertClauseParamToColumn(rhs_param, wildcard_type, database);
-  if (IsSimilarParams(lhs_param, rhs_param)) {
-    // This is specially for Next and Affects where it is possible to have similar parameters
-    final_table.AddColumn(LEFT_KEY, lhs_col);
-    final_table.AddColumn(RIGHT_KEY, rhs_col);
-    return final_table;
+  if (!has_table && IsSimilarParams(lhs_param, rhs_param)) {
+    lhs_col = ConvertClauseParamToColumn(lhs_param, wildcard_type, database);
+    rhs_col = lhs_col;
+  } else if (!has_table) {
+    // Since only one column is being retrieved, it's converted to a set to remove any duplicate elements
+    // resulting from previous cross products
+    lhs_col = QueryEvaluatorUtils::RemoveDuplicateTableElements(ConvertClauseParamToColumn(lhs_param, wildcard_type, database));
+    rhs_col = QueryEvaluatorUtils::RemoveDuplicateTableElements(ConvertClauseParamToColumn(rhs_param, wildcard_type, database));
+    if (static_cast<size_t>(lhs_col.size()) * rhs_col.size() > QueryMemory::GetStreamingRows()) {
+      QueryProfiler::SetClauseStrategy(NESTED_LOOP_STRATEGY);
+      // the number of valid pairs is only known once every pair is checked, so their bytes are reserved as they grow
+      size_t reserved_rows = 0;
+      for (auto& lhs_elem : lhs_col) {
+        utils::Cancellation::Check(rhs_col.size());
+        for (auto& rhs_elem : rhs_col) {
+          if (predicate(lhs_elem, rhs_elem)) {
+            if (lhs_valid.size() >= reserved_rows) {
+              reserved_rows = std::max<size_t>(2 * lhs_valid.size(), 1);
+              QueryMemory::Reserve(QueryMemory::EstimateBytes(reserved_rows, 2));
+              lhs_valid.reserve(reserved_rows);
+              rhs_valid.reserve(reserved_rows);
+            }
+            lhs_valid.push_back(lhs_elem);
+            rhs_valid.push_back(rhs_elem);
+          }
+        }
+      }
+      return;
+    }
+    ResultTable lhs_table;
+    ResultTable rhs_table;
+    lhs_table.AddColumn(LEFT_KEY, std::move(lhs_col));
+    rhs_table.AddColumn(RIGHT_KEY, std::move(rhs_col));
+    final_table = lhs_table.CrossTable(rhs_table);
+    lhs_col = std::move(final_table.GetColumn(LEFT_KEY));
+    rhs_col = std::move(final_table.GetColumn(RIGHT_KEY));
   }
-  // Since only one column is being retrieved, it's converted to a set to remove any duplicate elements
-  // resulting from previous cross products
-  lhs_col = QueryEvaluatorUtils::RemoveDuplicateTableElements(lhs_col);
-  rhs_col = QueryEvaluatorUtils::RemoveDuplicateTableElements(rhs_col);
-  ResultTable lhs_table;
-  ResultTable rhs_table;
-  lhs_table.AddColumn(LEFT_KEY, lhs_col);
-  rhs_table.AddColumn(RIGHT_KEY, rhs_col);
-  final_table = lhs_table.CrossTable(rhs_table);
 
-  return final_table;
+  // similar params, which are possible for Next and Affects, are checked pairwise against themselves
+  for (size_t i = 0; i < lhs_col.size(); i++) {
+    utils::Cancellation::Check();
+    if (predicate(lhs_col.at(i), rhs_col.at(i))) {
+      lhs_valid.push_back(lhs_col.at(i));
+      rhs_valid.push_back(rhs_col.at(i));
+    }
+  }
 }
 
 /*
- * Gets the full set that corresponds to the DesignEntity from the PKB and returns them as a Column.
+ * Gets the full set that corresponds to the DesignEntity from the PKB and returns them as a Column. The column is read
+ * once per query, or once per frozen PKB, and shared by every clause asking for it.
  */
-Column QueryEvaluator::GetDesignEntityTable(DesignEntityType entity) {
+const Column& QueryEvaluator::GetDesignEntityTable(DesignEntityType entity) {
+  // columns are never erased, so the one returned stays valid while other evaluators add theirs
+  std::lock_guard<std::mutex> lock(design_entity_tables->mutex);
+  std::map<DesignEntityType, Column>& columns = design_entity_tables->columns;
+  auto iter = columns.find(entity);
+  if (iter != columns.end()) {
+    return iter->second;
+  }
+  QueryProfiler::CountPkbProbes(1);
   Column design_entity_col;
   switch (entity) {
     case DesignEntityType::STMT:
@@ -676,7 +1069,7 @@ Column QueryEvaluator::GetDesignEntityTable(DesignEntityType entity) {
     default:
       throw std::runtime_error("Invalid design entity");
   }
-  return design_entity_col;
+  return columns.emplace(entity, std::move(design_entity_col)).first->second;
 }
 
 }  // namespace query_processor
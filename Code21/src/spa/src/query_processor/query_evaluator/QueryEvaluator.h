@@ -1,10 +1,16 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "QueryProfiler.h"
 #include "ResultTable.h"
 #include "pkb/PKB.h"
 #include "query_processor/commons/query/Query.h"
@@ -17,31 +23,60 @@
 namespace query_processor {
 typedef std::vector<ResultTable> Database;
 
+/*
+ * Evaluates the clauses of a query against the PKB it was constructed with, so that evaluations on different threads,
+ * or of different PKBs, never share any state other than the columns of the design entities of a frozen PKB.
+ */
 class QueryEvaluator {
- protected:
-  static PKB* pkb;
-
  public:
-  static QueryResult EvaluateQuery(Query, PKB*, bool);
-  static void SetPKB(PKB*);
-  static bool EvaluatePatternClause(PatternClause&, Database&);
-  static bool EvaluateSuchThatClause(SuchThatClause&, Database&);
-  static bool EvaluateWithClause(WithClause&, Database&);
+  explicit QueryEvaluator(PKB*);
+  static QueryResult EvaluateQuery(Query&, PKB*, bool);
+  static Query PlanQuery(Query);
+  static QueryResult EvaluatePlannedQuery(Query&, PKB*, bool);
+  static void ExplainPlannedQuery(Query&, PKB*, bool, QueryProfile&);
+  static bool EvaluateSharedClause(Clause&, PKB*);
+  bool EvaluatePatternClause(PatternClause&, Database&);
+  bool EvaluateSuchThatClause(SuchThatClause&, Database&);
+  bool EvaluateWithClause(WithClause&, Database&);
 
  private:
-  static QueryResult SelectTuple(std::vector<SelectedEntity>&, Database&);
-  static bool EvaluateConditionalPatternClause(PatternClause&, Database&);
-  static bool EvaluateSuchThatWildcardClause(SuchThatClause&);
-  static Column GetSmallestDesignEntitySet(DesignEntity&, ResultTable&);
-  static Column GetSmallestDesignEntitySet(DesignEntity&, Database&);
-  static Column GetDesignEntityTable(DesignEntityType);
-  static Column ConvertClauseParamToColumn(ClauseParam&, DesignEntityType, Database&);
-  static TableElement ConvertToAttribute(TableElement&, ClauseParam&, AttributeType);
-  static TableElement ConvertToAttribute(TableElement&, DesignEntityType, AttributeType);
-  static bool IsSimilarParams(ClauseParam&, ClauseParam&);
-  static bool IsWildcardParams(ClauseParam&, ClauseParam&);
-  static bool ApplyPKBFunction(TableElement&, TableElement&, DesignAbstraction);
-  static ResultTable GenerateTable(ClauseParam&, ClauseParam&, Column&, Column&);
-  static ResultTable ConvertClauseToResultTable(ClauseParam&, ClauseParam&, DesignEntityType, Database&);
+  // the columns of the design entities read from a PKB, shared by every evaluator of the same frozen PKB
+  struct DesignEntityTables {
+    std::mutex mutex;
+    std::map<DesignEntityType, Column> columns;
+  };
+  static const size_t kMaxFrozenDesignEntityTables = 4;
+  static std::mutex frozen_design_entity_tables_mutex;
+  static std::map<uint64_t, std::shared_ptr<DesignEntityTables>> frozen_design_entity_tables;
+
+  PKB* pkb;
+  std::shared_ptr<DesignEntityTables> design_entity_tables;
+
+  QueryResult EvaluatePlannedQuery(Query&, bool);
+  void ExplainPlannedQuery(Query&, bool, QueryProfile&);
+  bool EvaluateClause(Clause&, Database&);
+  bool EvaluateProfiledClause(Clause&, Database&);
+  size_t EstimateClauseRows(Clause&, Database&);
+  static std::string PredictClauseStrategy(Clause&, std::vector<std::vector<DesignEntity>>&);
+  static std::string GetMergeStrategy(bool);
+  QueryResult SelectTuple(std::vector<SelectedEntity>&, Database&);
+  bool EvaluateUncachedPatternClause(PatternClause&, Database&);
+  bool EvaluateConditionalPatternClause(PatternClause&, Database&);
+  bool EvaluateSuchThatWildcardClause(SuchThatClause&);
+  const Column& GetSmallestDesignEntitySet(const DesignEntity&, ResultTable&);
+  const Column& GetSmallestDesignEntitySet(const DesignEntity&, Database&);
+  const Column& GetDesignEntityTable(DesignEntityType);
+  Column ConvertClauseParamToColumn(const ClauseParam&, DesignEntityType, Database&);
+  TableElement ConvertToAttribute(const TableElement&, const ClauseParam&, AttributeType);
+  TableElement ConvertToAttribute(const TableElement&, DesignEntityType, AttributeType);
+  static bool IsSimilarParams(const ClauseParam&, const ClauseParam&);
+  static bool IsWildcardParams(const ClauseParam&, const ClauseParam&);
+  bool ApplyPKBFunction(const TableElement&, const TableElement&, DesignAbstraction);
+  const CompressedBitmap* GetRelationRow(const TableElement&, DesignAbstraction);
+  void EvaluateSuchThatPairs(const ClauseParam&, const ClauseParam&, DesignAbstraction, Database&, Column&, Column&);
+  bool IntersectRelationRows(const ClauseParam&, const ClauseParam&, DesignAbstraction, Database&, Column&, Column&);
+  static ResultTable GenerateTable(const ClauseParam&, const ClauseParam&, Column&, Column&);
+  void FilterClauseParamPairs(const ClauseParam&, const ClauseParam&, DesignEntityType, Database&,
+                              const std::function<bool(const TableElement&, const TableElement&)>&, Column&, Column&);
 };
 }  // namespace query_processor
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "QueryMemory.h"
+
+#include <algorithm>
+
+#include "ResultTable.h"
+
+namespace query_processor {
+
+const size_t QueryMemory::kDefaultStreamingRows;
+thread_local size_t QueryMemory::held_bytes = 0;
+thread_local size_t QueryMemory::peak_bytes = 0;
+std::atomic<size_t> QueryMemory::max_query_bytes(0);
+std::atomic<size_t> QueryMemory::streaming_rows(QueryMemory::kDefaultStreamingRows);
+
+void QueryMemory::SetLimits(size_t new_max_query_bytes, size_t new_streaming_rows) {
+  max_query_bytes = new_max_query_bytes;
+  streaming_rows = new_streaming_rows;
+}
+
+size_t QueryMemory::GetMaxQueryBytes() {
+  return max_query_bytes;
+}
+
+size_t QueryMemory::GetStreamingRows() {
+  return streaming_rows;
+}
+
+size_t QueryMemory::EstimateBytes(size_t rows, size_t columns) {
+  return rows * columns * sizeof(TableElement);
+}
+
+QueryMemory::Scope::Scope() : previous_peak_bytes(peak_bytes), start_bytes(held_bytes) {
+  peak_bytes = held_bytes;
+}
+
+QueryMemory::Scope::~Scope() {
+  peak_bytes = std::max(previous_peak_bytes, peak_bytes);
+}
+
+size_t QueryMemory::Scope::GetPeakBytes() const {
+  return peak_bytes - start_bytes;
+}
+
+QueryMemory::Reservation::Reservation() : held_bytes(0) {}
+
+QueryMemory::Reservation::~Reservation() {
+  QueryMemory::held_bytes -= held_bytes;
+}
+
+void QueryMemory::Reservation::Resize(size_t bytes) {
+  QueryMemory::held_bytes -= held_bytes;
+  held_bytes = bytes;
+  QueryMemory::held_bytes += held_bytes;
+  Reserve(0);
+}
+
+void QueryMemory::Reserve(size_t bytes) {
+  size_t total_bytes = held_bytes + bytes;
+  size_t max_bytes = max_query_bytes;
+  if (max_bytes != 0 && total_bytes > max_bytes) {
+    throw MemoryLimitError("Query needs " + std::to_string(total_bytes) + " bytes of intermediate results, past its " +
+                           "limit of " + std::to_string(max_bytes) + " bytes");
+  }
+  peak_bytes = std::max(peak_bytes, total_bytes);
+}
+
+size_t QueryMemory::GetHeldBytes() {
+  return held_bytes;
+}
+
+}  // namespace query_processor
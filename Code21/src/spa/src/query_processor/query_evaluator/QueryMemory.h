@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string>
+
+namespace query_processor {
+
+// Thrown when a query would hold more intermediate results than its memory limit. Like a utils::TimeoutError it is
+// not a runtime_error, so it is not mistaken for a semantic error of the query.
+class MemoryLimitError : virtual public std::exception {
+ protected:
+  std::string error_message;
+
+ public:
+  explicit MemoryLimitError(const std::string& msg) : error_message(msg) {}
+
+  virtual ~MemoryLimitError() noexcept {}
+
+  virtual const char* what() const throw() {
+    return error_message.c_str();
+  }
+};
+
+/*
+  Accounts for the intermediate results of the query evaluated on the current thread, i.e. the result tables it holds
+  and the tables it materialises on top of them, so that a single cross product can not take the memory of the whole
+  process.
+
+  Before a table is materialised, its size is reserved on top of the bytes held by the query. The highest total is the
+  peak of the query, and a total past the limit stops the query with a MemoryLimitError. As a worker thread evaluates
+  one query at a time, the limit caps the intermediate results of each worker. Clauses whose pairs would take more
+  than the streaming threshold in rows are checked pair by pair instead of from a materialised cross product.
+*/
+class QueryMemory {
+ public:
+  static const size_t kDefaultStreamingRows = 1 << 16;
+
+  // a limit of 0 bytes leaves queries unlimited
+  static void SetLimits(size_t max_query_bytes, size_t streaming_rows);
+  static size_t GetMaxQueryBytes();
+  static size_t GetStreamingRows();
+
+  // the bytes of a table of rows by columns, not counting names too long to be stored in their elements
+  static size_t EstimateBytes(size_t rows, size_t columns);
+
+  // accounts for the query evaluated on the current thread until it is destroyed
+  class Scope {
+   public:
+    Scope();
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // the most bytes the query has held since the scope began
+    size_t GetPeakBytes() const;
+
+   private:
+    size_t previous_peak_bytes;
+    size_t start_bytes;
+  };
+
+  // bytes held on the current thread until it is destroyed, e.g. by the result tables of a query
+  class Reservation {
+   public:
+    Reservation();
+    ~Reservation();
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+
+    // holds bytes in place of those held so far, throwing a MemoryLimitError if they take the thread past its limit
+    void Resize(size_t bytes);
+
+   private:
+    size_t held_bytes;
+  };
+
+  // records bytes about to be materialised on top of those held, throwing a MemoryLimitError if they would take the
+  // thread past its limit
+  static void Reserve(size_t bytes);
+
+  static size_t GetHeldBytes();
+
+ private:
+  static thread_local size_t held_bytes;
+  static thread_local size_t peak_bytes;
+  static std::atomic<size_t> max_query_bytes;
+  static std::atomic<size_t> streaming_rows;
+};
+
+}  // namespace query_processor
@@ -0,0 +1,325 @@
+#include "QueryProfiler.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "query_processor/commons/query/clause/ClauseParam.h"
+#include "query_processor/commons/query/utils/QueryUtils.h"
+
+namespace query_processor {
+
+namespace {
+
+std::string EscapeJson(const std::string& text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char code[7];
+      std::snprintf(code, sizeof(code), "\\u%04x", c);
+      escaped += code;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void AppendField(const std::string& name, std::ostringstream& json) {
+  json << '"' << name << "\":";
+}
+
+void AppendString(const std::string& name, const std::string& value, std::ostringstream& json) {
+  AppendField(name, json);
+  json << '"' << EscapeJson(value) << '"';
+}
+
+std::string DescribeClauseParam(const ClauseParam& param) {
+  switch (param.param_type) {
+    case ClauseParamType::DESIGN_ENTITY: {
+      DesignEntity design_entity = param.design_entity;
+      return design_entity.GetSynonym();
+    }
+    case ClauseParamType::NAME:
+      return "\"" + param.var_proc_name + "\"";
+    case ClauseParamType::INDEX:
+      return std::to_string(param.statement_index);
+    case ClauseParamType::EXPR: {
+      std::string expression;
+      for (const source_processor::Token& token : param.pattern_expr.token_list.GetUnderlyingList()) {
+        expression += token.GetValue();
+      }
+      if (!param.pattern_expr.is_wild_card) {
+        return "\"" + expression + "\"";
+      }
+      return expression.empty() ? "_" : "_\"" + expression + "\"_";
+    }
+    default:
+      return "_";
+  }
+}
+
+std::string DescribeAttribute(const ClauseParam& param, AttributeType attribute_type) {
+  std::string attribute = QueryUtils::ConvertAttributeTypeToString(attribute_type);
+  std::string description = DescribeClauseParam(param);
+  return attribute.empty() ? description : description + "." + attribute;
+}
+
+size_t FindGroup(std::vector<size_t>& parents, size_t index) {
+  while (parents[index] != index) {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
+  }
+  return index;
+}
+
+}  // namespace
+
+std::string QueryProfile::ToJson() const {
+  bool is_profiled = mode == ProfileMode::PROFILE;
+  std::ostringstream json;
+  json.setf(std::ios::fixed);
+  json.precision(3);
+
+  json << '{';
+  AppendString("mode", is_profiled ? "PROFILE" : "EXPLAIN", json);
+  json << ',';
+  AppendField("plan_ms", json);
+  json << plan_ms;
+  if (is_profiled) {
+    json << ',';
+    AppendField("evaluation_ms", json);
+    json << evaluation_ms << ',';
+    AppendField("pkb_probes", json);
+    json << pkb_probes << ',';
+    AppendField("result_rows", json);
+    json << result_rows << ',';
+    AppendField("peak_bytes", json);
+    json << peak_bytes;
+  }
+
+  json << ',';
+  AppendField("clauses", json);
+  json << '[';
+  for (size_t i = 0; i < clauses.size(); i++) {
+    const ClauseProfile& clause = clauses[i];
+    json << (i == 0 ? "{" : ",{");
+    AppendString("clause", clause.clause, json);
+    json << ',';
+    AppendString("strategy", clause.strategy, json);
+    json << ',';
+    AppendField("estimated_rows", json);
+    json << clause.estimated_rows;
+    if (is_profiled) {
+      json << ',';
+      AppendField("actual_rows", json);
+      json << clause.actual_rows << ',';
+      AppendField("time_ms", json);
+      json << clause.time_ms << ',';
+      AppendField("pkb_probes", json);
+      json << clause.pkb_probes << ',';
+      AppendField("is_true", json);
+      json << (clause.is_true ? "true" : "false");
+    }
+    json << '}';
+  }
+  json << "],";
+
+  AppendField("groups", json);
+  json << '[';
+  for (size_t i = 0; i < groups.size(); i++) {
+    json << (i == 0 ? "[" : ",[");
+    for (size_t j = 0; j < groups[i].size(); j++) {
+      json << (j == 0 ? "" : ",") << groups[i][j];
+    }
+    json << ']';
+  }
+  json << "],";
+  AppendString("merge_strategy", merge_strategy, json);
+
+  if (is_profiled) {
+    json << ',';
+    AppendField("merges", json);
+    json << '[';
+    for (size_t i = 0; i < merges.size(); i++) {
+      const MergeProfile& merge = merges[i];
+      json << (i == 0 ? "{" : ",{");
+      AppendString("strategy", merge.strategy, json);
+      json << ',';
+      AppendField("left_rows", json);
+      json << merge.left_rows << ',';
+      AppendField("right_rows", json);
+      json << merge.right_rows << ',';
+      AppendField("estimated_rows", json);
+      json << merge.estimated_rows << ',';
+      AppendField("actual_rows", json);
+      json << merge.actual_rows << ',';
+      AppendField("time_ms", json);
+      json << merge.time_ms << '}';
+    }
+    json << ']';
+  }
+  json << '}';
+  return json.str();
+}
+
+thread_local QueryProfile* QueryProfiler::profile = nullptr;
+thread_local size_t QueryProfiler::pkb_probes = 0;
+thread_local size_t QueryProfiler::query_start_probes = 0;
+thread_local size_t QueryProfiler::clause_start_probes = 0;
+thread_local bool QueryProfiler::has_clause_rows = false;
+thread_local std::chrono::steady_clock::time_point QueryProfiler::query_start_time;
+thread_local std::chrono::steady_clock::time_point QueryProfiler::clause_start_time;
+
+void QueryProfiler::Start(QueryProfile* query_profile) {
+  profile = query_profile;
+  query_start_probes = pkb_probes;
+  query_start_time = std::chrono::steady_clock::now();
+}
+
+void QueryProfiler::Stop() {
+  if (profile == nullptr) {
+    return;
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - query_start_time;
+  profile->evaluation_ms = elapsed.count();
+  profile->pkb_probes = pkb_probes - query_start_probes;
+  profile = nullptr;
+}
+
+bool QueryProfiler::IsActive() {
+  return profile != nullptr;
+}
+
+void QueryProfiler::BeginClause(Clause& clause, size_t estimated_rows) {
+  if (profile == nullptr) {
+    return;
+  }
+  ClauseProfile clause_profile;
+  clause_profile.clause = DescribeClause(clause);
+  clause_profile.estimated_rows = estimated_rows;
+  profile->clauses.push_back(clause_profile);
+  has_clause_rows = false;
+  clause_start_probes = pkb_probes;
+  clause_start_time = std::chrono::steady_clock::now();
+}
+
+void QueryProfiler::SetClauseStrategy(const std::string& strategy) {
+  if (profile != nullptr && !profile->clauses.empty()) {
+    profile->clauses.back().strategy = strategy;
+  }
+}
+
+void QueryProfiler::SetClauseRows(size_t rows) {
+  if (profile != nullptr && !profile->clauses.empty()) {
+    profile->clauses.back().actual_rows = rows;
+    has_clause_rows = true;
+  }
+}
+
+void QueryProfiler::EndClause(bool is_true) {
+  if (profile == nullptr || profile->clauses.empty()) {
+    return;
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - clause_start_time;
+  ClauseProfile& clause_profile = profile->clauses.back();
+  clause_profile.time_ms = elapsed.count();
+  clause_profile.pkb_probes = pkb_probes - clause_start_probes;
+  clause_profile.is_true = is_true;
+  if (!has_clause_rows) {
+    clause_profile.actual_rows = is_true ? 1 : 0;
+  }
+}
+
+void QueryProfiler::SetMergeStrategy(const std::string& merge_strategy) {
+  if (profile != nullptr) {
+    profile->merge_strategy = merge_strategy;
+  }
+}
+
+void QueryProfiler::RecordMerge(const std::vector<std::string>& join_synonyms, size_t left_rows, size_t right_rows,
+                                size_t estimated_rows, size_t actual_rows, double time_ms) {
+  if (profile == nullptr) {
+    return;
+  }
+  MergeProfile merge_profile;
+  merge_profile.strategy = join_synonyms.empty() ? "cross product" : "hash join on ";
+  for (size_t i = 0; i < join_synonyms.size(); i++) {
+    merge_profile.strategy += (i == 0 ? "" : ", ") + join_synonyms[i];
+  }
+  merge_profile.left_rows = left_rows;
+  merge_profile.right_rows = right_rows;
+  merge_profile.estimated_rows = estimated_rows;
+  merge_profile.actual_rows = actual_rows;
+  merge_profile.time_ms = time_ms;
+  profile->merges.push_back(merge_profile);
+}
+
+std::string QueryProfiler::DescribeClause(Clause& clause) {
+  switch (clause.GetClauseType()) {
+    case ClauseType::SUCHTHAT: {
+      SuchThatClause& such_that_clause = clause.GetSuchThatClause();
+      return QueryUtils::ConvertDesignAbstractionToString(such_that_clause.GetDesignAbstraction()) + "(" +
+             DescribeClauseParam(such_that_clause.GetLHSParam()) + ", " +
+             DescribeClauseParam(such_that_clause.GetRHSParam()) + ")";
+    }
+    case ClauseType::PATTERN: {
+      PatternClause& pattern_clause = clause.GetPatternClause();
+      return "pattern " + DescribeClauseParam(ClauseParam(pattern_clause.GetDesignEntity())) + "(" +
+             DescribeClauseParam(pattern_clause.GetLHSParam()) + ", " +
+             DescribeClauseParam(pattern_clause.GetRHSParam()) + ")";
+    }
+    case ClauseType::WITH: {
+      WithClause& with_clause = clause.GetWithClause();
+      return "with " + DescribeAttribute(with_clause.GetLHSParam(), with_clause.GetLHSAttributeType()) + " = " +
+             DescribeAttribute(with_clause.GetRHSParam(), with_clause.GetRHSAttributeType());
+    }
+    default:
+      return "";
+  }
+}
+
+/*
+ * Groups the clauses by the synonyms they share, in the same way the QueryOptimizer groups their result tables
+ * before merging them. Clauses without synonyms have no table to merge, so they are in no group.
+ */
+std::vector<std::vector<size_t>> QueryProfiler::GroupClauses(std::vector<Clause>& clauses) {
+  std::vector<size_t> parents(clauses.size());
+  std::unordered_map<std::string, size_t> synonym_clauses;
+  std::vector<bool> has_synonyms(clauses.size(), false);
+  for (size_t i = 0; i < clauses.size(); i++) {
+    parents[i] = i;
+    for (DesignEntity& synonym : QueryUtils::GetClauseSynonyms(clauses[i])) {
+      has_synonyms[i] = true;
+      auto synonym_it = synonym_clauses.find(synonym.GetSynonym());
+      if (synonym_it == synonym_clauses.end()) {
+        synonym_clauses[synonym.GetSynonym()] = i;
+      } else {
+        parents[FindGroup(parents, i)] = FindGroup(parents, synonym_it->second);
+      }
+    }
+  }
+
+  // groups are in the order of their first clause
+  std::unordered_map<size_t, size_t> group_indexes;
+  std::vector<std::vector<size_t>> clause_groups;
+  for (size_t i = 0; i < clauses.size(); i++) {
+    if (!has_synonyms[i]) {
+      continue;
+    }
+    size_t group = FindGroup(parents, i);
+    if (group_indexes.find(group) == group_indexes.end()) {
+      group_indexes[group] = clause_groups.size();
+      clause_groups.push_back({});
+    }
+    clause_groups[group_indexes[group]].push_back(i);
+  }
+  return clause_groups;
+}
+
+}  // namespace query_processor
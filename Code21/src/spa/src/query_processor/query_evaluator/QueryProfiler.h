@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "query_processor/commons/query/clause/Clause.h"
+
+namespace query_processor {
+
+// EXPLAIN only plans a query, while PROFILE also evaluates it
+enum class ProfileMode {
+  EXPLAIN,
+  PROFILE
+};
+
+struct ClauseProfile {
+  std::string clause;
+  std::string strategy;        // how the clause is evaluated, e.g. "relation row intersection"
+  size_t estimated_rows = 0;   // the product of the domains of its synonyms when it is evaluated
+  size_t actual_rows = 0;      // the height of its result table, or 1 if it holds without one
+  double time_ms = 0;
+  size_t pkb_probes = 0;
+  bool is_true = false;
+};
+
+struct MergeProfile {
+  std::string strategy;  // "cross product", or the synonyms of a hash join
+  size_t left_rows = 0;
+  size_t right_rows = 0;
+  size_t estimated_rows = 0;
+  size_t actual_rows = 0;
+  double time_ms = 0;
+};
+
+// the plan of a query and, if it was profiled, what its evaluation did
+struct QueryProfile {
+  ProfileMode mode = ProfileMode::PROFILE;
+  std::vector<ClauseProfile> clauses;       // in the order they are evaluated
+  std::vector<std::vector<size_t>> groups;  // the indexes of the clauses whose tables are merged together
+  std::string merge_strategy;
+  std::vector<MergeProfile> merges;
+  double plan_ms = 0;
+  double evaluation_ms = 0;
+  size_t pkb_probes = 0;
+  size_t result_rows = 0;
+  size_t peak_bytes = 0;  // the most bytes of intermediate results held at once, as accounted by QueryMemory
+
+  // the profile as a JSON object. The fields only known after evaluation are left out of an EXPLAIN
+  std::string ToJson() const;
+};
+
+/*
+  Records the evaluation of a query into a QueryProfile for EXPLAIN and PROFILE.
+
+  Profiling is per thread: the QueryEvaluator and ResultTable report each clause and merge to the profile started on
+  their thread, and only estimate rows while one is started, so queries evaluated without a profile pay for no more
+  than the PKB probe counter.
+*/
+class QueryProfiler {
+ public:
+  // records into the profile until Stop, timing the evaluation and counting its PKB probes
+  static void Start(QueryProfile*);
+  static void Stop();
+  static bool IsActive();
+
+  static void CountPkbProbes(size_t count) { pkb_probes += count; }
+
+  static void BeginClause(Clause&, size_t estimated_rows);
+  static void SetClauseStrategy(const std::string&);
+  static void SetClauseRows(size_t);
+  static void EndClause(bool is_true);
+  static void SetMergeStrategy(const std::string&);
+  static void RecordMerge(const std::vector<std::string>& join_synonyms, size_t left_rows, size_t right_rows,
+                          size_t estimated_rows, size_t actual_rows, double time_ms);
+
+  // the clause as it would be written in a query, e.g. "pattern a(v, _"x"_)"
+  static std::string DescribeClause(Clause&);
+
+  // the clauses connected by shared synonyms, whose result tables the QueryOptimizer merges together
+  static std::vector<std::vector<size_t>> GroupClauses(std::vector<Clause>&);
+
+ private:
+  static thread_local QueryProfile* profile;
+  static thread_local size_t pkb_probes;
+  static thread_local size_t query_start_probes;
+  static thread_local size_t clause_start_probes;
+  static thread_local bool has_clause_rows;
+  static thread_local std::chrono::steady_clock::time_point query_start_time;
+  static thread_local std::chrono::steady_clock::time_point clause_start_time;
+};
+
+}  // namespace query_processor
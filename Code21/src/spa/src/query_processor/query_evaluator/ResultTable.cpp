@@ -1,11 +1,61 @@
 #include "ResultTable.h"
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
-#include <map>
+#include <iterator>
+#include <utility>
+#include <vector>
 #include <stdexcept>
 
+#include "query_processor/query_evaluator/QueryMemory.h"
+#include "query_processor/query_evaluator/QueryProfiler.h"
+#include "utils/Arena.h"
+#include "utils/Cancellation.h"
+
 namespace query_processor {
 
+namespace {
+
+typedef std::vector<std::pair<const Column*, Column*>> ColumnMapping;
+
+// pairs the columns of a table with the columns of the same synonyms in a joined table, leaving out the synonyms of
+// another table whose columns are taken instead
+ColumnMapping MapColumns(ResultTable& from, ResultTable& to, ResultTable* taken_from) {
+  ColumnMapping column_mapping;
+  for (auto& column : from.GetTable()) {
+    if (taken_from == nullptr || !taken_from->Contains(column.first)) {
+      column_mapping.push_back({&column.second, &to.GetColumn(column.first)});
+    }
+  }
+  return column_mapping;
+}
+
+// reserves the bytes of a join before any of its rows is materialised, and room for them in its columns
+void ReserveJoin(ResultTable& joined_table, size_t joined_height) {
+  QueryMemory::Reserve(QueryMemory::EstimateBytes(joined_height, joined_table.GetSize()));
+  for (auto& column : joined_table.GetTable()) {
+    column.second.reserve(joined_height);
+  }
+}
+
+void AppendRow(const ColumnMapping& column_mapping, int index) {
+  for (auto& columns : column_mapping) {
+    columns.second->push_back((*columns.first)[index]);
+  }
+}
+
+size_t CountDistinctElements(Column& column) {
+  std::hash<std::string> hash_func;
+  std::unordered_set<size_t> keys;
+  for (TableElement& elem : column) {
+    keys.insert(elem.type == QueryResultType::STMTS ? elem.stmt : hash_func(elem.name));
+  }
+  return keys.size();
+}
+
+}  // namespace
+
 ResultTable::ResultTable() = default;
 
 ResultTable::ResultTable(std::unordered_set<std::string> synonyms) {
@@ -22,7 +72,7 @@ Column& ResultTable::GetColumn(const std::string& synonym) {
   return columns[synonym];
 }
 
-Column& ResultTable::GetColumn(ClauseParam& clause_param) {
+Column& ResultTable::GetColumn(const ClauseParam& clause_param) {
   switch (clause_param.param_type) {
     case ClauseParamType::DESIGN_ENTITY:
       return this->GetColumn(clause_param.design_entity.GetSynonym());
@@ -50,30 +100,38 @@ int ResultTable::GetHeight() {
   }
   return 0;
 }
+
+size_t ResultTable::CountBytes() {
+  return QueryMemory::EstimateBytes(this->GetHeight(), this->GetSize());
+}
+
 bool ResultTable::Contains(const std::string& synonym) {
   return columns.find(synonym) != columns.end();
 }
 
-bool ResultTable::Contains(ClauseParam& clause) {
+bool ResultTable::Contains(const ClauseParam& clause) {
   if (clause.param_type != ClauseParamType::DESIGN_ENTITY) {
     return false;
   }
   if (clause.design_entity.GetDesignEntityType() == DesignEntityType::WILDCARD) {
     return false;
   }
-  std::string synonym = clause.design_entity.GetSynonym();
-  return this->Contains(synonym);
+  return this->Contains(clause.design_entity.GetSynonym());
+}
+
+bool ResultTable::AddColumn(const std::string& synonym, const Column& data) {
+  return AddColumn(synonym, Column(data));
 }
 
-bool ResultTable::AddColumn(const std::string& synonym, Column& data) {
+bool ResultTable::AddColumn(const std::string& synonym, Column&& data) {
   if (!this->IsEmpty() && (data.size() != this->GetHeight())) {
     throw std::runtime_error("Column not the same height as rest of the table");
   }
-  columns[synonym] = data;
+  columns[synonym] = std::move(data);
   return true;
 }
 
-bool ResultTable::AddRow(const std::unordered_map<std::string, TableElement>& row_data) {
+bool ResultTable::AddRow(const Row& row_data) {
   if (row_data.size() != columns.size()) {
     throw std::runtime_error("Row size and table size does not match.");
   }
@@ -116,18 +174,46 @@ std::unordered_map<std::string, Column>& ResultTable::GetTable() {
 
 ResultTable ResultTable::MergeTable(ResultTable& other) {
   std::vector<std::string> intersecting_synonyms = this->FindIntersectingHeaders(other);
+  if (!QueryProfiler::IsActive() || this->IsEmpty() || other.IsEmpty()) {
+    return JoinTable(other, intersecting_synonyms);
+  }
+
+  size_t estimated_height = EstimateJoinHeight(other, intersecting_synonyms);
+  auto start_time = std::chrono::steady_clock::now();
+  ResultTable merged_table = JoinTable(other, intersecting_synonyms);
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  QueryProfiler::RecordMerge(intersecting_synonyms, this->GetHeight(), other.GetHeight(), estimated_height,
+                             merged_table.GetHeight(), elapsed.count());
+  return merged_table;
+}
+
+ResultTable ResultTable::JoinTable(ResultTable& other, const std::vector<std::string>& intersecting_synonyms) {
   if (intersecting_synonyms.empty()) {
     return this->CrossTable(other);
   }
-  if (intersecting_synonyms.size() == 1) {
-    return InnerJoin(other, intersecting_synonyms.front());
+  // the joins count their height before materialising any row, so they are never materialised past the limit
+  return intersecting_synonyms.size() == 1 ? InnerJoin(other, intersecting_synonyms.front())
+                                           : InnerJoin(other, intersecting_synonyms);
+}
+
+/*
+ * Estimates the height of a join by assuming the values of the first synonym it is on are spread evenly, so that each
+ * row matches the rows of the other table with the same value.
+ */
+size_t ResultTable::EstimateJoinHeight(ResultTable& other, const std::vector<std::string>& intersecting_synonyms) {
+  size_t cross_height = static_cast<size_t>(this->GetHeight()) * other.GetHeight();
+  if (intersecting_synonyms.empty() || cross_height == 0) {
+    return cross_height;
   }
-  return InnerJoin(other, intersecting_synonyms);
+  const std::string& synonym = intersecting_synonyms.front();
+  size_t distinct_elements = std::max(CountDistinctElements(this->GetColumn(synonym)),
+                                      CountDistinctElements(other.GetColumn(synonym)));
+  return cross_height / distinct_elements;
 }
 
-ResultTable ResultTable::MergeColumn(std::string header, Column& other_col) {
+ResultTable ResultTable::MergeColumn(const std::string& header, Column other_col) {
   ResultTable col_table;
-  col_table.AddColumn(header, other_col);
+  col_table.AddColumn(header, std::move(other_col));
   return this->MergeTable(col_table);
 }
 ResultTable ResultTable::CrossTable(ResultTable& other) {
@@ -143,27 +229,31 @@ ResultTable ResultTable::CrossTable(ResultTable& other) {
   ResultTable new_table;
   int lhs_height = this->GetHeight();
   int rhs_height = other.GetHeight();
-  int new_height = lhs_height * rhs_height;
+  size_t new_height = static_cast<size_t>(lhs_height) * rhs_height;
+  // the height of a cross product is known before any row of it is, so it is never materialised past the limit
+  QueryMemory::Reserve(QueryMemory::EstimateBytes(new_height, this->GetSize() + other.GetSize()));
   for (const auto& lhs_col : columns) {
     Column new_col;
     new_col.reserve(new_height);
     for (int i = 0; i < lhs_height; i++) {
+      utils::Cancellation::Check(rhs_height);
       for (int j = 0; j < rhs_height; j++) {
         new_col.push_back(lhs_col.second.at(i));
       }
     }
-    new_table.AddColumn(lhs_col.first, new_col);
+    new_table.AddColumn(lhs_col.first, std::move(new_col));
   }
 
   for (const auto& rhs_col : other_table) {
     Column new_col;
     new_col.reserve(new_height);
     for (int i = 0; i < lhs_height; i++) {
+      utils::Cancellation::Check(rhs_height);
       for (int j = 0; j < rhs_height; j++) {
         new_col.push_back(rhs_col.second.at(j));
       }
     }
-    new_table.AddColumn(rhs_col.first, new_col);
+    new_table.AddColumn(rhs_col.first, std::move(new_col));
   }
   return new_table;
 }
@@ -183,12 +273,12 @@ ResultTable ResultTable::InnerJoin(ResultTable& other, std::string matching_syno
     synonyms.insert(it.first);
   }
   ResultTable result_table = ResultTable(synonyms);
-  std::unordered_multimap<size_t, int> hash_map;
+  utils::ArenaUnorderedMultimap<size_t, int> hash_map;
 
   // Hashing
-  Column left_join_col = this->GetColumn(matching_synonym);
+  const Column& left_join_col = this->GetColumn(matching_synonym);
   for (int i = 0; i < this->GetHeight(); i++) {
-    TableElement& elem = left_join_col.at(i);
+    const TableElement& elem = left_join_col.at(i);
     size_t key;
     if (elem.type == QueryResultType::STMTS) {
       key = elem.stmt;
@@ -198,23 +288,33 @@ ResultTable ResultTable::InnerJoin(ResultTable& other, std::string matching_syno
     hash_map.insert(std::make_pair(key, i));
   }
 
-  // Matching
-  Column right_join_col = other.GetColumn(matching_synonym);
+  // Counting the matches of each row, so that the height of the join is reserved before it is materialised
+  typedef decltype(hash_map)::iterator Match;
+  utils::ArenaVector<std::pair<Match, Match>> matches;
+  matches.reserve(other.GetHeight());
+  size_t joined_height = 0;
+  const Column& right_join_col = other.GetColumn(matching_synonym);
   for (int i = 0; i < other.GetHeight(); i++) {
-    TableElement& elem = right_join_col.at(i);
+    const TableElement& elem = right_join_col.at(i);
     size_t key;
     if (elem.type == QueryResultType::STMTS) {
       key = elem.stmt;
     } else {
       key = hash_func(elem.name);  //returns std::size_t
     }
-    auto same_key = hash_map.equal_range(key);
-    for (auto it = same_key.first; it != same_key.second; ++it) {
-      Row left_row = this->GetRowAt(it->second);
-      Row right_row = other.GetRowAt(i);
-      Row merged_row = left_row;
-      merged_row.insert(right_row.begin(), right_row.end());
-      result_table.AddRow(merged_row);
+    matches.push_back(hash_map.equal_range(key));
+    joined_height += std::distance(matches.back().first, matches.back().second);
+  }
+  ReserveJoin(result_table, joined_height);
+
+  // Matching, appending each merged row to the columns of the result table
+  ColumnMapping left_columns = MapColumns(*this, result_table, nullptr);
+  ColumnMapping right_columns = MapColumns(other, result_table, this);
+  for (int i = 0; i < other.GetHeight(); i++) {
+    for (auto it = matches[i].first; it != matches[i].second; ++it) {
+      utils::Cancellation::Check();
+      AppendRow(left_columns, it->second);
+      AppendRow(right_columns, i);
     }
   }
   return result_table;
@@ -236,37 +336,41 @@ ResultTable ResultTable::InnerJoin(ResultTable& other, const std::vector<std::st
     synonyms.insert(it.first);
   }
   ResultTable result_table = ResultTable(synonyms);
-  std::multimap<std::vector<size_t>, int> hash_map;
+  utils::ArenaMultimap<utils::ArenaVector<size_t>, int> hash_map;
 
   // Hashing
-  std::vector<Column> left_join_cols;
+  std::vector<const Column*> left_join_cols;
   left_join_cols.reserve(intersecting_synonyms.size());
   for (const auto& synonym : intersecting_synonyms) {
-    left_join_cols.push_back(this->GetColumn(synonym));
+    left_join_cols.push_back(&this->GetColumn(synonym));
   }
   for (int i = 0; i < this->GetHeight(); i++) {
-    std::vector<size_t> row_of_elem;
-    for (auto& column : left_join_cols) {
-      TableElement& elem = column.at(i);
+    utils::ArenaVector<size_t> row_of_elem;
+    for (const Column* column : left_join_cols) {
+      const TableElement& elem = column->at(i);
       if (elem.type == QueryResultType::STMTS) {
         row_of_elem.push_back(elem.stmt);
       } else {
         row_of_elem.push_back(hash_func(elem.name));
       }
     }
-    hash_map.insert(std::make_pair(row_of_elem, i));
+    hash_map.insert(std::make_pair(std::move(row_of_elem), i));
   }
 
-  // Matching
-  std::vector<Column> right_join_cols;
+  // Counting the matches of each row, so that the height of the join is reserved before it is materialised
+  typedef decltype(hash_map)::iterator Match;
+  utils::ArenaVector<std::pair<Match, Match>> matches;
+  matches.reserve(other.GetHeight());
+  size_t joined_height = 0;
+  std::vector<const Column*> right_join_cols;
   right_join_cols.reserve(intersecting_synonyms.size());
   for (const auto& synonym : intersecting_synonyms) {
-    right_join_cols.push_back(other.GetColumn(synonym));
+    right_join_cols.push_back(&other.GetColumn(synonym));
   }
   for (int i = 0; i < other.GetHeight(); i++) {
-    std::vector<size_t> row_of_elem;
-    for (auto& column : right_join_cols) {
-      TableElement& elem = column.at(i);
+    utils::ArenaVector<size_t> row_of_elem;
+    for (const Column* column : right_join_cols) {
+      const TableElement& elem = column->at(i);
       if (elem.type == QueryResultType::STMTS) {
         row_of_elem.push_back(elem.stmt);
       } else {
@@ -274,13 +378,19 @@ ResultTable ResultTable::InnerJoin(ResultTable& other, const std::vector<std::st
       }
     }
 
-    auto same_key = hash_map.equal_range(row_of_elem);
-    for (auto it = same_key.first; it != same_key.second; ++it) {
-      Row left_row = this->GetRowAt(it->second);
-      Row right_row = other.GetRowAt(i);
-      Row merged_row = left_row;
-      merged_row.insert(right_row.begin(), right_row.end());
-      result_table.AddRow(merged_row);
+    matches.push_back(hash_map.equal_range(row_of_elem));
+    joined_height += std::distance(matches.back().first, matches.back().second);
+  }
+  ReserveJoin(result_table, joined_height);
+
+  // Matching, appending each merged row to the columns of the result table
+  ColumnMapping left_columns = MapColumns(*this, result_table, nullptr);
+  ColumnMapping right_columns = MapColumns(other, result_table, this);
+  for (int i = 0; i < other.GetHeight(); i++) {
+    for (auto it = matches[i].first; it != matches[i].second; ++it) {
+      utils::Cancellation::Check();
+      AppendRow(left_columns, it->second);
+      AppendRow(right_columns, i);
     }
   }
   return result_table;
@@ -288,10 +398,9 @@ ResultTable ResultTable::InnerJoin(ResultTable& other, const std::vector<std::st
 
 std::vector<std::string> ResultTable::FindIntersectingHeaders(ResultTable& other) {
   std::vector<std::string> intersecting_headers;
-  std::unordered_set<std::string> this_headers = this->GetHeaders();
-  for (const auto& synonym : this_headers) {
-    if (other.Contains(synonym)) {
-      intersecting_headers.push_back(synonym);
+  for (const auto& column : columns) {
+    if (other.Contains(column.first)) {
+      intersecting_headers.push_back(column.first);
     }
   }
   return intersecting_headers;
@@ -8,6 +8,7 @@
 
 #include "query_processor/commons/query/clause/ClauseParam.h"
 #include "query_processor/commons/query_result/QueryResult.h"
+#include "utils/Arena.h"
 
 namespace query_processor {
 struct TableElement {
@@ -42,7 +43,8 @@ struct TableElement {
 };
 
 typedef std::vector<TableElement> Column;
-typedef std::unordered_map<std::string, TableElement> Row;
+// rows only live while a table is built, so they are taken from the arena of the query
+typedef utils::ArenaUnorderedMap<std::string, TableElement> Row;
 
 class ResultTable {
  protected:
@@ -54,24 +56,29 @@ class ResultTable {
   // Initialise table with synonyms (which are headers of the table)
   ResultTable(std::unordered_set<std::string>);
   Column& GetColumn(const std::string&);
-  Column& GetColumn(ClauseParam&);
+  Column& GetColumn(const ClauseParam&);
   bool IsEmpty();
   int GetSize();
   int GetHeight();
+  // the bytes taken by its elements, as estimated by QueryMemory
+  size_t CountBytes();
   Row GetRowAt(int);
   std::unordered_map<std::string, Column>& GetTable();
   std::unordered_set<std::string> GetHeaders();
   bool Contains(const std::string&);
-  bool Contains(ClauseParam&);
-  bool AddColumn(const std::string&, Column&);
+  bool Contains(const ClauseParam&);
+  bool AddColumn(const std::string&, const Column&);
+  bool AddColumn(const std::string&, Column&&);
   bool AddRow(const Row&);
   void Clear();
   ResultTable MergeTable(ResultTable& other);
   ResultTable CrossTable(ResultTable&);
-  ResultTable MergeColumn(std::string, Column&);
+  ResultTable MergeColumn(const std::string&, Column);
 
  private:
   std::vector<std::string> FindIntersectingHeaders(ResultTable&);
+  ResultTable JoinTable(ResultTable&, const std::vector<std::string>&);
+  size_t EstimateJoinHeight(ResultTable&, const std::vector<std::string>&);
   ResultTable InnerJoin(ResultTable&, std::string);
   ResultTable InnerJoin(ResultTable&, const std::vector<std::string>&);
 };
@@ -1,11 +1,15 @@
 #include "QueryEvaluatorUtils.h"
 
 #include <stdexcept>
+#include <utility>
+
+#include "utils/Arena.h"
 
 namespace query_processor {
 
 Column QueryEvaluatorUtils::ConvertSetToColumn(const std::unordered_set<int>& stmts) {
   Column result;
+  result.reserve(stmts.size());
   for (auto stmt : stmts) {
     result.push_back(TableElement(stmt));
   }
@@ -14,6 +18,7 @@ Column QueryEvaluatorUtils::ConvertSetToColumn(const std::unordered_set<int>& st
 
 Column QueryEvaluatorUtils::ConvertSetToColumn(const std::unordered_set<std::string>& names) {
   Column result;
+  result.reserve(names.size());
   for (const auto& name : names) {
     result.push_back(TableElement(name));
   }
@@ -25,28 +30,28 @@ Column QueryEvaluatorUtils::RemoveDuplicateTableElements(const Column& column) {
     return column;
   }
   if (column.front().type == QueryResultType::STMTS) {
-    std::unordered_set<int> elem_set;
+    utils::ArenaUnorderedSet<int> elem_set;
     for (auto& elem : column) {
       if (elem.type != QueryResultType::STMTS) {
         throw std::runtime_error("Invalid table column with mixed element types.");
       }
       elem_set.insert(elem.stmt);
     }
-    return ConvertSetToColumn(elem_set);
+    return Column(elem_set.begin(), elem_set.end());
   } else {
-    std::unordered_set<std::string> elem_set;
+    utils::ArenaUnorderedSet<std::string> elem_set;
     for (auto& elem : column) {
       if (elem.type != QueryResultType::NAMES) {
         throw std::runtime_error("Invalid table column with mixed element types.");
       }
       elem_set.insert(elem.name);
     }
-    return ConvertSetToColumn(elem_set);
+    return Column(elem_set.begin(), elem_set.end());
   }
 }
 
-std::string QueryEvaluatorUtils::GetAttributeKey(AttributeType attr, DesignEntity& de) {
-  std::string synonym = de.GetSynonym();
+std::string QueryEvaluatorUtils::GetAttributeKey(AttributeType attr, const DesignEntity& de) {
+  const std::string& synonym = de.GetSynonym();
   if (attr == AttributeType::STMT_NO || attr == AttributeType::VALUE || attr == AttributeType::INTEGER) {
     return synonym + ".INTEGER";
   }
@@ -59,7 +64,7 @@ QueryResult QueryEvaluatorUtils::ConvertColumnToQueryResult(const Column& column
   QueryResult result;
   std::unordered_set<int> stmts;
   std::unordered_set<std::string> names;
-  for (TableElement elem : column) {
+  for (const TableElement& elem : column) {
     if (elem.type == QueryResultType::STMTS) {
       stmts.insert(elem.stmt);
     }
@@ -71,19 +76,18 @@ QueryResult QueryEvaluatorUtils::ConvertColumnToQueryResult(const Column& column
     throw std::runtime_error("Both statements and names have values.");
   }
 
-  if (stmts.empty()) {
-    result = QueryResult(names);
-  }
   if (names.empty()) {
-    result = QueryResult(stmts);
+    result = QueryResult(std::move(stmts));
+  } else {
+    result = QueryResult(std::move(names));
   }
   return result;
 }
 
-QueryResult QueryEvaluatorUtils::ConvertResultTableToTupleResult(ResultTable& final_table, std::vector<SelectedEntity> selected_synonyms) {
-  std::vector<std::string> relevant_columns;
+QueryResult QueryEvaluatorUtils::ConvertResultTableToTupleResult(ResultTable& final_table, const std::vector<SelectedEntity>& selected_synonyms) {
+  std::vector<const Column*> relevant_columns;
   relevant_columns.reserve(selected_synonyms.size());
-  for (SelectedEntity entity : selected_synonyms) {
+  for (const SelectedEntity& entity : selected_synonyms) {
     std::string key = "";
     if (entity.entity_type == SelectedEntityType::ATTRIBUTE) {
       key = GetAttributeKey(entity.attribute.second, entity.attribute.first);
@@ -91,25 +95,26 @@ QueryResult QueryEvaluatorUtils::ConvertResultTableToTupleResult(ResultTable& fi
     if (entity.entity_type == SelectedEntityType::DESIGN_ENTITY) {
       key = entity.design_entity.GetSynonym();
     }
-    relevant_columns.push_back(key);
+    relevant_columns.push_back(&final_table.GetColumn(key));
   }
 
   std::vector<std::vector<std::string>> final_list;
+  final_list.reserve(final_table.GetHeight());
 
   for (int i = 0; i < final_table.GetHeight(); i++) {
     std::vector<std::string> row_tuple;
-    for (const std::string& key : relevant_columns) {
-      TableElement elem = final_table.GetColumn(key).at(i);
+    row_tuple.reserve(relevant_columns.size());
+    for (const Column* column : relevant_columns) {
+      const TableElement& elem = column->at(i);
       if (elem.type == QueryResultType::NAMES) {
         row_tuple.push_back(elem.name);
       } else if (elem.type == QueryResultType::STMTS) {
         row_tuple.push_back(std::to_string(elem.stmt));
       }
     }
-    final_list.push_back(row_tuple);
+    final_list.push_back(std::move(row_tuple));
   }
-  QueryResult result = QueryResult(final_list);
-  return result;
+  return QueryResult(std::move(final_list));
 }
 
 DesignEntityType QueryEvaluatorUtils::ConvertAbstractionToWildcardType(DesignAbstraction abstraction) {
@@ -156,4 +161,17 @@ bool QueryEvaluatorUtils::IsDesignAbstractionWithNoSimilarParams(DesignAbstracti
       return false;
   }
 }
+
+// whether the PKB stores the relation as a compressed row for every stmt, which QueryEvaluator::GetRelationRow returns
+bool QueryEvaluatorUtils::HasRelationRows(DesignAbstraction abstraction) {
+  switch (abstraction) {
+    case DesignAbstraction::NEXT_T:
+    case DesignAbstraction::NEXTBIP_T:
+    case DesignAbstraction::AFFECTS_T:
+    case DesignAbstraction::AFFECTSBIP_T:
+      return true;
+    default:
+      return false;
+  }
+}
 }  // namespace query_processor
\ No newline at end of file
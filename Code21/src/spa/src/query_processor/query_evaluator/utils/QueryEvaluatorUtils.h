@@ -15,10 +15,11 @@ class QueryEvaluatorUtils {
   static Column ConvertSetToColumn(const std::unordered_set<int>&);
   static Column ConvertSetToColumn(const std::unordered_set<std::string>&);
   static Column RemoveDuplicateTableElements(const Column&);
-  static std::string GetAttributeKey(AttributeType, DesignEntity& de);
+  static std::string GetAttributeKey(AttributeType, const DesignEntity& de);
   static QueryResult ConvertColumnToQueryResult(const Column&);
-  static QueryResult ConvertResultTableToTupleResult(ResultTable&, std::vector<SelectedEntity>);
+  static QueryResult ConvertResultTableToTupleResult(ResultTable&, const std::vector<SelectedEntity>&);
   static DesignEntityType ConvertAbstractionToWildcardType(DesignAbstraction);
   static bool IsDesignAbstractionWithNoSimilarParams(DesignAbstraction);
+  static bool HasRelationRows(DesignAbstraction);
 };
 }  // namespace query_processor
@@ -5,14 +5,13 @@
 #include <utility>
 
 namespace query_processor {
-Query QueryOptimizer::OptimizeQuery(Query& query, bool remove_repeated_clauses = false, bool sort_clauses = false) {
+Query QueryOptimizer::OptimizeQuery(Query query, bool remove_repeated_clauses = false, bool sort_clauses = false) {
   if (remove_repeated_clauses) {
     std::vector<Clause>& clause_list = query.GetClauseList();
     query.SetClauseList(RemoveRepeatedClauses(clause_list));
   }
   if (sort_clauses) {
-    std::vector<Clause>& clause_list = query.GetClauseList();
-    query.SetClauseList(SortClausesByNumberOfSynonyms(clause_list));
+    SortClausesByNumberOfSynonyms(query.GetClauseList());
   }
   return query;
 }
@@ -29,8 +28,8 @@ std::vector<ResultTable> QueryOptimizer::OptimizeMerging(std::vector<ResultTable
   std::unordered_map<std::string, std::unordered_set<int>> distribution;
   for (int i = 0; i < num_of_nodes; i++) {
     ResultTable& table = database.at(i);
-    std::unordered_set<std::string> synonyms = table.GetHeaders();
-    for (auto& synonym : synonyms) {
+    for (auto& column : table.GetTable()) {
+      const std::string& synonym = column.first;
       if (distribution.find(synonym) != distribution.end()) {
         for (int node : distribution[synonym]) {
           adj_list.at(node).insert(i);
@@ -77,7 +76,7 @@ std::vector<ResultTable> QueryOptimizer::OptimizeMerging(std::vector<ResultTable
   return merged_tables;
 }
 
-ResultTable QueryOptimizer::BFSMerge(int node, std::vector<std::unordered_set<int>> adj_list, std::vector<bool>& merged, std::vector<ResultTable>& database, bool sort_before_merge) {
+ResultTable QueryOptimizer::BFSMerge(int node, const std::vector<std::unordered_set<int>>& adj_list, std::vector<bool>& merged, std::vector<ResultTable>& database, bool sort_before_merge) {
   ResultTable group_table;
   std::vector<int> queue;
   group_table = group_table.MergeTable(database.at(node));
@@ -86,7 +85,7 @@ ResultTable QueryOptimizer::BFSMerge(int node, std::vector<std::unordered_set<in
   while (!queue.empty()) {
     node = queue.back();
     queue.pop_back();
-    std::unordered_set<int>& node_adj = adj_list.at(node);
+    const std::unordered_set<int>& node_adj = adj_list.at(node);
     if (sort_before_merge) {
       // Neighbours are pairs stored by <size, index>
       std::vector<std::pair<int, int>> neighbours;
@@ -126,19 +125,19 @@ ResultTable QueryOptimizer::BFSMerge(int node, std::vector<std::unordered_set<in
   return group_table;
 }
 
+// the clauses kept are moved out of the list, which is replaced by the result
 std::vector<Clause> QueryOptimizer::RemoveRepeatedClauses(std::vector<Clause>& clause_list) {
   std::vector<Clause> set_clause_list;
   for (auto& clause : clause_list) {
     if (std::find(set_clause_list.begin(), set_clause_list.end(), clause) == set_clause_list.end()) {
-      set_clause_list.push_back(clause);
+      set_clause_list.push_back(std::move(clause));
     }
   }
 
   return set_clause_list;
 }
 
-std::vector<Clause> QueryOptimizer::SortClausesByNumberOfSynonyms(std::vector<Clause>& clause_list) {
+void QueryOptimizer::SortClausesByNumberOfSynonyms(std::vector<Clause>& clause_list) {
   std::sort(clause_list.begin(), clause_list.end());
-  return clause_list;
 }
 }  // namespace query_processor
\ No newline at end of file
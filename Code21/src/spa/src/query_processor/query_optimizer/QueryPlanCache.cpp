@@ -0,0 +1,423 @@
+#include "QueryPlanCache.h"
+
+#include <cctype>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "parser_utils/ExpressionParser.h"
+#include "query_processor/commons/BooleanSemanticError.h"
+#include "query_processor/commons/query/clause/Clause.h"
+#include "query_processor/query_evaluator/QueryEvaluator.h"
+#include "query_processor/query_parser/QueryParser.h"
+
+namespace query_processor {
+
+namespace {
+
+// Placeholders in the key are delimited by chars that are rejected in queries, so that no two shapes share a key
+const char kSynonymTag = '\x01';
+const char kIntegerTag = '\x02';
+const char kNameTag = '\x03';
+
+const size_t kDefaultCapacity = 1024;
+
+// Every word the parser compares the query against. The parser matches keywords by prefix, so a word
+// starting with one of these could be read as the keyword and is kept as it is.
+const char* const kReservedWords[] = {
+    "Select", "such", "that", "pattern", "with", "and", "BOOLEAN",
+    "stmt", "read", "print", "while", "if", "assign", "call", "variable", "constant", "procedure", "prog_line",
+    "Follows", "Parent", "Modifies", "Uses", "Calls", "Next", "Affects",
+    "procName", "varName", "value"};
+
+bool IsWhitespace(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+bool IsAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool IsReservedWord(const std::string& word) {
+  for (const char* reserved_word : kReservedWords) {
+    if (word[0] == reserved_word[0] && word.compare(0, std::char_traits<char>::length(reserved_word), reserved_word) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// whether [start, end) of the string is [a-zA-Z][a-zA-Z0-9]*
+bool IsName(const std::string& input_string, size_t start, size_t end) {
+  if (start == end || !IsAlpha(input_string[start])) {
+    return false;
+  }
+  for (size_t i = start; i < end; i++) {
+    if (!IsAlpha(input_string[i]) && !IsDigit(input_string[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// whether the digits in [start, end) of the string are 0|[1-9][0-9]*, short enough to never overflow an int
+bool IsSmallInteger(const std::string& input_string, size_t start, size_t end) {
+  return end - start <= 9 && (end - start == 1 || input_string[start] != '0');
+}
+
+// the index of the value in values, appending it if it is not there yet. Queries have few distinct values,
+// so a linear search beats hashing them
+template <typename T>
+size_t GetIndex(std::vector<T>& values, const T& value) {
+  for (size_t i = 0; i < values.size(); i++) {
+    if (values[i] == value) {
+      return i;
+    }
+  }
+  values.push_back(value);
+  return values.size() - 1;
+}
+
+// the digits of the index are written least significant first, which is as unambiguous between the tags
+void AppendPlaceholder(std::string& key, char tag, size_t index) {
+  key += tag;
+  do {
+    key += static_cast<char>('0' + index % 10);
+    index /= 10;
+  } while (index > 0);
+  key += tag;
+}
+
+}  // namespace
+
+double QueryPlanCacheStatistics::GetHitRate() const {
+  size_t total = hits + misses + uncacheable;
+  return total == 0 ? 0 : static_cast<double>(hits) / total;
+}
+
+// plans are only bounded in number
+std::mutex QueryPlanCache::cache_mutex;
+utils::LruCache<QueryPlanCache::QueryPlan> QueryPlanCache::plans(kDefaultCapacity, std::numeric_limits<size_t>::max());
+QueryPlanCacheStatistics QueryPlanCache::statistics;
+
+Query QueryPlanCache::GetPlannedQuery(std::string& query_string, const utils::Extension& extension) {
+  bool is_enabled;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    is_enabled = plans.IsEnabled();
+  }
+
+  QueryShape shape;
+  if (!is_enabled || !NormaliseQuery(query_string, shape)) {
+    CountUncacheable();
+    return QueryEvaluator::PlanQuery(QueryParser::ParseQuery(query_string, extension));
+  }
+  // a query may only be valid for some extensions
+  shape.key += extension.has_next_bip ? "\nNB" : "\n";
+  shape.key += extension.has_affects_bip ? "\nAB" : "\n";
+
+  std::shared_ptr<const QueryPlan> cached_plan;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cached_plan = plans.Get(shape.key);
+    if (cached_plan) {
+      statistics.hits++;
+    }
+  }
+  if (cached_plan) {
+    try {
+      return BindLiterals(*cached_plan, shape.names, shape.integers);
+    } catch (std::runtime_error&) {
+      // a name the expression parser rejects, which the parser reports as it would have without the cache
+      return QueryEvaluator::PlanQuery(QueryParser::ParseQuery(query_string, extension));
+    }
+  }
+
+  Query query;
+  try {
+    query = QueryEvaluator::PlanQuery(QueryParser::ParseQuery(query_string, extension));
+  } catch (...) {
+    CountUncacheable();
+    throw;
+  }
+  std::shared_ptr<QueryPlan> plan = std::make_shared<QueryPlan>();
+  if (!CreatePlan(query_string, shape, extension, query, *plan)) {
+    CountUncacheable();
+    return query;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  statistics.misses++;
+  plans.Put(shape.key, plan, 0);
+  statistics.size = plans.GetSize();
+  return query;
+}
+
+QueryPlanCacheStatistics QueryPlanCache::GetStatistics() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  return statistics;
+}
+
+void QueryPlanCache::SetCapacity(size_t new_capacity) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  plans.SetLimits(new_capacity, std::numeric_limits<size_t>::max());
+  statistics.size = plans.GetSize();
+}
+
+void QueryPlanCache::Clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  plans.Clear();
+  statistics = QueryPlanCacheStatistics();
+}
+
+bool QueryPlanCache::NormaliseQuery(const std::string& query_string, QueryShape& shape) {
+  /*
+    Reads the query as a sequence of whitespace runs, words, integers, quoted strings and other chars, and
+    writes each of them into the key:
+      - a run of whitespace as a single space
+      - a word as it is if it is reserved, and as the index of its first occurrence otherwise
+      - an integer or a name in quotes as the index of the first occurrence of its value
+      - anything else as it is
+    Returns false if the query is one the cache does not handle, which is left to the parser to report.
+  */
+  shape.key.reserve(query_string.size());
+  size_t position = 0;
+  while (position < query_string.size()) {
+    size_t start = position;
+    char c = query_string[position];
+    if (c == kSynonymTag || c == kIntegerTag || c == kNameTag) {
+      return false;
+    }
+
+    if (IsWhitespace(c)) {
+      while (position < query_string.size() && IsWhitespace(query_string[position])) {
+        position++;
+      }
+      shape.key += ' ';
+    } else if (IsAlpha(c)) {
+      bool has_underscore = false;
+      while (position < query_string.size() &&
+             (IsAlpha(query_string[position]) || IsDigit(query_string[position]) || query_string[position] == '_')) {
+        has_underscore = has_underscore || query_string[position] == '_';
+        position++;
+      }
+      std::string word = query_string.substr(start, position - start);
+      // no valid query has a '_' right after a name, other than in 'prog_line'
+      if (has_underscore && word != "prog_line") {
+        return false;
+      }
+      if (IsReservedWord(word)) {
+        shape.key += word;
+      } else {
+        AppendPlaceholder(shape.key, kSynonymTag, GetIndex(shape.words, word));
+      }
+    } else if (IsDigit(c)) {
+      while (position < query_string.size() && IsDigit(query_string[position])) {
+        position++;
+      }
+      if (IsSmallInteger(query_string, start, position)) {
+        int value = std::atoi(query_string.c_str() + start);
+        AppendPlaceholder(shape.key, kIntegerTag, GetIndex(shape.integers, value));
+      } else {
+        shape.key.append(query_string, start, position - start);
+      }
+    } else if (c == '"') {
+      size_t closing_quote = query_string.find('"', position + 1);
+      if (closing_quote == std::string::npos) {
+        return false;
+      }
+      position = closing_quote + 1;
+
+      size_t name_start = start + 1;
+      while (name_start < closing_quote && IsWhitespace(query_string[name_start])) {
+        name_start++;
+      }
+      size_t name_end = closing_quote;
+      while (name_end > name_start && IsWhitespace(query_string[name_end - 1])) {
+        name_end--;
+      }
+      if (IsName(query_string, name_start, name_end)) {
+        size_t name_index = GetIndex(shape.names, query_string.substr(name_start, name_end - name_start));
+        shape.name_literals.push_back({name_start, name_end, name_index});
+        shape.key += '"';
+        shape.key += name_start > start + 1 ? " " : "";
+        AppendPlaceholder(shape.key, kNameTag, name_index);
+        shape.key += name_end < closing_quote ? " " : "";
+        shape.key += '"';
+      } else {
+        // an expression is part of the shape, with whitespace collapsed as the parser does
+        shape.key += '"';
+        for (size_t i = start + 1; i < closing_quote; i++) {
+          if (!IsWhitespace(query_string[i])) {
+            shape.key += query_string[i];
+          } else if (shape.key.back() != ' ') {
+            shape.key += ' ';
+          }
+        }
+        shape.key += '"';
+      }
+    } else {
+      position++;
+      shape.key += c;
+    }
+  }
+  return true;
+}
+
+bool QueryPlanCache::CreatePlan(const std::string& query_string, const QueryShape& shape, const utils::Extension& extension, Query& query, QueryPlan& plan) {
+  // The plan is made from a probe query, in which every name in quotes is replaced by one found nowhere else
+  // in the query. A name may also turn up where it is not a literal, e.g. as "(x)" in a pattern expression,
+  // while a probe name can only have come from its literal.
+  std::string probe_prefix = "zq";
+  while (query_string.find(probe_prefix) != std::string::npos) {
+    probe_prefix += 'z';
+  }
+  std::vector<std::string> probe_names;
+  for (size_t i = 0; i < shape.names.size(); i++) {
+    probe_names.push_back(probe_prefix + std::to_string(i));
+  }
+  std::string probe_query;
+  size_t copied_until = 0;
+  for (const NameLiteral& name_literal : shape.name_literals) {
+    probe_query.append(query_string, copied_until, name_literal.start - copied_until);
+    probe_query += probe_names.at(name_literal.name_index);
+    copied_until = name_literal.end;
+  }
+  probe_query.append(query_string, copied_until, std::string::npos);
+
+  try {
+    plan.query = QueryEvaluator::PlanQuery(QueryParser::ParseQuery(probe_query, extension));
+  } catch (BooleanSemanticError&) {
+    return false;
+  } catch (std::runtime_error&) {
+    return false;
+  }
+
+  std::vector<Clause>& clause_list = plan.query.GetClauseList();
+  for (size_t i = 0; i < clause_list.size(); i++) {
+    Clause& clause = clause_list.at(i);
+    bool is_located;
+    switch (clause.GetClauseType()) {
+      case ClauseType::SUCHTHAT:
+        is_located = LocateLiteral(clause.GetSuchThatClause().GetLHSParam(), i, false, probe_names, shape.integers, plan) &&
+                     LocateLiteral(clause.GetSuchThatClause().GetRHSParam(), i, true, probe_names, shape.integers, plan);
+        break;
+      case ClauseType::PATTERN:
+        is_located = LocateLiteral(clause.GetPatternClause().GetLHSParam(), i, false, probe_names, shape.integers, plan) &&
+                     LocateLiteral(clause.GetPatternClause().GetRHSParam(), i, true, probe_names, shape.integers, plan);
+        break;
+      case ClauseType::WITH:
+        is_located = LocateLiteral(clause.GetWithClause().GetLHSParam(), i, false, probe_names, shape.integers, plan) &&
+                     LocateLiteral(clause.GetWithClause().GetRHSParam(), i, true, probe_names, shape.integers, plan);
+        break;
+      default:
+        return false;
+    }
+    if (!is_located) {
+      return false;
+    }
+  }
+
+  // Binding the literals of the query itself must give back the query, or the plan can not be trusted
+  try {
+    return BindLiterals(plan, shape.names, shape.integers).GetClauseList() == query.GetClauseList();
+  } catch (std::runtime_error&) {
+    return false;
+  }
+}
+
+bool QueryPlanCache::LocateLiteral(const ClauseParam& param, size_t clause_index, bool is_rhs, const std::vector<std::string>& probe_names,
+                                   const std::vector<int>& integers, QueryPlan& plan) {
+  switch (param.param_type) {
+    case ClauseParamType::NAME:
+      for (size_t i = 0; i < probe_names.size(); i++) {
+        if (param.var_proc_name == probe_names.at(i)) {
+          plan.literal_slots.push_back({clause_index, is_rhs, LiteralType::NAME, i});
+          return true;
+        }
+      }
+      return false;
+    case ClauseParamType::INDEX:
+      // integers too long to be placeholders are part of the shape
+      for (size_t i = 0; i < integers.size(); i++) {
+        if (param.statement_index == integers.at(i)) {
+          plan.literal_slots.push_back({clause_index, is_rhs, LiteralType::INDEX, i});
+        }
+      }
+      return true;
+    case ClauseParamType::EXPR:
+      // expressions other than a single name are part of the shape
+      for (size_t i = 0; i < probe_names.size(); i++) {
+        if (param.pattern_expr.token_list == parser_utils::ExpressionParser::ParseExpression(probe_names.at(i))) {
+          plan.literal_slots.push_back({clause_index, is_rhs, LiteralType::EXPR, i});
+        }
+      }
+      return true;
+    default:
+      return true;
+  }
+}
+
+Query QueryPlanCache::BindLiterals(const QueryPlan& plan, const std::vector<std::string>& names, const std::vector<int>& integers) {
+  Query query = plan.query;
+  std::vector<Clause>& clause_list = query.GetClauseList();
+  for (const LiteralSlot& slot : plan.literal_slots) {
+    Clause& clause = clause_list.at(slot.clause_index);
+    ClauseParam lhs_param;
+    ClauseParam rhs_param;
+    switch (clause.GetClauseType()) {
+      case ClauseType::SUCHTHAT:
+        lhs_param = clause.GetSuchThatClause().GetLHSParam();
+        rhs_param = clause.GetSuchThatClause().GetRHSParam();
+        break;
+      case ClauseType::PATTERN:
+        lhs_param = clause.GetPatternClause().GetLHSParam();
+        rhs_param = clause.GetPatternClause().GetRHSParam();
+        break;
+      case ClauseType::WITH:
+        lhs_param = clause.GetWithClause().GetLHSParam();
+        rhs_param = clause.GetWithClause().GetRHSParam();
+        break;
+      default:
+        throw std::runtime_error("Invalid clause type");
+    }
+
+    ClauseParam& param = slot.is_rhs ? rhs_param : lhs_param;
+    switch (slot.literal_type) {
+      case LiteralType::NAME:
+        param = ClauseParam(names.at(slot.literal_index));
+        break;
+      case LiteralType::INDEX:
+        param = ClauseParam(integers.at(slot.literal_index));
+        break;
+      case LiteralType::EXPR:
+        param = ClauseParam(PatternExpression(parser_utils::ExpressionParser::ParseExpression(names.at(slot.literal_index)),
+                                              param.pattern_expr.is_wild_card));
+        break;
+    }
+
+    switch (clause.GetClauseType()) {
+      case ClauseType::SUCHTHAT:
+        clause = Clause(SuchThatClause(clause.GetSuchThatClause().GetDesignAbstraction(), lhs_param, rhs_param));
+        break;
+      case ClauseType::PATTERN:
+        clause = Clause(PatternClause(clause.GetPatternClause().GetDesignEntity(), lhs_param, rhs_param));
+        break;
+      default:
+        clause = Clause(WithClause(std::make_pair(lhs_param, clause.GetWithClause().GetLHSAttributeType()),
+                                   std::make_pair(rhs_param, clause.GetWithClause().GetRHSAttributeType())));
+    }
+  }
+  return query;
+}
+
+void QueryPlanCache::CountUncacheable() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  statistics.uncacheable++;
+}
+
+}  // namespace query_processor
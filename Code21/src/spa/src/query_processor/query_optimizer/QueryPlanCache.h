@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "query_processor/commons/query/Query.h"
+#include "utils/Extension.h"
+#include "utils/LruCache.h"
+
+namespace query_processor {
+
+struct QueryPlanCacheStatistics {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t uncacheable = 0;  // queries parsed and planned without the cache, e.g. invalid ones
+  size_t size = 0;
+
+  double GetHitRate() const;
+};
+
+/*
+  Caches the parsed and planned Query of every query shape evaluated so far, so that a query of a shape
+  that has been seen before skips both the QueryParser and the QueryOptimizer.
+
+  Two queries have the same shape if they only differ in whitespace, in the names of their synonyms and in
+  the values of their literals, i.e. statement numbers and names in quotes. A plan is stored with the position
+  of every literal in its clauses, and a cache hit copies the plan and rebinds those literals to the values of
+  the new query. Which literals are equal is part of the shape, as it decides which clauses are removed as
+  repeats. Words that are, or start with, a PQL keyword are never renamed, so that the parser can not read
+  two queries of the same shape differently.
+
+  The cache is shared by all threads and bounded, evicting the least recently used plan once it is full.
+*/
+class QueryPlanCache {
+ public:
+  // returns the planned Query for the query, parsing and planning it only if no query of the same shape
+  // has been planned before for the same extensions. Invalid queries throw exactly as QueryParser::ParseQuery does
+  static Query GetPlannedQuery(std::string&, const utils::Extension& = utils::Extension());
+
+  static QueryPlanCacheStatistics GetStatistics();
+
+  // 0 disables the cache
+  static void SetCapacity(size_t);
+
+  // removes every plan and resets the statistics
+  static void Clear();
+
+ private:
+  enum class LiteralType { NAME,
+                           INDEX,
+                           EXPR };
+
+  struct LiteralSlot {
+    size_t clause_index;
+    bool is_rhs;
+    LiteralType literal_type;
+    size_t literal_index;
+  };
+
+  struct QueryPlan {
+    Query query;
+    std::vector<LiteralSlot> literal_slots;
+  };
+
+  struct NameLiteral {
+    size_t start;
+    size_t end;
+    size_t name_index;
+  };
+
+  struct QueryShape {
+    std::string key;
+    std::vector<std::string> words;  // the words renamed in the key, by index
+    std::vector<std::string> names;
+    std::vector<int> integers;
+    std::vector<NameLiteral> name_literals;  // where in the query each name in quotes is
+  };
+
+  static std::mutex cache_mutex;
+  static utils::LruCache<QueryPlan> plans;
+  static QueryPlanCacheStatistics statistics;
+
+  static bool NormaliseQuery(const std::string&, QueryShape&);
+  static bool CreatePlan(const std::string&, const QueryShape&, const utils::Extension&, Query&, QueryPlan&);
+  static bool LocateLiteral(const ClauseParam&, size_t, bool, const std::vector<std::string>&, const std::vector<int>&, QueryPlan&);
+  static Query BindLiterals(const QueryPlan&, const std::vector<std::string>&, const std::vector<int>&);
+  static void CountUncacheable();
+};
+
+}  // namespace query_processor
@@ -1,8 +1,7 @@
 #include "QueryParser.h"
 
-#include <iostream>
+#include <climits>
 #include <map>
-#include <regex>
 #include <stdexcept>
 
 #include "parser_utils/ExpressionParser.h"
@@ -12,29 +11,49 @@
 #include "query_processor/commons/query/entities/DesignEntity.h"
 #include "query_processor/commons/query/entities/SelectedEntity.h"
 #include "query_processor/commons/query/utils/QueryUtils.h"
-#include "utils/QueryParserUtils.h"
-#include "utils/QueryRegex.h"
-#include "utils/Extension.h"
-
 
 namespace query_processor {
 
-bool QueryParser::is_boolean_query = false;
-bool QueryParser::is_semantic_error = false;
-bool QueryParser::has_declaration_error = false;
+namespace {
+
+const char* const kSyntaxErrorMessage = "Query does not satisfy the valid PQL concrete grammar for conditional clauses.";
+
+// [a-zA-Z][a-zA-Z0-9]*
+bool IsName(const std::string& input_string) {
+  if (input_string.empty() || !isalpha(static_cast<unsigned char>(input_string[0]))) {
+    return false;
+  }
+  for (char c : input_string) {
+    if (!isalnum(static_cast<unsigned char>(c))) {
+      return false;
+    }
+  }
+  return true;
+}
 
-void QueryParser::ResetBooleans() {
-  QueryParser::is_boolean_query = false;
-  QueryParser::is_semantic_error = false;
-  QueryParser::has_declaration_error = false;
+bool IsDesignEntityType(const std::string& input_string) {
+  return input_string == "stmt" || input_string == "read" || input_string == "print" || input_string == "while" ||
+         input_string == "if" || input_string == "assign" || input_string == "call" || input_string == "variable" ||
+         input_string == "constant" || input_string == "procedure" || input_string == "prog_line";
 }
 
-Query QueryParser::ParseQuery(std::string& query_string) {
+bool IsDesignAbstraction(const std::string& input_string) {
+  return input_string == "Follows" || input_string == "Parent" || input_string == "Modifies" ||
+         input_string == "Uses" || input_string == "Calls" || input_string == "Next" || input_string == "Affects" ||
+         input_string == "NextBip" || input_string == "AffectsBip";
+}
+
+}  // namespace
+
+QueryParser::QueryParser(const utils::Extension& extension) : extension(extension) {}
+
+Query QueryParser::ParseQuery(std::string& query_string, const utils::Extension& extension) {
+  QueryParser parser(extension);
   try {
-    Query return_query = QueryParser::GenerateQuery(query_string);
+    Query return_query = parser.Generate(query_string);
     return return_query;
   } catch (std::runtime_error& error) {
-    if (QueryParser::is_boolean_query && QueryParser::is_semantic_error) {
+    if (parser.is_boolean_query && parser.is_semantic_error) {
       throw BooleanSemanticError(error.what(), 0, 0);
     } else {
       throw error;
@@ -42,10 +61,14 @@ Query QueryParser::ParseQuery(std::string& query_string) {
   }
 }
 
-Query QueryParser::GenerateQuery(std::string& query_string) {
+Query QueryParser::GenerateQuery(std::string& query_string, const utils::Extension& extension) {
+  return QueryParser(extension).Generate(query_string);
+}
+
+Query QueryParser::Generate(std::string& query_string) {
   /*
 		Generates a Query using the input query string.
-		
+
 		A valid query string follows 4 main rules:
 			- It starts with some number of declarations, and ends with a Select clause.
 			- All design entities in the Select clause must have been declared.
@@ -53,66 +76,69 @@ Query QueryParser::GenerateQuery(std::string& query_string) {
 			- Each design entity must only be declared once (but can have multiple synonyms).
 
 		Generally, any amount and type of whitespace is allowed, at any point in the query.
-	*/
 
-  QueryParser::ResetBooleans();
+		The query is parsed by recursive descent in a single pass over its tokens. Each conditional clause is
+		checked against the grammar in full before its synonyms are checked against the declarations, so
+		the first clause in error decides whether a BOOLEAN query fails syntactically or semantically.
+	*/
 
-  std::string& remaining_query_string = QueryParserUtils::StripWhitespace(query_string);
+  QueryTokenizer tokenizer(query_string);
 
   // Maintain a mapping of synonyms and their design entity types to check for duplicates
   std::map<std::string, DesignEntityType> synonym_to_de_type_mappings;
 
-  QueryParser::ParseDeclarationClauses(remaining_query_string, synonym_to_de_type_mappings);
+  QueryParser::ParseDeclarationClauses(tokenizer, synonym_to_de_type_mappings);
 
-  Query return_query = QueryParser::ParseSelectPhrase(remaining_query_string, synonym_to_de_type_mappings);
+  Query return_query = QueryParser::ParseSelectPhrase(tokenizer, synonym_to_de_type_mappings);
 
-  return_query = QueryParser::ParseConditionalClauses(remaining_query_string, synonym_to_de_type_mappings, return_query);
+  return_query = QueryParser::ParseConditionalClauses(tokenizer, synonym_to_de_type_mappings, return_query);
 
   return return_query;
 }
 
-void QueryParser::ParseDeclarationClauses(std::string& remaining_query_string, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  while (std::regex_search(remaining_query_string, QueryRegex::STARTS_WITH_VALID_DECLARATION_FIRST_SYNONYM_REGEX)) {
-    // First, pop the first synonym (which comes with the design entity type)
-    std::pair<std::string, std::string> split_query_string = QueryParserUtils::PopMatchFromFront(
-        remaining_query_string, QueryRegex::STARTS_WITH_VALID_DECLARATION_FIRST_SYNONYM_REGEX);
-    std::string declaration_type_and_first_synonym = QueryParserUtils::StripWhitespace(split_query_string.first);
-    remaining_query_string = split_query_string.second;
-
-    // Identify the design entity as the first token separated by spaces
-    std::string design_entity_type_as_string = QueryParserUtils::SplitStringAlongChar(declaration_type_and_first_synonym, ' ').at(0);
+void QueryParser::ParseDeclarationClauses(QueryTokenizer& tokenizer, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
+  while (true) {
+    // A declaration starts with a design entity type and a synonym; anything else ends the declarations
+    size_t declaration_start = tokenizer.GetPosition();
+    tokenizer.SkipWhitespace();
+    std::string design_entity_type_as_string = tokenizer.ReadWord();
+    if (!IsDesignEntityType(design_entity_type_as_string) || !tokenizer.SkipWhitespace()) {
+      tokenizer.SetPosition(declaration_start);
+      break;
+    }
+    std::string declaration_first_synonym = tokenizer.ReadName();
+    if (declaration_first_synonym.empty()) {
+      tokenizer.SetPosition(declaration_start);
+      break;
+    }
     DesignEntityType design_entity_type = QueryUtils::ConvertStringToDesignEntityType(design_entity_type_as_string);
-
-    // Identify the first synonym and initialize the vector used to hold all the synonyms for this declaration clause
-    std::string declaration_first_synonym = QueryParserUtils::SplitStringAlongChar(declaration_type_and_first_synonym, ' ').at(1);
     std::vector<std::string> synonyms = std::vector<std::string>{declaration_first_synonym};
 
-    // Then pop each following synonym in turn
-    while (std::regex_search(remaining_query_string, QueryRegex::STARTS_WITH_VALID_DECLARATION_OTHER_SYNONYM_REGEX)) {
-      std::pair<std::string, std::string> split_declaration_string = QueryParserUtils::PopMatchFromFront(
-          remaining_query_string, QueryRegex::STARTS_WITH_VALID_DECLARATION_OTHER_SYNONYM_REGEX);
-      std::string next_declaration_synonym_with_comma = split_declaration_string.first;
-      std::string next_declaration_synonym = QueryParserUtils::GetAllMatchesFromString(next_declaration_synonym_with_comma,
-                                                                                       QueryRegex::VALID_SYNONYM_REGEX)
-                                                 .at(0);
-      remaining_query_string = split_declaration_string.second;
-      synonyms.push_back(QueryParserUtils::StripWhitespace(next_declaration_synonym));
+    // Then read each following synonym in turn
+    while (true) {
+      size_t synonym_start = tokenizer.GetPosition();
+      tokenizer.SkipWhitespace();
+      if (!tokenizer.ReadChar(',')) {
+        tokenizer.SetPosition(synonym_start);
+        break;
+      }
+      tokenizer.SkipWhitespace();
+      std::string next_declaration_synonym = tokenizer.ReadName();
+      if (next_declaration_synonym.empty()) {
+        tokenizer.SetPosition(synonym_start);
+        break;
+      }
+      synonyms.push_back(next_declaration_synonym);
     }
 
     // Ensure that the declaration clause ends as it should (with a semicolon)
-    if (!std::regex_search(remaining_query_string, QueryRegex::STARTS_WITH_VALID_DECLARATION_CLAUSE_ENDING_REGEX)) {
+    tokenizer.SkipWhitespace();
+    if (!tokenizer.ReadChar(';')) {
       throw std::runtime_error("Query does not satisfy the valid PQL concrete grammar for declaration clauses.");
-    } else {
-      std::pair<std::string, std::string> split_declaration_string = QueryParserUtils::PopMatchFromFront(
-          remaining_query_string, QueryRegex::STARTS_WITH_VALID_DECLARATION_CLAUSE_ENDING_REGEX);
-      remaining_query_string = split_declaration_string.second;
     }
 
     // Ensure that no duplicates exist between synonym names
-    for (std::string synonym : synonyms) {
-      // Remove leading and trailing whitespace to ensure proper comparison
-      synonym = QueryParserUtils::StripWhitespace(synonym);
-
+    for (const std::string& synonym : synonyms) {
       if (synonym_to_design_entity_type_mappings.count(synonym) == 0) {
         synonym_to_design_entity_type_mappings.insert(std::pair<std::string, DesignEntityType>(synonym, design_entity_type));
       } else {
@@ -131,38 +157,58 @@ void QueryParser::ParseDeclarationClauses(std::string& remaining_query_string, s
   }
 }
 
-Query QueryParser::ParseSelectPhrase(std::string& remaining_query_string, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  // Ensure that exactly one match of the Select phrase (i.e. "Select (BOOLEAN/synonym/tuple/attribute)") exists
-  if (!std::regex_search(remaining_query_string, QueryRegex::STARTS_WITH_VALID_SELECT_PHRASE_REGEX)) {
+Query QueryParser::ParseSelectPhrase(QueryTokenizer& tokenizer, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
+  // Ensure that the Select phrase (i.e. "Select (BOOLEAN/synonym/tuple/attribute)") comes next
+  tokenizer.SkipWhitespace();
+  if (!tokenizer.ReadKeyword("Select") || !tokenizer.SkipWhitespace()) {
     throw std::runtime_error("Query does not satisfy the PQL concrete grammar.");
   }
 
-  std::pair<std::string, std::string> select_clause_components = QueryParserUtils::PopMatchFromFront(remaining_query_string, QueryRegex::STARTS_WITH_VALID_SELECT_PHRASE_REGEX);
-  std::string select_phrase = select_clause_components.first;
-  remaining_query_string = select_clause_components.second;
-
-  // Obtain the selected entity from the 'Select' phrase
-  std::string select_phrase_synonym = QueryParserUtils::PopMatchFromFront(select_phrase, QueryRegex::STARTS_WITH_SELECT_STRING_REGEX).second;
-  select_phrase_synonym = QueryParserUtils::StripWhitespace(select_phrase_synonym);
+  // Each selected element is a synonym and the name of its attribute, if it has one
+  std::vector<std::pair<std::string, std::string>> selected_elements;
+  bool is_tuple = tokenizer.ReadChar('<');
+  if (is_tuple) {
+    do {
+      tokenizer.SkipWhitespace();
+      std::string synonym = tokenizer.ReadName();
+      std::string attribute_name;
+      if (synonym.empty() || (tokenizer.ReadChar('.') && (attribute_name = tokenizer.ReadAttributeName()).empty())) {
+        throw std::runtime_error("Query does not satisfy the PQL concrete grammar.");
+      }
+      tokenizer.SkipWhitespace();
+      selected_elements.emplace_back(synonym, attribute_name);
+    } while (tokenizer.ReadChar(','));
 
-  Query return_query;
+    if (!tokenizer.ReadChar('>')) {
+      throw std::runtime_error("Query does not satisfy the PQL concrete grammar.");
+    }
+  } else {
+    std::string synonym = tokenizer.ReadName();
+    if (synonym.empty()) {
+      throw std::runtime_error("Query does not satisfy the PQL concrete grammar.");
+    }
 
-  if (std::regex_match(select_phrase_synonym, QueryRegex::STARTS_WITH_BOOLEAN_STRING_REGEX)) {
-    // This is to ensure that 'Select BOOLEANwith 1 = 1' is treated as syntactic and not semantic
-    if (std::regex_match(select_phrase_synonym, QueryRegex::STARTS_WITH_VALID_SELECT_BOOLEAN_REGEX)) {
-      QueryParser::is_boolean_query = true;
+    // A '.' that does not start an attribute name is left for the conditional clauses to reject
+    std::string attribute_name;
+    size_t attribute_start = tokenizer.GetPosition();
+    if (tokenizer.ReadChar('.') && (attribute_name = tokenizer.ReadAttributeName()).empty()) {
+      tokenizer.SetPosition(attribute_start);
+    }
+    selected_elements.emplace_back(synonym, attribute_name);
+  }
+  tokenizer.SkipWhitespace();
 
-      // This is used to resolve the one case where a re-declaration of synonym
-      //	 is not considered as a semantic BOOLEAN error, because the parser hasn't
-      //	 reached this part yet.
-      if (QueryParser::has_declaration_error) {
-        QueryParser::ThrowSemanticError("Synonym re-declared in declaration clauses.");
-      }
+  if (!is_tuple && selected_elements[0].first == "BOOLEAN" && selected_elements[0].second.empty()) {
+    QueryParser::is_boolean_query = true;
 
-      return Query(SelectedEntity(SelectedEntityType::BOOLEAN));
-    } else {
-      throw std::runtime_error("Select phrase entity starts with 'BOOLEAN' but is not 'BOOLEAN'.");
+    // This is used to resolve the one case where a re-declaration of synonym
+    //	 is not considered as a semantic BOOLEAN error, because the parser hasn't
+    //	 reached this part yet.
+    if (QueryParser::has_declaration_error) {
+      QueryParser::ThrowSemanticError("Synonym re-declared in declaration clauses.");
     }
+
+    return Query(SelectedEntity(SelectedEntityType::BOOLEAN));
   }
 
   // Fail-fast, since there is no point postponing it any longer.
@@ -170,177 +216,201 @@ Query QueryParser::ParseSelectPhrase(std::string& remaining_query_string, std::m
     QueryParser::ThrowSemanticError("Synonym re-declared in declaration clauses.");
   }
 
-  if (std::regex_match(select_phrase_synonym, QueryRegex::STARTS_WITH_VALID_ATTRIBUTE_REFERENCE_REGEX)) {
-    return_query = Query(SelectedEntity(QueryParser::CreateAttributeSelectedEntityFromString(select_phrase_synonym, synonym_to_design_entity_type_mappings)));
-  } else if (std::regex_match(select_phrase_synonym, QueryRegex::STARTS_WITH_VALID_SELECT_TUPLE_REGEX)) {
-    std::vector<SelectedEntity> tuple_entities{};
-
-    // Clean up the angle brackets from the start and end
-    select_phrase_synonym = std::regex_replace(select_phrase_synonym, QueryRegex::STARTS_OR_ENDS_WITH_VALID_TUPLE_ANGLE_BRACKETS_REGEX, "");
+  std::vector<SelectedEntity> selected_entities{};
+  for (const auto& element : selected_elements) {
+    const std::string& synonym = element.first;
+    const std::string& attribute_name = element.second;
 
-    std::vector<std::string> tuple_elements = QueryParserUtils::SplitStringAlongChar(select_phrase_synonym, ',');
-    for (std::string& element : tuple_elements) {
-      element = QueryParserUtils::StripWhitespace(element);
-
-      if (std::regex_match(element, QueryRegex::STARTS_WITH_VALID_SYNONYM_REGEX)) {
-        if (synonym_to_design_entity_type_mappings.count(element) == 1) {
-          tuple_entities.push_back(SelectedEntity(DesignEntity(synonym_to_design_entity_type_mappings[element], element)));
-        } else {
-          QueryParser::ThrowSemanticError("Synonym " + element + " used in Select clause but not declared previously.");
-        }
-      } else {
-        // Previous regex validation ensures that it is an attribute, if not a synonym
-        tuple_entities.push_back(SelectedEntity(QueryParser::CreateAttributeSelectedEntityFromString(element, synonym_to_design_entity_type_mappings)));
-      }
+    if (!attribute_name.empty()) {
+      selected_entities.push_back(SelectedEntity(QueryParser::CreateAttributeSelectedEntity(synonym, attribute_name, synonym_to_design_entity_type_mappings)));
+    } else if (synonym_to_design_entity_type_mappings.count(synonym) == 1) {
+      selected_entities.push_back(SelectedEntity(DesignEntity(synonym_to_design_entity_type_mappings[synonym], synonym)));
+    } else {
+      QueryParser::ThrowSemanticError("Synonym " + synonym + " used in Select clause but not declared previously.");
     }
-
-    return_query = Query(tuple_entities);
-
-  } else if (synonym_to_design_entity_type_mappings.count(select_phrase_synonym) == 1) {
-    // If none of the above are true, assume that it is a synonym
-    return_query = Query(SelectedEntity(DesignEntity(synonym_to_design_entity_type_mappings[select_phrase_synonym], select_phrase_synonym)));
-  } else {
-    QueryParser::ThrowSemanticError("Synonym " + select_phrase_synonym + " used in Select clause but not declared previously.");
   }
 
-  return return_query;
+  if (is_tuple) {
+    return Query(selected_entities);
+  }
+  return Query(selected_entities[0]);
 }
 
-Query QueryParser::ParseConditionalClauses(std::string& remaining_conditional_clauses, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings, Query query) {
+Query QueryParser::ParseConditionalClauses(QueryTokenizer& tokenizer, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings, Query query) {
   ClauseType most_recent_clause_type = ClauseType::UNDEFINED;
 
-  while (std::regex_search(remaining_conditional_clauses, QueryRegex::STARTS_WITH_VALID_CONDITION_CLAUSE_REGEX)) {
-    // Substitute out the syntactic sugar 'and' between each clause
-    remaining_conditional_clauses = QueryParser::ReplaceKeywordAnd(remaining_conditional_clauses, most_recent_clause_type);
-
-    std::pair<std::string, std::string> split_conditional_clauses = QueryParserUtils::PopMatchFromFront(
-        remaining_conditional_clauses, QueryRegex::STARTS_WITH_VALID_CONDITION_CLAUSE_REGEX);
-    std::string next_conditional_clause = split_conditional_clauses.first;
-    remaining_conditional_clauses = split_conditional_clauses.second;
+  tokenizer.SkipWhitespace();
+  while (!tokenizer.IsAtEnd()) {
+    ClauseType clause_type = QueryParser::ParseClauseKeyword(tokenizer, most_recent_clause_type);
 
-    if (std::regex_match(next_conditional_clause, QueryRegex::STARTS_WITH_VALID_WITH_CLAUSE_REGEX)) {
-      WithClause with_clause = QueryParser::ParseWithClause(next_conditional_clause, synonym_to_design_entity_type_mappings);
+    if (clause_type == ClauseType::WITH) {
+      WithClause with_clause = QueryParser::ParseWithClause(tokenizer, synonym_to_design_entity_type_mappings);
       query.AddClause(Clause(with_clause));
-      most_recent_clause_type = ClauseType::WITH;
-    } else if (std::regex_match(next_conditional_clause, QueryRegex::STARTS_WITH_VALID_PATTERN_CLAUSE_REGEX)) {
-      PatternClause pattern_clause = QueryParser::ParsePatternClause(next_conditional_clause, synonym_to_design_entity_type_mappings);
+    } else if (clause_type == ClauseType::PATTERN) {
+      PatternClause pattern_clause = QueryParser::ParsePatternClause(tokenizer, synonym_to_design_entity_type_mappings);
       query.AddClause(Clause(pattern_clause));
-      most_recent_clause_type = ClauseType::PATTERN;
-    } else if (std::regex_match(next_conditional_clause, QueryRegex::STARTS_WITH_VALID_SUCH_THAT_CLAUSE_REGEX)) {
-        SuchThatClause such_that_clause = QueryParser::ParseSuchThatClause(next_conditional_clause,
-                                                                           synonym_to_design_entity_type_mappings);
-        query.AddClause(Clause(such_that_clause));
-        most_recent_clause_type = ClauseType::SUCHTHAT;
+    } else {
+      SuchThatClause such_that_clause = QueryParser::ParseSuchThatClause(tokenizer, synonym_to_design_entity_type_mappings);
+      query.AddClause(Clause(such_that_clause));
     }
-  }
+    most_recent_clause_type = clause_type;
 
-  remaining_conditional_clauses = QueryParserUtils::StripWhitespace(remaining_conditional_clauses);
-  if (remaining_conditional_clauses != "") {
-    throw std::runtime_error("Query does not satisfy the valid PQL concrete grammar for conditional clauses.");
+    tokenizer.SkipWhitespace();
   }
 
   return query;
 }
 
-SuchThatClause QueryParser::ParseSuchThatClause(std::string& such_that_clause, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  // Identify if each synonym in the 'such that' clause is valid, based on whether it exists in synonym_to_design_entity_type_mappings
+ClauseType QueryParser::ParseClauseKeyword(QueryTokenizer& tokenizer, ClauseType most_recent_clause_type) {
+  // Every keyword must be followed by whitespace; the syntactic sugar 'and' repeats the most recent keyword
+  size_t keyword_start = tokenizer.GetPosition();
+  if (tokenizer.ReadKeyword("with") && tokenizer.SkipWhitespace()) {
+    return ClauseType::WITH;
+  }
+
+  tokenizer.SetPosition(keyword_start);
+  if (tokenizer.ReadKeyword("pattern") && tokenizer.SkipWhitespace()) {
+    return ClauseType::PATTERN;
+  }
+
+  tokenizer.SetPosition(keyword_start);
+  if (tokenizer.ReadKeyword("such") && tokenizer.SkipWhitespace() && tokenizer.ReadKeyword("that") && tokenizer.SkipWhitespace()) {
+    return ClauseType::SUCHTHAT;
+  }
+
+  tokenizer.SetPosition(keyword_start);
+  if (tokenizer.ReadKeyword("and") && tokenizer.SkipWhitespace()) {
+    if (most_recent_clause_type == ClauseType::UNDEFINED) {
+      throw std::runtime_error("Query uses 'and' as the first clause.");
+    }
+    return most_recent_clause_type;
+  }
+
+  throw std::runtime_error(kSyntaxErrorMessage);
+}
+
+SuchThatClause QueryParser::ParseSuchThatClause(QueryTokenizer& tokenizer, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
+  // Identify the design abstraction involved, and the kinds of references it takes
+  std::string design_abstraction_string = tokenizer.ReadName();
+  if (!IsDesignAbstraction(design_abstraction_string)) {
+    QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
+  }
+  bool is_modifies_or_uses = design_abstraction_string == "Modifies" || design_abstraction_string == "Uses";
+  bool is_calls = design_abstraction_string == "Calls";
+  if (!is_modifies_or_uses && tokenizer.ReadChar('*')) {
+    design_abstraction_string += "*";
+  }
+
+  tokenizer.SkipWhitespace();
+  QueryParser::ExpectChar(tokenizer, '(');
+  tokenizer.SkipWhitespace();
+  std::string lhs = QueryParser::ReadClauseParam(tokenizer, !is_calls, is_modifies_or_uses || is_calls);
+  tokenizer.SkipWhitespace();
+  QueryParser::ExpectChar(tokenizer, ',');
+  tokenizer.SkipWhitespace();
+  std::string rhs = QueryParser::ReadClauseParam(tokenizer, !is_modifies_or_uses && !is_calls, is_modifies_or_uses || is_calls);
+  tokenizer.SkipWhitespace();
+  QueryParser::ExpectChar(tokenizer, ')');
 
-  // Identify the design abstraction involved
-  std::string design_abstraction_string = QueryParserUtils::GetAllMatchesFromString(such_that_clause,
-                                                                                    QueryRegex::VALID_DESIGN_ABSTRACTION_REGEX)
-                                              .at(0);
   DesignAbstraction design_abstraction = QueryUtils::ConvertStringToDesignAbstraction(design_abstraction_string);
+  if (!extension.has_next_bip && (design_abstraction == DesignAbstraction::NEXTBIP || design_abstraction == DesignAbstraction::NEXTBIP_T)) {
+    QueryParser::ThrowSyntaxError("NextBip/* has not been turned on as an extension");
+  }
+  if (!extension.has_affects_bip && (design_abstraction == DesignAbstraction::AFFECTSBIP || design_abstraction == DesignAbstraction::AFFECTSBIP_T)) {
+    QueryParser::ThrowSyntaxError("AffectsBip/* has not been turned on as an extension");
+  }
 
-  // First identify the entire chunk of parameters for the design abstraction, so you can isolate the parameters
-  std::string design_abstraction_inputs = QueryParserUtils::GetAllMatchesFromString(such_that_clause,
-                                                                                    QueryRegex::VALID_DESIGN_ABSTRACTION_PARAMETERS_REGEX)
-                                              .at(0);
-
-  // Obfuscate synonym strings to prevent them from matching the synonym regex specifically,
-  //		since they are not subject to the same logic-based checking.
-  std::string obfuscated_design_abstraction_inputs = std::regex_replace(design_abstraction_inputs, QueryRegex::VALID_SYNONYM_STRING_REGEX, "~");
-  std::vector<std::string> design_abstraction_synonyms = QueryParserUtils::GetAllMatchesFromString(obfuscated_design_abstraction_inputs,
-                                                                                                   QueryRegex::VALID_SYNONYM_REGEX);
-
-  // Then, verify that any synonyms were declared.
-  for (const std::string& synonym : design_abstraction_synonyms) {
-    if (synonym_to_design_entity_type_mappings.count(synonym) == 0) {
-      QueryParser::ThrowSemanticError("Synonym " + synonym + " used in 'such that' clause but not declared previously.");
+  // Verify that any synonyms were declared
+  for (const std::string& param : {lhs, rhs}) {
+    if (IsName(param) && synonym_to_design_entity_type_mappings.count(param) == 0) {
+      QueryParser::ThrowSemanticError("Synonym " + param + " used in 'such that' clause but not declared previously.");
     }
   }
 
-  // Translate the parameters of the design abstraction into a SuchThatClause
-  std::vector<std::string> design_abstraction_parameters = QueryParserUtils::GetAllMatchesFromString(design_abstraction_inputs,
-                                                                                                     QueryRegex::VALID_DESIGN_ABSTRACTION_PARAMETER_REGEX);
-  ClauseParam lhs_clause_param = QueryParser::CreateClauseParamFromString(design_abstraction_parameters.at(0), synonym_to_design_entity_type_mappings);
-  ClauseParam rhs_clause_param = QueryParser::CreateClauseParamFromString(design_abstraction_parameters.at(1), synonym_to_design_entity_type_mappings);
+  ClauseParam lhs_clause_param = QueryParser::CreateClauseParamFromString(lhs, synonym_to_design_entity_type_mappings);
+  ClauseParam rhs_clause_param = QueryParser::CreateClauseParamFromString(rhs, synonym_to_design_entity_type_mappings);
 
   return SuchThatClause(design_abstraction, lhs_clause_param, rhs_clause_param);
 }
 
-PatternClause QueryParser::ParsePatternClause(std::string& pattern_clause, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  // Identify if each synonym in the 'pattern' clause is valid, based on whether it exists in synonym_to_design_entity_type_mappings
-
+PatternClause QueryParser::ParsePatternClause(QueryTokenizer& tokenizer, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
   /*
-		It is known (via regex validation) that the format is:
+		The grammar of every variant of the 'pattern' clause is:
 			- Synonym
 			- "("
 			- First parameter
 			- ","
-			- Second parameter
+			- Second parameter: an expression in quotes, optionally surrounded by wildcards, or a wildcard
 			- ")"
-		Or, if it is an if pattern clauses, then:
+		Or, if it is an if pattern clause, then:
 			- Synonym
 			- "("
 			- First parameter
 			- ","
-			- Second parameter
+			- Second parameter: a wildcard
 			- ","
-			- Third parameter
+			- Third parameter: a wildcard
 			- ")"
-		This knowledge is used to split the query appropriately.
+		Which variant is valid depends on the type of the synonym, so that is only checked after parsing.
 	*/
 
-  std::string pattern_parameters = QueryParserUtils::GetAllMatchesFromString(pattern_clause,
-                                                                             QueryRegex::VALID_PATTERN_PARAMETERS_REGEX)
-                                       .at(0);
-
-  // Split the parameters along the notable tokens (which are guaranteed because the string has been syntactically validated)
-  // The strange ordering helps protect against splitting along a parenthesis in the pattern expression instead.
-  std::vector<std::string> parameters_split_by_comma = QueryParserUtils::SplitStringAlongChar(pattern_parameters, ',');
-  std::vector<std::string> parameters_split_by_left_bracket = QueryParserUtils::SplitStringAlongChar(parameters_split_by_comma.front(), '(');
-
-  // Identify the design entity type of the synonym at the front
-  std::string pattern_clause_synonym = QueryParserUtils::StripWhitespace(parameters_split_by_left_bracket.at(0));
+  std::string pattern_clause_synonym = tokenizer.ReadName();
+  if (pattern_clause_synonym.empty()) {
+    QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
+  }
+  tokenizer.SkipWhitespace();
+  QueryParser::ExpectChar(tokenizer, '(');
+  tokenizer.SkipWhitespace();
+  std::string pattern_clause_first_param = QueryParser::ReadClauseParam(tokenizer, false, true);
+  tokenizer.SkipWhitespace();
+  QueryParser::ExpectChar(tokenizer, ',');
+  tokenizer.SkipWhitespace();
+
+  std::string expression;
+  bool has_expression = false;
+  bool is_partial_expression = false;
+  bool has_third_param = false;
+  if (tokenizer.ReadQuotedString(expression)) {
+    has_expression = true;
+  } else if (tokenizer.ReadChar('_')) {
+    tokenizer.SkipWhitespace();
+    if (tokenizer.ReadQuotedString(expression)) {
+      tokenizer.SkipWhitespace();
+      QueryParser::ExpectChar(tokenizer, '_');
+      has_expression = true;
+      is_partial_expression = true;
+    } else if (tokenizer.ReadChar(',')) {
+      tokenizer.SkipWhitespace();
+      QueryParser::ExpectChar(tokenizer, '_');
+      has_third_param = true;
+    }
+  } else {
+    QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
+  }
+  // Wildcards and quotes may only surround the expression, never appear within it
+  if (has_expression && (expression.empty() || expression.find('_') != std::string::npos)) {
+    QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
+  }
+  tokenizer.SkipWhitespace();
+  QueryParser::ExpectChar(tokenizer, ')');
 
   // Verify that the synonym used is a declared variable
   if (synonym_to_design_entity_type_mappings.count(pattern_clause_synonym) == 0) {
     QueryParser::ThrowSemanticError("Synonym " + pattern_clause_synonym + " used at front of 'pattern' clause but not declared previously.");
   }
 
-  // The value of the first parameter is shared between all variants. The second and third are not.
-  std::string pattern_clause_first_param = QueryParserUtils::StripWhitespace(parameters_split_by_left_bracket.at(1));
-  std::string pattern_clause_second_param;
-  std::string pattern_clause_third_param;
-  std::vector<std::string> parameters_split_by_right_bracket = QueryParserUtils::SplitStringAlongChar(parameters_split_by_comma.back(), ')');
-
-  // Verify that the synonym used is of assign/if/while type
+  // Verify that the synonym used is of assign/if/while type. An assign pattern with the wildcards of an if
+  // pattern is read as a wildcard, and so is a while pattern with them.
   switch (synonym_to_design_entity_type_mappings[pattern_clause_synonym]) {
     case DesignEntityType::ASSIGN:
-      pattern_clause_second_param = QueryParserUtils::GetAllMatchesFromString(parameters_split_by_comma.at(1),
-                                                                              QueryRegex::VALID_ASSIGN_PATTERN_SECOND_PARAMETER_REGEX)
-                                        .at(0);
       break;
     case DesignEntityType::WHILE:
-      pattern_clause_second_param = QueryParserUtils::StripWhitespace(parameters_split_by_right_bracket.at(0));
-      if (pattern_clause_second_param != "_") {
+      if (has_expression) {
         QueryParser::ThrowSemanticError("'pattern' clause of 'while' type contains a non-wildcard as second parameter.");
       }
       break;
     case DesignEntityType::IF:
-      pattern_clause_second_param = QueryParserUtils::StripWhitespace(parameters_split_by_comma.at(1));
-      pattern_clause_third_param = QueryParserUtils::StripWhitespace(parameters_split_by_right_bracket.at(0));
-      if (pattern_clause_second_param != "_" || pattern_clause_third_param != "_") {
+      if (!has_third_param) {
         QueryParser::ThrowSemanticError("'pattern' clause of 'if' type contains a non-wildcard as second or third parameter.");
       }
       break;
@@ -348,104 +418,128 @@ PatternClause QueryParser::ParsePatternClause(std::string& pattern_clause, std::
       QueryParser::ThrowSemanticError("Synonym " + pattern_clause_synonym + " used at front of 'pattern' clause but not of 'assign', 'if', or 'while' type.");
   }
 
-  // Obfuscate synonym strings to prevent them from matching the synonym regex specifically,
-  //		since they are not subject to the same logic-based checking.
-  std::string obfuscated_first_parameter = std::regex_replace(pattern_clause_first_param, QueryRegex::VALID_SYNONYM_STRING_REGEX, "~");
-  // Ensure that what remains has been declared
-  std::vector<std::string> first_param_synonyms = QueryParserUtils::GetAllMatchesFromString(obfuscated_first_parameter,
-                                                                                            QueryRegex::VALID_SYNONYM_REGEX);
-
-  for (const std::string& synonym : first_param_synonyms) {
-    if (synonym_to_design_entity_type_mappings.count(synonym) == 0) {
-      QueryParser::ThrowSemanticError("Synonym " + synonym + " used in 'pattern' clause but not declared previously.");
-    }
+  // Ensure that the first parameter has been declared, if it is a synonym
+  if (IsName(pattern_clause_first_param) && synonym_to_design_entity_type_mappings.count(pattern_clause_first_param) == 0) {
+    QueryParser::ThrowSemanticError("Synonym " + pattern_clause_first_param + " used in 'pattern' clause but not declared previously.");
   }
 
   // If the second parameter is a wildcard, insert that.
-  // Else, parse and validate the pattern expression via helper methods.
+  // Else, parse and validate the pattern expression.
   // Note again that the third parameter of the 'if' pattern clause is not considered, since it is known to be a wildcard only.
+  ClauseParam pattern_clause_second_param = ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_"));
+  if (has_expression) {
+    pattern_clause_second_param = ClauseParam(PatternExpression(
+        parser_utils::ExpressionParser::ParseExpression(expression), is_partial_expression));
+  }
+
   return PatternClause(
       DesignEntity(synonym_to_design_entity_type_mappings[pattern_clause_synonym], pattern_clause_synonym),
       QueryParser::CreateClauseParamFromString(pattern_clause_first_param, synonym_to_design_entity_type_mappings),
-      QueryParser::CreatePatternExpressionClauseParamFromString(pattern_clause_second_param));
+      pattern_clause_second_param);
 }
 
-WithClause QueryParser::ParseWithClause(std::string& with_clause, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  std::string with_clause_body = QueryParserUtils::PopMatchFromFront(with_clause, QueryRegex::STARTS_WITH_WITH_STRING_REGEX).second;
-
-  std::vector<std::string> with_clause_parameters = QueryParserUtils::GetAllMatchesFromString(with_clause_body,
-                                                                                              QueryRegex::VALID_WITH_CLAUSE_PARAMETER_REGEX);
-
-  std::string first_parameter = with_clause_parameters.at(0);
-  std::string second_parameter = with_clause_parameters.at(1);
+WithClause QueryParser::ParseWithClause(QueryTokenizer& tokenizer, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
+  std::string first_parameter = QueryParser::ReadWithClauseParam(tokenizer);
+  tokenizer.SkipWhitespace();
+  QueryParser::ExpectChar(tokenizer, '=');
+  tokenizer.SkipWhitespace();
+  std::string second_parameter = QueryParser::ReadWithClauseParam(tokenizer);
 
   // Convert synonym attribute parameters to their correct forms and create 'with' clause
-  return WithClause(
-      QueryParser::CreateWithClauseParamFromString(first_parameter, synonym_to_design_entity_type_mappings),
-      QueryParser::CreateWithClauseParamFromString(second_parameter, synonym_to_design_entity_type_mappings));
+  std::pair<ClauseParam, AttributeType> lhs = QueryParser::CreateWithClauseParamFromString(first_parameter, synonym_to_design_entity_type_mappings);
+  std::pair<ClauseParam, AttributeType> rhs = QueryParser::CreateWithClauseParamFromString(second_parameter, synonym_to_design_entity_type_mappings);
+  return WithClause(lhs, rhs);
 }
 
-ClauseParam QueryParser::CreateClauseParamFromString(std::string& clause_param_string, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_WILDCARD_TOKEN_REGEX)) {
-    return ClauseParam(DesignEntity(DesignEntityType::WILDCARD, clause_param_string));
-  } else if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_SYNONYM_STRING_REGEX)) {
-    std::string clause_param_string_quotes_removed = std::regex_replace(clause_param_string, QueryRegex::QUOTES_REGEX, "");
-    return ClauseParam(clause_param_string_quotes_removed);
-  } else if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_SYNONYM_REGEX)) {
-    DesignEntityType synonym_type = synonym_to_design_entity_type_mappings[clause_param_string];
-    return ClauseParam(DesignEntity(synonym_type, clause_param_string));
-  } else if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_INTEGER_REGEX)) {
-    return ClauseParam(std::stoi(clause_param_string));
-  } else {
-    throw std::runtime_error("String to be constructed into ClauseParam does not fit any of the available regexes.");
+std::string QueryParser::ReadClauseParam(QueryTokenizer& tokenizer, bool is_integer_allowed, bool is_name_allowed) {
+  // Returns the parameter as written in the query: a wildcard, a synonym, an integer or a name in quotes
+  if (tokenizer.ReadChar('_')) {
+    return "_";
+  }
+
+  std::string param = tokenizer.ReadName();
+  if (param.empty() && is_integer_allowed) {
+    param = tokenizer.ReadInteger();
+  }
+  if (param.empty() && is_name_allowed) {
+    std::string name;
+    if (tokenizer.ReadQuotedString(name) && IsName(name)) {
+      param = "\"" + name + "\"";
+    }
+  }
+
+  if (param.empty()) {
+    QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
   }
+  return param;
 }
 
-std::pair<DesignEntity, AttributeType> QueryParser::CreateAttributeSelectedEntityFromString(std::string& clause_param_string,
-                                                                                            std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_ATTRIBUTE_REFERENCE_REGEX)) {
-    std::pair<std::string, AttributeType> synonym_attribute_pair = QueryParser::ParseSynonymAttribute(clause_param_string,
-                                                                                                      synonym_to_design_entity_type_mappings);
-    std::string synonym = synonym_attribute_pair.first;
-    AttributeType attribute_type = synonym_attribute_pair.second;
+std::string QueryParser::ReadWithClauseParam(QueryTokenizer& tokenizer) {
+  // Returns the parameter as written in the query: an attribute reference, a synonym, an integer or a name in quotes
+  std::string param = tokenizer.ReadName();
+  if (!param.empty()) {
+    size_t attribute_start = tokenizer.GetPosition();
+    std::string attribute_name;
+    if (tokenizer.ReadChar('.') && !(attribute_name = tokenizer.ReadAttributeName()).empty()) {
+      return param + "." + attribute_name;
+    }
+    tokenizer.SetPosition(attribute_start);
+    return param;
+  }
 
-    return std::pair<DesignEntity, AttributeType>(DesignEntity(synonym_to_design_entity_type_mappings[synonym], synonym), attribute_type);
-  } else {
-    throw std::runtime_error("String passed to method is not a valid attribute.");
+  std::string name;
+  if (tokenizer.ReadQuotedString(name)) {
+    if (!IsName(name)) {
+      QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
+    }
+    return "\"" + name + "\"";
+  }
+
+  param = tokenizer.ReadInteger();
+  if (param.empty()) {
+    QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
+  }
+  return param;
+}
+
+void QueryParser::ExpectChar(QueryTokenizer& tokenizer, char expected_char) {
+  if (!tokenizer.ReadChar(expected_char)) {
+    QueryParser::ThrowSyntaxError(kSyntaxErrorMessage);
   }
 }
 
-ClauseParam QueryParser::CreatePatternExpressionClauseParamFromString(std::string& clause_param_string) {
-  clause_param_string = QueryParserUtils::StripWhitespace(clause_param_string);
-  if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_WILDCARD_TOKEN_REGEX)) {
+ClauseParam QueryParser::CreateClauseParamFromString(const std::string& clause_param_string, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
+  if (clause_param_string == "_") {
     return ClauseParam(DesignEntity(DesignEntityType::WILDCARD, clause_param_string));
-  } else if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_ASSIGN_PATTERN_EXPRESSION_WILDCARD_REGEX)) {
-    std::string clause_param_string_quotes_removed = std::regex_replace(clause_param_string, QueryRegex::QUOTES_REGEX, "");
-    std::string clause_param_string_wildcards_removed = std::regex_replace(clause_param_string_quotes_removed, QueryRegex::WILDCARD_TOKEN_REGEX, "");
-    return ClauseParam(PatternExpression(
-        parser_utils::ExpressionParser::ParseExpression(clause_param_string_wildcards_removed), true));
-  } else if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_ASSIGN_PATTERN_EXPRESSION_WITH_QUOTES_REGEX)) {
-    std::string clause_param_string_quotes_removed = std::regex_replace(clause_param_string, QueryRegex::QUOTES_REGEX, "");
-    return ClauseParam(PatternExpression(
-        parser_utils::ExpressionParser::ParseExpression(clause_param_string_quotes_removed), false));
+  } else if (clause_param_string.front() == '"') {
+    return ClauseParam(clause_param_string.substr(1, clause_param_string.size() - 2));
+  } else if (IsName(clause_param_string)) {
+    DesignEntityType synonym_type = synonym_to_design_entity_type_mappings[clause_param_string];
+    return ClauseParam(DesignEntity(synonym_type, clause_param_string));
   } else {
-    throw std::runtime_error("String to be constructed into ClauseParam does not fit any of the available pattern regexes.");
+    return ClauseParam(QueryParser::ConvertStringToInteger(clause_param_string));
   }
 }
 
-std::pair<ClauseParam, AttributeType> QueryParser::CreateWithClauseParamFromString(std::string& clause_param_string,
+std::pair<DesignEntity, AttributeType> QueryParser::CreateAttributeSelectedEntity(const std::string& synonym, const std::string& attribute_name,
+                                                                                  std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
+  AttributeType attribute_type = QueryParser::ParseSynonymAttribute(synonym, attribute_name, synonym_to_design_entity_type_mappings);
+  return std::pair<DesignEntity, AttributeType>(DesignEntity(synonym_to_design_entity_type_mappings[synonym], synonym), attribute_type);
+}
+
+std::pair<ClauseParam, AttributeType> QueryParser::CreateWithClauseParamFromString(const std::string& clause_param_string,
                                                                                    std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_ATTRIBUTE_REFERENCE_REGEX)) {
-    std::pair<std::string, AttributeType> synonym_attribute_pair = QueryParser::ParseSynonymAttribute(clause_param_string,
-                                                                                                      synonym_to_design_entity_type_mappings);
-    std::string synonym = synonym_attribute_pair.first;
-    AttributeType attribute_type = synonym_attribute_pair.second;
+  size_t attribute_separator = clause_param_string.find('.');
+  if (attribute_separator != std::string::npos) {
+    std::string synonym = clause_param_string.substr(0, attribute_separator);
+    AttributeType attribute_type = QueryParser::ParseSynonymAttribute(synonym, clause_param_string.substr(attribute_separator + 1),
+                                                                      synonym_to_design_entity_type_mappings);
 
     return std::pair<ClauseParam, AttributeType>(QueryParser::CreateClauseParamFromString(synonym, synonym_to_design_entity_type_mappings), attribute_type);
-  } else if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_SYNONYM_STRING_REGEX)) {
+  } else if (clause_param_string.front() == '"') {
     return std::pair<ClauseParam, AttributeType>(QueryParser::CreateClauseParamFromString(clause_param_string, synonym_to_design_entity_type_mappings),
                                                  AttributeType::NAME);
-  } else if (std::regex_match(clause_param_string, QueryRegex::STARTS_WITH_VALID_INTEGER_REGEX)) {
+  } else if (!IsName(clause_param_string)) {
     return std::pair<ClauseParam, AttributeType>(QueryParser::CreateClauseParamFromString(clause_param_string, synonym_to_design_entity_type_mappings),
                                                  AttributeType::INTEGER);
   }
@@ -459,34 +553,29 @@ std::pair<ClauseParam, AttributeType> QueryParser::CreateWithClauseParamFromStri
   }
 }
 
-std::pair<std::string, AttributeType> QueryParser::ParseSynonymAttribute(std::string& synonym_attribute, std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
-  std::vector<std::string> attribute_values = QueryParserUtils::SplitStringAlongChar(synonym_attribute, '.');
-  std::string synonym = attribute_values.at(0);
-  std::string type = attribute_values.at(1);
-
+AttributeType QueryParser::ParseSynonymAttribute(const std::string& synonym, const std::string& attribute_name,
+                                                 std::map<std::string, DesignEntityType>& synonym_to_design_entity_type_mappings) {
   // Check if this synonym has been declared
   if (synonym_to_design_entity_type_mappings.count(synonym) == 0) {
     QueryParser::ThrowSemanticError("Synonym " + synonym + " used but not declared previously.");
   }
 
-  AttributeType attribute_type = QueryUtils::ConvertStringToAttributeType(type);
-
-  return std::pair<std::string, AttributeType>(synonym, attribute_type);
+  return QueryUtils::ConvertStringToAttributeType(attribute_name);
 }
 
-std::string& QueryParser::ReplaceKeywordAnd(std::string& string_to_replace, ClauseType most_recent_clause_type) {
-  if (!std::regex_search(string_to_replace, QueryRegex::STARTS_WITH_OPTIONAL_SPACE_AND_AND_STRING_REGEX)) {
-    return string_to_replace;
-  }
-
-  if (most_recent_clause_type != ClauseType::UNDEFINED) {
-    string_to_replace = QueryParserUtils::PopMatchFromFront(string_to_replace, QueryRegex::STARTS_WITH_OPTIONAL_SPACE_AND_AND_STRING_REGEX).second;
-    string_to_replace = QueryUtils::ConvertClauseTypeToString(most_recent_clause_type) + string_to_replace;
-  } else {
-    throw std::runtime_error("Query uses 'and' as the first clause.");
+int QueryParser::ConvertStringToInteger(const std::string& integer_string) {
+  long long value = 0;
+  for (char digit : integer_string) {
+    value = value * 10 + (digit - '0');
+    if (value > INT_MAX) {
+      QueryParser::ThrowSyntaxError("Integer " + integer_string + " is too large to be a statement number.");
+    }
   }
+  return static_cast<int>(value);
+}
 
-  return string_to_replace;
+void QueryParser::ThrowSyntaxError(std::string error_message) {
+  throw std::runtime_error(error_message);
 }
 
 void QueryParser::ThrowSemanticError(std::string error_message) {
@@ -5,32 +5,47 @@
 #include <vector>
 
 #include "query_processor/commons/query/Query.h"
+#include "query_processor/query_parser/utils/QueryTokenizer.h"
+#include "utils/Extension.h"
 
 namespace query_processor {
 
+/*
+  Parses one query at a time. Every parse runs on its own QueryParser, which holds what has been learnt of
+  the query so far and the extensions the query may use, so that queries can be parsed on many threads
+  for programs analysed with different extensions.
+*/
 class QueryParser {
  public:
-  static Query ParseQuery(std::string&);
-  static Query GenerateQuery(std::string&);
+  // NextBip/* and AffectsBip/* clauses are only valid if their extension is in the given extensions
+  static Query ParseQuery(std::string&, const utils::Extension& = utils::Extension());
+  static Query GenerateQuery(std::string&, const utils::Extension& = utils::Extension());
 
  private:
-  static void ParseDeclarationClauses(std::string&, std::map<std::string, DesignEntityType>&);
-  static Query ParseSelectPhrase(std::string&, std::map<std::string, DesignEntityType>&);
-  static Query ParseConditionalClauses(std::string&, std::map<std::string, DesignEntityType>&, Query);
-  static SuchThatClause ParseSuchThatClause(std::string&, std::map<std::string, DesignEntityType>&);
-  static PatternClause ParsePatternClause(std::string&, std::map<std::string, DesignEntityType>&);
-  static WithClause ParseWithClause(std::string&, std::map<std::string, DesignEntityType>&);
-  static std::pair<DesignEntity, AttributeType> CreateAttributeSelectedEntityFromString(std::string&, std::map<std::string, DesignEntityType>&);
-  static ClauseParam CreateClauseParamFromString(std::string&, std::map<std::string, DesignEntityType>&);
-  static ClauseParam CreatePatternExpressionClauseParamFromString(std::string&);
-  static std::pair<ClauseParam, AttributeType> CreateWithClauseParamFromString(std::string&, std::map<std::string, DesignEntityType>&);
-  static std::pair<std::string, AttributeType> ParseSynonymAttribute(std::string&, std::map<std::string, DesignEntityType>&);
-  static std::string& ReplaceKeywordAnd(std::string&, ClauseType);
-  static void ThrowSemanticError(std::string);
-  static void ResetBooleans();
-  static bool is_boolean_query;
-  static bool is_semantic_error;
-  static bool has_declaration_error;
+  explicit QueryParser(const utils::Extension&);
+  Query Generate(std::string&);
+  void ParseDeclarationClauses(QueryTokenizer&, std::map<std::string, DesignEntityType>&);
+  Query ParseSelectPhrase(QueryTokenizer&, std::map<std::string, DesignEntityType>&);
+  Query ParseConditionalClauses(QueryTokenizer&, std::map<std::string, DesignEntityType>&, Query);
+  ClauseType ParseClauseKeyword(QueryTokenizer&, ClauseType);
+  SuchThatClause ParseSuchThatClause(QueryTokenizer&, std::map<std::string, DesignEntityType>&);
+  PatternClause ParsePatternClause(QueryTokenizer&, std::map<std::string, DesignEntityType>&);
+  WithClause ParseWithClause(QueryTokenizer&, std::map<std::string, DesignEntityType>&);
+  static std::string ReadClauseParam(QueryTokenizer&, bool, bool);
+  static std::string ReadWithClauseParam(QueryTokenizer&);
+  static void ExpectChar(QueryTokenizer&, char);
+  std::pair<DesignEntity, AttributeType> CreateAttributeSelectedEntity(const std::string&, const std::string&, std::map<std::string, DesignEntityType>&);
+  ClauseParam CreateClauseParamFromString(const std::string&, std::map<std::string, DesignEntityType>&);
+  std::pair<ClauseParam, AttributeType> CreateWithClauseParamFromString(const std::string&, std::map<std::string, DesignEntityType>&);
+  AttributeType ParseSynonymAttribute(const std::string&, const std::string&, std::map<std::string, DesignEntityType>&);
+  static int ConvertStringToInteger(const std::string&);
+  static void ThrowSyntaxError(std::string);
+  void ThrowSemanticError(std::string);
+
+  utils::Extension extension;
+  bool is_boolean_query = false;
+  bool is_semantic_error = false;
+  bool has_declaration_error = false;
 };
 
-}  // namespace query_processor
\ No newline at end of file
+}  // namespace query_processor
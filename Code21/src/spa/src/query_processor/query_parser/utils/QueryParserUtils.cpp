@@ -2,14 +2,13 @@
 #include "utils/Extension.h"
 
 
+#include <cctype>
 #include <iostream>
 #include <iterator>
 #include <regex>
 #include <sstream>
 #include <stdexcept>
 
-#include "QueryRegex.h"
-
 namespace query_processor {
 
 
@@ -19,11 +18,21 @@ std::string& QueryParserUtils::StripWhitespace(std::string& input_string) {
 		Also remove all non-space whitespace between characters, and reduces redundant spaces to 1 space.
 	*/
 
-  // Replace all consecutive spaces with a single space
-  input_string = std::regex_replace(input_string, QueryRegex::ONE_OR_MORE_WHITESPACE_REGEX, " ");
-
-  // Strip all spaces from the front and back of the substrings
-  input_string = std::regex_replace(input_string, QueryRegex::LEADING_OR_TRAILING_SPACE_REGEX, "");
+  // Replace all consecutive whitespace with a single space, dropping it at the front and back
+  size_t stripped_length = 0;
+  bool is_after_whitespace = false;
+  for (char c : input_string) {
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      is_after_whitespace = true;
+      continue;
+    }
+    if (is_after_whitespace && stripped_length > 0) {
+      input_string[stripped_length++] = ' ';
+    }
+    input_string[stripped_length++] = c;
+    is_after_whitespace = false;
+  }
+  input_string.resize(stripped_length);
 
   return input_string;
 }
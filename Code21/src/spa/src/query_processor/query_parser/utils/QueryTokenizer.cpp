@@ -0,0 +1,128 @@
+#include "QueryTokenizer.h"
+
+#include <cctype>
+
+namespace query_processor {
+
+namespace {
+
+bool IsWhitespace(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+bool IsAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+}  // namespace
+
+QueryTokenizer::QueryTokenizer(const std::string& query) : query(query) {}
+
+size_t QueryTokenizer::GetPosition() const {
+  return position;
+}
+
+void QueryTokenizer::SetPosition(size_t new_position) {
+  position = new_position;
+}
+
+bool QueryTokenizer::IsAtEnd() const {
+  return position >= query.size();
+}
+
+bool QueryTokenizer::SkipWhitespace() {
+  size_t start = position;
+  while (position < query.size() && IsWhitespace(query[position])) {
+    position++;
+  }
+  return position != start;
+}
+
+bool QueryTokenizer::PeekChar(char c) const {
+  return position < query.size() && query[position] == c;
+}
+
+bool QueryTokenizer::ReadChar(char c) {
+  if (!PeekChar(c)) {
+    return false;
+  }
+  position++;
+  return true;
+}
+
+bool QueryTokenizer::ReadKeyword(const std::string& keyword) {
+  if (query.compare(position, keyword.size(), keyword) != 0) {
+    return false;
+  }
+  position += keyword.size();
+  return true;
+}
+
+std::string QueryTokenizer::ReadName() {
+  size_t start = position;
+  if (position < query.size() && IsAlpha(query[position])) {
+    position++;
+    while (position < query.size() && (IsAlpha(query[position]) || IsDigit(query[position]))) {
+      position++;
+    }
+  }
+  return query.substr(start, position - start);
+}
+
+std::string QueryTokenizer::ReadWord() {
+  size_t start = position;
+  while (position < query.size() &&
+         (IsAlpha(query[position]) || IsDigit(query[position]) || query[position] == '_')) {
+    position++;
+  }
+  return query.substr(start, position - start);
+}
+
+std::string QueryTokenizer::ReadInteger() {
+  size_t start = position;
+  if (PeekChar('0')) {
+    position++;
+  } else {
+    while (position < query.size() && IsDigit(query[position])) {
+      position++;
+    }
+  }
+  return query.substr(start, position - start);
+}
+
+std::string QueryTokenizer::ReadAttributeName() {
+  static const std::string attribute_names[] = {"procName", "varName", "value", "stmt#"};
+  for (const std::string& attribute_name : attribute_names) {
+    if (ReadKeyword(attribute_name)) {
+      return attribute_name;
+    }
+  }
+  return "";
+}
+
+bool QueryTokenizer::ReadQuotedString(std::string& contents) {
+  if (!PeekChar('"')) {
+    return false;
+  }
+  size_t closing_quote = query.find('"', position + 1);
+  if (closing_quote == std::string::npos) {
+    return false;
+  }
+
+  contents.clear();
+  for (size_t i = position + 1; i < closing_quote; i++) {
+    if (!IsWhitespace(query[i])) {
+      contents += query[i];
+    } else if (contents.empty() || contents.back() != ' ') {
+      contents += ' ';
+    }
+  }
+  position = closing_quote + 1;
+  return true;
+}
+
+}  // namespace query_processor
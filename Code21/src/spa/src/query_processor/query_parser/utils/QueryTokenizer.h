@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace query_processor {
+
+/*
+  Reads the tokens of a PQL query one at a time, from a cursor that only ever moves forward (apart from
+  the parser rewinding a bounded lookahead). Which token comes next depends on where the parser is
+  (e.g. 'stmt#' after a '.', 'Follows*' before a '('), so the parser asks for the kind of token it expects
+  and the tokenizer reports whether the query continues with one. Every read is linear in the length of
+  the token, so a whole query is tokenized in time linear in its length.
+
+  Any run of whitespace counts as a single space, as the PQL grammar does not distinguish between them.
+*/
+class QueryTokenizer {
+ private:
+  const std::string& query;
+  size_t position = 0;
+
+ public:
+  explicit QueryTokenizer(const std::string&);
+
+  size_t GetPosition() const;
+
+  void SetPosition(size_t);
+
+  bool IsAtEnd() const;
+
+  /* skips a run of whitespace, returning whether there was any */
+  bool SkipWhitespace();
+
+  bool PeekChar(char) const;
+
+  bool ReadChar(char);
+
+  /* consumes the keyword if the query continues with it, regardless of what follows it */
+  bool ReadKeyword(const std::string&);
+
+  /* [a-zA-Z][a-zA-Z0-9]*, or "" if the query does not continue with a name */
+  std::string ReadName();
+
+  /* [a-zA-Z0-9_]*, so that design entity types such as 'prog_line' are read whole */
+  std::string ReadWord();
+
+  /* 0|[1-9][0-9]*, or "" if the query does not continue with an integer */
+  std::string ReadInteger();
+
+  /* the longest of 'procName', 'varName', 'value' and 'stmt#' the query continues with, or "" */
+  std::string ReadAttributeName();
+
+  /* the chars between a pair of double quotes, with whitespace runs collapsed into single spaces.
+     Returns false, consuming nothing, if the query does not continue with a quoted string */
+  bool ReadQuotedString(std::string&);
+};
+
+}  // namespace query_processor
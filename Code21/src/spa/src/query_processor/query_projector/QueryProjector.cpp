@@ -1,9 +1,10 @@
 #include "QueryProjector.h"
 
-#include <sstream>
+#include <string>
+#include <utility>
 
 namespace query_processor {
-std::list<std::string> QueryProjector::FormatResult(QueryResult raw_result) {
+std::list<std::string> QueryProjector::FormatResult(const QueryResult& raw_result) {
   std::list<std::string> result_list;
   if (raw_result.result_type == QueryResultType::STMTS && !raw_result.statement_indexes_or_constants.empty()) {
     result_list = QueryProjector::ConstructString<int>(raw_result.statement_indexes_or_constants);
@@ -23,25 +24,30 @@ std::list<std::string> QueryProjector::FormatResult(QueryResult raw_result) {
 }
 
 template <typename T>
-std::list<std::string> QueryProjector::ConstructString(std::unordered_set<T> result_set) {
+std::list<std::string> QueryProjector::ConstructString(const std::unordered_set<T>& result_set) {
   std::list<std::string> result_list;
-  typename std::unordered_set<T>::iterator iter;
+  typename std::unordered_set<T>::const_iterator iter;
   for (iter = result_set.begin(); iter != result_set.end(); iter++) {
     result_list.push_back(ToString(*iter));
   }
   return result_list;
 }
 
-std::list<std::string> QueryProjector::ConstructString(std::vector<std::vector<std::string>>& result_set) {
+std::list<std::string> QueryProjector::ConstructString(const std::vector<std::vector<std::string>>& result_set) {
   std::list<std::string> result_list;
   for (const auto& tuple : result_set) {
-    std::stringstream ss;
+    size_t tuple_length = 0;
     for (const auto& var : tuple) {
-      ss << var << ' ';
+      tuple_length += var.size() + 1;
+    }
+    std::string tuple_string;
+    tuple_string.reserve(tuple_length);
+    for (const auto& var : tuple) {
+      tuple_string += var;
+      tuple_string += ' ';
     }
-    std::string tuple_string = ss.str();
     tuple_string.pop_back();
-    result_list.push_back(tuple_string);
+    result_list.push_back(std::move(tuple_string));
   }
   return result_list;
 }
@@ -56,10 +62,11 @@ std::list<std::string> QueryProjector::ConstructString(bool boolean_result) {
   return result_list;
 }
 
-template <typename T>
-std::string QueryProjector::ToString(T t) {
-  std::stringstream s;
-  s << t;
-  return s.str();
+std::string QueryProjector::ToString(int stmt) {
+  return std::to_string(stmt);
+}
+
+const std::string& QueryProjector::ToString(const std::string& name) {
+  return name;
 }
 }  // namespace query_processor
\ No newline at end of file
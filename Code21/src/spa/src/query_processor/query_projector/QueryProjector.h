@@ -10,14 +10,14 @@
 namespace query_processor {
 class QueryProjector {
  public:
-  static std::list<std::string> FormatResult(QueryResult);
+  static std::list<std::string> FormatResult(const QueryResult&);
 
  private:
   template <typename T>
-  static std::list<std::string> ConstructString(std::unordered_set<T>);
+  static std::list<std::string> ConstructString(const std::unordered_set<T>&);
   static std::list<std::string> ConstructString(bool);
-  static std::list<std::string> ConstructString(std::vector<std::vector<std::string>>&);
-  template <typename T>
-  static std::string ToString(T);
+  static std::list<std::string> ConstructString(const std::vector<std::vector<std::string>>&);
+  static std::string ToString(int);
+  static const std::string& ToString(const std::string&);
 };
 }  // namespace query_processor
\ No newline at end of file
@@ -14,24 +14,22 @@
 
 namespace source_processor {
 
-// initialise the static TokenList
-TokenList Lexer::tokens = TokenList();
-
 const std::regex kAnyWhitespaces("\\s+");
 
 // These regex are ordered according to their precedence. The ones at the top
 // has higher precedence and must be tested for first in Lexer::Tokenise.
 // Some of the regex are made to be more lax; the strict checking of variables
 // is handled when constructing the Token object itself.
-// The last capture group must be the next chunk of raw input source to test.
-const std::regex kAssignNameTokenAndExpression("^\\s*([a-zA-Z][a-zA-Z0-9]*)\\s*=\\s*([\\s\\S]*?)\\s*(;\\s*[\\s\\S]*)");
-const std::regex kWhileConditionalExpression("^\\s*while\\s*(\\([\\s\\S]*?)\\s*(\\{[\\s\\S]*)");
-const std::regex kIfConditionalExpression("^\\s*if\\s*(\\([\\s\\S]*?)\\s*(then\\s*\\{[\\s\\S]*)");
-const std::regex kReservedKeywordToken("^\\s*(procedure|call|read|print|then|else)(\\s+[\\s\\S]*|\\{[\\s\\S]*)");
-const std::regex kNameToken("^\\s*([a-zA-Z0-9]+)\\s*([\\s\\S]*)");
-const std::regex kConstantValueToken("^\\s*([0-9]+)\\s*([\\s\\S]*)");
-const std::regex kParenthesisToken("^\\s*([{}()])\\s*([\\s\\S]*)");
-const std::regex kSemicolonToken("^\\s*;\\s*([\\s\\S]*)");
+// Each regex only consumes its own tokens; the lookaheads check what must follow
+// without capturing the rest of the input, which std::regex matches recursively.
+const std::regex kAssignNameTokenAndExpression("^\\s*([a-zA-Z][a-zA-Z0-9]*)\\s*=\\s*([\\s\\S]*?)\\s*(?=;)");
+const std::regex kWhileConditionalExpression("^\\s*while\\s*(\\([\\s\\S]*?)\\s*(?=\\{)");
+const std::regex kIfConditionalExpression("^\\s*if\\s*(\\([\\s\\S]*?)\\s*(?=then\\s*\\{)");
+const std::regex kReservedKeywordToken("^\\s*(procedure|call|read|print|then|else)(?=\\s|\\{)");
+const std::regex kNameToken("^\\s*([a-zA-Z0-9]+)\\s*");
+const std::regex kConstantValueToken("^\\s*([0-9]+)\\s*");
+const std::regex kParenthesisToken("^\\s*([{}()])\\s*");
+const std::regex kSemicolonToken("^\\s*;\\s*");
 
 void Lexer::HandleProcedureDeclarationTokens(const std::string& pname) {
   // procedure keyword
@@ -139,44 +137,48 @@ std::string SanitiseRawInput(const std::string& raw_input) {
 // Main entry point; returns a TokenList if supplied raw_input can be
 // tokenised successfully. Otherwise, a runtime exception is thrown.
 TokenList Lexer::Tokenise(const std::string& raw_input) {
-  // clear all current tokens:
-  tokens.Clear();
+  // start from no tokens:
+  Lexer lexer;
 
   // start the tokenising process:
-  std::string current = SanitiseRawInput(raw_input);
+  const std::string input = SanitiseRawInput(raw_input);
+  std::string::const_iterator current = input.begin();
   std::smatch matches;
-
-  while (current.length() > 0) {
-    if (std::regex_search(current, matches, kAssignNameTokenAndExpression)) {
-      HandleAssignStatementTokens(matches[1], matches[2]);
-    } else if (std::regex_search(current, matches, kWhileConditionalExpression)) {
-      HandleWhileConditionalExpressionTokens(matches[1]);
-    } else if (std::regex_search(current, matches, kIfConditionalExpression)) {
-      HandleIfConditionalExpressionTokens(matches[1]);
-    } else if (std::regex_search(current, matches, kReservedKeywordToken)) {
-      HandleReservedKeywordToken(matches[1]);
-    } else if (std::regex_search(current, matches, kNameToken)) {
-      HandleNameToken(matches[1]);
-    } else if (std::regex_search(current, matches, kConstantValueToken)) {
-      HandleConstantValueToken(matches[1]);
-    } else if (std::regex_search(current, matches, kParenthesisToken)) {
-      HandleParenthesisToken(matches[1]);
-    } else if (std::regex_search(current, matches, kSemicolonToken)) {
-      HandleSemicolonToken();
+  // only match at the current position instead of searching the rest of the input
+  const auto flags = std::regex_constants::match_continuous;
+
+  while (current != input.end()) {
+    if (std::regex_search(current, input.end(), matches, kAssignNameTokenAndExpression, flags)) {
+      lexer.HandleAssignStatementTokens(matches[1], matches[2]);
+    } else if (std::regex_search(current, input.end(), matches, kWhileConditionalExpression, flags)) {
+      lexer.HandleWhileConditionalExpressionTokens(matches[1]);
+    } else if (std::regex_search(current, input.end(), matches, kIfConditionalExpression, flags)) {
+      lexer.HandleIfConditionalExpressionTokens(matches[1]);
+    } else if (std::regex_search(current, input.end(), matches, kReservedKeywordToken, flags)) {
+      lexer.HandleReservedKeywordToken(matches[1]);
+    } else if (std::regex_search(current, input.end(), matches, kNameToken, flags)) {
+      lexer.HandleNameToken(matches[1]);
+    } else if (std::regex_search(current, input.end(), matches, kConstantValueToken, flags)) {
+      lexer.HandleConstantValueToken(matches[1]);
+    } else if (std::regex_search(current, input.end(), matches, kParenthesisToken, flags)) {
+      lexer.HandleParenthesisToken(matches[1]);
+    } else if (std::regex_search(current, input.end(), matches, kSemicolonToken, flags)) {
+      lexer.HandleSemicolonToken();
     } else {
+      std::string rest(current, input.end());
       std::stringstream err_msg;
       err_msg << "Lexer::Tokenise: invalid syntax found near ["
-              << (current.length() > 25
-                      ? current.substr(0, 25) + "...<truncated>"
-                      : current)
+              << (rest.length() > 25
+                      ? rest.substr(0, 25) + "...<truncated>"
+                      : rest)
               << "]";
       throw std::runtime_error(err_msg.str());
     }
-    // last element in matches is next chunk of raw input source to test
-    current = matches[matches.size() - 1];
+    // continue right after the tokens just matched
+    current = matches.suffix().first;
   }
 
-  return tokens;
+  return lexer.tokens;
 }
 
 }  // namespace source_processor
@@ -8,24 +8,25 @@
 
 namespace source_processor {
 
+// Each call to Tokenise fills a Lexer of its own, so that programs may be tokenised concurrently
 class Lexer {
  private:
-  static TokenList tokens;
+  TokenList tokens;
 
   static std::string SanitiseInput(const std::string&);
 
   // given their corresponding regex matches, these functions will extract
   // the tokens, push it into tokens, and return the next chunk of raw
   // input string to test.
-  static void HandleProcedureDeclarationTokens(const std::string&);
-  static void HandleAssignStatementTokens(const std::string&, const std::string&);
-  static void HandleWhileConditionalExpressionTokens(const std::string&);
-  static void HandleIfConditionalExpressionTokens(const std::string&);
-  static void HandleReservedKeywordToken(const std::string&);
-  static void HandleNameToken(const std::string&);
-  static void HandleConstantValueToken(const std::string&);
-  static void HandleParenthesisToken(const std::string&);
-  static void HandleSemicolonToken();
+  void HandleProcedureDeclarationTokens(const std::string&);
+  void HandleAssignStatementTokens(const std::string&, const std::string&);
+  void HandleWhileConditionalExpressionTokens(const std::string&);
+  void HandleIfConditionalExpressionTokens(const std::string&);
+  void HandleReservedKeywordToken(const std::string&);
+  void HandleNameToken(const std::string&);
+  void HandleConstantValueToken(const std::string&);
+  void HandleParenthesisToken(const std::string&);
+  void HandleSemicolonToken();
 
  public:
   static TokenList Tokenise(const std::string&);
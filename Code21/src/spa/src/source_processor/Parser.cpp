@@ -19,14 +19,6 @@ using namespace parser_utils;
 
 namespace source_processor {
 
-//* member variables *//
-
-// init static variables with default values:
-int Parser::statement_number = 0;
-TokenList Parser::tokens = TokenList();
-std::string Parser::current_pname;
-std::unordered_map<std::string, std::unordered_set<std::string>> Parser::pdeclared_to_pcalled;
-
 //* utilities *//
 
 // Returns a TokenList of expression when called during parsing of a
@@ -445,26 +437,15 @@ TNode* Parser::ParseProgram() {
   return program_node;
 }
 
-// Resets all static variables back to default values.
-// Should be called when starting to parse new input.
-void Parser::Reset() {
-  // reset statement number to start from 0:
-  statement_number = 0;
-  // clear all tokens:
-  tokens.Clear();
-  // clear procedure names map:
-  pdeclared_to_pcalled.clear();
-  current_pname = "";
-}
-
 // Main entry point; calls the required parsing functions recursively
 // and returns a const reference to the root of the AST formed.
 const TNode& Parser::Parse(const std::string& raw_input) {
-  Reset();
-  // assign static TokenList from lexer:
-  tokens = Lexer::Tokenise(raw_input);
+  // a fresh parser starts from statement number 0 with no procedures:
+  Parser parser;
+  // assign the parser's TokenList from lexer:
+  parser.tokens = Lexer::Tokenise(raw_input);
   // start parsing using recursive descent:
-  TNode* ast_root = ParseProgram();
+  TNode* ast_root = parser.ParseProgram();
 
   return *ast_root;
 }
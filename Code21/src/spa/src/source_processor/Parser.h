@@ -9,35 +9,36 @@
 
 namespace source_processor {
 
+// Each call to Parse parses its input on a Parser of its own, so that programs may be parsed
+// concurrently
 class Parser {
  private:
-  static int statement_number;
-  static TokenList tokens;
-  static std::string current_pname;
+  int statement_number = 0;
+  TokenList tokens;
+  std::string current_pname;
   // map of procedure declaration to procedures called in the declaration
-  static std::unordered_map<std::string, std::unordered_set<std::string>>
+  std::unordered_map<std::string, std::unordered_set<std::string>>
       pdeclared_to_pcalled;
 
-  static TokenList ExtractExpressionTokenList(bool is_lhs);
-  static bool IsRelativeExpression();
+  TokenList ExtractExpressionTokenList(bool is_lhs);
+  bool IsRelativeExpression();
 
-  static void Reset();
-  static void ValidateExistentCalls();
-  static bool ValidateNonRecursiveCallsUtils(
+  void ValidateExistentCalls();
+  bool ValidateNonRecursiveCallsUtils(
       const std::string&, std::unordered_set<std::string>&, std::unordered_set<std::string>&);
-  static void ValidateNonRecursiveCalls();
-  static TNode* ParseProgram();
-  static void ParseProcedure(TNode*);
-  static void ParseStatementList(TNode*);
-  static void ParseStatement(TNode*);
-  static void ParseCallStatement(TNode*);
-  static void ParsePrintStatement(TNode*);
-  static void ParseReadStatement(TNode*);
-  static void ParseAssignStatement(TNode*);
-  static void ParseConditionalExpression(TNode*);
-  static void ParseRelativeExpression(TNode*);
-  static void ParseWhileStatement(TNode*);
-  static void ParseIfStatement(TNode*);
+  void ValidateNonRecursiveCalls();
+  TNode* ParseProgram();
+  void ParseProcedure(TNode*);
+  void ParseStatementList(TNode*);
+  void ParseStatement(TNode*);
+  void ParseCallStatement(TNode*);
+  void ParsePrintStatement(TNode*);
+  void ParseReadStatement(TNode*);
+  void ParseAssignStatement(TNode*);
+  void ParseConditionalExpression(TNode*);
+  void ParseRelativeExpression(TNode*);
+  void ParseWhileStatement(TNode*);
+  void ParseIfStatement(TNode*);
 
  public:
   static const TNode& Parse(const std::string&);
@@ -1,25 +1,111 @@
 #include "spa.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
+#include <string>
 
 #include "design_extractor/DesignExtractor.h"
+#include "pkb/snapshot/PKBSnapshot.h"
 #include "query_processor/QueryProcessor.h"
+#include "query_processor/QueryResultCache.h"
 #include "query_processor/commons/BooleanSemanticError.h"
+#include "query_processor/query_evaluator/ClauseResultCache.h"
+#include "query_processor/query_evaluator/QueryMemory.h"
 #include "source_processor/Parser.h"
+#include "utils/Cancellation.h"
 #include "utils/Extension.h"
 
+namespace {
+
+// the value of a size environment variable, or default_value if it is unset or not a number
+size_t ReadSizeEnv(const char* name, size_t default_value) {
+  const char* value = std::getenv(name);
+  if (value == NULL || *value == '\0' || std::string(value).find_first_not_of("0123456789") != std::string::npos) {
+    return default_value;
+  }
+  return std::strtoull(value, NULL, 10);
+}
+
+}  // namespace
+
+// large programs answer transitive relationships from indexes instead of materialising them
+void SPA::ReportTransitiveRelations(PKB& pkb) {
+  if (!pkb.IsNextTMaterialised()) {
+    std::cout << "Answering Next* from statement labels\n";
+  }
+  const StatementReachability* indexes[] = {&pkb.GetNextBipTIndex(), &pkb.GetAffectsTIndex()};
+  const char* relations[] = {"NextBip*", "Affects*"};
+  for (int i = 0; i < 2; ++i) {
+    if (!indexes[i]->IsEmpty()) {
+      std::cout << "Answering " << relations[i] << " from a reachability index of " << indexes[i]->CountBytes()
+                << " bytes built in " << indexes[i]->GetBuildTime() << " ms\n";
+    }
+  }
+  if (pkb.CountCompressedBytes() != 0) {
+    std::cout << "Storing materialised transitive relations as compressed rows of " << pkb.CountCompressedBytes()
+              << " bytes\n";
+  }
+}
+
 void SPA::ParseSourceCode(const std::string& source_code_string, PKB& pkb) {
-  utils::Extension::ExtractEnvVar();
+  // the extensions belong to this analysis, so that the PKB answers extension queries only if it was extracted with them
+  utils::Extension extension = utils::Extension::FromEnvVar();
+  pkb.SetExtension(extension);
   std::cout << "Running SPA "
-            << (utils::Extension::HasNextBip ? "with " : "without ")
+            << (extension.has_next_bip ? "with " : "without ")
             << "NextBip/NextBip* extension\n";
   std::cout << "Running SPA "
-            << (utils::Extension::HasAffectsBip ? "with " : "without ")
+            << (extension.has_affects_bip ? "with " : "without ")
             << "AffectsBip/AffectsBip* extension\n";
 
+  // read before the snapshot lookup, as snapshots written under another limit materialise different relations
+  // a limit beyond the range of int materialises every program, as INT_MAX stmts already would
+  int new_max_materialised_stmts = static_cast<int>(std::min<size_t>(
+      ReadSizeEnv("SPA_MAX_MATERIALISED_STMTS", PKB::kDefaultMaxMaterialisedStatements), std::numeric_limits<int>::max()));
+  pkb.SetMaxMaterialisedStatements(new_max_materialised_stmts);
+
+  // a snapshot of a previous run on the same source skips parsing and extraction entirely
+  uint64_t source_hash = PKBSnapshot::HashSource(source_code_string, extension, new_max_materialised_stmts);
+  std::string snapshot_path = PKBSnapshot::GetCachePath(source_hash);
+  if (!snapshot_path.empty() && PKBSnapshot::Load(pkb, snapshot_path, source_hash)) {
+    std::cout << "Loaded PKB snapshot " << snapshot_path << "\n";
+    pkb.Freeze();
+    ReportTransitiveRelations(pkb);
+    return;
+  }
+
   const auto ast = source_processor::Parser::Parse(source_code_string);
-  design_extractor::DesignExtractor::ExtractDesigns(pkb, ast);
+  design_extractor::ExtractionContext context;
+  context.extension = extension;
+  design_extractor::DesignExtractor::ExtractDesigns(pkb, ast, context);
+  pkb.Freeze();  // the PKB is only read from here on, so queries may share it across threads
+  ReportTransitiveRelations(pkb);
+
+  if (!snapshot_path.empty() && !PKBSnapshot::Save(pkb, snapshot_path, source_hash)) {
+    std::cerr << "Unable to write PKB snapshot " << snapshot_path << "\n";
+  }
+}
+
+void SPA::ConfigureQueries() {
+  // bound the memory taken by cached query and clause results, 0 disabling the cache
+  query_processor::QueryResultCache::SetLimits(
+      query_processor::QueryResultCache::kDefaultMaxEntries,
+      ReadSizeEnv("SPA_RESULT_CACHE_BYTES", query_processor::QueryResultCache::kDefaultMaxBytes));
+  query_processor::ClauseResultCache::SetLimits(
+      query_processor::ClauseResultCache::kDefaultMaxEntries,
+      ReadSizeEnv("SPA_CLAUSE_CACHE_BYTES", query_processor::ClauseResultCache::kDefaultMaxBytes));
+
+  // stop the evaluation of a query that runs past this many milliseconds
+  query_processor::QueryProcessor::SetQueryTimeout(
+      ReadSizeEnv("SPA_QUERY_TIMEOUT_MS", static_cast<size_t>(query_processor::QueryProcessor::GetQueryTimeout())));
+
+  // cap the intermediate results of each query, and the rows of a cross product checked before it is materialised
+  query_processor::QueryMemory::SetLimits(
+      ReadSizeEnv("SPA_MAX_QUERY_BYTES", query_processor::QueryMemory::GetMaxQueryBytes()),
+      ReadSizeEnv("SPA_STREAMING_ROWS", query_processor::QueryMemory::GetStreamingRows()));
 }
 
 void SPA::HandleQueries(const std::string& query, std::list<std::string>& results, PKB& pkb) {
@@ -32,5 +118,11 @@ void SPA::HandleQueries(const std::string& query, std::list<std::string>& result
     results.push_back("FALSE");
   } catch (std::runtime_error error) {
     std::cerr << "Error encountered: " << error.what() << std::endl;
+  } catch (const utils::TimeoutError& error) {
+    std::cerr << "Timeout: " << error.what() << std::endl;
+    results.clear();
+  } catch (const query_processor::MemoryLimitError& error) {
+    std::cerr << "Memory limit: " << error.what() << std::endl;
+    results.clear();
   }
 }
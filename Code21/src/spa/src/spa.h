@@ -6,7 +6,12 @@
 #include "pkb/PKB.h"
 
 class SPA {
+ private:
+  static void ReportTransitiveRelations(PKB&);
+
  public:
   static void ParseSourceCode(const std::string&, PKB&);
+  // reads the query-time settings, i.e. cache sizes, timeouts and memory limits, from the environment
+  static void ConfigureQueries();
   static void HandleQueries(const std::string&, std::list<std::string>&, PKB&);
 };
@@ -0,0 +1,118 @@
+#include "Arena.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace utils {
+
+namespace {
+
+std::atomic<size_t> total_allocations(0);
+std::atomic<size_t> total_bytes(0);
+std::atomic<size_t> total_chunk_allocations(0);
+std::atomic<size_t> total_resets(0);
+
+}  // namespace
+
+const size_t Arena::kChunkBytes;
+const size_t Arena::kRetainedChunks;
+thread_local Arena* Arena::current = nullptr;
+
+Arena::Arena() : chunk_index(0), cursor(nullptr), chunk_end(nullptr) {}
+
+Arena::~Arena() {
+  Reset();
+  for (char* chunk : chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+void* Arena::Allocate(size_t bytes, size_t alignment) {
+  statistics.allocations++;
+  statistics.bytes += bytes;
+  // allocations taking a large part of a chunk get their own, so that they waste none of the others
+  if (bytes > kChunkBytes / 4) {
+    statistics.chunk_allocations++;
+    large_chunks.push_back(static_cast<char*>(::operator new(bytes)));
+    return large_chunks.back();
+  }
+
+  uintptr_t address = reinterpret_cast<uintptr_t>(cursor);
+  uintptr_t aligned_address = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+  if (cursor == nullptr || aligned_address + bytes > reinterpret_cast<uintptr_t>(chunk_end)) {
+    NextChunk();
+    address = reinterpret_cast<uintptr_t>(cursor);
+    aligned_address = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+  }
+  cursor = reinterpret_cast<char*>(aligned_address + bytes);
+  return reinterpret_cast<void*>(aligned_address);
+}
+
+void Arena::NextChunk() {
+  if (cursor != nullptr) {
+    chunk_index++;
+  }
+  if (chunk_index == chunks.size()) {
+    statistics.chunk_allocations++;
+    chunks.push_back(static_cast<char*>(::operator new(kChunkBytes)));
+  }
+  cursor = chunks[chunk_index];
+  chunk_end = cursor + kChunkBytes;
+}
+
+void Arena::Reset() {
+  for (char* chunk : large_chunks) {
+    ::operator delete(chunk);
+  }
+  large_chunks.clear();
+  while (chunks.size() > kRetainedChunks) {
+    ::operator delete(chunks.back());
+    chunks.pop_back();
+  }
+  // the retained chunks are allocated from again in order
+  chunk_index = 0;
+  cursor = nullptr;
+  chunk_end = nullptr;
+
+  statistics.resets++;
+  total_allocations += statistics.allocations - reset_statistics.allocations;
+  total_bytes += statistics.bytes - reset_statistics.bytes;
+  total_chunk_allocations += statistics.chunk_allocations - reset_statistics.chunk_allocations;
+  total_resets++;
+  reset_statistics = statistics;
+}
+
+ArenaStatistics Arena::GetStatistics() const {
+  return statistics;
+}
+
+Arena::Scope::Scope(Arena& new_arena) : arena(&new_arena), previous_arena(current) {
+  current = arena;
+}
+
+Arena::Scope::~Scope() {
+  current = previous_arena;
+  if (previous_arena != arena) {
+    arena->Reset();
+  }
+}
+
+Arena* Arena::GetCurrent() {
+  return current;
+}
+
+Arena& Arena::GetThreadArena() {
+  static thread_local Arena thread_arena;
+  return thread_arena;
+}
+
+ArenaStatistics Arena::GetTotalStatistics() {
+  ArenaStatistics statistics;
+  statistics.allocations = total_allocations;
+  statistics.bytes = total_bytes;
+  statistics.chunk_allocations = total_chunk_allocations;
+  statistics.resets = total_resets;
+  return statistics;
+}
+
+}  // namespace utils
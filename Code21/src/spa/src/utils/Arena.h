@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+struct ArenaStatistics {
+  size_t allocations = 0;        // allocations served by arenas instead of the heap
+  size_t bytes = 0;              // bytes handed out by those allocations
+  size_t chunk_allocations = 0;  // chunks arenas took from the heap to serve them
+  size_t resets = 0;
+};
+
+/*
+  A monotonic arena for the short-lived containers of a query. Allocations bump a cursor through chunks taken from the
+  heap, freeing does nothing, and a Reset frees everything at once while keeping a few chunks for the next query, so a
+  query costs a handful of heap allocations however many rows, maps and hash indexes it builds.
+
+  An ArenaAllocator takes its memory from the arena installed on its thread when it is constructed, or from the heap
+  if there is none, so containers using it work unchanged outside of a query. Containers taking memory from an arena
+  must be destroyed before the Scope that installed it ends.
+*/
+class Arena {
+ public:
+  static const size_t kChunkBytes = 64 << 10;
+  static const size_t kRetainedChunks = 16;
+
+  Arena();
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* Allocate(size_t bytes, size_t alignment);
+
+  // frees every allocation at once, keeping up to kRetainedChunks chunks for reuse
+  void Reset();
+
+  ArenaStatistics GetStatistics() const;
+
+  // installs an arena on the current thread until it is destroyed, then resets it. A scope nested in another of the
+  // same arena leaves it to the outer one
+  class Scope {
+   public:
+    explicit Scope(Arena&);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    Arena* arena;
+    Arena* previous_arena;
+  };
+
+  // the arena installed on the current thread, or nullptr if there is none
+  static Arena* GetCurrent();
+
+  // an arena owned by the current thread, for the queries it evaluates one at a time
+  static Arena& GetThreadArena();
+
+  // the allocations of every arena, counted at each reset
+  static ArenaStatistics GetTotalStatistics();
+
+ private:
+  std::vector<char*> chunks;         // chunks of kChunkBytes, allocated from in order
+  std::vector<char*> large_chunks;   // allocations too large for a chunk, freed at the next reset
+  size_t chunk_index;                // the chunk being allocated from
+  char* cursor;
+  char* chunk_end;
+  ArenaStatistics statistics;
+  ArenaStatistics reset_statistics;  // the statistics at the last reset, already counted in the totals
+
+  static thread_local Arena* current;
+
+  // moves the cursor to the start of the next chunk, taking a new one from the heap once the retained ones are used
+  void NextChunk();
+};
+
+// a C++11 allocator taking its memory from the arena installed on its thread when it was constructed
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  ArenaAllocator() : arena(Arena::GetCurrent()) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+  T* allocate(size_t n) {
+    if (arena == nullptr) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, size_t) {
+    if (arena == nullptr) {
+      ::operator delete(p);
+    }
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+
+  Arena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename T>
+using ArenaUnorderedSet = std::unordered_set<T, std::hash<T>, std::equal_to<T>, ArenaAllocator<T>>;
+
+template <typename Key, typename Value>
+using ArenaUnorderedMap = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>,
+                                             ArenaAllocator<std::pair<const Key, Value>>>;
+
+template <typename Key, typename Value>
+using ArenaUnorderedMultimap = std::unordered_multimap<Key, Value, std::hash<Key>, std::equal_to<Key>,
+                                                       ArenaAllocator<std::pair<const Key, Value>>>;
+
+template <typename Key, typename Value>
+using ArenaMultimap = std::multimap<Key, Value, std::less<Key>, ArenaAllocator<std::pair<const Key, Value>>>;
+
+}  // namespace utils
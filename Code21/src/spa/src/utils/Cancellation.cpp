@@ -0,0 +1,61 @@
+#include "Cancellation.h"
+
+#include <algorithm>
+
+namespace utils {
+
+const size_t Cancellation::kCheckInterval;
+thread_local const CancellationToken* Cancellation::token = nullptr;
+thread_local Cancellation::Clock::time_point Cancellation::deadline = Cancellation::Clock::time_point::max();
+thread_local size_t Cancellation::countdown = Cancellation::kCheckInterval;
+std::atomic<const volatile bool*> Cancellation::stop_flag(nullptr);
+
+Cancellation::Scope::Scope(const CancellationToken* new_token, Clock::time_point new_deadline)
+    : previous_token(token), previous_deadline(deadline) {
+  if (new_token != nullptr) {
+    token = new_token;
+  }
+  deadline = std::min(deadline, new_deadline);
+  // the new limits are checked from the first unit of work
+  countdown = 1;
+}
+
+Cancellation::Scope::~Scope() {
+  token = previous_token;
+  deadline = previous_deadline;
+}
+
+void Cancellation::CheckNow() {
+  countdown = kCheckInterval;
+  const volatile bool* global_stop = stop_flag;
+  if (global_stop != nullptr && *global_stop) {
+    throw TimeoutError("Evaluation stopped");
+  }
+  if (token != nullptr && token->IsCancelled()) {
+    throw TimeoutError("Evaluation cancelled");
+  }
+  if (deadline != Clock::time_point::max() && Clock::now() >= deadline) {
+    throw TimeoutError("Evaluation ran past its deadline");
+  }
+}
+
+const CancellationToken* Cancellation::GetToken() {
+  return token;
+}
+
+Cancellation::Clock::time_point Cancellation::GetDeadline() {
+  return deadline;
+}
+
+Cancellation::Clock::time_point Cancellation::GetDeadlineAfter(double timeout_ms) {
+  if (timeout_ms <= 0) {
+    return Clock::time_point::max();
+  }
+  return Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(timeout_ms));
+}
+
+void Cancellation::SetStopFlag(const volatile bool* flag) {
+  stop_flag = flag;
+}
+
+}  // namespace utils
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <string>
+
+namespace utils {
+
+// Thrown out of work that was cancelled or ran past its deadline. Like BooleanSemanticError it is not a
+// runtime_error, so it passes through the handlers of semantic errors up to whoever set the deadline.
+class TimeoutError : virtual public std::exception {
+ protected:
+  std::string error_message;
+
+ public:
+  explicit TimeoutError(const std::string& msg) : error_message(msg) {}
+
+  virtual ~TimeoutError() noexcept {}
+
+  virtual const char* what() const throw() {
+    return error_message.c_str();
+  }
+};
+
+// a flag shared between the thread that cancels work and the threads doing it
+class CancellationToken {
+ public:
+  CancellationToken() : is_cancelled(false) {}
+
+  void Cancel() { is_cancelled = true; }
+  bool IsCancelled() const { return is_cancelled; }
+
+ private:
+  std::atomic<bool> is_cancelled;
+};
+
+/*
+  The cancellation token and deadline of the work on the current thread, which query evaluation, joins and design
+  extraction check in their long loops. Check is called once per unit of work and only reads the clock and the flags
+  every kCheckInterval units, so an unlimited thread pays for little more than a decrement. Once the work is cancelled
+  or past its deadline, Check throws a TimeoutError, and the work unwinds through its destructors.
+
+  A Scope installs a token and a deadline for the current thread, and utils::Parallel installs the scope of the
+  calling thread on its workers, so they follow the deadline of the work they are part of.
+*/
+class Cancellation {
+ public:
+  typedef std::chrono::steady_clock Clock;
+
+  static const size_t kCheckInterval = 1024;
+
+  // installs a token and deadline on the current thread until it is destroyed. A null token keeps the token of the
+  // enclosing scope, and a deadline can only be brought forward by an inner scope
+  class Scope {
+   public:
+    explicit Scope(const CancellationToken*, Clock::time_point deadline = Clock::time_point::max());
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    const CancellationToken* previous_token;
+    Clock::time_point previous_deadline;
+  };
+
+  // accounts for work units of work, throwing a TimeoutError if the work has been cancelled or is past its deadline
+  static void Check(size_t work = 1) {
+    if (countdown <= work) {
+      CheckNow();
+    } else {
+      countdown -= work;
+    }
+  }
+
+  // throws a TimeoutError if the work has been cancelled or is past its deadline
+  static void CheckNow();
+
+  static const CancellationToken* GetToken();
+  static Clock::time_point GetDeadline();
+
+  // the deadline timeout_ms from now, or none if timeout_ms is not positive
+  static Clock::time_point GetDeadlineAfter(double timeout_ms);
+
+  // a flag outside of the SPA, e.g. the GlobalStop of the autotester, which cancels the work of every thread once set
+  static void SetStopFlag(const volatile bool*);
+
+ private:
+  static thread_local const CancellationToken* token;
+  static thread_local Clock::time_point deadline;
+  static thread_local size_t countdown;
+  static std::atomic<const volatile bool*> stop_flag;
+};
+
+}  // namespace utils
@@ -5,23 +5,18 @@
 
 namespace utils {
 
-// Defaults to false
-bool Extension::HasNextBip = false;
-bool Extension::HasAffectsBip = false;
-
-void Extension::ExtractEnvVar() {
+Extension Extension::FromEnvVar() {
+  // Defaults to false
+  Extension extension;
   const char* env_char = std::getenv("EXTENSION");
   if (env_char == NULL) {
-    return;
+    return extension;
   }
 
   std::string env_str = std::string(env_char);
-  if (env_str.find("NB") != std::string::npos) {
-    HasNextBip = true;
-  }
-  if (env_str.find("AB") != std::string::npos) {
-    HasAffectsBip = true;
-  }
+  extension.has_next_bip = env_str.find("NB") != std::string::npos;
+  extension.has_affects_bip = env_str.find("AB") != std::string::npos;
+  return extension;
 }
 
-}  // namespace utils
\ No newline at end of file
+}  // namespace utils
@@ -2,14 +2,15 @@
 
 namespace utils {
 
+// The extensions turned on for one analysis. Every analysis carries its own, so programs analysed
+// concurrently in one process may run with different extensions.
 class Extension {
  public:
-  static bool HasNextBip;
-  static bool HasAffectsBip;
+  bool has_next_bip = false;
+  bool has_affects_bip = false;
 
-  // Extracts the environment variable and caches the result in the
-  // static variables. Should be called only once within spa.cpp.
-  static void ExtractEnvVar();
+  // Reads the extensions named by the EXTENSION environment variable at the time of the call
+  static Extension FromEnvVar();
 };
 
-}  // namespace utils
\ No newline at end of file
+}  // namespace utils
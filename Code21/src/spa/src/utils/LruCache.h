@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace utils {
+
+// Maps string keys to immutable values, bounded in both its number of entries and the total size of its
+// values as given by the caller, and evicting the least recently used entries once either bound is exceeded.
+// Values are shared, so a value that is evicted stays valid for whoever got it before.
+// Not thread safe: callers that share a cache between threads lock around it.
+template <typename Value>
+class LruCache {
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const Value> value;
+    size_t bytes;
+  };
+
+  typedef std::list<Entry> EntryList;
+
+  EntryList entries;  // most recently used first
+  std::unordered_map<std::string, typename EntryList::iterator> entry_index;
+  size_t max_entries;
+  size_t max_bytes;
+  size_t bytes = 0;
+  size_t evictions = 0;
+
+  void Erase(typename EntryList::iterator entry_it) {
+    bytes -= entry_it->bytes;
+    entry_index.erase(entry_it->key);
+    entries.erase(entry_it);
+  }
+
+  void EvictToLimits() {
+    while (!entries.empty() && (entries.size() > max_entries || bytes > max_bytes)) {
+      Erase(std::prev(entries.end()));
+      evictions++;
+    }
+  }
+
+ public:
+  LruCache(size_t max_entries, size_t max_bytes) : max_entries(max_entries), max_bytes(max_bytes) {}
+
+  // the value cached for the key, or nullptr if there is none
+  std::shared_ptr<const Value> Get(const std::string& key) {
+    auto index_it = entry_index.find(key);
+    if (index_it == entry_index.end()) {
+      return nullptr;
+    }
+    entries.splice(entries.begin(), entries, index_it->second);
+    return index_it->second->value;
+  }
+
+  // caches the value under the key, replacing any value cached for it. A value larger than the whole
+  // cache is not cached
+  void Put(const std::string& key, std::shared_ptr<const Value> value, size_t value_bytes) {
+    auto index_it = entry_index.find(key);
+    if (index_it != entry_index.end()) {
+      Erase(index_it->second);
+    }
+    if (max_entries == 0 || value_bytes > max_bytes) {
+      return;
+    }
+    entries.push_front({key, value, value_bytes});
+    entry_index[key] = entries.begin();
+    bytes += value_bytes;
+    EvictToLimits();
+  }
+
+  // a limit of 0 entries or bytes disables the cache
+  void SetLimits(size_t new_max_entries, size_t new_max_bytes) {
+    max_entries = new_max_entries;
+    max_bytes = new_max_bytes;
+    EvictToLimits();
+  }
+
+  bool IsEnabled() const {
+    return max_entries > 0 && max_bytes > 0;
+  }
+
+  void Clear() {
+    entries.clear();
+    entry_index.clear();
+    bytes = 0;
+    evictions = 0;
+  }
+
+  size_t GetSize() const {
+    return entries.size();
+  }
+
+  size_t GetBytes() const {
+    return bytes;
+  }
+
+  size_t GetEvictions() const {
+    return evictions;
+  }
+};
+
+}  // namespace utils
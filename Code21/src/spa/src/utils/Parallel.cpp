@@ -0,0 +1,71 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Cancellation.h"
+
+namespace utils {
+
+namespace {
+
+std::atomic<int> default_num_threads(0);
+
+}  // namespace
+
+int Parallel::GetDefaultNumThreads() {
+  int num_threads = default_num_threads;
+  return num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Parallel::SetDefaultNumThreads(int num_threads) {
+  default_num_threads = std::max(0, num_threads);
+}
+
+void Parallel::For(size_t count, int num_threads, const std::function<void(size_t, int)>& body) {
+  num_threads = std::max(1, std::min<int>(num_threads, count));
+  std::atomic<size_t> next_index(0);
+  std::atomic<bool> has_failed(false);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  // workers follow the cancellation token and deadline of the calling thread
+  const CancellationToken* token = Cancellation::GetToken();
+  Cancellation::Clock::time_point deadline = Cancellation::GetDeadline();
+
+  // each worker claims the next index until all are claimed or one of them fails
+  auto worker = [&](int worker_id) {
+    Cancellation::Scope scope(token, deadline);
+    for (size_t i = next_index++; i < count && !has_failed; i = next_index++) {
+      try {
+        body(i, worker_id);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        has_failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int i = 1; i < num_threads; i++) {
+    workers.emplace_back(worker, i);
+  }
+  worker(0);  // the calling thread takes part instead of idling
+  for (auto& thread : workers) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace utils
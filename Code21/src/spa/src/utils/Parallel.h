@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace utils {
+
+class Parallel {
+ public:
+  // Number of threads to use when the caller has no preference; one per hardware thread
+  // unless set otherwise.
+  static int GetDefaultNumThreads();
+  // Overrides the default number of threads for the whole process; 0 restores one per hardware thread.
+  static void SetDefaultNumThreads(int);
+
+  // Calls body(index, worker) for every index in [0, count) on at most num_threads threads,
+  // the calling thread included, and returns once all of them are done. Indices are claimed
+  // in increasing order and worker is in [0, num_threads), so callers can give every worker
+  // its own buffers. The first exception thrown by body stops the remaining indices from
+  // being claimed and is rethrown on the calling thread. Every worker follows the cancellation
+  // token and deadline of the calling thread.
+  static void For(size_t count, int num_threads, const std::function<void(size_t, int)>& body);
+};
+
+}  // namespace utils
@@ -483,7 +483,7 @@ bool PKBStub::IsCallsT(const std::string& p1, const std::string& p2) {
   return false;
 }
 
-std::unordered_set<int> PKBStub::GetAllAssignStmtsThatMatches(TokenList& token_list) {
+std::unordered_set<int> PKBStub::GetAllAssignStmtsThatMatches(const TokenList& token_list) {
   Token zero("0", TokenType::ConstantValue);
   Token number("number", TokenType::VariableName);
   Token mod("%", TokenType::ExpressionOp);
@@ -540,7 +540,7 @@ std::unordered_set<int> PKBStub::GetAllAssignStmtsThatModifies(const std::string
   return std::unordered_set<int>{};
 }
 
-std::unordered_set<int> PKBStub::GetAllAssignStmtsThatContains(TokenList& token_list) {
+std::unordered_set<int> PKBStub::GetAllAssignStmtsThatContains(const TokenList& token_list) {
   Token zero("0", TokenType::ConstantValue);
   Token number("number", TokenType::VariableName);
   Token mod("%", TokenType::ExpressionOp);
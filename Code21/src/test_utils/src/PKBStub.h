@@ -21,8 +21,8 @@ class PKBStub : public PKB {
   bool IsCalls(const std::string&, const std::string&) override;
   bool IsCallsT(const std::string&, const std::string&) override;
 
-  std::unordered_set<int> GetAllAssignStmtsThatMatches(source_processor::TokenList&) override;
-  std::unordered_set<int> GetAllAssignStmtsThatContains(source_processor::TokenList&) override;
+  std::unordered_set<int> GetAllAssignStmtsThatMatches(const source_processor::TokenList&) override;
+  std::unordered_set<int> GetAllAssignStmtsThatContains(const source_processor::TokenList&) override;
   std::unordered_set<int> GetAllAssignStmtsThatModifies(const std::string&) override;
   std::unordered_set<std::string> GetVariablesUsedByWhileStmt(int) override;
   std::unordered_set<std::string> GetVariablesUsedByIfStmt(int) override;
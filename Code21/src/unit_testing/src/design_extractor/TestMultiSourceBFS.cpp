@@ -0,0 +1,75 @@
+#include <unordered_set>
+#include <vector>
+
+#include "catch.hpp"
+#include "design_extractor/utils/CFGHandler.h"
+#include "design_extractor/utils/CSRGraph.h"
+#include "design_extractor/utils/MultiSourceBFS.h"
+#include "design_extractor/utils/TransitiveClosure.h"
+
+using namespace design_extractor;
+using namespace std;
+
+SCENARIO("MultiSourceBFS GetReachableNodes tests") {
+  GIVEN("A graph with a branch and a loop") {
+    // 0 -> 1 -> {2, 3}, 3 -> 4 -> 3, 5 is isolated
+    CFG adjacency_list = {{1}, {2, 3}, {}, {4}, {3}, {}};
+    CSRGraph graph(adjacency_list);
+
+    WHEN("Searching from every node at once") {
+      auto reachable = MultiSourceBFS::GetReachableNodes(graph, {0, 1, 2, 3, 4, 5});
+
+      THEN("Each source reaches the nodes after it, and itself only on a cycle") {
+        REQUIRE(reachable[0] == unordered_set<int>{1, 2, 3, 4});
+        REQUIRE(reachable[1] == unordered_set<int>{2, 3, 4});
+        REQUIRE(reachable[2].empty());
+        REQUIRE(reachable[3] == unordered_set<int>{3, 4});
+        REQUIRE(reachable[4] == unordered_set<int>{3, 4});
+        REQUIRE(reachable[5].empty());
+      }
+    }
+
+    WHEN("Searching from a repeated source") {
+      auto reachable = MultiSourceBFS::GetReachableNodes(graph, {4, 2, 4});
+
+      THEN("Every copy of the source gets the same result") {
+        REQUIRE(reachable[0] == unordered_set<int>{3, 4});
+        REQUIRE(reachable[1].empty());
+        REQUIRE(reachable[2] == unordered_set<int>{3, 4});
+      }
+    }
+  }
+
+  GIVEN("A graph with more sources than fit in one batch") {
+    // a chain of nodes where every 10th node loops back 5 nodes
+    int num_nodes = 3 * MultiSourceBFS::kLanes + 7;
+    CFG adjacency_list(num_nodes);
+    for (int node = 0; node + 1 < num_nodes; node++) {
+      adjacency_list[node].push_back(node + 1);
+      if (node % 10 == 9) {
+        adjacency_list[node].push_back(node - 5);
+      }
+    }
+    vector<int> sources;
+    for (int node = num_nodes - 1; node >= 0; node--) {
+      sources.push_back(node);
+    }
+
+    WHEN("Searching from every node") {
+      CSRGraph graph(adjacency_list);
+      auto reachable = MultiSourceBFS::GetReachableNodes(graph, sources);
+
+      THEN("Every batch agrees with the transitive closure of the graph") {
+        vector<int> labels(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+          labels[node] = node;
+        }
+        TransitiveClosure closure(graph, labels, num_nodes);
+        REQUIRE(reachable.size() == sources.size());
+        for (int i = 0; i < sources.size(); i++) {
+          REQUIRE(reachable[i] == TransitiveClosure::ToSet(closure.GetRow(sources[i])));
+        }
+      }
+    }
+  }
+}
@@ -246,4 +246,75 @@ SCENARIO("Underlying affects and affectsT tables created.") {
       REQUIRE(affects_table.GetAffectedTTable().IsEmpty());
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("AffectsT is searched on demand when it is not materialised.") {
+  AffectsTable affects_table;
+
+  // 1 -> 2 -> 3 -> 2, and 4 -> 5
+  affects_table.InsertAffects(1, 2);
+  affects_table.InsertAffects(2, 3);
+  affects_table.InsertAffects(3, 2);
+  affects_table.InsertAffects(4, 5);
+
+  GIVEN("No AffectsT relationship has been inserted.") {
+    REQUIRE_FALSE(affects_table.IsAffectsTMaterialised());
+
+    THEN("IsAffectsT(stmt1, stmt2) holds iff there is a chain of Affects from stmt1 to stmt2.") {
+      REQUIRE(affects_table.IsAffectsT(1, 3));
+      REQUIRE(affects_table.IsAffectsT(3, 2));
+      REQUIRE(affects_table.IsAffectsT(2, 2));
+      REQUIRE(affects_table.IsAffectsT(4, 5));
+      REQUIRE_FALSE(affects_table.IsAffectsT(1, 1));
+      REQUIRE_FALSE(affects_table.IsAffectsT(3, 1));
+      REQUIRE_FALSE(affects_table.IsAffectsT(1, 5));
+      REQUIRE_FALSE(affects_table.IsAffectsT(0, 2));
+    }
+  }
+
+  GIVEN("Some AffectsT relationship has been inserted.") {
+    affects_table.InsertAffectsT(1, 2);
+
+    THEN("IsAffectsT(stmt1, stmt2) is answered from the materialised table only.") {
+      REQUIRE(affects_table.IsAffectsTMaterialised());
+      REQUIRE(affects_table.IsAffectsT(1, 2));
+      REQUIRE_FALSE(affects_table.IsAffectsT(1, 3));
+    }
+  }
+}
+
+SCENARIO("AffectsT is answered from a reachability index over the Affects graph.") {
+  AffectsTable affects_table;
+
+  // 1 -> 2 -> 3 -> 2, and 4 -> 5
+  affects_table.InsertAffects(1, 2);
+  affects_table.InsertAffects(2, 3);
+  affects_table.InsertAffects(3, 2);
+  affects_table.InsertAffects(4, 5);
+
+  GIVEN("The Affects graph has been indexed.") {
+    affects_table.IndexAffectsT();
+
+    THEN("AffectsT holds between the stmts connected by a chain of Affects without being materialised.") {
+      REQUIRE_FALSE(affects_table.IsAffectsTMaterialised());
+      REQUIRE_FALSE(affects_table.GetAffectsTIndex().IsEmpty());
+      REQUIRE(affects_table.IsAffectsT(1, 3));
+      REQUIRE(affects_table.IsAffectsT(2, 2));
+      REQUIRE(affects_table.IsAffectsT(4, 5));
+      REQUIRE_FALSE(affects_table.IsAffectsT(1, 1));
+      REQUIRE_FALSE(affects_table.IsAffectsT(1, 5));
+      REQUIRE(affects_table.GetAffectedTStatements(1) == std::unordered_set<int>({2, 3}));
+      REQUIRE(affects_table.GetStatementsThatAffectsT(2) == std::unordered_set<int>({1, 2, 3}));
+      REQUIRE(affects_table.GetAllAffectedTStatements() == std::unordered_set<int>({2, 3, 5}));
+      REQUIRE(affects_table.GetAllStatementsThatAffectsT() == std::unordered_set<int>({1, 2, 3, 4}));
+    }
+
+    WHEN("The tables are cleared.") {
+      affects_table.ClearAffectsTable();
+
+      THEN("The index is cleared with them.") {
+        REQUIRE(affects_table.GetAffectsTIndex().IsEmpty());
+        REQUIRE_FALSE(affects_table.IsAffectsT(1, 3));
+      }
+    }
+  }
+}
@@ -0,0 +1,144 @@
+#include <unordered_set>
+#include <vector>
+
+#include "catch.hpp"
+#include "pkb/templates/TableMultiple.h"
+#include "pkb/utils/CompressedBitmap.h"
+#include "pkb/utils/CompressedRelation.h"
+
+namespace {
+
+std::vector<int> Range(int first, int last) {
+  std::vector<int> values;
+  for (int value = first; value <= last; ++value) {
+    values.push_back(value);
+  }
+  return values;
+}
+
+}  // namespace
+
+SCENARIO("Construct an empty CompressedBitmap.") {
+  GIVEN("A default constructed CompressedBitmap.") {
+    CompressedBitmap bitmap;
+    THEN("CompressedBitmap is empty and contains nothing.") {
+      REQUIRE(bitmap.IsEmpty());
+      REQUIRE(bitmap.Size() == 0);
+      REQUIRE_FALSE(bitmap.Contains(0));
+      REQUIRE(bitmap.ToVector().empty());
+      REQUIRE(bitmap.GetContainerTypes().empty());
+    }
+  }
+}
+
+SCENARIO("CompressedBitmap chooses the smallest container for every chunk of values.") {
+  typedef CompressedBitmap::ContainerType ContainerType;
+
+  GIVEN("Sparse values, dense values and ranges of values in separate chunks.") {
+    std::vector<int> values = {3, 70, 9000};
+    for (int value = 65536; value < 2 * 65536; value += 3) {
+      values.push_back(value);
+    }
+    std::vector<int> range = Range(2 * 65536 + 10, 2 * 65536 + 30000);
+    values.insert(values.end(), range.begin(), range.end());
+    CompressedBitmap bitmap(values);
+
+    THEN("Sparse chunks are arrays, dense chunks are bitmaps and ranges are runs.") {
+      REQUIRE(bitmap.GetContainerTypes() ==
+              std::vector<ContainerType>({ContainerType::ARRAY, ContainerType::BITMAP, ContainerType::RUN}));
+      REQUIRE(bitmap.Size() == values.size());
+      REQUIRE(bitmap.ToVector() == values);
+      REQUIRE(bitmap.Contains(9000));
+      REQUIRE(bitmap.Contains(65536 + 3));
+      REQUIRE_FALSE(bitmap.Contains(65536 + 4));
+      REQUIRE(bitmap.Contains(2 * 65536 + 30000));
+      REQUIRE_FALSE(bitmap.Contains(2 * 65536 + 30001));
+    }
+
+    THEN("The bitmap takes a fraction of the memory of an unordered_set.") {
+      REQUIRE(bitmap.CountBytes() < values.size() * sizeof(int));
+    }
+  }
+
+  GIVEN("Values inserted one at a time.") {
+    CompressedBitmap bitmap;
+    for (int value = 1; value <= 5000; ++value) {
+      REQUIRE(bitmap.Insert(value));
+    }
+
+    THEN("An array outgrowing 4096 values becomes a bitmap, and a single range is optimised into a run.") {
+      REQUIRE(bitmap.GetContainerTypes() == std::vector<ContainerType>({ContainerType::BITMAP}));
+      bitmap.Optimise();
+      REQUIRE(bitmap.GetContainerTypes() == std::vector<ContainerType>({ContainerType::RUN}));
+      REQUIRE(bitmap.Size() == 5000);
+    }
+
+    THEN("Existing and negative values are not inserted.") {
+      REQUIRE_FALSE(bitmap.Insert(1));
+      REQUIRE_FALSE(bitmap.Insert(-1));
+      REQUIRE_FALSE(bitmap.Contains(-1));
+      REQUIRE(bitmap.Size() == 5000);
+    }
+  }
+}
+
+SCENARIO("CompressedBitmaps are intersected and united container by container.") {
+  GIVEN("Bitmaps with containers of different types.") {
+    CompressedBitmap runs(Range(1, 20000));
+    CompressedBitmap evens;
+    for (int value = 0; value < 70000; value += 2) {
+      evens.Insert(value);
+    }
+    CompressedBitmap sparse(std::vector<int>({5, 6, 19999, 20001, 65540}));
+
+    THEN("Intersections hold the common values of every pair of container types.") {
+      REQUIRE(runs.Intersect(sparse).ToVector() == std::vector<int>({5, 6, 19999}));
+      REQUIRE(sparse.Intersect(evens).ToVector() == std::vector<int>({6, 65540}));
+      REQUIRE(runs.Intersect(evens).Size() == 10000);
+      REQUIRE(runs.Intersect(CompressedBitmap(Range(19990, 30000))).ToVector() == Range(19990, 20000));
+      REQUIRE(runs.Intersects(sparse));
+      REQUIRE_FALSE(CompressedBitmap(Range(1, 4)).Intersects(sparse));
+      REQUIRE(runs.Intersect(CompressedBitmap()).IsEmpty());
+    }
+
+    THEN("Unions hold the values of either bitmap.") {
+      REQUIRE(runs.Union(sparse).Size() == 20002);
+      REQUIRE(runs.Union(CompressedBitmap(Range(20001, 30000))).ToVector() == Range(1, 30000));
+      REQUIRE(runs.Union(evens).Size() == 20000 + 35000 - 10000);
+      REQUIRE(sparse.Union(CompressedBitmap()) == sparse);
+    }
+  }
+}
+
+SCENARIO("CompressedRelation stores the rows of a TableMultiple as CompressedBitmaps.") {
+  GIVEN("A TableMultiple with some rows.") {
+    TableMultiple<int, int> table;
+    table.Insert(1, 2);
+    table.Insert(1, 3);
+    table.Insert(4, 5);
+
+    WHEN("A CompressedRelation is built from the table.") {
+      CompressedRelation relation(table);
+
+      THEN("The relation answers the same lookups as the table.") {
+        REQUIRE(relation.IsAttached());
+        REQUIRE(relation.Contains(1, 3));
+        REQUIRE_FALSE(relation.Contains(1, 4));
+        REQUIRE_FALSE(relation.Contains(2, 1));
+        REQUIRE(relation.ContainsKey(4));
+        REQUIRE_FALSE(relation.ContainsKey(5));
+        REQUIRE(relation.Get(1) == std::unordered_set<int>({2, 3}));
+        REQUIRE(relation.GetRow(4).ToVector() == std::vector<int>({5}));
+        REQUIRE(relation.GetRow(6).IsEmpty());
+        REQUIRE(relation.GetAllKeys() == std::unordered_set<int>({1, 4}));
+        REQUIRE(relation.ToTable().Get(1) == table.Get(1));
+      }
+
+      THEN("Resetting the relation detaches it.") {
+        relation.Reset();
+        REQUIRE_FALSE(relation.IsAttached());
+        REQUIRE_FALSE(relation.Contains(1, 3));
+      }
+    }
+  }
+}
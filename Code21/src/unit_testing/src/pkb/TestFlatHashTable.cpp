@@ -0,0 +1,171 @@
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "catch.hpp"
+#include "pkb/templates/FlatHashTable.h"
+
+SCENARIO("Construct an empty FlatHashMap.") {
+  GIVEN("A default constructed FlatHashMap.") {
+    FlatHashMap<int, std::string> map;
+    THEN("FlatHashMap is empty and has no allocated slots.") {
+      REQUIRE(map.empty());
+      REQUIRE(map.size() == 0);
+      REQUIRE(map.capacity() == 0);
+      REQUIRE(map.find(1) == map.end());
+      REQUIRE(map.count(1) == 0);
+      REQUIRE(map.begin() == map.end());
+    }
+  }
+}
+
+SCENARIO("FlatHashMap has been constructed.") {
+  FlatHashMap<int, std::string> map;
+
+  GIVEN("FlatHashMap is currently empty.") {
+    WHEN("Insert a key and a value.") {
+      THEN("Insertion returns True. The value can be found with its key.") {
+        REQUIRE(map.insert(std::make_pair(1, "x")).second);
+        REQUIRE(map.size() == 1);
+        REQUIRE(map.find(1)->second == "x");
+        REQUIRE(map.count(1) == 1);
+      }
+    }
+  }
+
+  GIVEN("FlatHashMap is not empty.") {
+    REQUIRE(map.insert(std::make_pair(1, "x")).second);
+    REQUIRE(map.insert(std::make_pair(2, "y")).second);
+
+    WHEN("Insert an existing key with a different value.") {
+      THEN("Insertion returns False. The existing value is unchanged.") {
+        REQUIRE_FALSE(map.insert(std::make_pair(1, "z")).second);
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.find(1)->second == "x");
+      }
+    }
+
+    WHEN("Access a key with operator[].") {
+      THEN("Existing keys return their value and missing keys are default inserted.") {
+        REQUIRE(map[2] == "y");
+        REQUIRE(map[3].empty());
+        REQUIRE(map.size() == 3);
+      }
+    }
+
+    WHEN("Erase a key.") {
+      THEN("The key can no longer be found but the other keys remain, and the key can be reinserted.") {
+        REQUIRE(map.erase(1) == 1);
+        REQUIRE(map.erase(1) == 0);
+        REQUIRE(map.find(1) == map.end());
+        REQUIRE(map.find(2)->second == "y");
+        REQUIRE(map.size() == 1);
+        REQUIRE(map.insert(std::make_pair(1, "z")).second);
+        REQUIRE(map.find(1)->second == "z");
+      }
+    }
+
+    WHEN("Clear the map.") {
+      map.clear();
+      THEN("FlatHashMap is empty.") {
+        REQUIRE(map.empty());
+        REQUIRE(map.find(2) == map.end());
+      }
+    }
+  }
+}
+
+SCENARIO("FlatHashMap grows past many group widths.") {
+  FlatHashMap<int, std::unordered_set<int>> map;
+  std::unordered_map<int, std::unordered_set<int>> expected;
+  const int num_keys = 5000;
+
+  for (int i = 0; i < num_keys; ++i) {
+    map[i * 7].insert(i);
+    map[i * 7].insert(i + 1);
+    expected[i * 7] = {i, i + 1};
+  }
+
+  THEN("Every key is found with its values after repeated rehashing.") {
+    REQUIRE(map.size() == num_keys);
+    REQUIRE(map.capacity() >= num_keys);
+    for (auto& it : expected) {
+      auto found = map.find(it.first);
+      REQUIRE(found != map.end());
+      REQUIRE(found->second == it.second);
+    }
+    REQUIRE(map.find(1) == map.end());
+  }
+
+  THEN("Iteration visits every key exactly once.") {
+    std::unordered_set<int> visited;
+    for (auto& it : map) {
+      REQUIRE(visited.insert(it.first).second);
+    }
+    REQUIRE(visited.size() == num_keys);
+  }
+
+  THEN("Copies are independent of the original.") {
+    FlatHashMap<int, std::unordered_set<int>> copy = map;
+    copy[0].insert(-1);
+    REQUIRE(copy.size() == map.size());
+    REQUIRE(copy.find(0)->second.size() == 3);
+    REQUIRE(map.find(0)->second.size() == 2);
+  }
+
+  THEN("Moving leaves the source empty.") {
+    FlatHashMap<int, std::unordered_set<int>> moved = std::move(map);
+    REQUIRE(moved.size() == num_keys);
+    REQUIRE(map.empty());
+    REQUIRE(map.find(0) == map.end());
+  }
+}
+
+SCENARIO("FlatHashMap reserve.") {
+  FlatHashMap<std::string, int> map;
+  map.reserve(1000);
+  size_t reserved_capacity = map.capacity();
+
+  THEN("Inserting up to the reserved size does not rehash.") {
+    REQUIRE(reserved_capacity >= 1000);
+    for (int i = 0; i < 1000; ++i) {
+      REQUIRE(map.insert(std::make_pair("v" + std::to_string(i), i)).second);
+    }
+    REQUIRE(map.capacity() == reserved_capacity);
+    REQUIRE(map.find("v999")->second == 999);
+  }
+}
+
+SCENARIO("FlatHashSet has been constructed.") {
+  FlatHashSet<std::string> set;
+
+  GIVEN("FlatHashSet is not empty.") {
+    REQUIRE(set.insert("x").second);
+    REQUIRE(set.insert("y").second);
+
+    WHEN("Insert an existing element.") {
+      THEN("Insertion returns False.") {
+        REQUIRE_FALSE(set.insert("x").second);
+        REQUIRE(set.size() == 2);
+      }
+    }
+
+    WHEN("Batch insert a range of elements.") {
+      std::unordered_set<std::string> values = {"x", "z", "w"};
+      set.insert(values.begin(), values.end());
+      THEN("Only new elements are added.") {
+        REQUIRE(set.size() == 4);
+        REQUIRE(set.count("z") == 1);
+        REQUIRE(set.count("w") == 1);
+      }
+    }
+
+    WHEN("Convert to an unordered_set.") {
+      std::unordered_set<std::string> converted = set.ToUnorderedSet();
+      THEN("The unordered_set contains the same elements.") {
+        REQUIRE(converted == std::unordered_set<std::string>({"x", "y"}));
+      }
+    }
+  }
+}
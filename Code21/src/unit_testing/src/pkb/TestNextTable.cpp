@@ -149,6 +149,16 @@ SCENARIO("Underlying next and nextT tables created.") {
       }
     }
 
+    WHEN("Insert a set of NextT(prog_line1, prog_line2) that is empty or has only prog_line2 <= 0.") {
+      THEN("Insertion returns False. prog_line1 is not PreviousT to any prog_line.") {
+        REQUIRE_FALSE(next_table.InsertNextT(24, std::unordered_set<int>()));
+        REQUIRE_FALSE(next_table.InsertNextT(25, std::unordered_set<int>({0, -1})));
+        REQUIRE(next_table.GetNextTTable().Size() == 7);
+        REQUIRE_FALSE(next_table.GetAllPreviousTStatements().count(24));
+        REQUIRE_FALSE(next_table.GetAllPreviousTStatements().count(25));
+      }
+    }
+
     WHEN("Insert a NextT(prog_line1, prog_line2) such that both already exist.") {
       THEN("Insertion returns False. prog_line2 already exists in NextT statement set of prog_line1.") {
         REQUIRE_FALSE(next_table.InsertNextT(1, 2));
@@ -233,4 +243,175 @@ SCENARIO("Underlying next and nextT tables created.") {
       REQUIRE(next_table.GetInverseNextTTable().IsEmpty());
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("NextT is searched on demand when it is not materialised.") {
+  NextTable next_table;
+
+  // 1 -> 2 -> 3, a loop 5 -> 6 -> 7 -> 5 after 4, and 8 branching to 9 and 10 which meet again at 11
+  next_table.InsertNext(1, 2);
+  next_table.InsertNext(2, 3);
+  next_table.InsertNext(4, 5);
+  next_table.InsertNext(5, 6);
+  next_table.InsertNext(6, 7);
+  next_table.InsertNext(7, 5);
+  next_table.InsertNext(8, 9);
+  next_table.InsertNext(8, 10);
+  next_table.InsertNext(9, 11);
+  next_table.InsertNext(10, 11);
+
+  GIVEN("No NextT relationship has been inserted.") {
+    REQUIRE_FALSE(next_table.IsNextTMaterialised());
+
+    WHEN("IsNextT(stmt1, stmt2) called with a path from stmt1 to stmt2.") {
+      THEN("Returns true.") {
+        REQUIRE(next_table.IsNextT(1, 2));
+        REQUIRE(next_table.IsNextT(1, 3));
+        REQUIRE(next_table.IsNextT(4, 7));
+        REQUIRE(next_table.IsNextT(7, 6));
+        REQUIRE(next_table.IsNextT(8, 11));
+        REQUIRE(next_table.IsNextT(10, 11));
+      }
+    }
+
+    WHEN("IsNextT(stmt, stmt) called.") {
+      THEN("Returns true only if stmt lies on a cycle.") {
+        REQUIRE(next_table.IsNextT(5, 5));
+        REQUIRE(next_table.IsNextT(7, 7));
+        REQUIRE_FALSE(next_table.IsNextT(4, 4));
+        REQUIRE_FALSE(next_table.IsNextT(1, 1));
+      }
+    }
+
+    WHEN("IsNextT(stmt1, stmt2) called without a path from stmt1 to stmt2.") {
+      THEN("Returns false.") {
+        REQUIRE_FALSE(next_table.IsNextT(3, 1));
+        REQUIRE_FALSE(next_table.IsNextT(5, 4));
+        REQUIRE_FALSE(next_table.IsNextT(9, 10));
+        REQUIRE_FALSE(next_table.IsNextT(3, 4));
+        REQUIRE_FALSE(next_table.IsNextT(0, 1));
+        REQUIRE_FALSE(next_table.IsNextT(1, 0));
+        REQUIRE_FALSE(next_table.IsNextT(12, 13));
+      }
+    }
+  }
+
+  GIVEN("Some NextT relationship has been inserted.") {
+    next_table.InsertNextT(1, 2);
+
+    THEN("IsNextT(stmt1, stmt2) is answered from the materialised table only.") {
+      REQUIRE(next_table.IsNextTMaterialised());
+      REQUIRE(next_table.IsNextT(1, 2));
+      REQUIRE_FALSE(next_table.IsNextT(1, 3));
+    }
+  }
+}
+
+SCENARIO("NextT is derived from stmt labels when it is not materialised.") {
+  NextTable next_table;
+  auto insert_label = [&next_table](int stmt, int proc_first, int proc_last, int parent, int last, int else_first,
+                                    bool is_while) {
+    StatementLabel label;
+    label.proc_first = proc_first;
+    label.proc_last = proc_last;
+    label.parent = parent;
+    label.last = last;
+    label.else_first = else_first;
+    label.is_while = is_while;
+    return next_table.InsertNextTLabel(stmt, label);
+  };
+
+  // procedure p {
+  // 1  x = 1;
+  // 2  while (x > 0) {
+  // 3    if (x > 1) then {
+  // 4      x = 2;
+  // 5      while (x > 2) {
+  // 6        x = 3; } }
+  //      else {
+  // 7      x = 4; }
+  // 8    x = 5; }
+  // 9  if (x > 6) then {
+  // 10   x = 7; }
+  //    else {
+  // 11   x = 8; }
+  // 12 x = 9; }
+  // procedure q {
+  // 13 x = 10; }
+  REQUIRE(insert_label(1, 1, 12, 0, 1, 0, false));
+  REQUIRE(insert_label(2, 1, 12, 0, 8, 0, true));
+  REQUIRE(insert_label(3, 1, 12, 2, 7, 7, false));
+  REQUIRE(insert_label(4, 1, 12, 3, 4, 0, false));
+  REQUIRE(insert_label(5, 1, 12, 3, 6, 0, true));
+  REQUIRE(insert_label(6, 1, 12, 5, 6, 0, false));
+  REQUIRE(insert_label(7, 1, 12, 3, 7, 0, false));
+  REQUIRE(insert_label(8, 1, 12, 2, 8, 0, false));
+  REQUIRE(insert_label(9, 1, 12, 0, 11, 11, false));
+  REQUIRE(insert_label(10, 1, 12, 9, 10, 0, false));
+  REQUIRE(insert_label(11, 1, 12, 9, 11, 0, false));
+  REQUIRE(insert_label(12, 1, 12, 0, 12, 0, false));
+  REQUIRE(insert_label(13, 13, 13, 0, 13, 0, false));
+
+  GIVEN("No NextT relationship has been inserted.") {
+    REQUIRE_FALSE(next_table.IsNextTMaterialised());
+
+    WHEN("A stmt is labelled twice or with an invalid stmt.") {
+      THEN("The label is rejected.") {
+        REQUIRE_FALSE(insert_label(1, 1, 12, 0, 1, 0, false));
+        REQUIRE_FALSE(insert_label(0, 1, 12, 0, 0, 0, false));
+      }
+    }
+
+    WHEN("IsNextT(stmt1, stmt2) called.") {
+      THEN("Returns true if stmt2 comes after stmt1 or both lie in a common while.") {
+        REQUIRE(next_table.IsNextT(1, 12));
+        REQUIRE(next_table.IsNextT(7, 4));
+        REQUIRE(next_table.IsNextT(4, 7));
+        REQUIRE(next_table.IsNextT(6, 3));
+        REQUIRE(next_table.IsNextT(5, 5));
+        REQUIRE(next_table.IsNextT(11, 12));
+        REQUIRE(next_table.IsNextT(9, 10));
+      }
+
+      THEN("Returns false across the branches of an if, backwards outside a while or across procedures.") {
+        REQUIRE_FALSE(next_table.IsNextT(10, 11));
+        REQUIRE_FALSE(next_table.IsNextT(12, 1));
+        REQUIRE_FALSE(next_table.IsNextT(9, 8));
+        REQUIRE_FALSE(next_table.IsNextT(1, 1));
+        REQUIRE_FALSE(next_table.IsNextT(1, 13));
+        REQUIRE_FALSE(next_table.IsNextT(13, 13));
+        REQUIRE_FALSE(next_table.IsNextT(0, 1));
+        REQUIRE_FALSE(next_table.IsNextT(1, 14));
+      }
+    }
+
+    WHEN("GetNextTStatements(stmt) and GetPreviousTStatements(stmt) called.") {
+      THEN("Returns the stmts in the ranges that stmt reaches or is reached from.") {
+        REQUIRE(ContainsExactly<int>(next_table.GetNextTStatements(1), {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}));
+        REQUIRE(ContainsExactly<int>(next_table.GetNextTStatements(4), {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}));
+        REQUIRE(ContainsExactly<int>(next_table.GetNextTStatements(10), {12}));
+        REQUIRE(ContainsExactly<int>(next_table.GetNextTStatements(12), {}));
+        REQUIRE(ContainsExactly<int>(next_table.GetPreviousTStatements(11), {1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        REQUIRE(ContainsExactly<int>(next_table.GetPreviousTStatements(12), {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+        REQUIRE(ContainsExactly<int>(next_table.GetPreviousTStatements(6), {1, 2, 3, 4, 5, 6, 7, 8}));
+        REQUIRE(ContainsExactly<int>(next_table.GetPreviousTStatements(1), {}));
+        REQUIRE(ContainsExactly<int>(next_table.GetPreviousTStatements(13), {}));
+      }
+    }
+
+    WHEN("GetAllNextTStatements() and GetAllPreviousTStatements() called.") {
+      THEN("Returns the stmts that are reached from or reach another stmt.") {
+        REQUIRE(ContainsExactly<int>(next_table.GetAllNextTStatements(), {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}));
+        REQUIRE(ContainsExactly<int>(next_table.GetAllPreviousTStatements(), {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+      }
+    }
+  }
+
+  GIVEN("ClearNextTable() called.") {
+    next_table.ClearNextTable();
+
+    THEN("The labels are cleared.") {
+      REQUIRE(next_table.GetNextTLabels().IsEmpty());
+      REQUIRE_FALSE(next_table.IsNextT(1, 12));
+    }
+  }
+}
@@ -1786,4 +1786,118 @@ SCENARIO("Clear a populated pkb.") {
       }
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("Check unmaterialised transitive relationships within procedures.") {
+  GIVEN("A pkb with two procedures and their Next and Affects relationships, but no NextT or AffectsT.") {
+    PKB pkb;
+    REQUIRE(pkb.InsertProcedure("first", 1, 3));
+    REQUIRE(pkb.InsertProcedure("second", 4, 6));
+    pkb.InsertNext(1, 2);
+    pkb.InsertNext(2, 3);
+    pkb.InsertNext(4, 5);
+    pkb.InsertNext(5, 6);
+    pkb.InsertAffects(1, 2);
+    pkb.InsertAffects(2, 3);
+    // not a valid program, but shows that the search never leaves a procedure
+    pkb.InsertNext(3, 4);
+    pkb.InsertAffects(3, 4);
+
+    WHEN("pkb.GetProcRangeOfStmt(stmt_index) called.") {
+      THEN("Returns the range of the procedure containing the statement, or (0, 0) if there is none.") {
+        REQUIRE(pkb.GetProcRangeOfStmt(1) == std::pair<int, int>(1, 3));
+        REQUIRE(pkb.GetProcRangeOfStmt(3) == std::pair<int, int>(1, 3));
+        REQUIRE(pkb.GetProcRangeOfStmt(5) == std::pair<int, int>(4, 6));
+        REQUIRE(pkb.GetProcRangeOfStmt(0) == std::pair<int, int>(0, 0));
+        REQUIRE(pkb.GetProcRangeOfStmt(7) == std::pair<int, int>(0, 0));
+      }
+    }
+
+    WHEN("pkb.IsNextT(stmt1, stmt2) and pkb.IsAffectsT(stmt1, stmt2) called.") {
+      THEN("Pairs within a procedure are searched, and pairs across procedures never hold.") {
+        REQUIRE(pkb.IsNextT(1, 3));
+        REQUIRE(pkb.IsNextT(4, 6));
+        REQUIRE_FALSE(pkb.IsNextT(3, 1));
+        REQUIRE_FALSE(pkb.IsNextT(1, 5));
+        REQUIRE(pkb.IsAffectsT(1, 3));
+        REQUIRE_FALSE(pkb.IsAffectsT(1, 4));
+      }
+    }
+  }
+}
+
+SCENARIO("Freeze a populated pkb.") {
+  GIVEN("A pkb with some statements and relationships.") {
+    PKB pkb;
+    REQUIRE(pkb.InsertStatement(1));
+    REQUIRE(pkb.InsertStatement(2));
+    REQUIRE(pkb.InsertFollows(1, 2));
+    REQUIRE_FALSE(pkb.IsFrozen());
+    REQUIRE(pkb.GetGenerationId() == 0);
+
+    WHEN("The pkb is frozen.") {
+      pkb.Freeze();
+      THEN("Queries are still answered but insertions throw.") {
+        REQUIRE(pkb.IsFrozen());
+        REQUIRE(pkb.IsFollows(1, 2));
+        REQUIRE(pkb.GetAllStmts().size() == 2);
+        REQUIRE_THROWS_AS(pkb.InsertStatement(3), std::runtime_error);
+        REQUIRE_THROWS_AS(pkb.InsertFollows(2, 3), std::runtime_error);
+        REQUIRE(pkb.GetAllStmts().size() == 2);
+      }
+
+      THEN("Clearing the pkb lifts the freeze.") {
+        pkb.ClearAllTables();
+        REQUIRE_FALSE(pkb.IsFrozen());
+        REQUIRE(pkb.GetGenerationId() == 0);
+        REQUIRE(pkb.InsertStatement(3));
+      }
+
+      THEN("Each freeze gives the pkb a new generation id.") {
+        uint64_t generation_id = pkb.GetGenerationId();
+        REQUIRE(generation_id != 0);
+        pkb.ClearAllTables();
+        pkb.Freeze();
+        REQUIRE(pkb.GetGenerationId() != 0);
+        REQUIRE(pkb.GetGenerationId() != generation_id);
+      }
+    }
+  }
+}
+
+SCENARIO("Freezing a pkb stores its transitive relationships as compressed rows.") {
+  GIVEN("A pkb with materialised NextT and AffectsT relationships.") {
+    PKB pkb;
+    REQUIRE(pkb.InsertNextT(1, 2));
+    REQUIRE(pkb.InsertNextT(1, 3));
+    REQUIRE(pkb.InsertNextT(2, 3));
+    REQUIRE(pkb.InsertAffectsT(1, 3));
+    REQUIRE(pkb.GetNextTRow(1) == nullptr);
+
+    WHEN("The pkb is frozen.") {
+      pkb.Freeze();
+
+      THEN("The relationships are answered from compressed rows.") {
+        REQUIRE(pkb.IsNextTMaterialised());
+        REQUIRE(pkb.CountCompressedBytes() > 0);
+        REQUIRE(pkb.GetNextTRow(1) != nullptr);
+        REQUIRE(pkb.GetNextTRow(1)->ToVector() == std::vector<int>({2, 3}));
+        REQUIRE(pkb.GetNextTRow(3)->IsEmpty());
+        REQUIRE(pkb.GetAffectsTRow(1)->ToVector() == std::vector<int>({3}));
+        REQUIRE(pkb.GetNextBipTRow(1) == nullptr);
+        REQUIRE(pkb.IsNextT(1, 3));
+        REQUIRE_FALSE(pkb.IsNextT(3, 1));
+        REQUIRE(pkb.GetPreviousTStatements(3) == std::unordered_set<int>({1, 2}));
+        REQUIRE(pkb.GetAllPreviousTStatements() == std::unordered_set<int>({1, 2}));
+        REQUIRE(pkb.GetAllNextTStatements() == std::unordered_set<int>({2, 3}));
+        REQUIRE(pkb.IsAffectsT(1, 3));
+        REQUIRE(pkb.GetStatementsThatAffectsT(3) == std::unordered_set<int>({1}));
+      }
+
+      THEN("Clearing the pkb drops the compressed rows.") {
+        pkb.ClearAllTables();
+        REQUIRE(pkb.GetNextTRow(1) == nullptr);
+        REQUIRE_FALSE(pkb.IsNextT(1, 3));
+      }
+    }
+  }
+}
@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+
+#include "BuildPKBUtils.h"
+#include "catch.hpp"
+#include "pkb/PKB.h"
+#include "pkb/snapshot/PKBSnapshot.h"
+#include "source_processor/token/TokenList.h"
+
+using namespace source_processor;
+
+namespace {
+
+const char* kSnapshotPath = "pkb_snapshot_test.bin";
+
+void FlipByte(const std::string& path, long position) {
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekg(position);
+  char byte = file.get();
+  file.seekp(position);
+  file.put(static_cast<char>(~byte));
+}
+
+}  // namespace
+
+SCENARIO("Saving and loading a PKB snapshot.") {
+  PKB pkb = BuildPKBSampleProgram();
+  uint64_t source_hash = PKBSnapshot::HashSource("procedure main { x = 1; }", utils::Extension(), PKB::kDefaultMaxMaterialisedStatements);
+  REQUIRE(PKBSnapshot::Save(pkb, kSnapshotPath, source_hash));
+
+  GIVEN("A snapshot written for the same source.") {
+    PKB loaded_pkb;
+    REQUIRE(PKBSnapshot::Load(loaded_pkb, kSnapshotPath, source_hash));
+
+    THEN("Entities are restored.") {
+      REQUIRE(loaded_pkb.GetAllVariables() == pkb.GetAllVariables());
+      REQUIRE(loaded_pkb.GetAllStmts() == pkb.GetAllStmts());
+      REQUIRE(loaded_pkb.GetAllConstants() == pkb.GetAllConstants());
+      REQUIRE(loaded_pkb.GetAllProcedures() == pkb.GetAllProcedures());
+      REQUIRE(loaded_pkb.GetProcRange("computeCentroid") == std::make_pair(10, 23));
+      REQUIRE(loaded_pkb.GetVariablesUsedByWhileStmt(14) == pkb.GetVariablesUsedByWhileStmt(14));
+      REQUIRE(loaded_pkb.GetCallsProcName(13) == "readPoint");
+      REQUIRE(loaded_pkb.GetStatementType(14) == pkb.GetStatementType(14));
+      REQUIRE(loaded_pkb.GetAssignedVariable(16) == "cenX");
+    }
+
+    THEN("Assignment expressions are restored for pattern matching.") {
+      TokenList expression;
+      expression.Push(Token("cenX", TokenType::VariableName)).Push(Token("+", TokenType::ExpressionOp)).Push(Token("x", TokenType::VariableName));
+      REQUIRE(loaded_pkb.GetAllAssignStmtsThatMatches(expression) == std::unordered_set<int>({16}));
+    }
+
+    THEN("Relationships are restored.") {
+      REQUIRE(loaded_pkb.IsFollows(1, 2));
+      REQUIRE(loaded_pkb.IsParent(14, 15));
+      REQUIRE(loaded_pkb.GetModifiedVariables("main") == pkb.GetModifiedVariables("main"));
+      REQUIRE(loaded_pkb.GetUsedVariables(23) == pkb.GetUsedVariables(23));
+      REQUIRE(loaded_pkb.IsCalls("main", "computeCentroid"));
+      REQUIRE(loaded_pkb.IsCallsT("main", "computeCentroid"));
+    }
+
+    THEN("Transitive relationships are served from the mapped snapshot.") {
+      REQUIRE(loaded_pkb.IsNextT(12, 15));
+      REQUIRE(loaded_pkb.IsNextT(14, 14));
+      REQUIRE_FALSE(loaded_pkb.IsNextT(15, 12));
+      REQUIRE(loaded_pkb.GetNextTStatements(12) == pkb.GetNextTStatements(12));
+      REQUIRE(loaded_pkb.GetPreviousTStatements(15) == pkb.GetPreviousTStatements(15));
+      REQUIRE(loaded_pkb.GetAllPreviousTStatements() == pkb.GetAllPreviousTStatements());
+      REQUIRE(loaded_pkb.IsAffectsT(15, 22));
+      REQUIRE(loaded_pkb.GetStatementsThatAffectsT(21) == pkb.GetStatementsThatAffectsT(21));
+    }
+
+    THEN("Clearing the PKB detaches the mapped relationships.") {
+      loaded_pkb.ClearAllTables();
+      REQUIRE_FALSE(loaded_pkb.IsNextT(12, 15));
+      REQUIRE(loaded_pkb.GetAllNextTStatements().empty());
+    }
+  }
+
+  GIVEN("A snapshot written for a different source.") {
+    PKB loaded_pkb;
+    loaded_pkb.InsertVariable("untouched");
+    THEN("Loading fails and the PKB is unchanged.") {
+      REQUIRE_FALSE(PKBSnapshot::Load(loaded_pkb, kSnapshotPath, source_hash + 1));
+      REQUIRE(loaded_pkb.GetAllVariables() == std::unordered_set<std::string>({"untouched"}));
+    }
+  }
+
+  GIVEN("A snapshot written for the same source under another materialisation limit.") {
+    PKB loaded_pkb;
+    THEN("Loading fails, as the snapshot materialises different relations.") {
+      uint64_t other_hash = PKBSnapshot::HashSource("procedure main { x = 1; }", utils::Extension(), 0);
+      REQUIRE(other_hash != source_hash);
+      REQUIRE_FALSE(PKBSnapshot::Load(loaded_pkb, kSnapshotPath, other_hash));
+    }
+  }
+
+  GIVEN("A snapshot saved over an existing one.") {
+    uint64_t other_hash = PKBSnapshot::HashSource("procedure main { y = 2; }", utils::Extension(), PKB::kDefaultMaxMaterialisedStatements);
+    REQUIRE(PKBSnapshot::Save(pkb, kSnapshotPath, other_hash));
+    PKB loaded_pkb;
+    THEN("The new snapshot replaces the old one.") {
+      REQUIRE_FALSE(PKBSnapshot::Load(loaded_pkb, kSnapshotPath, source_hash));
+      REQUIRE(PKBSnapshot::Load(loaded_pkb, kSnapshotPath, other_hash));
+      REQUIRE(loaded_pkb.GetAllStmts() == pkb.GetAllStmts());
+    }
+  }
+
+  GIVEN("A snapshot saved where no file can be created.") {
+    THEN("Saving fails.") {
+      REQUIRE_FALSE(PKBSnapshot::Save(pkb, "missing_directory/pkb_snapshot.bin", source_hash));
+    }
+  }
+
+  GIVEN("A corrupted snapshot.") {
+    FlipByte(kSnapshotPath, 100);
+    PKB loaded_pkb;
+    THEN("Loading fails the checksum.") {
+      REQUIRE_FALSE(PKBSnapshot::Load(loaded_pkb, kSnapshotPath, source_hash));
+      REQUIRE(loaded_pkb.GetAllStmts().empty());
+    }
+  }
+
+  GIVEN("A missing snapshot.") {
+    PKB loaded_pkb;
+    THEN("Loading fails.") {
+      REQUIRE_FALSE(PKBSnapshot::Load(loaded_pkb, "missing_pkb_snapshot.bin", source_hash));
+    }
+  }
+
+  std::remove(kSnapshotPath);
+}
@@ -0,0 +1,101 @@
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "pkb/utils/ReachabilityIndex.h"
+#include "pkb/utils/StatementReachability.h"
+
+SCENARIO("Construct an empty ReachabilityIndex.") {
+  GIVEN("A default constructed ReachabilityIndex.") {
+    ReachabilityIndex index;
+    THEN("ReachabilityIndex is empty and reaches nothing.") {
+      REQUIRE(index.IsEmpty());
+      REQUIRE(index.CountNodes() == 0);
+      REQUIRE_FALSE(index.IsReachable(0, 0));
+      REQUIRE_FALSE(index.HasSuccessors(0));
+      REQUIRE(index.GetReachableNodes({0}).empty());
+      REQUIRE(index.GetReachingNodes({0}).empty());
+    }
+  }
+}
+
+SCENARIO("ReachabilityIndex has been built from a graph.") {
+  // 0 -> 1 -> 2 -> 1 (a cycle), 2 -> 3, 0 -> 4 -> 3, 5 -> 5, and 6 on its own
+  std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 2}, {2, 1}, {2, 3}, {0, 4}, {4, 3}, {5, 5}};
+  ReachabilityIndex index(7, edges);
+
+  GIVEN("Pairs of nodes with and without a path between them.") {
+    THEN("IsReachable(from, to) holds iff there is a path of at least one edge from from to to.") {
+      REQUIRE(index.IsReachable(0, 3));
+      REQUIRE(index.IsReachable(1, 1));
+      REQUIRE(index.IsReachable(2, 1));
+      REQUIRE(index.IsReachable(4, 3));
+      REQUIRE(index.IsReachable(5, 5));
+      REQUIRE_FALSE(index.IsReachable(0, 0));
+      REQUIRE_FALSE(index.IsReachable(3, 3));
+      REQUIRE_FALSE(index.IsReachable(4, 1));
+      REQUIRE_FALSE(index.IsReachable(3, 0));
+      REQUIRE_FALSE(index.IsReachable(6, 6));
+      REQUIRE_FALSE(index.IsReachable(0, 7));
+    }
+  }
+
+  GIVEN("Sets of nodes.") {
+    THEN("The nodes reachable from and reaching them are found in a single search.") {
+      auto reachable_nodes = index.GetReachableNodes({1, 4});
+      REQUIRE(std::unordered_set<int>(reachable_nodes.begin(), reachable_nodes.end()) ==
+              std::unordered_set<int>({1, 2, 3}));
+      auto reaching_nodes = index.GetReachingNodes({3});
+      REQUIRE(std::unordered_set<int>(reaching_nodes.begin(), reaching_nodes.end()) ==
+              std::unordered_set<int>({0, 1, 2, 4}));
+      REQUIRE(index.GetReachableNodes({6}).empty());
+    }
+
+    THEN("Only nodes with an outgoing edge have successors.") {
+      REQUIRE(index.HasSuccessors(0));
+      REQUIRE(index.HasSuccessors(2));
+      REQUIRE(index.HasSuccessors(5));
+      REQUIRE_FALSE(index.HasSuccessors(3));
+      REQUIRE_FALSE(index.HasSuccessors(6));
+    }
+  }
+}
+
+SCENARIO("StatementReachability answers a transitive relation between stmts from blocks.") {
+  GIVEN("Blocks with a single copy each.") {
+    // block 0 = 1, 2 -> block 1 = 3, 4 -> block 0, and block 1 -> block 2 = 5
+    StatementReachability reachability({{1, 2}, {3, 4}, {5}}, 1, {{0, 1}, {1, 0}, {1, 2}});
+
+    THEN("Stmts reach the later stmts of their block and every stmt of the blocks reachable from it.") {
+      REQUIRE(reachability.IsReachable(1, 2));
+      REQUIRE(reachability.IsReachable(2, 1));
+      REQUIRE(reachability.IsReachable(4, 3));
+      REQUIRE(reachability.IsReachable(1, 5));
+      REQUIRE_FALSE(reachability.IsReachable(5, 1));
+      REQUIRE_FALSE(reachability.IsReachable(5, 5));
+      REQUIRE_FALSE(reachability.IsReachable(0, 1));
+      REQUIRE_FALSE(reachability.IsReachable(1, 6));
+      REQUIRE(reachability.GetReachableStatements(3) == std::unordered_set<int>({1, 2, 3, 4, 5}));
+      REQUIRE(reachability.GetReachingStatements(5) == std::unordered_set<int>({1, 2, 3, 4}));
+      REQUIRE(reachability.GetReachableStatements(5).empty());
+      REQUIRE(reachability.GetAllReachableStatements() == std::unordered_set<int>({1, 2, 3, 4, 5}));
+      REQUIRE(reachability.GetAllReachingStatements() == std::unordered_set<int>({1, 2, 3, 4}));
+    }
+  }
+
+  GIVEN("Blocks with two copies each, where paths only start from the first copy.") {
+    // copy 0 of block 0 = 1 -> copy 1 of block 1 = 2, and copy 1 of block 2 = 3 -> copy 0 of block 0
+    StatementReachability reachability({{1}, {2}, {3}}, 2, {{0, 4}, {5, 0}});
+
+    THEN("Stmts are reached in any copy of their block.") {
+      REQUIRE(reachability.CountCopies() == 2);
+      REQUIRE(reachability.IsReachable(1, 2));
+      REQUIRE_FALSE(reachability.IsReachable(3, 1));
+      REQUIRE_FALSE(reachability.IsReachable(2, 1));
+      REQUIRE(reachability.GetReachableStatements(1) == std::unordered_set<int>({2}));
+      REQUIRE(reachability.GetReachingStatements(2) == std::unordered_set<int>({1}));
+      REQUIRE(reachability.GetReachingStatements(1).empty());
+    }
+  }
+}
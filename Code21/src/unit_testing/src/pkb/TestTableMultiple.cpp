@@ -61,4 +61,46 @@ SCENARIO("TableMultiple has been constructed.") {
       }
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("Batch insertion into TableMultiple.") {
+  TableMultiple<int, int> table;
+  REQUIRE(table.Insert(1, 2));
+
+  WHEN("Insert a set of values at an existing key.") {
+    THEN("Insertion returns True if any value is new, and values are merged.") {
+      REQUIRE(table.InsertBatch(1, {2, 3, 4}));
+      REQUIRE(table.Get(1).size() == 3);
+      REQUIRE_FALSE(table.InsertBatch(1, {3, 4}));
+      REQUIRE(table.Get(1).size() == 3);
+    }
+  }
+
+  WHEN("Insert a set of values at a new key.") {
+    THEN("Insertion returns True and the key is added.") {
+      REQUIRE(table.InsertBatch(5, {6, 7}));
+      REQUIRE(table.Size() == 2);
+      REQUIRE(table.Get(5) == std::unordered_set<int>({6, 7}));
+    }
+  }
+
+  WHEN("Insert an empty set of values at a new key.") {
+    THEN("Insertion returns False and the key is not added.") {
+      REQUIRE_FALSE(table.InsertBatch(5, {}));
+      REQUIRE_FALSE(table.Contains(5));
+      REQUIRE(table.Size() == 1);
+    }
+  }
+}
+
+SCENARIO("Lookups do not modify a TableMultiple.") {
+  TableMultiple<int, int> table;
+  REQUIRE(table.Insert(1, 2));
+
+  WHEN("Get is called with a key that is absent.") {
+    THEN("An empty set is returned and no key is added.") {
+      REQUIRE(table.Get(7).empty());
+      REQUIRE(table.Size() == 1);
+      REQUIRE_FALSE(table.Contains(7));
+    }
+  }
+}
@@ -21,42 +21,42 @@ using namespace source_processor;
 SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb_stub = PKBStub();
-    QueryEvaluator::SetPKB(&pkb_stub);
+    QueryEvaluator evaluator(&pkb_stub);
     Database empty_database;
     WHEN("Invalid Follows SuchThatClause is evaluated") {
       SuchThatClause invalid_follows_clause_with_variables = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                             ClauseParam(1),
                                                                             ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "V")));
       THEN("Throws error on invalid DesignEntity") {
-        REQUIRE_THROWS(QueryEvaluator::EvaluateSuchThatClause(invalid_follows_clause_with_variables, empty_database));
+        REQUIRE_THROWS(evaluator.EvaluateSuchThatClause(invalid_follows_clause_with_variables, empty_database));
       }
 
       SuchThatClause invalid_follows_clause_with_names = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                         ClauseParam(1),
                                                                         ClauseParam("test"));
       THEN("Throws error on invalid SuchThatClause parameter") {
-        REQUIRE_THROWS(QueryEvaluator::EvaluateSuchThatClause(invalid_follows_clause_with_names, empty_database));
+        REQUIRE_THROWS(evaluator.EvaluateSuchThatClause(invalid_follows_clause_with_names, empty_database));
       }
     }
 
     WHEN("Valid Follows(INT, INT) SuchThatClause is evaluated") {
       SuchThatClause valid_follows_clause_returns_true = SuchThatClause(DesignAbstraction::FOLLOWS, ClauseParam(1), ClauseParam(2));
-      bool test_bool = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_returns_true,
-                                                              empty_database);
+      bool test_bool = evaluator.EvaluateSuchThatClause(valid_follows_clause_returns_true,
+                                                        empty_database);
       THEN("Clause evaluates to true when Follows(1, 2)") {
         REQUIRE(test_bool == true);
       }
 
       SuchThatClause valid_follows_clause_returns_false = SuchThatClause(DesignAbstraction::FOLLOWS, ClauseParam(1), ClauseParam(3));
-      bool test_bool_false = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_returns_false,
-                                                                    empty_database);
+      bool test_bool_false = evaluator.EvaluateSuchThatClause(valid_follows_clause_returns_false,
+                                                              empty_database);
       THEN("Clause evaluates to false when Follows(1, 3") {
         REQUIRE(test_bool_false == false);
       }
 
       SuchThatClause valid_follows_clause_inverted = SuchThatClause(DesignAbstraction::FOLLOWS, ClauseParam(2), ClauseParam(1));
-      bool test_bool_inverted = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_inverted,
-                                                                       empty_database);
+      bool test_bool_inverted = evaluator.EvaluateSuchThatClause(valid_follows_clause_inverted,
+                                                                 empty_database);
       THEN("Clause evaluates to false when Follows(2, 1)") {
         REQUIRE(test_bool_inverted == false);
       }
@@ -70,7 +70,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_clause_returns_true = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                         ClauseParam(1),
                                                                         ClauseParam(DesignEntity(DesignEntityType::STMT, "s")));
-      bool test_bool = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_returns_true, database);
+      bool test_bool = evaluator.EvaluateSuchThatClause(valid_follows_clause_returns_true, database);
       THEN("Clause evaluates to true when Follows(1, s) where s = {1, 2}") {
         REQUIRE(test_bool == true);
       }
@@ -80,7 +80,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_clause_returns_false = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                          ClauseParam(2),
                                                                          ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")));
-      bool test_bool_false = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_returns_false, database);
+      bool test_bool_false = evaluator.EvaluateSuchThatClause(valid_follows_clause_returns_false, database);
       THEN("Clause evaluates to false when Follows (2, a) where a = {4, 5, 6}") {
         REQUIRE(test_bool_false == false);
       }
@@ -91,7 +91,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_separated_returns_true = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                            ClauseParam(3),
                                                                            ClauseParam(DesignEntity(DesignEntityType::STMT, "s")));
-      bool test_separated_bool = QueryEvaluator::EvaluateSuchThatClause(valid_follows_separated_returns_true, new_database);
+      bool test_separated_bool = evaluator.EvaluateSuchThatClause(valid_follows_separated_returns_true, new_database);
       THEN("Clause evaluates to true when Follows (3, s) where the only statement after is 7") {
         REQUIRE(test_separated_bool == true);
       }
@@ -101,7 +101,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_wildcard_clause_returns_true = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                                  ClauseParam(4),
                                                                                  ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
-      bool test_bool = QueryEvaluator::EvaluateSuchThatClause(valid_follows_wildcard_clause_returns_true, empty_database);
+      bool test_bool = evaluator.EvaluateSuchThatClause(valid_follows_wildcard_clause_returns_true, empty_database);
       THEN("SuchThatClause evaluates to true when Follows (4, _)") {
         REQUIRE(test_bool == true);
       }
@@ -109,7 +109,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_wildcard_clause_returns_false = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                                   ClauseParam(6),
                                                                                   ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
-      bool test_bool_false = QueryEvaluator::EvaluateSuchThatClause(valid_follows_wildcard_clause_returns_false, empty_database);
+      bool test_bool_false = evaluator.EvaluateSuchThatClause(valid_follows_wildcard_clause_returns_false, empty_database);
       THEN("SuchThatClause evaluates to false with Follows (6, _)") {
         REQUIRE(test_bool_false == false);
       }
@@ -119,7 +119,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_wildcard_clause_returns_true = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                                  ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                                                  ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
-      bool test_bool = QueryEvaluator::EvaluateSuchThatClause(valid_follows_wildcard_clause_returns_true, empty_database);
+      bool test_bool = evaluator.EvaluateSuchThatClause(valid_follows_wildcard_clause_returns_true, empty_database);
       THEN("SuchThatClause evaluates to true when Follows (_, _)") {
         REQUIRE(test_bool == true);
       }
@@ -133,7 +133,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_clause_stmt_stmt = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                      ClauseParam(DesignEntity(DesignEntityType::STMT, "s")),
                                                                      ClauseParam(DesignEntity(DesignEntityType::STMT, "s")));
-      bool test_bool_false = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_stmt_stmt, database);
+      bool test_bool_false = evaluator.EvaluateSuchThatClause(valid_follows_clause_stmt_stmt, database);
       THEN("SuchThatClause evaluates to false.") {
         REQUIRE(test_bool_false == false);
       }
@@ -149,7 +149,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_clause_assign1_assign2 = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                            ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a1")),
                                                                            ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a2")));
-      bool test_bool = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_assign1_assign2, database);
+      bool test_bool = evaluator.EvaluateSuchThatClause(valid_follows_clause_assign1_assign2, database);
       THEN("SuchThatClause evaluates to true.") {
         REQUIRE(test_bool == true);
       }
@@ -164,7 +164,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_clause_read1_read2 = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                        ClauseParam(DesignEntity(DesignEntityType::READ, "r1")),
                                                                        ClauseParam(DesignEntity(DesignEntityType::READ, "r2")));
-      bool test_bool_false = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_read1_read2, database);
+      bool test_bool_false = evaluator.EvaluateSuchThatClause(valid_follows_clause_read1_read2, database);
       THEN("SuchThatClause evaluates to false.") {
         REQUIRE(test_bool_false == false);
       }
@@ -179,7 +179,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_clause_assign_while = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                         ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")),
                                                                         ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")));
-      bool test_bool = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_assign_while, database);
+      bool test_bool = evaluator.EvaluateSuchThatClause(valid_follows_clause_assign_while, database);
       THEN("SuchThatClause evaluates to true.") {
         REQUIRE(test_bool == true);
       }
@@ -194,7 +194,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
       SuchThatClause valid_follows_clause_while_assign = SuchThatClause(DesignAbstraction::FOLLOWS,
                                                                         ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
                                                                         ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")));
-      bool test_bool_false = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_while_assign, database);
+      bool test_bool_false = evaluator.EvaluateSuchThatClause(valid_follows_clause_while_assign, database);
       THEN("SuchThatClause evaluates to false.") {
         REQUIRE(test_bool_false == false);
       }
@@ -205,7 +205,7 @@ SCENARIO("Test EvaluateSuchThatClause with Follows Clause") {
 SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
 
     WHEN("Invalid Parent Clause is evaluated") {
@@ -213,14 +213,14 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                  ClauseParam(1),
                                                                  ClauseParam("s"));
       THEN("Clause throws error when Parent(int, string)") {
-        REQUIRE_THROWS(QueryEvaluator::EvaluateSuchThatClause(invalid_clause_with_string, empty_database));
+        REQUIRE_THROWS(evaluator.EvaluateSuchThatClause(invalid_clause_with_string, empty_database));
       }
 
       SuchThatClause invalid_clause_with_procedure = SuchThatClause(DesignAbstraction::PARENT,
                                                                     ClauseParam(1),
                                                                     ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p")));
       THEN("Clause throws error when Parent(int, PROCEDURE DE)") {
-        REQUIRE_THROWS(QueryEvaluator::EvaluateSuchThatClause(invalid_clause_with_procedure, empty_database));
+        REQUIRE_THROWS(evaluator.EvaluateSuchThatClause(invalid_clause_with_procedure, empty_database));
       }
     }
 
@@ -229,14 +229,14 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                ClauseParam(3),
                                                                ClauseParam(6));
       THEN("Clause evaluates to true when Parent(3, 6)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_return_true, empty_database));
       }
 
       SuchThatClause valid_inverted_clause_return_false = SuchThatClause(DesignAbstraction::PARENT,
                                                                          ClauseParam(6),
                                                                          ClauseParam(3));
       THEN("Clause evaluates to false when Parent(6, 3)") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_inverted_clause_return_false, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_inverted_clause_return_false, empty_database));
       }
 
       SuchThatClause valid_clause_nested_return_true = SuchThatClause(DesignAbstraction::PARENT,
@@ -244,7 +244,7 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                       ClauseParam(10));
       THEN("Clause evaluates to true when Parent (9, 10)") {
         //Statement 9 is a container nested within another container
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_nested_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_nested_return_true, empty_database));
       }
     }
 
@@ -254,14 +254,14 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")));
 
       THEN("Clause evaluates to true when Parent(3, a)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_return_true, empty_database));
       }
 
       SuchThatClause valid_clause_return_false = SuchThatClause(DesignAbstraction::PARENT,
                                                                 ClauseParam(3),
                                                                 ClauseParam(DesignEntity(DesignEntityType::READ, "r")));
       THEN("Clause evaluates to false when Parent(3, r)") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_false, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_clause_return_false, empty_database));
       }
 
       SuchThatClause valid_clause_nested_return_false = SuchThatClause(DesignAbstraction::PARENT,
@@ -270,7 +270,7 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
 
       THEN("Clause evaluates to false when Parent(8, pn)") {
         // This should evaluate to True when Parent* but false when Parent
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_nested_return_false, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_clause_nested_return_false, empty_database));
       }
     }
 
@@ -279,13 +279,13 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
                                                                ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")));
       THEN("Clause evaluates to true when Parent(w, a)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_return_true, empty_database));
       }
 
       SuchThatClause valid_clause_nested_return_false = SuchThatClause(DesignAbstraction::PARENT,
                                                                        ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
                                                                        ClauseParam(DesignEntity(DesignEntityType::PRINT, "pn")));
-      bool result = QueryEvaluator::EvaluateSuchThatClause(valid_clause_nested_return_false, empty_database);
+      bool result = evaluator.EvaluateSuchThatClause(valid_clause_nested_return_false, empty_database);
       THEN("Clause evaluates to true when Parent(w,pn)") {
         REQUIRE(result);
       }
@@ -294,7 +294,7 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                          ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
                                                                          ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")));
       THEN("Clause evaluates to false when Parent(w,w)") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_repeated_return_false, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_clause_repeated_return_false, empty_database));
       }
     }
 
@@ -304,21 +304,21 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
                                                                ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
       THEN("Clause evaluates to true when Parent(w, _)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_return_true, empty_database));
       }
       SuchThatClause valid_clause_return_false = SuchThatClause(DesignAbstraction::PARENT,
                                                                 ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")),
                                                                 ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
 
       THEN("Clause evaluates to false when Parent(a, _)") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_false, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_clause_return_false, empty_database));
       }
 
       SuchThatClause valid_clause_inverted_return_true = SuchThatClause(DesignAbstraction::PARENT,
                                                                         ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                                         ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")));
       THEN("Clause evaluates to true when Parent(_,a)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_inverted_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_inverted_return_true, empty_database));
       }
     }
 
@@ -327,7 +327,7 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
                                                                ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                                ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
       THEN("Clause evaluates to true when Parent(_, _)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_return_true, empty_database));
       }
     }
   }
@@ -336,7 +336,7 @@ SCENARIO("Test EvaluateSuchThatClause with Parent Clause") {
 SCENARIO("Test EvaluateSuchThatClause with ParentT Clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
 
     WHEN("Valid ParentT (INT, INT) Clause is evaluated") {
@@ -344,7 +344,7 @@ SCENARIO("Test EvaluateSuchThatClause with ParentT Clause") {
                                                                ClauseParam(8),
                                                                ClauseParam(10));
       THEN("Clause evaluates to true when ParentT(8, 10)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_return_true, empty_database));
       }
 
       SuchThatClause valid_inverted_clause_return_false = SuchThatClause(DesignAbstraction::PARENT_T,
@@ -352,7 +352,7 @@ SCENARIO("Test EvaluateSuchThatClause with ParentT Clause") {
                                                                          ClauseParam(8));
       THEN("Clause evaluates to false when ParentT(10, 8)") {
         REQUIRE_FALSE(
-            QueryEvaluator::EvaluateSuchThatClause(valid_inverted_clause_return_false, empty_database));
+            evaluator.EvaluateSuchThatClause(valid_inverted_clause_return_false, empty_database));
       }
     }
 
@@ -363,7 +363,7 @@ SCENARIO("Test EvaluateSuchThatClause with ParentT Clause") {
                                                                                                "pn")));
 
       THEN("Clause evaluates to true when ParentT(8, pn)") {
-        bool result = QueryEvaluator::EvaluateSuchThatClause(valid_clause_nested_return_true, empty_database);
+        bool result = evaluator.EvaluateSuchThatClause(valid_clause_nested_return_true, empty_database);
         REQUIRE(result == true);
       }
     }
@@ -376,7 +376,7 @@ SCENARIO("Test EvaluateSuchThatClause with ParentT Clause") {
                                                                           DesignEntityType::PRINT, "pn")));
       THEN("Clause evaluates to true when ParentT(w,pn)") {
         //This should evaluate to True when Parent* but false when Parent
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_nested_return_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_clause_nested_return_true, empty_database));
       }
 
       SuchThatClause valid_clause_repeated_return_false = SuchThatClause(DesignAbstraction::PARENT_T,
@@ -385,8 +385,8 @@ SCENARIO("Test EvaluateSuchThatClause with ParentT Clause") {
                                                                          ClauseParam(DesignEntity(
                                                                              DesignEntityType::WHILE, "w")));
       THEN("Clause evaluates to false when ParentT(w,w)") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_clause_repeated_return_false,
-                                                             empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_clause_repeated_return_false,
+                                                       empty_database));
       }
     }
   }
@@ -395,7 +395,7 @@ SCENARIO("Test EvaluateSuchThatClause with ParentT Clause") {
 SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
 
     WHEN("Valid Uses(INT, NAME) is evaluated") {
@@ -403,19 +403,19 @@ SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(4),
                                                           ClauseParam("number"));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
       THEN("Uses(7, \"sum\") is a print statement that returns true") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(7),
                                                           ClauseParam("sum"));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
       THEN("Uses(4, \"digit\" is an assignment statement that modifies digit, returns false") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(4),
                                                           ClauseParam("digit"));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
     }
 
@@ -424,7 +424,7 @@ SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(5),
                                                           ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
 
       ResultTable v1_table = CreateSingleColumnResultTable("v1", std::unordered_set<std::string>{"number"});
@@ -433,14 +433,14 @@ SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(5),
                                                           ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v1")));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, filled_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_uses_clause, filled_database));
       }
 
       THEN("Uses(2, v) is an assignment statement that only uses constants, returns false") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(2),
                                                           ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
     }
 
@@ -449,14 +449,14 @@ SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(7),
                                                           ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
 
       THEN("Uses(2, _) returns false") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(2),
                                                           ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
     }
 
@@ -465,21 +465,21 @@ SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
                                                           ClauseParam("digit"));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
 
       THEN("Uses(a, \"digit\") returns true") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")),
                                                           ClauseParam("digit"));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
 
       THEN("Uses(p, \"x\") returns true") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p")),
                                                           ClauseParam("x"));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
     }
 
@@ -488,14 +488,14 @@ SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")),
                                                           ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
 
       THEN("Uses(r, v) returns false") {
         SuchThatClause valid_uses_clause = SuchThatClause(DesignAbstraction::USES,
                                                           ClauseParam(DesignEntity(DesignEntityType::READ, "r")),
                                                           ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_uses_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_uses_clause, empty_database));
       }
     }
   }
@@ -506,7 +506,7 @@ SCENARIO("Test EvaluateSuchThatClause with Uses Clause") {
 SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
 
     WHEN("Valid Modifies(INT, NAME) is evaluated") {
@@ -514,14 +514,14 @@ SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
         SuchThatClause valid_modifies_clause = SuchThatClause(DesignAbstraction::MODIFIES,
                                                               ClauseParam(2),
                                                               ClauseParam("sum"));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, empty_database));
       }
 
       THEN("Modifies(4, \"number\" returns false") {
         SuchThatClause valid_modifies_clause = SuchThatClause(DesignAbstraction::MODIFIES,
                                                               ClauseParam(4),
                                                               ClauseParam("number"));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, empty_database));
       }
     }
 
@@ -530,7 +530,7 @@ SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
         SuchThatClause valid_modifies_clause = SuchThatClause(DesignAbstraction::MODIFIES,
                                                               ClauseParam(1),
                                                               ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, empty_database));
       }
 
       ResultTable v1_table = CreateSingleColumnResultTable("v1", std::unordered_set<std::string>{"digit"});
@@ -539,7 +539,7 @@ SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
         SuchThatClause valid_modifies_clause = SuchThatClause(DesignAbstraction::MODIFIES,
                                                               ClauseParam(1),
                                                               ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v1")));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, filled_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, filled_database));
       }
     }
 
@@ -548,7 +548,7 @@ SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
         SuchThatClause valid_modifies_clause = SuchThatClause(DesignAbstraction::MODIFIES,
                                                               ClauseParam(DesignEntity(DesignEntityType::STMT, "s")),
                                                               ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, empty_database));
       }
 
       ResultTable s1_table = CreateSingleColumnResultTable("s1", std::unordered_set<int>{7});
@@ -557,8 +557,8 @@ SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
         SuchThatClause valid_modifies_clause = SuchThatClause(DesignAbstraction::MODIFIES,
                                                               ClauseParam(DesignEntity(DesignEntityType::STMT, "s1")),
                                                               ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, filled_database));
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, filled_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, empty_database));
       }
     }
 
@@ -567,7 +567,7 @@ SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
         SuchThatClause valid_modifies_clause = SuchThatClause(DesignAbstraction::MODIFIES,
                                                               ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p")),
                                                               ClauseParam("y"));
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_modifies_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_modifies_clause, empty_database));
       }
     }
   }
@@ -576,14 +576,14 @@ SCENARIO("Test EvaluateSuchThatClause with Modifies Clause") {
 SCENARIO("Test SuchThatClause with Calls/* clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
 
     WHEN("Invalid calls clause") {
       SuchThatClause invalid_calls_clause = SuchThatClause(DesignAbstraction::CALLS_T,
                                                            ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")),
                                                            ClauseParam("test"));
-      REQUIRE_THROWS(QueryEvaluator::EvaluateSuchThatClause(invalid_calls_clause, empty_database));
+      REQUIRE_THROWS(evaluator.EvaluateSuchThatClause(invalid_calls_clause, empty_database));
     }
 
     WHEN("Valid Calls(NAME, NAME) returns true") {
@@ -591,7 +591,7 @@ SCENARIO("Test SuchThatClause with Calls/* clause") {
                                                          ClauseParam("nestVar"),
                                                          ClauseParam("sumDigits"));
       THEN("Calls(nestVar, sumDigits) return true") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_calls_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_calls_clause, empty_database));
       }
     }
 
@@ -600,7 +600,7 @@ SCENARIO("Test SuchThatClause with Calls/* clause") {
                                                          ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p")),
                                                          ClauseParam("nestVar"));
       THEN("Calls(p, nestVar) returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_calls_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_calls_clause, empty_database));
       }
     }
 
@@ -609,7 +609,7 @@ SCENARIO("Test SuchThatClause with Calls/* clause") {
                                                          ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p")),
                                                          ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p2")));
       THEN("Calls(p, p2) returns true") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_calls_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_calls_clause, empty_database));
       }
     }
 
@@ -618,7 +618,7 @@ SCENARIO("Test SuchThatClause with Calls/* clause") {
                                                          ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p")),
                                                          ClauseParam(DesignEntity(DesignEntityType::PROCEDURE, "p")));
       THEN("Calls*(p, p) returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_calls_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_calls_clause, empty_database));
       }
     }
 
@@ -627,7 +627,7 @@ SCENARIO("Test SuchThatClause with Calls/* clause") {
                                                          ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                          ClauseParam("nestVar"));
       THEN("Calls*(_, nestVar) returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_calls_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_calls_clause, empty_database));
       }
     }
   }
@@ -636,7 +636,7 @@ SCENARIO("Test SuchThatClause with Calls/* clause") {
 SCENARIO("Test SuchThatClause with Next/* clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
 
     WHEN("Valid Next(int, int) returns true") {
@@ -644,7 +644,7 @@ SCENARIO("Test SuchThatClause with Next/* clause") {
                                                         ClauseParam(6),
                                                         ClauseParam(3));
       THEN("Next (6, 3) returns true") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_next_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_next_clause, empty_database));
       }
     }
 
@@ -653,7 +653,7 @@ SCENARIO("Test SuchThatClause with Next/* clause") {
                                                         ClauseParam(6),
                                                         ClauseParam(7));
       THEN("Next (6, 7) returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_next_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_next_clause, empty_database));
       }
     }
 
@@ -662,7 +662,7 @@ SCENARIO("Test SuchThatClause with Next/* clause") {
                                                         ClauseParam(3),
                                                         ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")));
       THEN("Next (3, n) returns true") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_next_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_next_clause, empty_database));
       }
     }
 
@@ -671,7 +671,7 @@ SCENARIO("Test SuchThatClause with Next/* clause") {
                                                         ClauseParam(7),
                                                         ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")));
       THEN("Next (7, n) returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateSuchThatClause(valid_next_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateSuchThatClause(valid_next_clause, empty_database));
       }
     }
 
@@ -680,7 +680,7 @@ SCENARIO("Test SuchThatClause with Next/* clause") {
                                                          ClauseParam(3),
                                                          ClauseParam(3));
       THEN("Next*(3, 3) returns true") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_nextT_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_nextT_clause, empty_database));
       }
     }
 
@@ -689,7 +689,7 @@ SCENARIO("Test SuchThatClause with Next/* clause") {
                                                          ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")),
                                                          ClauseParam(DesignEntity(DesignEntityType::PROG_LINE, "n")));
       THEN("Next*(n, n) returns true") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_nextT_clause, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_nextT_clause, empty_database));
       }
     }
   }
@@ -697,7 +697,7 @@ SCENARIO("Test SuchThatClause with Next/* clause") {
 SCENARIO("Test EvaluatePatternClause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
 
     WHEN("Invalid pattern clause") {
@@ -706,7 +706,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                         ClauseParam("x + 10"));
 
       THEN("Throws error on invalid non-PatternExpression param on the right side") {
-        REQUIRE_THROWS(QueryEvaluator::EvaluatePatternClause(invalid_rhs_pattern, empty_database));
+        REQUIRE_THROWS(evaluator.EvaluatePatternClause(invalid_rhs_pattern, empty_database));
       }
 
       PatternClause invalid_lhs_pattern = PatternClause(DesignEntity(DesignEntityType::ASSIGN, "a"),
@@ -714,7 +714,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                         ClauseParam(PatternExpression(TokenList())));
 
       THEN("Throws error on invalid DesignEntity on the LHS") {
-        REQUIRE_THROWS(QueryEvaluator::EvaluatePatternClause(invalid_lhs_pattern, empty_database));
+        REQUIRE_THROWS(evaluator.EvaluatePatternClause(invalid_lhs_pattern, empty_database));
       }
     }
 
@@ -729,7 +729,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                              DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                          ClauseParam(PatternExpression(rhs_expr)));
       THEN("pattern a(_, \"number % 10\") returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause, empty_database));
       }
 
       PatternClause valid_pattern_clause_2 = PatternClause(DesignEntity(DesignEntityType::ASSIGN, "a1"),
@@ -745,7 +745,7 @@ SCENARIO("Test EvaluatePatternClause") {
           ClauseParam(PatternExpression(partial_rhs)));
       THEN("pattern a(_, \"number\") returns false") {
         REQUIRE_FALSE(
-            QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_returns_false, empty_database));
+            evaluator.EvaluatePatternClause(valid_pattern_clause_returns_false, empty_database));
       }
     }
 
@@ -757,7 +757,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                          ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")),
                                                          ClauseParam(PatternExpression(rhs_constant)));
       THEN("pattern a(v, \"0\") returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause, empty_database));
       }
 
       TokenList rhs_expr;
@@ -769,7 +769,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                                  ClauseParam("sum"),
                                                                  ClauseParam(PatternExpression(rhs_expr)));
       THEN("pattern a(\"sum\", \"sum + digit\") returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_lhs_sum, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause_lhs_sum, empty_database));
       }
 
       PatternClause valid_pattern_clause_lhs_digit = PatternClause(DesignEntity(DesignEntityType::ASSIGN, "a"),
@@ -777,7 +777,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                                    ClauseParam(PatternExpression(rhs_expr)));
 
       THEN("pattern a(\"digit\", \"sum + digit\") returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_lhs_digit, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluatePatternClause(valid_pattern_clause_lhs_digit, empty_database));
       }
     }
 
@@ -792,7 +792,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                          ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                          ClauseParam(PatternExpression(partial_list, true)));
       THEN("pattern a(_, _\"sum\"_) returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause, empty_database));
       }
 
       TokenList full_list;
@@ -802,7 +802,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                               ClauseParam(PatternExpression(full_list, true)));
 
       THEN("pattern a(_, _\"sum + digit\"_) returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_full, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause_full, empty_database));
       }
 
       Token nonexistent("nonexistent", TokenType::VariableName);
@@ -812,7 +812,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                                       ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                                       ClauseParam(PatternExpression(bad_list, true)));
       THEN("pattern a(_, _\"nonexistent\"_) returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_return_false, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluatePatternClause(valid_pattern_clause_return_false, empty_database));
       }
     }
 
@@ -828,7 +828,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                              ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")),
                                                              ClauseParam(PatternExpression(rhs_constant, true)));
       THEN("pattern a(v, _\"10\"_) returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_var, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause_var, empty_database));
       }
 
       TokenList rhs_expr;
@@ -837,7 +837,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                              ClauseParam("sum"),
                                                              ClauseParam(PatternExpression(rhs_expr, true)));
       THEN("pattern a(\"sum\", _\"sum + digit\"_) returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_sum, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause_sum, empty_database));
       }
 
       TokenList rhs_digit;
@@ -846,7 +846,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                                       ClauseParam("number"),
                                                                       ClauseParam(PatternExpression(rhs_digit, true)));
       THEN("pattern a(\"number\", _\"digit\"_) returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_return_false, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluatePatternClause(valid_pattern_clause_return_false, empty_database));
       }
     }
     WHEN("Assignment pattern(_,_)") {
@@ -854,7 +854,7 @@ SCENARIO("Test EvaluatePatternClause") {
                                                                   ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")),
                                                                   ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
       THEN("pattern a(_,_) returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(valid_pattern_clause_wildcard, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(valid_pattern_clause_wildcard, empty_database));
       }
     }
   }
@@ -863,14 +863,14 @@ SCENARIO("Test EvaluatePatternClause") {
 SCENARIO("Test evaluate conditional pattern clauses") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
     WHEN("While pattern(NAME, _) returns true") {
       PatternClause pattern_clause = PatternClause(DesignEntity(DesignEntityType::WHILE, "w"),
                                                    ClauseParam("x"),
                                                    ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
       THEN("pattern w(\"x\",_) returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(pattern_clause, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(pattern_clause, empty_database));
       }
     }
 
@@ -879,7 +879,7 @@ SCENARIO("Test evaluate conditional pattern clauses") {
                                                    ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")),
                                                    ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
       THEN("pattern w(v, _) returns true") {
-        REQUIRE(QueryEvaluator::EvaluatePatternClause(pattern_clause, empty_database));
+        REQUIRE(evaluator.EvaluatePatternClause(pattern_clause, empty_database));
       }
     }
   }
@@ -888,25 +888,25 @@ SCENARIO("Test evaluate conditional pattern clauses") {
 SCENARIO("Test EvaluateWithClause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
     WHEN("with INT == INT returns true") {
       WithClause with_clause = WithClause(make_pair(ClauseParam(1), AttributeType::INTEGER), make_pair(ClauseParam(1), AttributeType::INTEGER));
       THEN("with 1==1 returns true") {
-        REQUIRE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
     WHEN("with NAME == NAME returns false") {
       WithClause with_clause = WithClause(make_pair(ClauseParam("x"), AttributeType::NAME), make_pair(ClauseParam("y"), AttributeType::NAME));
       THEN("with x==y returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
 
     WHEN("with INT == NAME returns false") {
       WithClause with_clause = WithClause(make_pair(ClauseParam("x"), AttributeType::NAME), make_pair(ClauseParam(1), AttributeType::INTEGER));
       THEN("with x==1 returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
     WHEN("with DE == INT returns true") {
@@ -914,7 +914,7 @@ SCENARIO("Test EvaluateWithClause") {
                                           make_pair(ClauseParam(9), AttributeType::INTEGER));
 
       THEN("with w.stmt# == 9 returns true") {
-        REQUIRE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
 
@@ -923,7 +923,7 @@ SCENARIO("Test EvaluateWithClause") {
                                           make_pair(ClauseParam(3), AttributeType::INTEGER));
 
       THEN("with a.stmt# == 3 returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
     WHEN("with DE == NAME returns true") {
@@ -931,7 +931,7 @@ SCENARIO("Test EvaluateWithClause") {
                                           make_pair(ClauseParam("sumDigits"), AttributeType::NAME));
 
       THEN("with c.procName == sumDigits returns true") {
-        REQUIRE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
 
@@ -940,7 +940,7 @@ SCENARIO("Test EvaluateWithClause") {
                                           make_pair(ClauseParam("y"), AttributeType::NAME));
 
       THEN("with pn.varName == y returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
     WHEN("with DE == DE returns true") {
@@ -948,7 +948,7 @@ SCENARIO("Test EvaluateWithClause") {
                                           make_pair(ClauseParam(DesignEntity(DesignEntityType::READ, "r")), AttributeType::VAR_NAME));
 
       THEN("with v.varName == r.varName returns true") {
-        REQUIRE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
     WHEN("with DE == DE returns false") {
@@ -956,7 +956,7 @@ SCENARIO("Test EvaluateWithClause") {
                                           make_pair(ClauseParam(DesignEntity(DesignEntityType::WHILE, "w")), AttributeType::STMT_NO));
 
       THEN("with a.stmt# == w.stmt# returns false") {
-        REQUIRE_FALSE(QueryEvaluator::EvaluateWithClause(with_clause, empty_database));
+        REQUIRE_FALSE(evaluator.EvaluateWithClause(with_clause, empty_database));
       }
     }
   }
@@ -965,7 +965,7 @@ SCENARIO("Test EvaluateWithClause") {
 SCENARIO("Test special cases") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
+    QueryEvaluator evaluator(&pkb);
     Database empty_database;
     WHEN("Synonyms names are the same as left key and right key") {
       SuchThatClause valid_follows_clause_returns_true = SuchThatClause(DesignAbstraction::FOLLOWS,
@@ -976,7 +976,7 @@ SCENARIO("Test special cases") {
                                                                             "RIGHT")));
 
       THEN("stmt LEFT, RIGHT; Clause evaluates to true when Follows(LEFT, RIGHT)") {
-        REQUIRE(QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_returns_true, empty_database));
+        REQUIRE(evaluator.EvaluateSuchThatClause(valid_follows_clause_returns_true, empty_database));
       }
     }
 
@@ -987,11 +987,28 @@ SCENARIO("Test special cases") {
                                                                          ClauseParam(DesignEntity(
                                                                              DesignEntityType::STMT,
                                                                              "RIGHT")));
-      bool evaluation = QueryEvaluator::EvaluateSuchThatClause(valid_follows_clause_returns_false,
-                                                               empty_database);
+      bool evaluation = evaluator.EvaluateSuchThatClause(valid_follows_clause_returns_false,
+                                                         empty_database);
       THEN("if LEFT; stmt RIGHT; Clause evaluates to false when Follows(LEFT, RIGHT)") {
         REQUIRE_FALSE(evaluation);
       }
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("Test evaluators of different PKBs used together") {
+  GIVEN("An evaluator of the PKB Stub and one of an empty PKB") {
+    PKBStub pkb_stub = PKBStub();
+    PKB empty_pkb = PKB();
+    QueryEvaluator stub_evaluator(&pkb_stub);
+    QueryEvaluator empty_evaluator(&empty_pkb);
+    Database empty_database;
+    WHEN("The same clause is evaluated by each of them in turn") {
+      SuchThatClause follows_clause = SuchThatClause(DesignAbstraction::FOLLOWS, ClauseParam(1), ClauseParam(2));
+      THEN("Each evaluator answers from its own PKB") {
+        REQUIRE(stub_evaluator.EvaluateSuchThatClause(follows_clause, empty_database));
+        REQUIRE_FALSE(empty_evaluator.EvaluateSuchThatClause(follows_clause, empty_database));
+        REQUIRE(stub_evaluator.EvaluateSuchThatClause(follows_clause, empty_database));
+      }
+    }
+  }
+}
@@ -6,6 +6,7 @@
 #include "query_processor/commons/query/entities/DesignEntity.h"
 #include "query_processor/commons/query_result/QueryResult.h"
 #include "query_processor/query_evaluator/QueryEvaluator.h"
+#include "query_processor/query_evaluator/QueryMemory.h"
 #include "source_processor/token/TokenList.h"
 
 using namespace std;
@@ -15,7 +16,6 @@ using namespace source_processor;
 SCENARIO("Test EvaluateQuery Select BOOLEAN") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     WHEN("Query evaluates to true") {
       Query valid_query = Query(SelectedEntity(SelectedEntityType::BOOLEAN));
       SuchThatClause true_follows_clause = SuchThatClause(DesignAbstraction::FOLLOWS_T,
@@ -57,7 +57,6 @@ SCENARIO("Test EvaluateQuery Select BOOLEAN") {
 SCENARIO("Test EvaluateQuery with one Such That and one Pattern clause") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     WHEN("Such that clause and pattern clause evaluates to true separately, selects a different synonym") {
       Query valid_query = Query(SelectedEntity(DesignEntity(DesignEntityType::READ, "r")));
       SuchThatClause true_follows_clause = SuchThatClause(DesignAbstraction::FOLLOWS,
@@ -210,7 +209,6 @@ SCENARIO("Test EvaluateQuery with one Such That and one Pattern clause") {
 SCENARIO("Test EvaluateQuery with multiple SuchThatClauses") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     WHEN("Two SuchThatClauses evaluate independently and selected design entity is independent returns true") {
       Query valid_query = Query(SelectedEntity(DesignEntity(DesignEntityType::VARIABLE, "v")));
       SuchThatClause follows_clause = SuchThatClause(DesignAbstraction::FOLLOWS,
@@ -440,7 +438,6 @@ SCENARIO("Test EvaluateQuery with multiple SuchThatClauses") {
 SCENARIO("Test EvaluateQuery with multiple PatternClauses") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     Token number("number", TokenType::VariableName);
     Token sum("sum", TokenType::VariableName);
     Token digit("digit", TokenType::VariableName);
@@ -553,7 +550,6 @@ SCENARIO("Test EvaluateQuery with multiple PatternClauses") {
 SCENARIO("Test EvaluateQuery with multiple SuchThatClauses and PatternClauses") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     Token number("number", TokenType::VariableName);
     Token sum("sum", TokenType::VariableName);
     Token digit("digit", TokenType::VariableName);
@@ -642,7 +638,6 @@ SCENARIO("Test EvaluateQuery with multiple SuchThatClauses and PatternClauses")
 SCENARIO("Test With queries") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     WHEN("Multiple such that clauses result shrunk by with clause") {
       Query valid_query = Query(SelectedEntity(DesignEntity(DesignEntityType::ASSIGN, "a")));
       SuchThatClause parent_clause = SuchThatClause(DesignAbstraction::PARENT,
@@ -735,7 +730,6 @@ SCENARIO("Test With queries") {
 SCENARIO("Test selection of tuples") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     WHEN("Selected tuple both in final table") {
       DesignEntity w1 = DesignEntity(DesignEntityType::WHILE, "w1");
       DesignEntity w2 = DesignEntity(DesignEntityType::WHILE, "w2");
@@ -806,7 +800,6 @@ SCENARIO("Test selection of tuples") {
 SCENARIO("Test selection of attributes") {
   GIVEN("PKB Stub") {
     PKBStub pkb = PKBStub();
-    QueryEvaluator::SetPKB(&pkb);
     WHEN("Selected design entity is retrieved from the PKB") {
       Query valid_query = Query(SelectedEntity(
           make_pair(DesignEntity(DesignEntityType::PRINT, "pn"), AttributeType::VAR_NAME)));
@@ -858,3 +851,35 @@ SCENARIO("Test selection of attributes") {
     }
   }
 }
+
+SCENARIO("Test EvaluateQuery streams cross products past the streaming threshold") {
+  GIVEN("PKB Stub") {
+    PKBStub pkb = PKBStub();
+    Query valid_query = Query(SelectedEntity(DesignEntity(DesignEntityType::ASSIGN, "a")));
+    SuchThatClause follows_clause = SuchThatClause(DesignAbstraction::FOLLOWS,
+                                                   ClauseParam(DesignEntity(DesignEntityType::STMT, "s")),
+                                                   ClauseParam(DesignEntity(DesignEntityType::ASSIGN, "a")));
+    PatternClause pattern_clause = PatternClause(DesignEntity(DesignEntityType::ASSIGN, "a"),
+                                                 ClauseParam(DesignEntity(DesignEntityType::VARIABLE, "v")),
+                                                 ClauseParam(DesignEntity(DesignEntityType::WILDCARD, "_")));
+    valid_query.AddClause(Clause(follows_clause));
+    valid_query.AddClause(Clause(pattern_clause));
+    QueryResult materialised_result = QueryEvaluator::EvaluateQuery(valid_query, &pkb, false);
+    WHEN("Every cross product is checked in a nested loop instead of being materialised") {
+      QueryMemory::SetLimits(0, 0);
+      QueryResult streamed_result = QueryEvaluator::EvaluateQuery(valid_query, &pkb, false);
+      QueryMemory::SetLimits(0, QueryMemory::kDefaultStreamingRows);
+      THEN("Select a such that Follows(s, a) pattern a(v, _) returns the same assignments") {
+        REQUIRE(!materialised_result.statement_indexes_or_constants.empty());
+        REQUIRE(streamed_result.statement_indexes_or_constants == materialised_result.statement_indexes_or_constants);
+      }
+    }
+    WHEN("The query is limited to less memory than its cross products take") {
+      QueryMemory::SetLimits(1, QueryMemory::kDefaultStreamingRows);
+      THEN("It stops with a MemoryLimitError") {
+        REQUIRE_THROWS_AS(QueryEvaluator::EvaluateQuery(valid_query, &pkb, false), MemoryLimitError);
+      }
+      QueryMemory::SetLimits(0, QueryMemory::kDefaultStreamingRows);
+    }
+  }
+}
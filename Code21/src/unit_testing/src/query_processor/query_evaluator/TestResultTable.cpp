@@ -1,5 +1,6 @@
 #include "TestUtils.h"
 #include "catch.hpp"
+#include "query_processor/query_evaluator/QueryMemory.h"
 #include "query_processor/query_evaluator/ResultTable.h"
 #include "query_processor/query_evaluator/utils/QueryEvaluatorUtils.h"
 
@@ -342,4 +343,52 @@ SCENARIO("Test Merge Table") {
       REQUIRE(IsSimilarColumn(result.GetColumn("s"), Column{TableElement(9), TableElement(9)}));
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("Test tables are accounted against the memory of a query") {
+  ResultTable table1 = CreateSingleColumnResultTable("a", unordered_set<int>{1, 2, 3});
+  ResultTable table2 = CreateSingleColumnResultTable("w", unordered_set<int>{4, 5, 6});
+  size_t cross_bytes = QueryMemory::EstimateBytes(9, 2);
+  WHEN("Two tables are crossed within the limit") {
+    QueryMemory::Scope scope;
+    ResultTable table1_2 = table1.CrossTable(table2);
+    THEN("The cross product is the peak of the query") {
+      REQUIRE(table1_2.CountBytes() == cross_bytes);
+      REQUIRE(scope.GetPeakBytes() == cross_bytes);
+    }
+  }
+  WHEN("Tables are held by the query") {
+    QueryMemory::Scope scope;
+    {
+      QueryMemory::Reservation reservation;
+      reservation.Resize(table1.CountBytes());
+      table1.CrossTable(table2);
+      REQUIRE(QueryMemory::GetHeldBytes() == table1.CountBytes());
+    }
+    THEN("The cross product is accounted on top of them until they are released") {
+      REQUIRE(scope.GetPeakBytes() == table1.CountBytes() + cross_bytes);
+      REQUIRE(QueryMemory::GetHeldBytes() == 0);
+    }
+  }
+  WHEN("Two tables are crossed past the limit") {
+    QueryMemory::SetLimits(cross_bytes - 1, QueryMemory::kDefaultStreamingRows);
+    THEN("The cross product is not materialised") {
+      REQUIRE_THROWS_AS(table1.CrossTable(table2), MemoryLimitError);
+      REQUIRE_THROWS_AS(table1.MergeTable(table2), MemoryLimitError);
+    }
+    QueryMemory::SetLimits(0, QueryMemory::kDefaultStreamingRows);
+  }
+  WHEN("Two tables are joined") {
+    ResultTable table3 = CreateSingleColumnResultTable("a", unordered_set<int>{2, 3, 4});
+    size_t join_bytes = QueryMemory::EstimateBytes(2, 1);
+    THEN("The join is counted before it is materialised") {
+      QueryMemory::Scope scope;
+      REQUIRE(table1.MergeTable(table3).CountBytes() == join_bytes);
+      REQUIRE(scope.GetPeakBytes() == join_bytes);
+    }
+    THEN("The join is not materialised past the limit") {
+      QueryMemory::SetLimits(join_bytes - 1, QueryMemory::kDefaultStreamingRows);
+      REQUIRE_THROWS_AS(table1.MergeTable(table3), MemoryLimitError);
+      QueryMemory::SetLimits(0, QueryMemory::kDefaultStreamingRows);
+    }
+  }
+}
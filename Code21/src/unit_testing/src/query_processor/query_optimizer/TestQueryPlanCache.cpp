@@ -0,0 +1,177 @@
+#include <string>
+
+#include "catch.hpp"
+#include "parser_utils/ExpressionParser.h"
+#include "query_processor/commons/BooleanSemanticError.h"
+#include "query_processor/commons/query/Query.h"
+#include "query_processor/query_optimizer/QueryPlanCache.h"
+#include "utils/Extension.h"
+
+using namespace std;
+using namespace query_processor;
+
+SCENARIO("Testing that queries of the same shape share a plan in the QueryPlanCache.", "[query_plan_cache]") {
+  QueryPlanCache::Clear();
+
+  WHEN("Queries only differ in whitespace, synonym names and literal values.") {
+    string first_query = "stmt s; variable v; Select s such that Follows*(s, 3) and Modifies(s, \"x\") with s.stmt# = 4";
+    string second_query = "stmt   st;\nvariable var;  Select st such that Follows*(st, 12) and Modifies(st, \"count\") with st.stmt# = 7";
+    Query first_planned_query = QueryPlanCache::GetPlannedQuery(first_query);
+    Query second_planned_query = QueryPlanCache::GetPlannedQuery(second_query);
+
+    THEN("The second query is a cache hit.") {
+      QueryPlanCacheStatistics statistics = QueryPlanCache::GetStatistics();
+      REQUIRE(statistics.hits == 1);
+      REQUIRE(statistics.misses == 1);
+      REQUIRE(statistics.uncacheable == 0);
+      REQUIRE(statistics.size == 1);
+      REQUIRE(statistics.GetHitRate() == 0.5);
+    }
+
+    THEN("The literals of the second query are bound into the plan, in the planned clause order.") {
+      vector<Clause>& clause_list = second_planned_query.GetClauseList();
+      REQUIRE(clause_list.size() == 3);
+      REQUIRE(clause_list.at(0).GetClauseType() == ClauseType::WITH);
+      REQUIRE(clause_list.at(0).GetWithClause().GetRHSParam().statement_index == 7);
+      REQUIRE(clause_list.at(1).GetSuchThatClause().GetDesignAbstraction() == DesignAbstraction::FOLLOWS_T);
+      REQUIRE(clause_list.at(1).GetSuchThatClause().GetRHSParam().statement_index == 12);
+      REQUIRE(clause_list.at(2).GetSuchThatClause().GetDesignAbstraction() == DesignAbstraction::MODIFIES);
+      REQUIRE(clause_list.at(2).GetSuchThatClause().GetRHSParam().var_proc_name == "count");
+    }
+
+    THEN("The first query keeps its own literals.") {
+      vector<Clause>& clause_list = first_planned_query.GetClauseList();
+      REQUIRE(clause_list.at(0).GetWithClause().GetRHSParam().statement_index == 4);
+      REQUIRE(clause_list.at(1).GetSuchThatClause().GetRHSParam().statement_index == 3);
+      REQUIRE(clause_list.at(2).GetSuchThatClause().GetRHSParam().var_proc_name == "x");
+    }
+  }
+
+  WHEN("A single name in a pattern expression is rebound.") {
+    string first_query = "assign a; Select a pattern a(\"x\", _\"y\"_)";
+    string second_query = "assign a; Select a pattern a(\"y\", _\"while\"_)";
+    QueryPlanCache::GetPlannedQuery(first_query);
+    Query planned_query = QueryPlanCache::GetPlannedQuery(second_query);
+
+    THEN("The expression is parsed from the new name.") {
+      REQUIRE(QueryPlanCache::GetStatistics().hits == 1);
+      PatternClause& pattern_clause = planned_query.GetClauseList().front().GetPatternClause();
+      REQUIRE(pattern_clause.GetLHSParam().var_proc_name == "y");
+      REQUIRE(pattern_clause.GetRHSParam().pattern_expr.token_list == parser_utils::ExpressionParser::ParseExpression("while"));
+      REQUIRE(pattern_clause.GetRHSParam().pattern_expr.is_wild_card);
+    }
+  }
+
+  QueryPlanCache::Clear();
+}
+
+SCENARIO("Testing that queries of different shapes do not share a plan in the QueryPlanCache.", "[query_plan_cache]") {
+  QueryPlanCache::Clear();
+
+  WHEN("Two queries only differ in which of their literals are equal.") {
+    string repeated_query = "stmt s; Select s such that Follows(1, s) and Follows(1, s)";
+    string distinct_query = "stmt s; Select s such that Follows(1, s) and Follows(2, s)";
+    Query planned_repeated_query = QueryPlanCache::GetPlannedQuery(repeated_query);
+    Query planned_distinct_query = QueryPlanCache::GetPlannedQuery(distinct_query);
+
+    THEN("Only the repeated clause is removed.") {
+      REQUIRE(QueryPlanCache::GetStatistics().hits == 0);
+      REQUIRE(planned_repeated_query.GetClauseList().size() == 1);
+      REQUIRE(planned_distinct_query.GetClauseList().size() == 2);
+    }
+  }
+
+  WHEN("Two queries only differ in synonyms named after keywords.") {
+    string follows_query = "stmt Follows; Select Follows such that Follows(Follows, 1)";
+    string parent_query = "stmt Parent; Select Parent such that Parent(Parent, 1)";
+    Query planned_follows_query = QueryPlanCache::GetPlannedQuery(follows_query);
+    Query planned_parent_query = QueryPlanCache::GetPlannedQuery(parent_query);
+
+    THEN("Each query keeps its own relationship.") {
+      REQUIRE(QueryPlanCache::GetStatistics().hits == 0);
+      REQUIRE(planned_follows_query.GetClauseList().front().GetSuchThatClause().GetDesignAbstraction() == DesignAbstraction::FOLLOWS);
+      REQUIRE(planned_parent_query.GetClauseList().front().GetSuchThatClause().GetDesignAbstraction() == DesignAbstraction::PARENT);
+    }
+  }
+
+  WHEN("Two queries only differ in an expression that is more than a single name.") {
+    string name_query = "assign a; Select a pattern a(_, _\"x\"_)";
+    string bracketed_query = "assign a; Select a pattern a(_, _\"(y)\"_)";
+    QueryPlanCache::GetPlannedQuery(name_query);
+    Query planned_bracketed_query = QueryPlanCache::GetPlannedQuery(bracketed_query);
+
+    THEN("The expression is part of the shape.") {
+      REQUIRE(QueryPlanCache::GetStatistics().hits == 0);
+      REQUIRE(planned_bracketed_query.GetClauseList().front().GetPatternClause().GetRHSParam().pattern_expr.token_list ==
+              parser_utils::ExpressionParser::ParseExpression("y"));
+    }
+  }
+
+  WHEN("The same query is planned for programs analysed with and without the NextBip extension.") {
+    string next_bip_query = "stmt s; Select s such that NextBip(s, 1)";
+    utils::Extension extension;
+    extension.has_next_bip = true;
+    Query planned_query = QueryPlanCache::GetPlannedQuery(next_bip_query, extension);
+
+    THEN("The plan is not shared with the program without the extension.") {
+      REQUIRE(planned_query.GetClauseList().front().GetSuchThatClause().GetDesignAbstraction() == DesignAbstraction::NEXTBIP);
+      REQUIRE_THROWS_AS(QueryPlanCache::GetPlannedQuery(next_bip_query), runtime_error);
+      REQUIRE(QueryPlanCache::GetStatistics().hits == 0);
+    }
+  }
+
+  QueryPlanCache::Clear();
+}
+
+SCENARIO("Testing invalid queries and the capacity of the QueryPlanCache.", "[query_plan_cache]") {
+  QueryPlanCache::Clear();
+
+  WHEN("Invalid queries are planned.") {
+    string syntax_error_query = "stmt s; Select s such that Follows(s, \"x\")";
+    string semantic_error_query = "stmt s; Select BOOLEAN such that Follows(s, s1)";
+
+    THEN("They throw as the parser does, and are never cached.") {
+      REQUIRE_THROWS_AS(QueryPlanCache::GetPlannedQuery(syntax_error_query), runtime_error);
+      REQUIRE_THROWS_AS(QueryPlanCache::GetPlannedQuery(semantic_error_query), BooleanSemanticError);
+      REQUIRE_THROWS_AS(QueryPlanCache::GetPlannedQuery(semantic_error_query), BooleanSemanticError);
+      QueryPlanCacheStatistics statistics = QueryPlanCache::GetStatistics();
+      REQUIRE(statistics.uncacheable == 3);
+      REQUIRE(statistics.size == 0);
+    }
+  }
+
+  WHEN("More shapes are planned than fit in the cache.") {
+    QueryPlanCache::SetCapacity(2);
+    string first_query = "stmt s; Select s such that Follows(s, 1)";
+    string second_query = "stmt s; Select s such that Parent(s, 1)";
+    string third_query = "stmt s; Select s such that Next(s, 1)";
+    QueryPlanCache::GetPlannedQuery(first_query);
+    QueryPlanCache::GetPlannedQuery(second_query);
+    QueryPlanCache::GetPlannedQuery(first_query);
+    QueryPlanCache::GetPlannedQuery(third_query);
+    QueryPlanCache::GetPlannedQuery(first_query);
+    QueryPlanCache::GetPlannedQuery(second_query);
+
+    THEN("The least recently used plan is evicted.") {
+      QueryPlanCacheStatistics statistics = QueryPlanCache::GetStatistics();
+      REQUIRE(statistics.hits == 2);
+      REQUIRE(statistics.misses == 4);
+      REQUIRE(statistics.size == 2);
+    }
+  }
+
+  WHEN("The cache is disabled.") {
+    QueryPlanCache::SetCapacity(0);
+    string query = "stmt s; Select s such that Follows(s, 1)";
+    QueryPlanCache::GetPlannedQuery(query);
+    Query planned_query = QueryPlanCache::GetPlannedQuery(query);
+
+    THEN("Every query is parsed and planned.") {
+      REQUIRE(QueryPlanCache::GetStatistics().uncacheable == 2);
+      REQUIRE(planned_query.GetClauseList().size() == 1);
+    }
+  }
+
+  QueryPlanCache::SetCapacity(1024);
+  QueryPlanCache::Clear();
+}
@@ -1770,10 +1770,11 @@ SCENARIO("Testing GenerateQuery() given a valid query with AffectsT clauses.", "
 }
 
 SCENARIO("Testing GenerateQuery() given a valid query with NextBip clauses.", "[query_parser]") {
-  utils::Extension::HasNextBip = true;
+  utils::Extension extension;
+  extension.has_next_bip = true;
   WHEN("NextBip clause compares an int with a valid synonym.") {
     string INT_SYNONYM_NEXT_BIP_STRING = "stmt s; Select s such that NextBip(1, s)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(INT_SYNONYM_NEXT_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(INT_SYNONYM_NEXT_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::NEXTBIP,
@@ -1789,7 +1790,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with NextBip clauses.", "[
 
   WHEN("NextBip clause uses synonyms and synonym strings with design entity type names.") {
     string CONFUSING_SYNONYM_NAMES_STRING = "stmt stmt, NextBip; while while, if, Select; Select Select such that NextBip(if, Select)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(CONFUSING_SYNONYM_NAMES_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(CONFUSING_SYNONYM_NAMES_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::WHILE, "Select")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::NEXTBIP,
@@ -1806,7 +1807,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with NextBip clauses.", "[
 
   WHEN("NextBip clause compares two valid synonyms.") {
     string TWO_SYNONYMS_NEXT_BIP_STRING = "stmt s, s1; Select s such that NextBip(s,s1)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_SYNONYMS_NEXT_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_SYNONYMS_NEXT_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::NEXTBIP,
@@ -1823,7 +1824,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with NextBip clauses.", "[
 
   WHEN("NextBip clause compares valid synonym with wildcard.") {
     string SYNONYM_WILDCARD_NEXT_BIP_STRING = "stmt s; Select s such that NextBip(s, _)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(SYNONYM_WILDCARD_NEXT_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(SYNONYM_WILDCARD_NEXT_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::NEXTBIP,
@@ -1840,7 +1841,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with NextBip clauses.", "[
 
   WHEN("NextBip clause compares two wildcards.") {
     string TWO_WILDCARDS_NEXT_BIP_STRING = "stmt s; Select s such that NextBip(_, _)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_WILDCARDS_NEXT_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_WILDCARDS_NEXT_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::NEXTBIP,
@@ -1857,7 +1858,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with NextBip clauses.", "[
 
   WHEN("NextBip clause contains valid excessive whitespace.") {
     string EXCESSIVE_WHITESPACE_NEXT_BIP_STRING = "stmt s; Select s \n\n\n\t\r\v \nsuch\n\n\nthat\t\t \r\n\n\nNextBip\n\n\t   \n( \t \n\n \r\n1\n\n\n,\r\n\n\n   2\n\n\n     )\n\n\n";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(EXCESSIVE_WHITESPACE_NEXT_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(EXCESSIVE_WHITESPACE_NEXT_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::NEXTBIP,
@@ -1873,10 +1874,11 @@ SCENARIO("Testing GenerateQuery() given a valid query with NextBip clauses.", "[
 }
 
 SCENARIO("Testing GenerateQuery() given a valid query with NextBipT clauses.", "[query_parser]") {
-  utils::Extension::HasNextBip = true;
+  utils::Extension extension;
+  extension.has_next_bip = true;
   WHEN("NextBipT clause has excessive valid whitespace between the asterisk and parameters.") {
     string VALID_WHITESPACE_NEXT_BIP_T_STRING = "stmt s; Select s such that NextBip*   \t\t\n\n\n\n \r\n\v\t (1, 2)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(VALID_WHITESPACE_NEXT_BIP_T_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(VALID_WHITESPACE_NEXT_BIP_T_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::NEXTBIP_T,
@@ -1892,10 +1894,11 @@ SCENARIO("Testing GenerateQuery() given a valid query with NextBipT clauses.", "
 }
 
 SCENARIO("Testing GenerateQuery() given a valid query with AffectsBip clauses.", "[query_parser]") {
-  utils::Extension::HasAffectsBip = true;
+  utils::Extension extension;
+  extension.has_affects_bip = true;
   WHEN("AffectsBip clause compares an int with a valid synonym.") {
     string INT_SYNONYM_AFFECTS_BIP_STRING = "stmt s; Select s such that AffectsBip(1, s)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(INT_SYNONYM_AFFECTS_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(INT_SYNONYM_AFFECTS_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::AFFECTSBIP,
@@ -1911,7 +1914,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with AffectsBip clauses.",
 
   WHEN("AffectsBip clause uses synonyms and synonym strings with design entity type names.") {
     string CONFUSING_SYNONYM_NAMES_STRING = "stmt stmt, AffectsBip; while while, if, Select; Select Select such that AffectsBip(if, Select)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(CONFUSING_SYNONYM_NAMES_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(CONFUSING_SYNONYM_NAMES_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::WHILE, "Select")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::AFFECTSBIP,
@@ -1928,7 +1931,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with AffectsBip clauses.",
 
   WHEN("AffectsBip clause compares two valid synonyms.") {
     string TWO_SYNONYMS_AFFECTS_BIP_STRING = "stmt s, s1; Select s such that AffectsBip(s,s1)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_SYNONYMS_AFFECTS_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_SYNONYMS_AFFECTS_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::AFFECTSBIP,
@@ -1945,7 +1948,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with AffectsBip clauses.",
 
   WHEN("AffectsBip clause compares valid synonym with wildcard.") {
     string SYNONYM_WILDCARD_AFFECTS_BIP_STRING = "stmt s; Select s such that AffectsBip(s, _)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(SYNONYM_WILDCARD_AFFECTS_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(SYNONYM_WILDCARD_AFFECTS_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::AFFECTSBIP,
@@ -1962,7 +1965,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with AffectsBip clauses.",
 
   WHEN("AffectsBip clause compares two wildcards.") {
     string TWO_WILDCARDS_AFFECTS_BIP_STRING = "stmt s; Select s such that AffectsBip(_, _)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_WILDCARDS_AFFECTS_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(TWO_WILDCARDS_AFFECTS_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::AFFECTSBIP,
@@ -1979,7 +1982,7 @@ SCENARIO("Testing GenerateQuery() given a valid query with AffectsBip clauses.",
 
   WHEN("AffectsBip clause contains valid excessive whitespace.") {
     string EXCESSIVE_WHITESPACE_AFFECTS_BIP_STRING = "stmt s; Select s \n\n\n\t\r\v \nsuch\n\n\nthat\t\t \r\n\n\nAffectsBip\n\n\t   \n( \t \n\n \r\n1\n\n\n,\r\n\n\n   2\n\n\n     )\n\n\n";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(EXCESSIVE_WHITESPACE_AFFECTS_BIP_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(EXCESSIVE_WHITESPACE_AFFECTS_BIP_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::AFFECTSBIP,
@@ -1995,10 +1998,11 @@ SCENARIO("Testing GenerateQuery() given a valid query with AffectsBip clauses.",
 }
 
 SCENARIO("Testing GenerateQuery() given a valid query with AffectsBipT clauses.", "[query_parser]") {
-  utils::Extension::HasAffectsBip = true;
+  utils::Extension extension;
+  extension.has_affects_bip = true;
   WHEN("AffectsBipT clause has excessive valid whitespace between the asterisk and parameters.") {
     string VALID_WHITESPACE_AFFECTS_BIP_T_STRING = "stmt s; Select s such that AffectsBip*   \t\t\n\n\n\n \r\n\v\t (1, 2)";
-    Query GENERATED_QUERY = QueryParser::GenerateQuery(VALID_WHITESPACE_AFFECTS_BIP_T_STRING);
+    Query GENERATED_QUERY = QueryParser::GenerateQuery(VALID_WHITESPACE_AFFECTS_BIP_T_STRING, extension);
 
     Query EXPECTED_QUERY = Query(SelectedEntity(DesignEntity(DesignEntityType::STMT, "s")));
     EXPECTED_QUERY.AddClause(SuchThatClause(DesignAbstraction::AFFECTSBIP_T,
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "catch.hpp"
+#include "commons.cpp"
+#include "design_extractor/DesignExtractor.h"
+#include "design_extractor/ExtractionContext.h"
+#include "pkb/PKB.h"
+#include "source_processor/Parser.h"
+
+using namespace std;
+
+// NOTE: To toggle whether this scenario will be run, look at the 'GetTag()' method in commons.cpp
+
+SCENARIO("Extracting AffectsBip* from a deep chain of procedures that are each called twice.", GetTag()) {
+  WHEN("Inlining every call would copy the last procedure 2^(depth - 1) times.") {
+    int depth = 40;
+    string program;
+    for (int p = 0; p < depth; p++) {
+      string calls = p + 1 < depth
+                         ? "call p" + to_string(p + 1) + "; y = x + y; call p" + to_string(p + 1) + ";"
+                         : "x = y + 1;";
+      program += "procedure p" + to_string(p) + " {"
+                 "  x = x + 1;"
+                 "  while (x > 0) {"
+                 "    " + calls + " }"
+                 "  y = x; }";
+    }
+
+    design_extractor::ExtractionContext context;
+    context.extension.has_affects_bip = true;
+    PKB pkb;
+    auto start = chrono::steady_clock::now();
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, source_processor::Parser::Parse(program), context);
+    auto end = chrono::steady_clock::now();
+
+    int num_stmts = pkb.GetAllStmts().size();
+    cout << "AffectsBip* over " << num_stmts << " statements in " << depth << " procedures: "
+         << chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms" << endl;
+
+    THEN("Definitions flow between the outermost and the innermost procedure in both directions.") {
+      REQUIRE(pkb.IsAffectsBip(num_stmts - 1, 4));
+      REQUIRE(!pkb.IsAffectsBip(num_stmts - 1, 1));
+      REQUIRE(pkb.IsAffectsBipT(1, num_stmts - 1));
+    }
+  }
+}
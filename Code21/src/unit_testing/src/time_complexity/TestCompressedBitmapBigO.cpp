@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+#include "catch.hpp"
+#include "commons.cpp"
+#include "pkb/utils/CompressedBitmap.h"
+
+using namespace std;
+
+// NOTE: To toggle whether this scenario will be run, look at the 'GetTag()' method in commons.cpp
+
+SCENARIO("Comparing CompressedBitmap against unordered_set as the rows of a transitive relation.", GetTag()) {
+  WHEN("The rows of a long loop, where every stmt reaches every other stmt, are intersected with a sparse column.") {
+    int num_stmts = 20000;
+    int num_rows = 200;
+    vector<int> all_stmts;
+    for (int stmt = 1; stmt <= num_stmts; stmt++) {
+      all_stmts.push_back(stmt);
+    }
+    vector<int> column;
+    for (int stmt = 7; stmt <= num_stmts; stmt += 13) {
+      column.push_back(stmt);
+    }
+
+    unordered_set<int> set_row(all_stmts.begin(), all_stmts.end());
+    unordered_set<int> set_column(column.begin(), column.end());
+    size_t set_matches = 0;
+    auto start = chrono::steady_clock::now();
+    for (int row = 0; row < num_rows; row++) {
+      for (int stmt : set_column) {
+        set_matches += set_row.count(stmt);
+      }
+    }
+    long long set_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    CompressedBitmap bitmap_row(all_stmts);
+    CompressedBitmap bitmap_column(column);
+    size_t bitmap_matches = 0;
+    start = chrono::steady_clock::now();
+    for (int row = 0; row < num_rows; row++) {
+      bitmap_matches += bitmap_row.Intersect(bitmap_column).Size();
+    }
+    long long bitmap_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    size_t set_bytes = set_row.size() * (sizeof(int) + 2 * sizeof(void*)) + set_row.bucket_count() * sizeof(void*);
+    cout << "unordered_set: " << set_time << "us, ~" << set_bytes << " bytes per row, CompressedBitmap: "
+         << bitmap_time << "us, " << bitmap_row.CountBytes() << " bytes per row" << endl;
+
+    THEN("Both rows agree on the intersection, and the compressed row is much smaller.") {
+      REQUIRE(set_matches == bitmap_matches);
+      REQUIRE(bitmap_row.CountBytes() * 100 < set_bytes);
+    }
+  }
+}
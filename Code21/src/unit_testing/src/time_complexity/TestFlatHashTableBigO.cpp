@@ -0,0 +1,65 @@
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "catch.hpp"
+#include "commons.cpp"
+#include "pkb/templates/FlatHashTable.h"
+
+using namespace std;
+
+// NOTE: To toggle whether this scenario will be run, look at the 'GetTag()' method in commons.cpp
+
+namespace {
+
+template <class Map>
+long long TimeInsertAndLookup(Map& map, int num_keys, int values_per_key, int& hits) {
+  auto start = chrono::steady_clock::now();
+  for (int i = 1; i <= num_keys; i++) {
+    for (int j = 1; j <= values_per_key; j++) {
+      map[i].insert(j);
+    }
+  }
+  for (int round = 0; round < 200; round++) {
+    for (int i = 1; i <= 2 * num_keys; i++) {
+      auto it = map.find(i);
+      if (it != map.end() && it->second.find(i % values_per_key + 1) != it->second.end()) {
+        hits++;
+      }
+    }
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration_cast<chrono::microseconds>(end - start).count();
+}
+
+}  // namespace
+
+SCENARIO("Comparing FlatHashMap against unordered_map as the backing store of TableMultiple.", GetTag()) {
+  WHEN("A table with a large source program's number of statement keys is filled and then probed many times.") {
+    int num_keys = 10000;
+    int values_per_key = 4;
+
+    unordered_map<int, unordered_set<int>> node_map;
+    int node_hits = 0;
+    long long node_time = TimeInsertAndLookup(node_map, num_keys, values_per_key, node_hits);
+
+    FlatHashMap<int, unordered_set<int>> flat_map;
+    int flat_hits = 0;
+    long long flat_time = TimeInsertAndLookup(flat_map, num_keys, values_per_key, flat_hits);
+
+    FlatHashMap<int, unordered_set<int>> reserved_flat_map;
+    reserved_flat_map.reserve(num_keys);
+    int reserved_flat_hits = 0;
+    long long reserved_flat_time = TimeInsertAndLookup(reserved_flat_map, num_keys, values_per_key, reserved_flat_hits);
+
+    cout << "unordered_map: " << node_time << "us, FlatHashMap: " << flat_time
+         << "us, FlatHashMap with reserve: " << reserved_flat_time << "us" << endl;
+
+    THEN("All maps agree on the lookups.") {
+      REQUIRE(node_hits == flat_hits);
+      REQUIRE(node_hits == reserved_flat_hits);
+      REQUIRE(node_map.size() == flat_map.size());
+    }
+  }
+}
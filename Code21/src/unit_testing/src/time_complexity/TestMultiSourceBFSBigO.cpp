@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "catch.hpp"
+#include "commons.cpp"
+#include "design_extractor/utils/CFGHandler.h"
+#include "design_extractor/utils/CSRGraph.h"
+#include "design_extractor/utils/MultiSourceBFS.h"
+#include "design_extractor/utils/TransitiveClosure.h"
+
+using namespace std;
+using namespace design_extractor;
+
+// NOTE: To toggle whether this scenario will be run, look at the 'GetTag()' method in commons.cpp
+
+SCENARIO("Comparing a multi-source BFS against the transitive closure.", GetTag()) {
+  WHEN("Every statement of a large CFG of nested loops and branches is a source.") {
+    // a CFG shaped like a sequence of while loops, each holding an if with a run of statements on either side
+    int num_loops = 400;
+    int run_length = 5;
+    CFG cfg(1);
+    int exit_node = -1;
+    auto add_node = [&cfg]() {
+      cfg.push_back({});
+      return static_cast<int>(cfg.size()) - 1;
+    };
+    auto add_run = [&](int from) {
+      int node = from;
+      for (int i = 0; i < run_length; i++) {
+        int next = add_node();
+        cfg[node].push_back(next);
+        node = next;
+      }
+      return node;
+    };
+    for (int loop = 0; loop < num_loops; loop++) {
+      int while_node = add_node();
+      if (exit_node != -1) {
+        cfg[exit_node].push_back(while_node);
+      }
+      int if_node = add_node();
+      cfg[while_node].push_back(if_node);
+      cfg[add_run(if_node)].push_back(while_node);
+      cfg[add_run(if_node)].push_back(while_node);
+      exit_node = while_node;
+    }
+
+    vector<int> sources;
+    for (int node = 1; node < cfg.size(); node++) {
+      sources.push_back(node);
+    }
+
+    CSRGraph graph(cfg);
+    vector<int> labels(cfg.size());
+    for (int node = 0; node < cfg.size(); node++) {
+      labels[node] = node;
+    }
+    auto start = chrono::steady_clock::now();
+    TransitiveClosure closure(graph, labels, cfg.size());
+    vector<unordered_set<int>> per_source;
+    for (int src : sources) {
+      per_source.push_back(TransitiveClosure::ToSet(closure.GetRow(src)));
+    }
+    auto per_source_end = chrono::steady_clock::now();
+
+    // the search alone, counting the reached (source, node) pairs from the bit lanes
+    MultiSourceBFS bfs(graph);
+    vector<uint64_t> reached;
+    long long num_pairs = 0;
+    for (int first = 0; first < sources.size(); first += MultiSourceBFS::kLanes) {
+      bfs.RunBatch(sources, first, reached);
+      for (uint64_t lanes : reached) {
+        num_pairs += __builtin_popcountll(lanes);
+      }
+    }
+    auto lanes_end = chrono::steady_clock::now();
+
+    auto multi_source = MultiSourceBFS::GetReachableNodes(graph, sources);
+    auto sets_end = chrono::steady_clock::now();
+
+    auto ms = [](chrono::steady_clock::time_point from, chrono::steady_clock::time_point to) {
+      return chrono::duration_cast<chrono::milliseconds>(to - from).count();
+    };
+    cout << "Reachability from " << sources.size() << " sources: transitive closure in "
+         << ms(start, per_source_end) << " ms; " << MultiSourceBFS::kLanes << " sources per pass in "
+         << ms(per_source_end, lanes_end) << " ms, or " << ms(lanes_end, sets_end) << " ms when expanded into sets" << endl;
+
+    THEN("Both find the same nodes from every source.") {
+      REQUIRE(multi_source == per_source);
+      long long num_per_source_pairs = 0;
+      for (const auto& nodes : per_source) {
+        num_per_source_pairs += nodes.size();
+      }
+      REQUIRE(num_pairs == num_per_source_pairs);
+    }
+  }
+}
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "catch.hpp"
+#include "commons.cpp"
+#include "design_extractor/DesignExtractor.h"
+#include "design_extractor/ExtractionContext.h"
+#include "pkb/PKB.h"
+#include "source_processor/Parser.h"
+
+using namespace std;
+
+// NOTE: To toggle whether this scenario will be run, look at the 'GetTag()' method in commons.cpp
+
+SCENARIO("Extracting NextBip* from a program with hundreds of procedures.", GetTag()) {
+  WHEN("Every procedure loops over a branch and calls the next procedure twice.") {
+    int num_procedures = 300;
+    string program;
+    for (int p = 0; p < num_procedures; p++) {
+      string calls = p + 1 < num_procedures
+                         ? "call p" + to_string(p + 1) + "; x = x + 1; call p" + to_string(p + 1) + ";"
+                         : "print x;";
+      program += "procedure p" + to_string(p) + " {"
+                 "  read x;"
+                 "  while (x > 0) {"
+                 "    if (x > 5) then { y = x; } else { " + calls + " }"
+                 "    x = x - 1; }"
+                 "  print y; }";
+    }
+
+    design_extractor::ExtractionContext context;
+    context.extension.has_next_bip = true;
+    PKB pkb;
+    auto start = chrono::steady_clock::now();
+    design_extractor::DesignExtractor::ExtractDesigns(pkb, source_processor::Parser::Parse(program), context);
+    auto end = chrono::steady_clock::now();
+
+    int num_stmts = pkb.GetAllStmts().size();
+    cout << "NextBip* over " << num_stmts << " statements in " << num_procedures << " procedures: "
+         << chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms" << endl;
+
+    THEN("The first statement reaches every other statement, and the last procedure cannot reach back.") {
+      REQUIRE(pkb.GetNextBipTStatements(1).size() == num_stmts - 1);
+      REQUIRE(pkb.GetNextBipTStatements(num_stmts).size() < num_stmts);
+    }
+  }
+}
@@ -1,4 +1,7 @@
+#include <chrono>
+#include <iostream>
 #include <string>
+#include <vector>
 
 #include "catch.hpp"
 #include "commons.cpp"
@@ -44,3 +47,34 @@ SCENARIO("Testing GenerateQuery() given a query with a huge number of conditiona
     }
   }
 }
+
+SCENARIO("Testing that GenerateQuery() scales linearly in the number of conditional clauses.", GetTag()) {
+  WHEN("Queries with up to 10000 clauses of every kind are parsed.") {
+    // each repetition holds one clause of every kind, half of them chained with 'and'
+    auto build_query = [](int number_of_repetitions) {
+      string query = "stmt s1, s2; assign a; while w; variable v; procedure p; Select <s1, a.stmt#>";
+      for (int i = 0; i < number_of_repetitions; i++) {
+        query += " such that Follows*(s1, " + to_string(i + 1) + ") and Modifies(a, \"x\")";
+        query += " pattern a(v, _\"x + y * (z - " + to_string(i) + ")\"_) and w(\"y\", _)";
+        query += " with p.procName = \"main\" and s2.stmt# = " + to_string(i + 1);
+      }
+      return query;
+    };
+
+    vector<long long> elapsed_us;
+    vector<int> number_of_clauses = {1000, 2000, 5000, 10000};
+    for (int clauses : number_of_clauses) {
+      string query = build_query(clauses / 6);
+      auto start = chrono::steady_clock::now();
+      Query generated_query = QueryParser::GenerateQuery(query);
+      elapsed_us.push_back(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+      cout << clauses << " clauses (" << query.size() << " chars): " << elapsed_us.back() << "us" << endl;
+
+      REQUIRE(generated_query.GetClauseList().size() == clauses / 6 * 6);
+    }
+
+    THEN("Ten times the clauses take about ten times as long to parse.") {
+      REQUIRE(elapsed_us.back() < 20 * (elapsed_us.front() + 1000));
+    }
+  }
+}
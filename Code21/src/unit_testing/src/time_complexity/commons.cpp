@@ -2,7 +2,7 @@
 
 using namespace std;
 
-string GetTag() {
+inline string GetTag() {
   // Toggle this boolean to determine whether time complexity tests will be run.
   //		All time complexity tests should reference this method to centralize test runs.
 
@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "utils/Arena.h"
+
+using namespace std;
+using utils::Arena;
+
+SCENARIO("Arena hands out the memory of short-lived containers") {
+  GIVEN("An arena installed on the thread") {
+    Arena arena;
+
+    WHEN("Containers are built within its scope") {
+      size_t sum = 0;
+      {
+        Arena::Scope scope(arena);
+        utils::ArenaUnorderedMap<string, int> map;
+        utils::ArenaVector<size_t> values;
+        for (int i = 0; i < 1000; i++) {
+          map[to_string(i)] = i;
+          values.push_back(i);
+        }
+        for (size_t value : values) {
+          sum += value + map[to_string(value)];
+        }
+      }
+
+      THEN("Their allocations are served from a few chunks and freed at once") {
+        utils::ArenaStatistics statistics = arena.GetStatistics();
+        REQUIRE(sum == 999 * 1000);
+        REQUIRE(statistics.allocations > 1000);
+        REQUIRE(statistics.chunk_allocations < 10);
+        REQUIRE(statistics.resets == 1);
+        REQUIRE(Arena::GetCurrent() == nullptr);
+      }
+
+      THEN("The next scope reuses the retained chunks") {
+        size_t chunk_allocations = arena.GetStatistics().chunk_allocations;
+        {
+          Arena::Scope scope(arena);
+          utils::ArenaVector<int> values(1000, 1);
+          REQUIRE(values.size() == 1000);
+        }
+        REQUIRE(arena.GetStatistics().chunk_allocations == chunk_allocations);
+      }
+    }
+
+    WHEN("Allocations of different alignments and sizes are made") {
+      Arena::Scope scope(arena);
+      void* small = arena.Allocate(1, 1);
+      void* aligned = arena.Allocate(8, 8);
+      void* large = arena.Allocate(Arena::kChunkBytes, 16);
+      THEN("Each is aligned and large ones get a chunk of their own") {
+        REQUIRE(small != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(aligned) % 8 == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(large) % 16 == 0);
+        REQUIRE(arena.GetStatistics().chunk_allocations == 2);
+      }
+    }
+
+    WHEN("Scopes of the arena are nested") {
+      {
+        Arena::Scope outer_scope(arena);
+        {
+          Arena::Scope inner_scope(arena);
+          REQUIRE(Arena::GetCurrent() == &arena);
+        }
+        THEN("Only the outer scope resets it") {
+          REQUIRE(Arena::GetCurrent() == &arena);
+          REQUIRE(arena.GetStatistics().resets == 0);
+        }
+      }
+      REQUIRE(arena.GetStatistics().resets == 1);
+    }
+  }
+
+  GIVEN("No arena installed on the thread") {
+    THEN("Containers take their memory from the heap") {
+      REQUIRE(Arena::GetCurrent() == nullptr);
+      utils::ArenaVector<int> values;
+      for (int i = 0; i < 100; i++) {
+        values.push_back(i);
+      }
+      REQUIRE(values.back() == 99);
+    }
+  }
+}
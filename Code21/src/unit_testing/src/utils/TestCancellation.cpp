@@ -0,0 +1,156 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "catch.hpp"
+#include "utils/Cancellation.h"
+#include "utils/Parallel.h"
+
+using namespace std;
+using utils::Cancellation;
+
+namespace {
+
+// does units of work until Check throws, returning how many it did
+size_t WorkUntilStopped(size_t limit) {
+  size_t work_done = 0;
+  try {
+    for (; work_done < limit; work_done++) {
+      Cancellation::Check();
+    }
+  } catch (const utils::TimeoutError&) {
+  }
+  return work_done;
+}
+
+}  // namespace
+
+SCENARIO("Cancellation stops work that is cancelled or past its deadline") {
+  GIVEN("No scope on the thread") {
+    THEN("Work is never stopped") {
+      REQUIRE(WorkUntilStopped(10 * Cancellation::kCheckInterval) == 10 * Cancellation::kCheckInterval);
+      REQUIRE_NOTHROW(Cancellation::CheckNow());
+    }
+  }
+
+  GIVEN("A scope with a cancellation token") {
+    utils::CancellationToken token;
+    Cancellation::Scope scope(&token);
+
+    WHEN("The token is not cancelled") {
+      THEN("Work goes on") {
+        REQUIRE_NOTHROW(Cancellation::CheckNow());
+      }
+    }
+
+    WHEN("The token is cancelled") {
+      token.Cancel();
+      THEN("Work stops within a check interval") {
+        REQUIRE_THROWS_AS(Cancellation::CheckNow(), utils::TimeoutError);
+        REQUIRE(WorkUntilStopped(10 * Cancellation::kCheckInterval) <= Cancellation::kCheckInterval);
+      }
+    }
+  }
+
+  GIVEN("A scope with a deadline") {
+    WHEN("The deadline has passed") {
+      Cancellation::Scope scope(nullptr, Cancellation::Clock::now() - chrono::milliseconds(1));
+      THEN("Work stops at its first unit") {
+        REQUIRE(WorkUntilStopped(10) == 0);
+      }
+    }
+
+    WHEN("The deadline is far off") {
+      Cancellation::Scope scope(nullptr, Cancellation::GetDeadlineAfter(60000));
+      THEN("Work goes on") {
+        REQUIRE(WorkUntilStopped(10 * Cancellation::kCheckInterval) == 10 * Cancellation::kCheckInterval);
+      }
+    }
+
+    WHEN("The timeout is not positive") {
+      THEN("There is no deadline") {
+        REQUIRE(Cancellation::GetDeadlineAfter(0) == Cancellation::Clock::time_point::max());
+        REQUIRE(Cancellation::GetDeadlineAfter(-1) == Cancellation::Clock::time_point::max());
+      }
+    }
+  }
+
+  GIVEN("Nested scopes") {
+    utils::CancellationToken token;
+    Cancellation::Clock::time_point outer_deadline = Cancellation::GetDeadlineAfter(60000);
+    Cancellation::Scope outer_scope(&token, outer_deadline);
+
+    WHEN("The inner scope has a later deadline and no token") {
+      {
+        Cancellation::Scope inner_scope(nullptr, Cancellation::GetDeadlineAfter(120000));
+        THEN("It keeps the token and the earlier deadline of the outer scope") {
+          REQUIRE(Cancellation::GetToken() == &token);
+          REQUIRE(Cancellation::GetDeadline() == outer_deadline);
+        }
+      }
+    }
+
+    WHEN("The inner scope has a passed deadline") {
+      {
+        Cancellation::Scope inner_scope(nullptr, Cancellation::Clock::now() - chrono::milliseconds(1));
+        REQUIRE_THROWS_AS(Cancellation::CheckNow(), utils::TimeoutError);
+      }
+      THEN("The outer scope is restored once it ends") {
+        REQUIRE(Cancellation::GetDeadline() == outer_deadline);
+        REQUIRE_NOTHROW(Cancellation::CheckNow());
+      }
+    }
+  }
+
+  GIVEN("A stop flag") {
+    volatile bool stop = false;
+    Cancellation::SetStopFlag(&stop);
+
+    WHEN("The flag is set") {
+      stop = true;
+      THEN("Work on every thread stops") {
+        REQUIRE_THROWS_AS(Cancellation::CheckNow(), utils::TimeoutError);
+      }
+    }
+
+    Cancellation::SetStopFlag(nullptr);
+  }
+}
+
+SCENARIO("Parallel::For workers follow the cancellation of the calling thread") {
+  GIVEN("A cancelled token on the calling thread") {
+    utils::CancellationToken token;
+    token.Cancel();
+    Cancellation::Scope scope(&token);
+
+    THEN("The workers stop and the TimeoutError reaches the caller") {
+      atomic<size_t> indices_run(0);
+      REQUIRE_THROWS_AS(utils::Parallel::For(1000, 4,
+                                             [&](size_t, int) {
+                                               Cancellation::Check();
+                                               indices_run++;
+                                             }),
+                        utils::TimeoutError);
+      REQUIRE(indices_run < 1000);
+    }
+  }
+
+  GIVEN("A token cancelled while the workers run") {
+    utils::CancellationToken token;
+    Cancellation::Scope scope(&token);
+
+    THEN("Every worker stops") {
+      REQUIRE_THROWS_AS(utils::Parallel::For(4, 4,
+                                             [&](size_t i, int) {
+                                               if (i == 0) {
+                                                 token.Cancel();
+                                               }
+                                               while (true) {
+                                                 Cancellation::Check();
+                                                 this_thread::yield();
+                                               }
+                                             }),
+                        utils::TimeoutError);
+    }
+  }
+}
@@ -0,0 +1,80 @@
+#include <memory>
+#include <string>
+
+#include "catch.hpp"
+#include "utils/LruCache.h"
+
+using namespace std;
+
+SCENARIO("LruCache evicts its least recently used entries") {
+  GIVEN("A cache bounded to 2 entries and 100 bytes") {
+    utils::LruCache<string> cache(2, 100);
+    cache.Put("a", make_shared<const string>("first"), 10);
+    cache.Put("b", make_shared<const string>("second"), 10);
+
+    WHEN("An entry is read before a third is put") {
+      REQUIRE(*cache.Get("a") == "first");
+      cache.Put("c", make_shared<const string>("third"), 10);
+
+      THEN("The entry that was not read is evicted") {
+        REQUIRE(cache.Get("b") == nullptr);
+        REQUIRE(*cache.Get("a") == "first");
+        REQUIRE(*cache.Get("c") == "third");
+        REQUIRE(cache.GetSize() == 2);
+        REQUIRE(cache.GetBytes() == 20);
+        REQUIRE(cache.GetEvictions() == 1);
+      }
+    }
+
+    WHEN("An entry is put under a key that is cached") {
+      cache.Put("a", make_shared<const string>("replaced"), 30);
+
+      THEN("The entry is replaced") {
+        REQUIRE(*cache.Get("a") == "replaced");
+        REQUIRE(cache.GetSize() == 2);
+        REQUIRE(cache.GetBytes() == 40);
+        REQUIRE(cache.GetEvictions() == 0);
+      }
+    }
+
+    WHEN("Entries exceed the bytes of the cache") {
+      shared_ptr<const string> evicted_value = cache.Get("b");
+      REQUIRE(*cache.Get("a") == "first");
+      cache.Put("c", make_shared<const string>("large"), 90);
+      cache.Put("d", make_shared<const string>("too large"), 101);
+
+      THEN("Entries are evicted until the rest fit, and values larger than the cache are never cached") {
+        REQUIRE(cache.Get("b") == nullptr);
+        REQUIRE(*cache.Get("a") == "first");
+        REQUIRE(*cache.Get("c") == "large");
+        REQUIRE(cache.Get("d") == nullptr);
+        REQUIRE(cache.GetBytes() == 100);
+        REQUIRE(*evicted_value == "second");
+      }
+    }
+
+    WHEN("The limits are lowered") {
+      cache.SetLimits(1, 100);
+
+      THEN("The cache evicts down to them, and a limit of 0 disables it") {
+        REQUIRE(cache.GetSize() == 1);
+        REQUIRE(cache.IsEnabled());
+        cache.SetLimits(0, 100);
+        REQUIRE(cache.GetSize() == 0);
+        REQUIRE_FALSE(cache.IsEnabled());
+        cache.Put("a", make_shared<const string>("first"), 10);
+        REQUIRE(cache.Get("a") == nullptr);
+      }
+    }
+
+    WHEN("The cache is cleared") {
+      cache.Clear();
+
+      THEN("It is empty") {
+        REQUIRE(cache.Get("a") == nullptr);
+        REQUIRE(cache.GetSize() == 0);
+        REQUIRE(cache.GetBytes() == 0);
+      }
+    }
+  }
+}
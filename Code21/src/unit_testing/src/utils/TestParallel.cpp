@@ -0,0 +1,68 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "catch.hpp"
+#include "utils/Parallel.h"
+
+using namespace std;
+
+SCENARIO("Parallel::For runs a loop body on a pool of threads") {
+  GIVEN("More indices than threads") {
+    const size_t kCount = 1000;
+    const int kNumThreads = 4;
+
+    WHEN("Every index is counted by the worker it was given to") {
+      vector<atomic<int>> times_run(kCount);
+      vector<vector<size_t>> claimed_by(kNumThreads);
+      utils::Parallel::For(kCount, kNumThreads, [&](size_t i, int worker) {
+        times_run[i]++;
+        claimed_by[worker].push_back(i);
+      });
+
+      THEN("Each index is run exactly once, in increasing order within a worker") {
+        for (size_t i = 0; i < kCount; i++) {
+          REQUIRE(times_run[i] == 1);
+        }
+        size_t total = 0;
+        for (auto& indices : claimed_by) {
+          total += indices.size();
+          for (size_t j = 1; j < indices.size(); j++) {
+            REQUIRE(indices[j - 1] < indices[j]);
+          }
+        }
+        REQUIRE(total == kCount);
+      }
+    }
+
+    WHEN("The body throws for one of the indices") {
+      THEN("The exception reaches the caller") {
+        REQUIRE_THROWS_AS(utils::Parallel::For(kCount, kNumThreads, [](size_t i, int) {
+                            if (i == 10) {
+                              throw runtime_error("failed");
+                            }
+                          }),
+                          runtime_error);
+      }
+    }
+  }
+
+  GIVEN("No indices") {
+    THEN("The body is never run") {
+      bool has_run = false;
+      utils::Parallel::For(0, 4, [&](size_t, int) { has_run = true; });
+      REQUIRE(!has_run);
+    }
+  }
+
+  GIVEN("A default number of threads set for the process") {
+    utils::Parallel::SetDefaultNumThreads(3);
+    int num_threads = utils::Parallel::GetDefaultNumThreads();
+    utils::Parallel::SetDefaultNumThreads(0);
+
+    THEN("It is used until it is reset") {
+      REQUIRE(num_threads == 3);
+      REQUIRE(utils::Parallel::GetDefaultNumThreads() >= 1);
+    }
+  }
+}